@@ -84,6 +84,9 @@ protected:
 	bool	_initialized;
 	Node *	_target;
 	float	_last;
+	size_t	_index;			// ڶеλ
+	Action*	_prevBinded;	// ͬһڵϵǰһ
+	Action*	_nextBinded;	// ͬһڵϵĺһ
 };
 
 
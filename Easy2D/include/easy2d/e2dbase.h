@@ -1,6 +1,7 @@
 #pragma once
 #include <easy2d/e2dmacros.h>
 #include <easy2d/e2dcommon.h>
+#include <cstdio>
 
 
 // Base Classes
@@ -97,8 +98,10 @@ public:
 	// ȡڴС
 	static Size getSize();
 
+#ifndef E2D_HEADLESS
 	// ȡھ
 	static HWND getHWnd();
+#endif
 
 	// ǷӦ뷨
 	static void setTypewritingEnable(
@@ -140,8 +143,10 @@ private:
 	// ָ
 	static void __updateCursor();
 
+#ifndef E2D_HEADLESS
 	// Win32 Ϣص
 	static LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
+#endif
 };
 
 
@@ -163,6 +168,31 @@ public:
 	// ȡϷʱ룩
 	static unsigned int getTotalTimeMilliseconds();
 
+	// ֮֡С룩ĬΪ 16 
+	static void setFrameInterval(
+		float interval
+	);
+
+	// ù̶룩 0 ʱÿ֡һ
+	// ÿ֡ۻʵʱɴΣͶʱȡʱÿƽһ
+	static void setFixedStep(
+		float step,
+		int maxSteps = 5	/* ÿ֡׷ϵĲʱᱻ */
+	);
+
+	// ȡ̶룩
+	static float getFixedStep();
+
+	// ϷʱǷʵʱͬ
+	// رպٵȴ̶ģʽÿֻ֡һԿʵʱ
+	static void setRealTime(
+		bool realTime
+	);
+
+	// ȡȾֵϵ
+	// ̶ģʽ±ʾۻδµʱռһıΪ 1
+	static float getInterpolation();
+
 private:
 	// ʼʱ
 	static bool __init();
@@ -170,6 +200,12 @@ private:
 	// Ƿﵽʱ
 	static bool __isReady();
 
+	// 㱾֡ҪµĴ
+	static void __beginFrame();
+
+	// ƽϷʱ䣬֡ĸ´ʱ false
+	static bool __step();
+
 	// µǰʱ
 	static void __updateNow();
 
@@ -252,11 +288,20 @@ private:
 };
 
 
+class RenderDevice;
+class RenderCommandList;
+
+
 // Ⱦ
 class Renderer
 {
 	friend class Game;
 	friend class Window;
+	friend class Node;
+	friend class Scene;
+#ifndef E2D_HEADLESS
+	friend class D2DRenderDevice;
+#endif
 
 public:
 	// ȡɫ
@@ -278,6 +323,43 @@ public:
 	// ȡϵͳ DPI 
 	static float getDpiScaleY();
 
+	// ȡǰȾ豸
+	static RenderDevice * getDevice();
+
+	// Ⱦ豸 nullptr ʱָĬ豸
+	// Windows Ĭʹ Direct2D 豸޴ڻĬϲȾ
+	static void setDevice(
+		RenderDevice * device
+	);
+
+	// ģʽĬϿ
+	// ûб仯ʱطһ֡¼Ⱦٱڵ
+	static void setRetainedMode(
+		bool enabled = true
+	);
+
+	// ǿһ֡¼¼Ⱦ
+	//  onRender лƵڵ״̬ʱ
+	static void invalidate();
+
+	// ӿ޳ĬϿ
+	// ƷΧȫӿ֮Ľڵ㼰ᱻȾ
+	static void setCulling(
+		bool enabled = true
+	);
+
+	// ޳ʹõӿھΣΪʱʹȾĿ
+	static void setCullingRect(
+		const Rect& rect
+	);
+
+	// ȡһαڵʱƵĽڵ
+	static size_t getDrawnNodeCount();
+
+	// ȡһαڵʱ޳Ľڵ޳ֻһΣ
+	static size_t getCulledNodeCount();
+
+#ifndef E2D_HEADLESS
 	// ȡ ID2D1Factory 
 	static ID2D1Factory * getID2D1Factory();
 
@@ -315,11 +397,43 @@ public:
 
 	// ȡ Round ʽ ID2D1StrokeStyle
 	static ID2D1StrokeStyle * getRoundID2D1StrokeStyle();
+#endif
 
 private:
 	// ȾϷ
 	static void __render();
 
+	// ȡڼ¼Ⱦбڼ¼ʱ nullptr
+	static RenderCommandList * __getRecordingList();
+
+	// ڵȾ
+	static void __renderScene();
+
+	// ͼ󣬲ӿµ޳Χ
+	static void __setViewMatrix(
+		const Matrix32& view
+	);
+
+	// ȡͼ
+	static const Matrix32& __getViewMatrix();
+
+	// жİΧǷӿ֮
+	static bool __isSubtreeCulled(
+		float left,
+		float top,
+		float right,
+		float bottom
+	);
+
+	// жϽڵİΧǷӿ֮⣬ͳƻƵĽڵ
+	static bool __isNodeCulled(
+		float left,
+		float top,
+		float right,
+		float bottom
+	);
+
+#ifndef E2D_HEADLESS
 	// 豸޹Դ
 	static bool __createDeviceIndependentResources();
 
@@ -328,16 +442,32 @@ private:
 
 	// ɾ豸Դ
 	static void __discardDeviceResources();
+#endif
 
 	// ɾȾԴ
 	static void __discardResources();
 };
 
 
+class LogSink;
+
+
 // ־
+// κ̶߳־ϢʽУɺ̨߳дĿ
+// ʱµϢϢд
 class Logger
 {
+	friend class Game;
+
 public:
+	// ־ȼ
+	enum class Level : int
+	{
+		Message,	/* Ϣ */
+		Warning,	/*  */
+		Error		/*  */
+	};
+
 	// ־¼
 	static void enable();
 
@@ -355,12 +485,236 @@ public:
 
 	// /رտ̨
 	static void showConsole(bool show = true);
+
+	// Ŀ
+	static void addSink(
+		LogSink* sink
+	);
+
+	// ƳĿ
+	static void removeSink(
+		LogSink* sink
+	);
+
+	// ƳȫĿ꣨ĬϵĿ̨
+	static void clearSinks();
+
+	// Ѷе־ȫдĿ
+	static void flush();
+
+	// ȡ־
+	static size_t getDroppedCount();
+
+private:
+	// ־߳
+	static void __init();
+
+	// дʣ־־߳
+	static void __uninit();
+};
+
+
+// ־Ŀ
+// write  flush ֻд־߳еãҪ־
+class LogSink :
+	public Object
+{
+public:
+	// һ־
+	virtual void write(
+		Logger::Level level,	/* ־ȼ */
+		const String& text		/* ־ݣз */
+	) = 0;
+
+	// де
+	virtual void flush() {}
+};
+
+
+// ̨
+class ConsoleLogSink :
+	public LogSink
+{
+public:
+	virtual void write(
+		Logger::Level level,
+		const String& text
+	) override;
+};
+
+
+// ļ
+// ־ UTF-8 дļ
+class FileLogSink :
+	public LogSink
+{
+public:
+	explicit FileLogSink(
+		const String& filePath,	/* ļ· */
+		bool append = false		/* Ƿ׷ӵļĩβ */
+	);
+
+	virtual ~FileLogSink();
+
+	// ļǷ򿪳ɹ
+	bool isOpened() const;
+
+	virtual void write(
+		Logger::Level level,
+		const String& text
+	) override;
+
+	virtual void flush() override;
+
+protected:
+	FILE* _file;
+};
+
+
+#ifndef E2D_HEADLESS
+
+// 
+// ͨ OutputDebugString  Visual Studio 
+class DebugLogSink :
+	public LogSink
+{
+public:
+	virtual void write(
+		Logger::Level level,
+		const String& text
+	) override;
+};
+
+#endif
+
+
+// ܷ
+//  E2D_PROFILE_SCOPE Ǵ䣬ÿ̰߳¼ԵĻλ
+// ĸ½׶Ѿǣ¼ԵΪ Chrome  trace ʽchrome://tracing
+class Profiler
+{
+public:
+	// ֮ǰļ¼ʼ¼
+	static void start();
+
+	// ֹͣ¼
+	static void stop();
+
+	// Ƿڼ¼
+	static bool isRunning();
+
+	// ÿ߳ౣ󸲸ļ¼
+	static void setBufferSize(
+		size_t zoneCount
+	);
+
+	// õǰ߳ڵʾ
+	static void setThreadName(
+		const String& name
+	);
+
+	// Ѽ¼Ϊ Chrome trace ʽ JSON ļ
+	static bool exportChromeTrace(
+		const String& filePath
+	);
+
+	// ¼һ䣬name ڵǰһֱЧͨΪַ
+	static void record(
+		const char* name,		/*  */
+		long long beginTicks,	/* ʼʱ */
+		long long endTicks		/* ʱ */
+	);
+
+	// ȡǰʱ̣ʱ̶ȣ
+	static long long getTicks();
 };
 
 
+// ܷ
+// ʱʼʱʱ¼
+class ProfileZone
+{
+public:
+	explicit ProfileZone(
+		const char* name
+	)
+		: _name(Profiler::isRunning() ? name : nullptr)
+		, _begin(_name ? Profiler::getTicks() : 0)
+	{
+	}
+
+	~ProfileZone()
+	{
+		if (_name)
+		{
+			Profiler::record(_name, _begin, Profiler::getTicks());
+		}
+	}
+
+private:
+	ProfileZone(const ProfileZone&);
+	ProfileZone& operator=(const ProfileZone&);
+
+private:
+	const char* _name;
+	long long _begin;
+};
+
+
+// ϵͳ
+// ̸߳ԳһУʱ̵߳Ķȡ
+class JobSystem
+{
+	friend class Game;
+
+public:
+	// ù߳0 ʾʹȫӲ̣߳
+	// ߳Ҳִʵʴ߳һ
+	static void setThreadCount(
+		int threadCount
+	);
+
+	// ȡִ̣߳߳
+	static int getThreadCount();
+
+	// ִ func(0) ~ func(count - 1)ʱ
+	// ȴڼ߳ҲִǶ׵
+	static void parallelFor(
+		size_t count,
+		const std::function<void(size_t)>& func
+	);
+
+private:
+	// ߳
+	static void __init();
+
+	// й߳
+	static void __uninit();
+};
+
+
+namespace __gc_helper
+{
+	class GCTempHelper;
+}
+
+
 // װ
 class GC
 {
+	friend class Object;
+	friend class __gc_helper::GCTempHelper;
+
+public:
+	// һ֡Ķͳ
+	struct Stats
+	{
+		size_t createdCount;	// Ķ
+		size_t destroyedCount;	// ٵĶ
+		size_t pooledCount;		//  GC صĶ
+		size_t temporaryBytes;	// ʱռõڴ
+	};
+
 public:
 	//  GC 
 	static void trace(
@@ -376,6 +730,15 @@ public:
 	// GC ״̬
 	static bool isClearing();
 
+	// ȡһ֡Ķͳ
+	static const Stats& getStats();
+
+	// ʱڴзڴ棨 gctemp ʹã
+	// ڴ GC ʱãԱõĶڵڴᱣ
+	static void* allocateTemporary(
+		size_t size
+	);
+
 	// 
 	template <typename Type>
 	static inline void retain(Type*& p)
@@ -396,6 +759,22 @@ public:
 			p = nullptr;
 		}
 	}
+
+private:
+	// ¼Ĵ
+	static void __onCreated();
+
+	static void __onDestroyed();
+
+	// Ƕʱڴ
+	static void __markTemporary(
+		Object* pObject
+	);
+
+	// ʱ󲢹黹ڴ
+	static void __destroyTemporary(
+		Object* pObject
+	);
 };
 
 
@@ -422,35 +801,103 @@ namespace __gc_helper
 		//  IntelliSense 
 		static GCNewHelper instance;
 	};
+
+	class GCTempHelper
+	{
+	public:
+		template <typename _Ty>
+		inline _Ty* operator<< (_Ty* newObj) const
+		{
+			if (newObj)
+			{
+				GC::__markTemporary(newObj);
+				newObj->autorelease();
+			}
+			return newObj;
+		}
+
+		static GCTempHelper instance;
+	};
 }
 
 #ifndef gcnew
 #	define gcnew __gc_helper::GCNewHelper::instance << new (std::nothrow)
 #endif
 
+// ʱڴдʺֻڱ֡ʹõĶڶ
+#ifndef gctemp
+#	define gctemp __gc_helper::GCTempHelper::instance << new (__gc_helper::GCTempHelper::instance)
+#endif
+
 
 //
 // Log macros
 //
 
-#ifndef E2D_LOG
+// ȼ E2D_LOG_LEVEL ־ڱʱƳ
+// 0ȫ  1ʹ  2ֻ  3ȫر
+#ifndef E2D_LOG_LEVEL
 #	ifdef E2D_DEBUG
-#		define E2D_LOG(FORMAT, ...) easy2d::Logger::messageln(FORMAT, __VA_ARGS__)
+#		define E2D_LOG_LEVEL 0
+#	else
+#		define E2D_LOG_LEVEL 1
+#	endif
+#endif
+
+#ifdef _MSC_VER
+#	define E2D_LOG_DISCARD __noop
+#else
+#	define E2D_LOG_DISCARD(FORMAT, ...) ((void)0)
+#endif
+
+#ifndef E2D_LOG
+#	if E2D_LOG_LEVEL <= 0
+#		define E2D_LOG(FORMAT, ...) easy2d::Logger::messageln(FORMAT, ##__VA_ARGS__)
 #	else
-#		define E2D_LOG __noop
+#		define E2D_LOG E2D_LOG_DISCARD
 #	endif
 #endif
 
 #ifndef E2D_WARNING
-#	define E2D_WARNING(FORMAT, ...) easy2d::Logger::warningln(FORMAT, __VA_ARGS__)
+#	if E2D_LOG_LEVEL <= 1
+#		define E2D_WARNING(FORMAT, ...) easy2d::Logger::warningln(FORMAT, ##__VA_ARGS__)
+#	else
+#		define E2D_WARNING E2D_LOG_DISCARD
+#	endif
 #endif
 
 #ifndef E2D_ERROR
-#	define E2D_ERROR(FORMAT, ...) easy2d::Logger::errorln(FORMAT, __VA_ARGS__)
+#	if E2D_LOG_LEVEL <= 2
+#		define E2D_ERROR(FORMAT, ...) easy2d::Logger::errorln(FORMAT, ##__VA_ARGS__)
+#	else
+#		define E2D_ERROR E2D_LOG_DISCARD
+#	endif
+#endif
+
+//  E2D_DISABLE_PROFILER ܷڱʱƳ
+#ifndef E2D_PROFILE_SCOPE
+#	ifndef E2D_DISABLE_PROFILER
+#		define E2D_PROFILE_SCOPE_NAME2(LINE) __e2d_profile_zone_##LINE
+#		define E2D_PROFILE_SCOPE_NAME(LINE) E2D_PROFILE_SCOPE_NAME2(LINE)
+#		define E2D_PROFILE_SCOPE(NAME) easy2d::ProfileZone E2D_PROFILE_SCOPE_NAME(__LINE__)(NAME)
+#	else
+#		define E2D_PROFILE_SCOPE(NAME) ((void)0)
+#	endif
 #endif
 
-#ifndef E2D_ERROR_IF_FAILED
-#	define E2D_ERROR_IF_FAILED(HR, FORMAT, ...) do { if (FAILED(HR)) { E2D_ERROR(FORMAT, __VA_ARGS__); } } while (0)
+#if !defined(E2D_ERROR_IF_FAILED) && !defined(E2D_HEADLESS)
+#	define E2D_ERROR_IF_FAILED(HR, FORMAT, ...) do { if (FAILED(HR)) { E2D_ERROR(FORMAT, ##__VA_ARGS__); } } while (0)
 #endif
 
-}
\ No newline at end of file
+}
+
+// ʱķ亯
+inline void* operator new(size_t size, const easy2d::__gc_helper::GCTempHelper&)
+{
+	return easy2d::GC::allocateTemporary(size);
+}
+
+// ʧʱҪ黹ڴ棬ڴػ
+inline void operator delete(void*, const easy2d::__gc_helper::GCTempHelper&)
+{
+}
@@ -61,6 +61,12 @@ ByteString WideToNarrow(const String& str);
 // խַתַ
 String NarrowToWide(const ByteString& str);
 
+// ַת UTF-8 ַ
+ByteString WideToUtf8(const String& str);
+
+// UTF-8 ַתַ
+String Utf8ToWide(const char* str, size_t size);
+
 
 // ɫ
 class Color
@@ -90,7 +96,21 @@ public:
 		float alpha
 	);
 
+	// ȡɫ
+	float getRed() const;
+
+	// ȡɫ
+	float getGreen() const;
+
+	// ȡɫ
+	float getBlue() const;
+
+	// ȡ͸
+	float getAlpha() const;
+
+#ifndef E2D_HEADLESS
 	D2D1_COLOR_F toD2DColorF() const;
+#endif
 
 public:
 	enum Value : UINT
@@ -189,6 +209,8 @@ public:
 // 
 class Object
 {
+	friend class GC;
+
 public:
 	Object();
 
@@ -207,17 +229,117 @@ public:
 	int getRefCount() const;
 
 private:
-	int _refCount;
+	int			_refCount;
+	unsigned	_gcGeneration;	//  GC ʱĴ
+	bool		_temporary;		// Ƿʱڴ
+};
+
+
+// Դ
+class Resource
+{
+public:
+	// ԴĶ
+	struct Data
+	{
+		void* buffer;	// Դ
+		int size;	// ԴݴС
+
+		Data();
+
+		bool isValid() const;
+
+		template <typename Elem>
+		friend std::basic_ostream<Elem>& operator<<(std::basic_ostream<Elem>& out, const Resource::Data& data)
+		{
+			using OStreamType = std::basic_ostream<Elem>;
+
+			typename OStreamType::iostate state = OStreamType::goodbit;
+			const typename OStreamType::sentry ok(out);
+			if (!ok)
+			{
+				state |= OStreamType::badbit;
+			}
+			else
+			{
+				if (data.buffer && data.size)
+				{
+					out.write(reinterpret_cast<const Elem*>(data.buffer), static_cast<std::streamsize>(data.size));
+				}
+				else
+				{
+					state |= OStreamType::badbit;
+				}
+			}
+			out.setstate(state);
+			return out;
+		}
+	};
+
+	Resource();
+
+	Resource(
+		int id,				/* Դ ID */
+		const String& type	/* Դ */
+	);
+
+	// ԴĶ
+	Resource::Data loadData() const;
+
+	// ȡԴ ID
+	int getId() const;
+
+	// ȡԴ
+	String getType() const;
+
+private:
+	int		_id;
+	String	_type;
+
+	mutable Resource::Data _data;
 };
 
 
+class Texture;
+
+
 // ͼƬ
 class Image :
 	public Object
 {
+	friend class Game;
+	friend class TextureAtlas;
+
+public:
+	// ״̬
+	enum class State
+	{
+		Empty,		/* δ */
+		Loading,	/* 첽 */
+		Ready,		/*  */
+		Failed		/* ʧ */
+	};
+
+	// ɻʧʱĻص
+	using LoadCallback = Function<void(Image*)>;
+
+	// ͳ
+	struct CacheStats
+	{
+		size_t hitCount;		/* д */
+		size_t missCount;		/* δд */
+		size_t evictionCount;	/* ͷŵ */
+		size_t cachedCount;		/* е */
+		size_t cachedBytes;		/* еռõֽ */
+	};
+
 public:
 	Image();
 
+	explicit Image(
+		Texture * texture		/*  */
+	);
+
 	explicit Image(
 		const String& filePath	/* ͼƬļ· */
 	);
@@ -251,6 +373,25 @@ public:
 		const String& resType	/* ͼƬԴ */
 	);
 
+	// ʹѴ
+	bool open(
+		Texture * texture		/*  */
+	);
+
+	// ڹ߳нͼƬļɺ߳д
+	// ǰͼƬûݣ false ʾҲļ
+	bool openAsync(
+		const String& filePath	/* ͼƬļ· */
+	);
+
+	// ȡ״̬
+	State getState() const;
+
+	// ӼɻʧʱִеĻصͼƬڼʱִ
+	void addLoadCallback(
+		const LoadCallback& callback
+	);
+
 	// ͼƬüΪ
 	void crop(
 		const Rect& cropRect	/* ü */
@@ -286,8 +427,13 @@ public:
 	// ָλȾͼƬ
 	void draw(const Rect& destRect, float opacity) const;
 
+	// ȡ
+	Texture * getTexture() const;
+
+#ifndef E2D_HEADLESS
 	// ȡ ID2D1Bitmap 
 	ID2D1Bitmap * getBitmap();
+#endif
 
 	// ԤͼƬļ
 	static bool preload(
@@ -300,18 +446,98 @@ public:
 		const String& resType	/* ͼƬԴ */
 	);
 
-	// ջ
+	// ԤڴеͼƬļݣ֮ name ͼƬ
+	static bool preload(
+		const String& name,		/* ͼƬ */
+		const Resource::Data& data	/* ͼƬļ */
+	);
+
+	// ڹ߳ԤͼƬļ
+	static bool preloadAsync(
+		const String& filePath	/* ͼƬļ· */
+	);
+
+	// ȡ첽صͼƬļ
+	static size_t getLoadingCount();
+
+	// ÿ֡ʱԤ㣨룩ĬΪ 4 
+	// ԤʱʣͼƬһ֡ÿ֡ٴһ
+	static void setUploadBudget(
+		float seconds
+	);
+
+	// Ԥ㣨ֽڣĬΪ 256 MB
+	// Ԥʱδʹõ˳ͷûбͼƬõٴʹʱ¼
+	static void setCacheBudget(
+		size_t bytes
+	);
+
+	// ȡԤ㣨ֽڣ
+	static size_t getCacheBudget();
+
+	// ȡͳ
+	static CacheStats getCacheStats();
+
+	// ͷûбͼƬõ
+	static void purgeCache();
+
+	// ջ棨עͼ
 	static void clearCache();
 
+	// ͼƬļΪ 32 λ RGBA ݣԤˣ
+	static bool decode(
+		const String& filePath,					/* ͼƬļ· */
+		std::vector<unsigned char>& pixels,		/*  */
+		int* width,								/*  */
+		int* height								/* ߶ */
+	);
+
+	// ʹýڴе PNG  BMP ͼƬ̵߳
+	static bool decode(
+		const void* data,						/* ͼƬļ */
+		size_t size,							/* ݴС */
+		std::vector<unsigned char>& pixels,		/*  */
+		int* width,								/*  */
+		int* height								/* ߶ */
+	);
+
 protected:
-	//  Bitmap
-	void _setBitmap(
-		ID2D1Bitmap * bitmap
+	// ʹΪԴͼƬ
+	void _setTexture(
+		Texture * texture
+	);
+
+	// ʹеһΪԴͼƬ
+	void _setTexture(
+		Texture * texture,
+		const Rect& sourceRect
+	);
+
+	// ؽִвջص
+	void _finishLoading(
+		State state
 	);
 
+	// עͼеͼƬ֮ԸƴͼƬʱֱʹ
+	static void __addAtlasRegion(
+		const String& name,
+		Texture * texture,
+		const Rect& sourceRect
+	);
+
+	// ΪɵͼƬ
+	static void __update();
+
+	// ̣߳ȡδɵļ
+	static void __uninit();
+
 protected:
-	Rect _cropRect;
-	ID2D1Bitmap * _bitmap;
+	Rect _cropRect;		// üΣ꣩
+	Rect _sourceRect;	// ԴͼƬе
+	Texture * _texture;
+	State _state;
+	unsigned int _loadId;	// 첽صıţ´ͼƬɵļؽ
+	std::vector<LoadCallback> _loadCallbacks;
 };
 
 
@@ -544,69 +770,5 @@ protected:
 	Callback _callback;
 };
 
-// Դ
-class Resource
-{
-public:
-	// ԴĶ
-	struct Data
-	{
-		void* buffer;	// Դ
-		int size;	// ԴݴС
-
-		Data();
-
-		bool isValid() const;
-
-		template <typename Elem>
-		friend std::basic_ostream<Elem>& operator<<(std::basic_ostream<Elem>& out, const Resource::Data& data)
-		{
-			using OStreamType = std::basic_ostream<Elem>;
-
-			typename OStreamType::iostate state = OStreamType::goodbit;
-			const typename OStreamType::sentry ok(out);
-			if (!ok)
-			{
-				state |= OStreamType::badbit;
-			}
-			else
-			{
-				if (data.buffer && data.size)
-				{
-					out.write(reinterpret_cast<const Elem*>(data.buffer), static_cast<std::streamsize>(data.size));
-				}
-				else
-				{
-					state |= OStreamType::badbit;
-				}
-			}
-			out.setstate(state);
-			return out;
-		}
-	};
-
-	Resource();
-
-	Resource(
-		int id,				/* Դ ID */
-		const String& type	/* Դ */
-	);
-
-	// ԴĶ
-	Resource::Data loadData() const;
-
-	// ȡԴ ID
-	int getId() const;
-
-	// ȡԴ
-	String getType() const;
-
-private:
-	int		_id;
-	String	_type;
-
-	mutable Resource::Data _data;
-};
-
 
 }
\ No newline at end of file
@@ -1,5 +1,12 @@
 #pragma once
 
+//  Windows ƽ̨ܱ޴ڵĺĿ
+#if !defined(_WIN32) && !defined(E2D_HEADLESS)
+#	define E2D_HEADLESS
+#endif
+
+#ifndef E2D_HEADLESS
+
 #ifndef WINVER
 #	define WINVER 0x0700       // Allow use of features specific to Windows 7 or later
 #endif
@@ -35,14 +42,6 @@
 #include <dwrite.h>
 #include <d2d1helper.h>
 
-// C++ RunTime Header Files
-#include <stack>
-#include <vector>
-#include <functional>
-#include <sstream>
-#include <random>
-#include <utility>
-
 // Import Libraries
 #pragma comment(lib, "d2d1.lib")
 #pragma comment(lib, "dwrite.lib")
@@ -55,6 +54,57 @@
 #	define HINST_THISCOMPONENT ((HINSTANCE)&__ImageBase)
 #endif
 
+#else // E2D_HEADLESS
+
+// C RunTime Header Files
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <type_traits>
+
+//  Win32 һµĻ
+typedef unsigned int UINT;
+
+//  windows.h е min / max 
+template <typename _Ty1, typename _Ty2>
+inline typename std::common_type<_Ty1, _Ty2>::type min(_Ty1 a, _Ty2 b)
+{
+	return (b < a) ? b : a;
+}
+
+template <typename _Ty1, typename _Ty2>
+inline typename std::common_type<_Ty1, _Ty2>::type max(_Ty1 a, _Ty2 b)
+{
+	return (a < b) ? b : a;
+}
+
+// 룬ȡֵ Win32 ͬ
+#define VK_BACK			0x08
+#define VK_TAB			0x09
+#define VK_RETURN		0x0D
+#define VK_SHIFT		0x10
+#define VK_CONTROL		0x11
+#define VK_MENU			0x12
+#define VK_ESCAPE		0x1B
+#define VK_SPACE		0x20
+#define VK_LEFT			0x25
+#define VK_UP			0x26
+#define VK_RIGHT		0x27
+#define VK_DOWN			0x28
+#define VK_DELETE		0x2E
+#define VK_NUMPAD0		0x60
+#define VK_F1			0x70
+
+#endif // E2D_HEADLESS
+
+// C++ RunTime Header Files
+#include <stack>
+#include <vector>
+#include <functional>
+#include <sstream>
+#include <random>
+#include <utility>
+
 #if !defined(E2D_DEBUG) && defined(_DEBUG)
 #	define E2D_DEBUG
 #endif
@@ -56,6 +56,9 @@ private:
 	// Ⱦ
 	static void __render();
 
+	// ǷҪȾ
+	static bool __isDirty();
+
 	// ʼ
 	static bool __init();
 
@@ -121,11 +124,34 @@ private:
 		Node * target
 	);
 
+	// ڽڵͬĶ
+	static void __resumeBindedWith(
+		Node * target,
+		const String& name
+	);
+
+	// ͣڽڵͬĶ
+	static void __pauseBindedWith(
+		Node * target,
+		const String& name
+	);
+
+	// ֹͣڽڵͬĶ
+	static void __stopBindedWith(
+		Node * target,
+		const String& name
+	);
+
 	// հڽڵϵж
 	static void __clearAllBindedWith(
 		Node * target
 	);
 
+	// Ƴ
+	static void __remove(
+		Action * action
+	);
+
 	// ж״̬
 	static void __resetAll();
 
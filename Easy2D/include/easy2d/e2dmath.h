@@ -67,6 +67,55 @@ namespace easy2d
 		inline float Floor(float val) { return ::floor(val); }
 
 		inline double Floor(double val) { return ::floor(val); }
+
+		// ͬʱҺңǶƣڹ任
+		// Ȱ 90 ȵԼ [-45, 45] ȣöʽƣ 2e-7
+		// 0 Ⱥ 90 ȵֵС 1e9 ʱȷǶȹֵʱʹñ׼
+		inline void FastSinCos(float degrees, float& sinVal, float& cosVal)
+		{
+			if (degrees == 0)
+			{
+				sinVal = 0.f;
+				cosVal = 1.f;
+				return;
+			}
+
+			if (!(::fabsf(degrees) < 1e9f))
+			{
+				sinVal = Sin(degrees);
+				cosVal = Cos(degrees);
+				return;
+			}
+
+			// õޣԼǾȷģ90 ȵΪ 0
+			const int quadrant = static_cast<int>(degrees * (1.f / 90.f) + (degrees < 0 ? -0.5f : 0.5f));
+			const float x = (degrees - static_cast<float>(quadrant) * 90.f) * (constants::PI_F / 180.f);
+			const float z = x * x;
+
+			// [-PI/4, PI/4] ϵļСʽϵȡ Cephes
+			const float s = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+			const float c = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.f;
+
+			// ޽ȡдѡԱ֧
+			const bool swap = (quadrant & 1) != 0;
+			const float sv = swap ? c : s;
+			const float cv = swap ? s : c;
+			sinVal = (quadrant & 2) ? -sv : sv;
+			cosVal = ((quadrant + 1) & 2) ? -cv : cv;
+		}
+
+		// УǶƣ FastSinCos ͬӽ 90 ʱ
+		// 90 ȵǡΪ 0 Tan ԭֵͬ
+		inline float FastTan(float degrees)
+		{
+			float s, c;
+			FastSinCos(degrees, s, c);
+			if (c == 0)
+			{
+				return Tan(degrees);
+			}
+			return s / c;
+		}
 	}
 
 	class Size;
@@ -228,7 +277,7 @@ namespace easy2d
 			return *this;
 		}
 
-		float operator [](unsigned int index) const;
+		inline float operator [](unsigned int index) const { return m[index]; }
 
 
 		void identity();
@@ -247,7 +296,9 @@ namespace easy2d
 
 		bool isInvertible() const;
 
+#ifndef E2D_HEADLESS
 		D2D1::Matrix3x2F const& toD2DMatrix() const;
+#endif
 
 		static Matrix32 translation(
 			float x,
@@ -268,6 +319,46 @@ namespace easy2d
 			const Point& center = Point());
 
 		static Matrix32 invert(Matrix32 const& matrix);
+
+		// ʱ CPU ֵָ֧ѡ AVXSSE2 ʵ
+		// ͬܲص
+
+		// out[i] = lhs[i] * rhs[i]
+		static void multiply(
+			const Matrix32* lhs,
+			const Matrix32* rhs,
+			Matrix32* out,
+			size_t count);
+
+		// out[i] = lhs[i] * rhsͬһڵӽڵ
+		static void multiply(
+			const Matrix32* lhs,
+			Matrix32 const& rhs,
+			Matrix32* out,
+			size_t count);
+
+		// out[i] = invert(matrices[i])
+		static void invert(
+			const Matrix32* matrices,
+			Matrix32* out,
+			size_t count);
+
+		// out[i] = matrix.transform(points[i])
+		static void transformPoints(
+			Matrix32 const& matrix,
+			const Vector2* points,
+			Vector2* out,
+			size_t count);
+
+		// out[i] = matrices[i].transform(rects[i])Χ
+		static void transformRects(
+			const Matrix32* matrices,
+			const Rect* rects,
+			Rect* out,
+			size_t count);
+
+		// ʹõָ"AVX""SSE2"  "Scalar"
+		static const char* getBatchInstructionSet();
 	};
 
 
@@ -1,11 +1,14 @@
 #pragma once
 #include <easy2d/e2dbase.h>
+#include <atomic>
 
 namespace easy2d 
 {
 
 
 class Action;
+class Scene;
+class Button;
 class Transition;
 class SceneManager;
 
@@ -15,6 +18,7 @@ class Node :
 	friend class Scene;
 	friend class Transition;
 	friend class SceneManager;
+	friend class ActionManager;
 
 public:
 	// ڵ
@@ -133,6 +137,14 @@ public:
 	// Ƿ
 	bool containsPoint(Point const& point);
 
+	// Ƿڵཻཻʱ㵽ľ
+	bool intersectsRay(
+		const Point& origin,		/*  */
+		const Vector2& direction,	/* ߷ */
+		float maxDistance,			/* ߳ */
+		float* distance = nullptr	/*  */
+	);
+
 	// ýڵǷʾ
 	void setVisible(
 		bool value
@@ -143,6 +155,16 @@ public:
 		bool bAutoUpdate
 	);
 
+	// Ƿڶ߳виӽڵ
+	// иڼӡƳӽڵֹͣƳٵ֡½ʱִ
+	// ӽڵ onUpdate вܴڵ㣬Ҳ޸еĽڵ
+	void setParallelUpdate(
+		bool parallel
+	);
+
+	// Ƿиӽڵ
+	bool isParallelUpdate() const;
+
 	// ýڵ
 	void setName(
 		const String& name
@@ -429,6 +451,12 @@ protected:
 	// ½ڵ
 	void _update();
 
+	//  [begin, end) Χڵӽڵ
+	void _updateChildren(
+		size_t begin,
+		size_t end
+	);
+
 	// Ⱦڵ
 	void _render();
 
@@ -443,12 +471,60 @@ protected:
 	// ¶ά任
 	void _updateInverseTransform() const;
 
+	// ڵı±任λ
+	void _attachSlot();
+
+	// ѽڵ㼰ӽڵı任λƶ洢ĩβ
+	void _moveSlots();
+
+	// нڵĶά任
+	static void __updateTransforms();
+
+	// Ƿڲи½ڵ
+	static bool __isUpdatingInParallel();
+
+	// ִвиڼƳٵĲ
+	static void __flushDeferred();
+
+	// ²иڼƳٵĿռΧУǰб任
+	static void __flushPendingProxies();
+
 	// ӽڵ
 	void _sortChildren();
 
 	// ½ڵ͸
 	void _updateOpacity();
 
+	// Ⱦڵ
+	void _renderSelf();
+
+	// ǽڵѸı䣬ϱиڵ
+	void _setContentDirty();
+
+	// ڵݱǣȾ
+	void _clearChildrenContentDirty();
+
+	// ½ڵڳռеİΧ
+	void _updateProxy(
+		const Matrix32& world,
+		float width,
+		float height
+	);
+
+	// ѽڵӳռƳ
+	void _removeProxy();
+
+	// ȡڵʱ߿ľ룬ӿ޳
+	// ظʾƷΧδ֪ڵ㲻ᱻ޳
+	virtual float _getRenderMargin() const;
+
+	// ƷΧıʱ¼Χ
+	void _setBoundsDirty();
+
+	// ڵĻܷ񱻼¼ΪȾ
+	// ֻõĽڵͻᱻ¼ڵڻطʱִ onRender 
+	virtual bool _isRecordable() const;
+
 	// ¼
 	void __updateListeners(Event* evt);
 
@@ -458,41 +534,226 @@ protected:
 protected:
 	bool		_visible;
 	bool		_autoUpdate;
+	bool		_parallelUpdate;
 	bool		_needSort;
+	bool		_dirtyContent;
 	bool		_positionFixed;
-	float		_posX;
-	float		_posY;
+	bool		_updatingChildren;	// Ƿڲиӽڵ
+	std::atomic<bool> _childContentDirty;	// иڼǷӽڵݸı
 	float		_width;
 	float		_height;
-	float		_scaleX;
-	float		_scaleY;
-	float		_rotation;
-	float		_skewAngleX;
-	float		_skewAngleY;
 	float		_displayOpacity;
 	float		_realOpacity;
-	float		_anchorX;
-	float		_anchorY;
 	int			_nOrder;
+	size_t		_slot;		// 任ڱ任洢еĲλ
+	int			_proxy;		// ڳռеı
 	String		_name;
 	size_t		_hashName;
 	Scene *		_parentScene;
 	Node *		_parent;
+	Action *	_actions;	// ڽڵϵĶ
 	
 	std::vector<Node*>	_children;
 	std::vector<Listener*> _listeners;
 
-	mutable bool		_dirtyTransform;
-	mutable Matrix32	_transform;
-	mutable bool		_dirtyInverseTransform;
 	mutable Matrix32	_inverseTransform;
 };
 
 
+// ̬Χ
+// ҶӱڵİΧУڲڵİΧаӽڵ㣬ʱƽ
+class SpatialTree
+{
+public:
+	// ѯص false ʱֹͣѯ
+	typedef std::function<bool(Node*)> QueryCallback;
+
+	SpatialTree();
+
+	// ӰΧУı
+	int createProxy(
+		const Rect& bounds,
+		Node * node
+	);
+
+	// ƳΧ
+	void destroyProxy(
+		int proxy
+	);
+
+	// ƶΧУǷ²
+	bool moveProxy(
+		int proxy,
+		const Rect& bounds
+	);
+
+	// ȡΧжӦĽڵ
+	Node * getNode(
+		int proxy
+	) const;
+
+	// ȡΧ
+	Rect getBounds(
+		int proxy
+	) const;
+
+	// ѯΧཻĽڵ
+	void query(
+		const Rect& rect,
+		const QueryCallback& callback
+	) const;
+
+	// ѯΧཻĽڵ
+	void raycast(
+		const Point& origin,
+		const Vector2& direction,
+		float maxDistance,
+		const QueryCallback& callback
+	) const;
+
+	// ȡΧ
+	size_t getProxyCount() const;
+
+	// ȡĸ߶
+	int getHeight() const;
+
+private:
+	struct TreeNode
+	{
+		float	minX, minY, maxX, maxY;		// İΧ
+		Rect	bounds;						// ʵʵİΧ
+		int		parent;						// ڵ㣬ʱΪһнڵ
+		int		child1;
+		int		child2;
+		int		height;						// ҶΪ 0ʱΪ -1
+		Node *	node;
+
+		bool isLeaf() const { return child1 == -1; }
+	};
+
+	int _allocateNode();
+
+	void _freeNode(int id);
+
+	void _insertLeaf(int leaf);
+
+	void _removeLeaf(int leaf);
+
+	int _balance(int id);
+
+	void _setFatBounds(int id, const Rect& bounds);
+
+	void _combine(int id, int child1, int child2);
+
+private:
+	std::vector<TreeNode>	_nodes;
+	int						_root;
+	int						_freeList;
+	size_t					_proxyCount;
+};
+
+
+// 
+// ͼֻȾʱƶ¼ڵ
+class Camera :
+	public Object
+{
+	friend class Scene;
+
+public:
+	Camera();
+
+	virtual ~Camera();
+
+	// ȡλ
+	Point getPos() const;
+
+	// ȡű
+	float getZoom() const;
+
+	// ȡתǶ
+	float getRotation() const;
+
+	// ȡê
+	float getAnchorX() const;
+
+	// ȡê
+	float getAnchorY() const;
+
+	// λã꽫ʾӿڵê㴦
+	void setPos(
+		const Point& point
+	);
+
+	// λ
+	void setPos(
+		float x,
+		float y
+	);
+
+	// ƶ
+	void movePos(
+		float x,
+		float y
+	);
+
+	// ű 1 ʱŴ
+	void setZoom(
+		float zoom
+	);
+
+	// תǶȣ水෴ת
+	void setRotation(
+		float rotation
+	);
+
+	// ê㣨ӿڴСĬΪϽǣ
+	// Ĭϵı仭
+	void setAnchor(
+		float anchorX,
+		float anchorY
+	);
+
+	// ȡͼ任ΪĻ
+	Matrix32 getViewMatrix() const;
+
+	// ĻתΪ
+	Point screenToWorld(
+		const Point& point
+	) const;
+
+	// תΪĻ
+	Point worldToScreen(
+		const Point& point
+	) const;
+
+	// ȡӿµо
+	Rect getVisibleRect() const;
+
+protected:
+	// ıȾڳ
+	void _setDirty();
+
+protected:
+	float	_posX;
+	float	_posY;
+	float	_zoom;
+	float	_rotation;
+	float	_anchorX;
+	float	_anchorY;
+	Scene *	_scene;
+};
+
+
 // 
 class Scene :
 	public Node
 {
+	friend class Node;
+	friend class Camera;
+	friend class Transition;
+	friend class SceneManager;
+
 public:
 	Scene();
 
@@ -506,6 +767,51 @@ public:
 
 	// дڹرմʱִУ false ֹڹرգ
 	virtual bool onCloseWindow() { return true; }
+
+	// ȡнڵ
+	std::vector<Node*> queryPoint(
+		const Point& point
+	);
+
+	// ȡаΧཻнڵ
+	std::vector<Node*> queryRect(
+		const Rect& rect
+	);
+
+	// ȡཻнڵ㣬ɽԶ
+	std::vector<Node*> queryRay(
+		const Point& origin,		/*  */
+		const Vector2& direction,	/* ߷ */
+		float maxDistance			/* ߳ */
+	);
+
+	// ȡĿռ
+	// п߲ΪĽڵڱ任ʱԶάԼİΧ
+	const SpatialTree& getSpatialTree();
+
+	// óΪʱͼ任
+	// Ĭϴһı仭һֻһ
+	void setCamera(
+		Camera * camera
+	);
+
+	// ȡ
+	Camera * getCamera() const;
+
+protected:
+	// ʹͼȾ
+	void _renderView();
+
+	// Ϣַť
+	// ÿռҵµİťֻͣİťյϢ
+	void _dispatchToButtons(
+		Event * evt
+	);
+
+protected:
+	Camera *	_camera;
+	Button *	_hoverButton;	// ͣİť
+	SpatialTree _spatialTree;
 };
 
 
@@ -569,11 +875,16 @@ public:
 	// Ⱦ
 	virtual void onRender() override;
 
+protected:
+	virtual bool _isRecordable() const override;
+
 protected:
 	Image * _image;
 };
 
 
+#ifndef E2D_HEADLESS
+
 // ı
 class Text :
 	public Node
@@ -788,11 +1099,15 @@ protected:
 	IDWriteTextLayout * _textLayout;
 };
 
+#endif
+
 
 // ť
 class Button :
 	public Node
 {
+	friend class Scene;
+
 public:
 	using Callback = Function<void()>;
 
@@ -870,7 +1185,11 @@ protected:
 	// ִаť
 	virtual void _runCallback();
 
-	void updateStatus(Event* evt);
+	// Ϣhit ʾǷڰť
+	void _updateStatus(
+		Event * evt,
+		bool hit
+	);
 
 protected:
 	bool		_enable;
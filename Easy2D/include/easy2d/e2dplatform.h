@@ -0,0 +1,125 @@
+#pragma once
+#include <easy2d/e2dmacros.h>
+#include <easy2d/e2dcommon.h>
+#include <cstdio>
+
+namespace easy2d
+{
+
+
+// ƽ̨
+// ĿֻͨʲϵͳWindows  POSIX ƽ̨һʵ
+namespace platform
+{
+	//
+	// ʱ
+	//
+
+	// ȡʱӵĵǰʱ̣΢룩
+	long long GetTimestamp();
+
+	// ȡ߾ȼʱĵǰ̶
+	long long GetTicks();
+
+	// ȡ߾ȼʱÿĿ̶
+	long long GetTickFrequency();
+
+	// ǰ߳
+	void SleepFor(
+		unsigned int milliseconds	/* ʱ룩 */
+	);
+
+	//
+	// ļϵͳ
+	//
+
+	// ·ָ
+	wchar_t GetPathSeparator();
+
+	// жļļǷ
+	bool FileExists(
+		const String& path
+	);
+
+	// ļ
+	bool MakeDirectory(
+		const String& dirPath
+	);
+
+	// ļ fopen ͬʧʱ nullptr
+	FILE* OpenFile(
+		const String& filePath,	/* ļ· */
+		const char* mode		/* 򿪷ʽ */
+	);
+
+	// ļед̣ʧʱ false
+	bool SyncFile(
+		FILE* file
+	);
+
+	// ļĿļѴʱֱ滻
+	bool RenameFile(
+		const String& srcPath,	/* ԭ· */
+		const String& destPath	/* · */
+	);
+
+	// ֻʽļӳ䵽ڴ棬ʧʱ nullptr
+	const void* MapFile(
+		const String& filePath,	/* ļ· */
+		size_t* size,			/* ļС */
+		void** handle			/* ӳʱʹõľ */
+	);
+
+	// ļӳ
+	void UnmapFile(
+		const void* data,		/* MapFile صĵַ */
+		size_t size,			/* ļС */
+		void* handle			/* MapFile صľ */
+	);
+
+	// ȡӦĿ¼ʱؿַ
+	String GetLocalDataDirectory();
+
+	// ȡϵͳʱļĿ¼
+	String GetTempDirectory();
+
+	// ȡִгľ·
+	String GetExecutablePath();
+
+	//
+	// ־
+	//
+
+	// һ־̨
+	void WriteLog(
+		const String& text,		/* ־ */
+		bool isError			/* ǷΪϢ */
+	);
+
+	// һ־ûеӿڵƽ̨Ϻԣ
+	void WriteDebugString(
+		const String& text
+	);
+
+	// /رտ̨ʧʱ false
+	bool ShowConsole(
+		bool show
+	);
+
+	//
+	// ַ
+	//
+
+	// ַתضַֽ
+	ByteString WideToNarrow(
+		const String& str
+	);
+
+	// ضַֽתַ
+	String NarrowToWide(
+		const ByteString& str
+	);
+}
+
+
+}
@@ -0,0 +1,734 @@
+#pragma once
+#include <easy2d/e2dmacros.h>
+#include <easy2d/e2dcommon.h>
+
+namespace easy2d
+{
+
+
+class Node;
+
+
+// 
+// Ⱦ豸ֻɴ豸
+class Texture :
+	public Object
+{
+public:
+	// ȡ
+	virtual float getWidth() const = 0;
+
+	// ȡ߶
+	virtual float getHeight() const = 0;
+};
+
+
+// ͼ
+struct LayerParam
+{
+	Rect	clipRect;	// üΣ豸꣬ܵǰ任Ӱ죩
+	float	opacity;	// ͸
+
+	LayerParam();
+
+	LayerParam(
+		const Rect& clipRect,
+		float opacity
+	);
+};
+
+
+// εύԭ
+enum class FlushReason : int
+{
+	TextureChanged,	/* ı */
+	StateChanged,	/* ͼ */
+	LayerChanged,	/* ͼı */
+	BatchFull,		/*  */
+	EndFrame,		/* һ֡ */
+	Manual,			/* ֶύ */
+	Count
+};
+
+
+// Ⱦͳƣÿ֡ʼʱ
+struct RenderStats
+{
+	size_t spriteCount;		// Ƶľ
+	size_t batchCount;		// ľƴ
+	size_t flushCount[static_cast<int>(FlushReason::Count)];	// ԭµύ
+
+	RenderStats();
+
+	// ȡĳԭµύ
+	size_t getFlushCount(
+		FlushReason reason
+	) const;
+};
+
+
+// ı
+struct SpriteQuad
+{
+	Matrix32	transform;	// ά任
+	Rect		destRect;	// Ŀ
+	Rect		srcRect;	// Դ
+	float		opacity;	// ͸
+};
+
+
+// Ⱦ豸
+// ڵ㡢ͼƬ״лƲͨȾ豸
+// ͬһʱỺΪһΣֱı䡢ͼλһ֡ʱһύ
+class RenderDevice :
+	public Object
+{
+public:
+	RenderDevice();
+
+	virtual ~RenderDevice();
+
+	// ύľ
+	void flush();
+
+	// ȡǰ֡Ⱦͳ
+	const RenderStats& getStats() const;
+
+	// һε
+	void setMaxBatchSize(
+		size_t size
+	);
+
+	// ȡһε
+	size_t getMaxBatchSize() const;
+
+	// ʼȾһ֡ false ʱ֡Ⱦ
+	virtual bool beginFrame(
+		const Color& clearColor		/* ɫ */
+	) = 0;
+
+	// Ⱦһ֡
+	virtual void endFrame() = 0;
+
+	// ȡȾĿС
+	virtual Size getSize() const = 0;
+
+	// öά任
+	virtual void setTransform(
+		const Matrix32& matrix
+	) = 0;
+
+	// ʹ 32 λ RGBA ݣԤˣ
+	virtual Texture * createTexture(
+		const void* pixels,		/*  */
+		int width,				/*  */
+		int height,				/* ߶ */
+		int pitch				/* ÿֽ */
+	) = 0;
+
+	// 
+	virtual void drawTexture(
+		Texture * texture,		/*  */
+		const Rect& destRect,	/* Ŀ */
+		const Rect& srcRect,	/* Դ */
+		float opacity			/* ͸ */
+	) = 0;
+
+	// 
+	virtual void fillRect(
+		const Rect& rect,
+		const Color& color
+	) = 0;
+
+	// ƾ
+	virtual void drawRect(
+		const Rect& rect,
+		const Color& color,
+		float strokeWidth,
+		LineJoin lineJoin
+	) = 0;
+
+	// ԲǾ
+	virtual void fillRoundedRect(
+		const Rect& rect,
+		float radiusX,
+		float radiusY,
+		const Color& color
+	) = 0;
+
+	// ԲǾ
+	virtual void drawRoundedRect(
+		const Rect& rect,
+		float radiusX,
+		float radiusY,
+		const Color& color,
+		float strokeWidth,
+		LineJoin lineJoin
+	) = 0;
+
+	// Բ
+	virtual void fillEllipse(
+		const Point& center,
+		float radiusX,
+		float radiusY,
+		const Color& color
+	) = 0;
+
+	// Բ
+	virtual void drawEllipse(
+		const Point& center,
+		float radiusX,
+		float radiusY,
+		const Color& color,
+		float strokeWidth
+	) = 0;
+
+	// ѹͼ㣬֮ĻƱüͼ㲻͸
+	virtual void pushLayer(
+		const LayerParam& param
+	) = 0;
+
+	// ͼ
+	virtual void popLayer() = 0;
+
+	// 豸֮֡Ƿһ֡Ļ
+	// 豸ڳûб仯ʱ֡
+	virtual bool isFramePreserved() const;
+
+protected:
+	// Ⱦͳ
+	void _resetStats();
+
+	// һ뵱ǰ
+	void _addSprite(
+		Texture * texture,
+		const Matrix32& transform,
+		const Rect& destRect,
+		const Rect& srcRect,
+		float opacity
+	);
+
+	// ύǰ
+	void _flushSprites(
+		FlushReason reason
+	);
+
+	// һʹͬһľ
+	virtual void _drawSprites(
+		Texture * texture,
+		const SpriteQuad* quads,
+		size_t count
+	) = 0;
+
+protected:
+	Texture * _batchTexture;
+	std::vector<SpriteQuad> _batchQuads;
+	size_t _maxBatchSize;
+	RenderStats _stats;
+};
+
+
+// Ⱦб
+// ¼Ⱦ豸ĻƲ֮豸ϻط
+// вֵʽ洢ͽڵбǰ
+class RenderCommandList :
+	public RenderDevice
+{
+public:
+	RenderCommandList();
+
+	virtual ~RenderCommandList();
+
+	// 
+	void clear();
+
+	// ȡ
+	size_t getCommandCount() const;
+
+	// ôȡСʱʹõ豸
+	void setTarget(
+		RenderDevice * target
+	);
+
+	// ¼ڵ㣬طʱڵǰ任ִнڵ onRender 
+	// ڻ޷¼Ľڵ
+	void addNode(
+		Node * node
+	);
+
+	// Ƿ¼˽ڵ㣬ЩڵÿλطŵĻƽܲͬ
+	bool hasNodeCommands() const;
+
+	// 豸ϻط
+	void replay(
+		RenderDevice * device
+	) const;
+
+	virtual bool beginFrame(const Color& clearColor) override;
+
+	virtual void endFrame() override;
+
+	virtual Size getSize() const override;
+
+	virtual void setTransform(const Matrix32& matrix) override;
+
+	virtual Texture * createTexture(const void* pixels, int width, int height, int pitch) override;
+
+	virtual void drawTexture(Texture * texture, const Rect& destRect, const Rect& srcRect, float opacity) override;
+
+	virtual void fillRect(const Rect& rect, const Color& color) override;
+
+	virtual void drawRect(const Rect& rect, const Color& color, float strokeWidth, LineJoin lineJoin) override;
+
+	virtual void fillRoundedRect(const Rect& rect, float radiusX, float radiusY, const Color& color) override;
+
+	virtual void drawRoundedRect(const Rect& rect, float radiusX, float radiusY, const Color& color, float strokeWidth, LineJoin lineJoin) override;
+
+	virtual void fillEllipse(const Point& center, float radiusX, float radiusY, const Color& color) override;
+
+	virtual void drawEllipse(const Point& center, float radiusX, float radiusY, const Color& color, float strokeWidth) override;
+
+	virtual void pushLayer(const LayerParam& param) override;
+
+	virtual void popLayer() override;
+
+protected:
+	virtual void _drawSprites(Texture * texture, const SpriteQuad* quads, size_t count) override;
+
+protected:
+	// Ⱦ
+	struct Command
+	{
+		enum class Type
+		{
+			SetTransform,
+			DrawTexture,
+			FillRect,
+			DrawRect,
+			FillRoundedRect,
+			DrawRoundedRect,
+			FillEllipse,
+			DrawEllipse,
+			PushLayer,
+			PopLayer,
+			RenderNode
+		};
+
+		Type		type;
+		Rect		rect;			// ĿΡͼηΧüΣԲ origin ΪԲ
+		Rect		srcRect;
+		float		radiusX;
+		float		radiusY;
+		float		strokeWidth;
+		float		opacity;
+		Color		color;
+		LineJoin	lineJoin;
+		size_t		matrix;			// 任Ӧľ±
+		Object *	object;			// ڵ
+
+		Command();
+	};
+
+	// һ
+	Command& _addCommand(
+		Command::Type type
+	);
+
+protected:
+	RenderDevice * _target;
+	size_t _nodeCount;
+	std::vector<Command> _commands;
+	std::vector<Matrix32> _matrices;
+};
+
+
+// Ⱦ豸
+// ʹ CPU ̹߳դڴе RGBA ֡壬κͼνӿ
+class SoftwareRenderDevice :
+	public RenderDevice
+{
+public:
+	explicit SoftwareRenderDevice(
+		int width,				/* ֡ */
+		int height,				/* ֡߶ */
+		int threadCount = 0		/* դ߳0 ʾʹȫӲ̣߳ */
+	);
+
+	virtual ~SoftwareRenderDevice();
+
+	// ȡ֡
+	int getWidth() const;
+
+	// ȡ֡߶
+	int getHeight() const;
+
+	// ȡ֡壨Ԥ alpha  RGBAÿ 4 ֽڣд洢
+	const unsigned char* getPixels() const;
+
+	// ùդ߳֡尴Ϊϵͳ̲߳
+	void setThreadCount(
+		int threadCount
+	);
+
+	// ȡդ߳
+	int getThreadCount() const;
+
+	// ǰ֡Ϊ 32 λ BMP ļ
+	bool saveBitmap(
+		const String& filePath
+	) const;
+
+	virtual bool beginFrame(const Color& clearColor) override;
+
+	virtual void endFrame() override;
+
+	virtual Size getSize() const override;
+
+	virtual void setTransform(const Matrix32& matrix) override;
+
+	virtual Texture * createTexture(const void* pixels, int width, int height, int pitch) override;
+
+	virtual void drawTexture(Texture * texture, const Rect& destRect, const Rect& srcRect, float opacity) override;
+
+	virtual void fillRect(const Rect& rect, const Color& color) override;
+
+	virtual void drawRect(const Rect& rect, const Color& color, float strokeWidth, LineJoin lineJoin) override;
+
+	virtual void fillRoundedRect(const Rect& rect, float radiusX, float radiusY, const Color& color) override;
+
+	virtual void drawRoundedRect(const Rect& rect, float radiusX, float radiusY, const Color& color, float strokeWidth, LineJoin lineJoin) override;
+
+	virtual void fillEllipse(const Point& center, float radiusX, float radiusY, const Color& color) override;
+
+	virtual void drawEllipse(const Point& center, float radiusX, float radiusY, const Color& color, float strokeWidth) override;
+
+	virtual void pushLayer(const LayerParam& param) override;
+
+	virtual void popLayer() override;
+
+	virtual bool isFramePreserved() const override;
+
+protected:
+	virtual void _drawSprites(Texture * texture, const SpriteQuad* quads, size_t count) override;
+
+protected:
+	// դ
+	struct Command
+	{
+		enum class Type
+		{
+			Texture,
+			FillRect,
+			StrokeRect,
+			FillRoundedRect,
+			StrokeRoundedRect,
+			FillEllipse,
+			StrokeEllipse
+		};
+
+		Type			type;
+		Matrix32		inverse;		// 豸굽ֲ任
+		int				left, top;		// 豸ΧУѲü
+		int				right, bottom;
+		Rect			rect;			// ֲµͼηΧ
+		float			radiusX;
+		float			radiusY;
+		float			strokeWidth;
+		LineJoin		lineJoin;
+		unsigned char	color[4];		// Ԥ alpha  RGBAֻʹ alpha Ϊ͸
+		Texture *		texture;
+		size_t			firstSprite;	// Ӧľ鷶Χ
+		size_t			spriteCount;
+
+		Command();
+	};
+
+	// դ
+	struct Sprite
+	{
+		Matrix32		inverse;
+		int				left, top;
+		int				right, bottom;
+		Rect			destRect;
+		Rect			srcRect;
+		unsigned int	opacity;		// 0 ~ 255
+	};
+
+	// ɫԵǰͼĲ͸
+	void _setColor(
+		Command& cmd,
+		const Color& color
+	) const;
+
+	// ¼һ
+	void _addCommand(
+		Command& cmd,
+		const Rect& bounds
+	);
+
+	// դ֡ [top, bottom) Χ
+	void _rasterize(
+		int top,
+		int bottom
+	);
+
+	// դһ [top, bottom) Χ
+	void _rasterizeSprites(
+		const Command& cmd,
+		int top,
+		int bottom
+	);
+
+protected:
+	int _width;
+	int _height;
+	int _threadCount;
+	bool _drawing;
+	Matrix32 _transform;
+	std::vector<unsigned char> _framebuffer;
+	std::vector<Command> _commands;
+	std::vector<Sprite> _sprites;
+	std::vector<LayerParam> _layers;
+	unsigned char _clearColor[4];
+};
+
+
+// ͼ
+// СͼƬŴУʹͬһͼľԺϲΪһ
+// ͼƬƵ Image::open ʱֱʹͼе
+class TextureAtlas :
+	public Object
+{
+public:
+	TextureAtlas();
+
+	explicit TextureAtlas(
+		int pageWidth,			/* ҳ */
+		int pageHeight,			/* ҳ߶ */
+		int padding = 1			/* ͼƬ֮ļ */
+	);
+
+	virtual ~TextureAtlas();
+
+	//  32 λ RGBA ݣԤˣ
+	bool add(
+		const String& name,		/* ͼƬ */
+		const void* pixels,		/*  */
+		int width,				/*  */
+		int height,				/* ߶ */
+		int pitch				/* ÿֽ */
+	);
+
+	// 벢ͼƬļͼƬΪļ·
+	bool add(
+		const String& filePath	/* ͼƬļ· */
+	);
+
+	// ͼƬעͼƬ
+	bool build();
+
+	// Ѵҳ浽ļҪ build ֮ǰ
+	bool save(
+		const String& filePath
+	);
+
+	//  save ͼļעͼƬ
+	bool load(
+		const String& filePath
+	);
+
+	// жͼǷиͼƬ
+	bool contains(
+		const String& name
+	) const;
+
+	// ȡͼеͼƬ
+	Image * getImage(
+		const String& name
+	) const;
+
+	// ȡͼƬ
+	size_t getImageCount() const;
+
+	// ȡҳ
+	size_t getPageCount() const;
+
+	// ȡҳbuild  load ֮Ч
+	Texture * getPage(
+		size_t index
+	) const;
+
+	// ȡҳƽ
+	float getOccupancy() const;
+
+private:
+	// ߵһ
+	struct Skyline
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	struct Entry
+	{
+		String name;
+		int page;
+		int x;
+		int y;
+		int width;
+		int height;
+		std::vector<unsigned char> pixels;
+	};
+
+	struct Page
+	{
+		int width;
+		int height;
+		Texture * texture;
+		std::vector<Skyline> skyline;
+		std::vector<unsigned char> pixels;
+	};
+
+	// ͼƬеҳУ
+	bool _pack();
+
+	// ҳѰҷλãʧʱ false
+	bool _findPosition(
+		const Page& page,
+		int width,
+		int height,
+		int* x,
+		int* y,
+		size_t* index
+	) const;
+
+	// Ѿηŵ
+	void _placeRect(
+		Page& page,
+		size_t index,
+		int x,
+		int y,
+		int width,
+		int height
+	);
+
+	// Ϊҳ洴עеͼƬ
+	bool _createTextures();
+
+	// ͷҳ
+	void _clearPages();
+
+private:
+	int _pageWidth;
+	int _pageHeight;
+	int _padding;
+	bool _packed;
+	std::vector<Entry> _entries;
+	std::vector<Page> _pages;
+};
+
+
+#ifndef E2D_HEADLESS
+
+// Direct2D 
+class D2DTexture :
+	public Texture
+{
+public:
+	explicit D2DTexture(
+		ID2D1Bitmap * bitmap
+	);
+
+	virtual ~D2DTexture();
+
+	virtual float getWidth() const override;
+
+	virtual float getHeight() const override;
+
+	// ȡ ID2D1Bitmap 
+	ID2D1Bitmap * getBitmap() const;
+
+protected:
+	ID2D1Bitmap * _bitmap;
+};
+
+
+// Direct2D Ⱦ豸
+// Ƶڵ ID2D1HwndRenderTarget Windows µĬȾ豸
+class D2DRenderDevice :
+	public RenderDevice
+{
+public:
+	D2DRenderDevice();
+
+	virtual ~D2DRenderDevice();
+
+	virtual bool beginFrame(const Color& clearColor) override;
+
+	virtual void endFrame() override;
+
+	virtual Size getSize() const override;
+
+	virtual void setTransform(const Matrix32& matrix) override;
+
+	virtual Texture * createTexture(const void* pixels, int width, int height, int pitch) override;
+
+	virtual void drawTexture(Texture * texture, const Rect& destRect, const Rect& srcRect, float opacity) override;
+
+	virtual void fillRect(const Rect& rect, const Color& color) override;
+
+	virtual void drawRect(const Rect& rect, const Color& color, float strokeWidth, LineJoin lineJoin) override;
+
+	virtual void fillRoundedRect(const Rect& rect, float radiusX, float radiusY, const Color& color) override;
+
+	virtual void drawRoundedRect(const Rect& rect, float radiusX, float radiusY, const Color& color, float strokeWidth, LineJoin lineJoin) override;
+
+	virtual void fillEllipse(const Point& center, float radiusX, float radiusY, const Color& color) override;
+
+	virtual void drawEllipse(const Point& center, float radiusX, float radiusY, const Color& color, float strokeWidth) override;
+
+	virtual void pushLayer(const LayerParam& param) override;
+
+	virtual void popLayer() override;
+
+protected:
+	virtual void _drawSprites(Texture * texture, const SpriteQuad* quads, size_t count) override;
+
+	// ʹ ID2D1SpriteBatch һλо飬ϵͳֻ֧Դβʱ false
+	bool _drawSpriteBatch(
+		ID2D1Bitmap * bitmap,
+		const SpriteQuad* quads,
+		size_t count
+	);
+
+	// ȡཻʽӦ ID2D1StrokeStyle
+	ID2D1StrokeStyle * _getStrokeStyle(
+		LineJoin lineJoin
+	) const;
+
+	// ûˢɫ
+	ID2D1SolidColorBrush * _getBrush(
+		const Color& color
+	) const;
+
+	// ͷžΣȾĿؽ»ȡ
+	void _discardSpriteBatch();
+
+protected:
+	size_t _layerDepth;
+	Matrix32 _transform;
+	std::vector<ID2D1Layer*> _layers;
+	ID2D1RenderTarget * _spriteTarget;	// ȡʱȾĿ
+	ID2D1RenderTarget * _spriteContext;	// ȾĿ ID2D1DeviceContext3 ӿڣ֧ʱΪ
+	ID2D1Resource * _spriteBatch;		// ID2D1SpriteBatch֧ʱΪ
+	std::vector<D2D1_RECT_F> _spriteDestRects;
+	std::vector<D2D1_RECT_U> _spriteSrcRects;
+	std::vector<D2D1_COLOR_F> _spriteColors;
+	std::vector<D2D1_MATRIX_3X2_F> _spriteTransforms;
+};
+
+#endif
+
+
+}
@@ -62,18 +62,27 @@ public:
 	virtual void onRender() override;
 
 protected:
+	virtual bool _isRecordable() const override;
+
+	// һڱ߿֮
+	virtual float _getRenderMargin() const override;
+
 	// Ⱦ
-	virtual void _renderLine() = 0;
+	virtual void _renderLine(
+		const Color& color
+	) = 0;
 
 	// Ⱦɫ
-	virtual void _renderFill() = 0;
+	virtual void _renderFill(
+		const Color& color
+	) = 0;
 
 protected:
 	Style	_style;
 	float	_strokeWidth;
 	Color	_lineColor;
 	Color	_fillColor;
-	ID2D1StrokeStyle * _strokeStyle;
+	LineJoin _lineJoin;
 };
 
 
@@ -97,10 +106,14 @@ public:
 
 protected:
 	// Ⱦ
-	virtual void _renderLine() override;
+	virtual void _renderLine(
+		const Color& color
+	) override;
 
 	// Ⱦɫ
-	virtual void _renderFill() override;
+	virtual void _renderFill(
+		const Color& color
+	) override;
 };
 
 
@@ -144,10 +157,14 @@ public:
 
 protected:
 	// Ⱦ
-	virtual void _renderLine() override;
+	virtual void _renderLine(
+		const Color& color
+	) override;
 
 	// Ⱦɫ
-	virtual void _renderFill() override;
+	virtual void _renderFill(
+		const Color& color
+	) override;
 
 protected:
 	float _radiusX;
@@ -183,10 +200,14 @@ public:
 
 protected:
 	// Ⱦ
-	virtual void _renderLine() override;
+	virtual void _renderLine(
+		const Color& color
+	) override;
 
 	// Ⱦɫ
-	virtual void _renderFill() override;
+	virtual void _renderFill(
+		const Color& color
+	) override;
 
 protected:
 	float _radius;
@@ -231,10 +252,14 @@ public:
 
 protected:
 	// Ⱦ
-	virtual void _renderLine() override;
+	virtual void _renderLine(
+		const Color& color
+	) override;
 
 	// Ⱦɫ
-	virtual void _renderFill() override;
+	virtual void _renderFill(
+		const Color& color
+	) override;
 
 protected:
 	float _radiusX;
@@ -5,6 +5,9 @@ namespace easy2d
 {
 
 
+class Archive;
+
+
 // 
 class Random
 {
@@ -48,6 +51,304 @@ private:
 };
 
 
+// 
+// Ϊ 32 λ PCM ݣ򿪺޸ģͬʱ
+class Sound :
+	public Object
+{
+	friend class Mixer;
+
+public:
+	Sound();
+
+	explicit Sound(
+		const String& filePath	/* Ƶļ· */
+	);
+
+	virtual ~Sound();
+
+	// Ƶļ WAV Windows ʽʹ Media Foundation 
+	bool open(
+		const String& filePath	/* Ƶļ· */
+	);
+
+	// ڴеƵļ
+	bool open(
+		const Resource::Data& data	/* Ƶļ */
+	);
+
+	// ʹýеĸ
+	bool open(
+		const float* samples,	/*  */
+		int frameCount,			/* ֡ */
+		int channelCount,		/* 1  2 */
+		int sampleRate			/*  */
+	);
+
+	// ǷѴ
+	bool isOpened() const;
+
+	// ȡ
+	int getChannelCount() const;
+
+	// ȡ
+	int getSampleRate() const;
+
+	// ȡ֡
+	int getFrameCount() const;
+
+	// ȡʱ룩
+	float getDuration() const;
+
+	// ȡݣͬһļֻһ
+	static Sound * preload(
+		const String& filePath	/* Ƶļ· */
+	);
+
+	// ݻ
+	static void clearCache();
+
+private:
+	std::vector<float> _samples;
+	int _channelCount;
+	int _sampleRate;
+	int _frameCount;
+};
+
+
+// Ƶ
+// е 32 λ
+class AudioDecoder :
+	public Object
+{
+public:
+	// ȡ
+	virtual int getChannelCount() const = 0;
+
+	// ȡ
+	virtual int getSampleRate() const = 0;
+
+	// ȡʵʶȡ֡ 0 ʾѾ
+	virtual int read(
+		float* samples,			/*  */
+		int frameCount			/* ȡ֡ */
+	) = 0;
+
+	// صͷ
+	virtual bool rewind() = 0;
+};
+
+
+// 
+// ʱں̨߳룬ֻռüСʺϽϳ
+class SoundStream :
+	public Object
+{
+public:
+	SoundStream();
+
+	explicit SoundStream(
+		const String& filePath	/* Ƶļ· */
+	);
+
+	virtual ~SoundStream();
+
+	// Ƶļʱļȡ
+	bool open(
+		const String& filePath	/* Ƶļ· */
+	);
+
+	// ڴеƵļݣݻᱻ
+	bool open(
+		const Resource::Data& data	/* Ƶļ */
+	);
+
+	// ǷѴ
+	bool isOpened() const;
+
+	// ȡ
+	int getChannelCount() const;
+
+	// ȡ
+	int getSampleRate() const;
+
+	// ͷʼĽÿβʹøԵĽ
+	AudioDecoder * createDecoder();
+
+private:
+	// üΪ 1 Ľ
+	AudioDecoder * _createDecoder();
+
+	// ȡͲ
+	bool _probe();
+
+private:
+	String _filePath;
+	std::vector<unsigned char> _data;
+	Resource::Data _archiveData;
+	Archive* _archive;
+	int _channelCount;
+	int _sampleRate;
+};
+
+
+// Ƶ豸
+// 豸ӻȡϺõݣֱӽӴ
+class AudioSink :
+	public Object
+{
+public:
+	// ʼӻȡ
+	virtual bool start() = 0;
+
+	// ֹͣȡݣغٵû
+	virtual void stop() = 0;
+};
+
+
+// 豸
+// ں̨߳аʵʱȡݣ԰ѽд 16 λ WAV ļ
+class NullAudioSink :
+	public AudioSink
+{
+public:
+	explicit NullAudioSink(
+		const String& waveFilePath = L""	/* WAV ļ·Ϊʱ */
+	);
+
+	virtual ~NullAudioSink();
+
+	virtual bool start() override;
+
+	virtual void stop() override;
+
+private:
+	class Context;
+	Context* _context;
+};
+
+
+#ifndef E2D_HEADLESS
+
+// XAudio2 豸
+class XAudio2AudioSink :
+	public AudioSink
+{
+public:
+	XAudio2AudioSink();
+
+	virtual ~XAudio2AudioSink();
+
+	virtual bool start() override;
+
+	virtual void stop() override;
+
+private:
+	class Context;
+	Context* _context;
+};
+
+#endif
+
+
+// 
+// ̶Ƶ߳лΪϷ߳ͨз
+//  mix ĺֻϷ߳е
+class Mixer
+{
+	friend class Game;
+
+public:
+	// 
+	static const int SAMPLE_RATE = 48000;
+
+	// ʱֹͣ翪ʼŵ
+	static const int VOICE_COUNT = 64;
+
+	// 豸Ϊʱ´βʱʹĬ豸
+	static void setSink(
+		AudioSink * sink
+	);
+
+	// ȡ豸
+	static AudioSink * getSink();
+
+	// ţʧʱ 0
+	static unsigned int play(
+		Sound * sound,			/*  */
+		float volume = 1.f,		/*  */
+		float pan = 0.f,		/* -1 Ϊ1 Ϊ */
+		int loopCount = 0		/* ظŴ -1 Ϊѭ */
+	);
+
+	// ÿβŴͷʼ룬ţʧʱ 0
+	static unsigned int play(
+		SoundStream * stream,	/*  */
+		float volume = 1.f,		/*  */
+		float pan = 0.f,		/* -1 Ϊ1 Ϊ */
+		int loopCount = 0		/* ظŴ -1 Ϊѭ */
+	);
+
+	// ֹͣ
+	static void stop(
+		unsigned int voice
+	);
+
+	// ͣ
+	static void pause(
+		unsigned int voice
+	);
+
+	// 
+	static void resume(
+		unsigned int voice
+	);
+
+	// 
+	static void setVolume(
+		unsigned int voice,
+		float volume
+	);
+
+	// 
+	static void setPan(
+		unsigned int voice,
+		float pan
+	);
+
+	// Ƿڲţͣ false
+	static bool isPlaying(
+		unsigned int voice
+	);
+
+	// ֹͣ
+	static void stopAll();
+
+	// 
+	static void setMasterVolume(
+		float volume
+	);
+
+	// ȡ
+	static float getMasterVolume();
+
+	// ȡʹõ
+	static int getActiveVoiceCount();
+
+	// 豸Ƶ߳е
+	static void mix(
+		float * output,			/* е */
+		int frameCount			/* ֡ */
+	);
+
+private:
+	// ղŽ
+	static void __update();
+
+	static void __uninit();
+};
+
+
 // 
 class Music :
 	public Object
@@ -79,6 +380,11 @@ public:
 		const String& resType		/* Դ */
 	);
 
+	// ڴеļݣ open غٱʹ
+	bool open(
+		const Resource::Data& data	/* ļ */
+	);
+
 	// 
 	bool play(
 		int nLoopCount = 0
@@ -275,8 +581,11 @@ private:
 
 
 // ݹ
+// ״ηʱһԶڴ棬޸ĺ flush дļ
 class Data
 {
+	friend class Game;
+
 public:
 	//  int ͵ֵ
 	static void saveInt(
@@ -337,6 +646,20 @@ public:
 		const String& defaultValue,			/* Ĭֵ */
 		const String& field = L"Defalut"	/* ֶ */
 	);
+
+	// ޸Ĺдļ
+	// дʱļ滻д;ԭд浵
+	static bool flush();
+
+	// ûر׷־
+	// úÿα涼׷ӵ־ļ´ʱԶָ
+	static void setJournalEnabled(
+		bool enabled
+	);
+
+private:
+	// дݲر־
+	static void __uninit();
 };
 
 
@@ -356,12 +679,14 @@ public:
 		const String& path
 	);
 
+#ifndef E2D_HEADLESS
 	// ȡԴļȡļ·
 	static String extractResource(
 		int resNameId,				/* Դ */
 		const String& resType,		/* Դ */
 		const String& destFileName	/* Ŀļ */
 	);
+#endif
 
 	// ȡݵĬϱ·
 	static String getDataSavePath();
@@ -372,11 +697,13 @@ public:
 	// ȡִгľ·
 	static String getExecutableFilePath();
 
+#ifndef E2D_HEADLESS
 	// 򿪱ļԻ
 	static String getSaveFilePath(
 		const String& title = L"浽",		/* Ի */
 		const String& defExt = L""			/* Ĭչ */
 	);
+#endif
 
 	// ļ
 	static bool createFolder(
@@ -395,4 +722,98 @@ private:
 	);
 };
 
+
+// Դ
+// ԴļΪһļʱӳ䵽ڴ棬ȡδѹĿ
+class Archive :
+	public Object
+{
+public:
+	Archive();
+
+	explicit Archive(
+		const String& filePath	/* Դļ· */
+	);
+
+	virtual ~Archive();
+
+	// Դļ
+	bool open(
+		const String& filePath	/* Դļ· */
+	);
+
+	// رԴ֮ǰȡõĿ֮ʧЧ
+	void close();
+
+	// ǷѴ
+	bool isOpened() const;
+
+	// жԴǷиĿ
+	bool contains(
+		const String& name		/* Ŀ */
+	) const;
+
+	// ȡĿݣҲʱЧ
+	// δѹĿֱָӳļݣѹĿڵһζȡʱѹ
+	Resource::Data getData(
+		const String& name		/* Ŀ */
+	);
+
+	//  UTF-8 ıȡĿ
+	String getText(
+		const String& name		/* Ŀ */
+	);
+
+	// ȡĿ
+	size_t getEntryCount() const;
+
+	// ȡĿ
+	String getEntryName(
+		size_t index
+	) const;
+
+	// Դ֮ Image  Music ļ·ʱȶȡԴеͬĿ
+	static void mount(
+		Archive * archive
+	);
+
+	// ȡ
+	static void unmount(
+		Archive * archive
+	);
+
+	// ȡԴ
+	static void unmountAll();
+
+	// ѹصԴвĿԴжʱص
+	static Archive * search(
+		const String& name		/* Ŀ */
+	);
+
+	// ȡ UTF-8 ıѹصԴûиĿʱȡļ
+	static String loadText(
+		const String& filePath	/* ļ· */
+	);
+
+	// ļΪԴѡʹ LZ4 ѹĿ
+	static bool pack(
+		const String& archivePath,								/* Դļ· */
+		const std::vector<std::pair<String, String>>& files,	/* ĿƺͶӦļ· */
+		bool compress = true									/* Ƿѹ */
+	);
+
+private:
+	// ĿţҲʱ -1
+	int _find(
+		const String& name
+	) const;
+
+private:
+	const unsigned char* _data;
+	size_t _size;
+	void* _mapping;
+	size_t _entryCount;
+	std::vector<std::vector<unsigned char>> _decompressed;
+};
+
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <easy2d/e2dcommon.h>
+#include <easy2d/e2drender.h>
 
 namespace easy2d
 {
@@ -52,10 +53,8 @@ protected:
 	Size _windowSize;
 	Scene * _outScene;
 	Scene * _inScene;
-	ID2D1Layer * _outLayer;
-	ID2D1Layer * _inLayer;
-	D2D1_LAYER_PARAMETERS _outLayerParam;
-	D2D1_LAYER_PARAMETERS _inLayerParam;
+	LayerParam _outLayerParam;
+	LayerParam _inLayerParam;
 };
 
 
@@ -12,7 +12,7 @@
 #	error  C++ ʹ Easy2D
 #endif
 
-#if _MSC_VER < 1700
+#if defined(_MSC_VER) && _MSC_VER < 1700
 #	error Easy2D ֧ Visual Studio 2012 °汾
 #endif
 
@@ -27,9 +27,13 @@
 #include <easy2d/e2dtool.h>
 #include <easy2d/e2daction.h>
 #include <easy2d/e2dtransition.h>
+#include <easy2d/e2drender.h>
+#include <easy2d/e2dplatform.h>
 
-#if defined(DEBUG) || defined(_DEBUG)
-#	pragma comment(lib, "libeasy2dd.lib")
-#else
-#	pragma comment(lib, "libeasy2d.lib")
+#if defined(_MSC_VER) && !defined(E2D_HEADLESS)
+#	if defined(DEBUG) || defined(_DEBUG)
+#		pragma comment(lib, "libeasy2dd.lib")
+#	else
+#		pragma comment(lib, "libeasy2d.lib")
+#	endif
 #endif
@@ -7,6 +7,9 @@ easy2d::Action::Action()
 	, _initialized(false)
 	, _target(nullptr)
 	, _last(0)
+	, _index(static_cast<size_t>(-1))
+	, _prevBinded(nullptr)
+	, _nextBinded(nullptr)
 {
 }
 
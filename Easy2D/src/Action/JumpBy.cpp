@@ -35,7 +35,7 @@ void easy2d::JumpBy::_update()
 
 	if (_target)
 	{
-		float frac = std::fmodf(_delta * _jumps, 1.0f);
+		float frac = std::fmod(_delta * _jumps, 1.0f);
 		float x = _deltaPos.x * _delta;
 		float y = _height * 4 * frac * (1 - frac);
 		y += _deltaPos.y * _delta;
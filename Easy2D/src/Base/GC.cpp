@@ -1,9 +1,13 @@
 #include <easy2d/e2dbase.h>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
 
 //
 // gcnew helper
 //
 easy2d::__gc_helper::GCNewHelper easy2d::__gc_helper::GCNewHelper::instance;
+easy2d::__gc_helper::GCTempHelper easy2d::__gc_helper::GCTempHelper::instance;
 
 // GC ͷųصʵֻƣ
 // Object еü_refCountһ̶Ϸֹڴй©
@@ -13,21 +17,42 @@ easy2d::__gc_helper::GCNewHelper easy2d::__gc_helper::GCNewHelper::instance;
 
 namespace
 {
+	// ֡ GC صĶһ֡´νÿ֡·ڴ
 	std::vector<easy2d::Object*> s_vObjectPool;
+	std::vector<easy2d::Object*> s_vReleasePool;
+	std::mutex s_PoolMutex;
 	bool s_bClearing = false;
+
+	// ǰĴ֮ͬʱ˵ GC 
+	unsigned s_nGeneration = 1;
+
+	// ͳ
+	std::atomic<size_t> s_nCreatedCount(0);
+	std::atomic<size_t> s_nDestroyedCount(0);
+	easy2d::GC::Stats s_Stats = {};
+
+	// ʱڴ
+	// ÿǰڴָ룬ʱڴ
+	struct TemporaryChunk
+	{
+		char*	data;
+		size_t	capacity;
+		size_t	used;
+		size_t	live;		// ԴĶ
+	};
+
+	const size_t TEMPORARY_ALIGN = 16;
+	const size_t TEMPORARY_HEADER = TEMPORARY_ALIGN;
+	const size_t TEMPORARY_CHUNK_SIZE = 64 * 1024;
+
+	std::vector<TemporaryChunk*> s_vChunks;
+	size_t s_nCurrentChunk = 0;
+	size_t s_nTemporaryBytes = 0;
 }
 
 bool easy2d::GC::isInPool(Object* pObject)
 {
-	if (pObject)
-	{
-		for (const auto& pObj : s_vObjectPool)
-		{
-			if (pObj == pObject)
-				return true;
-		}
-	}
-	return false;
+	return pObject && pObject->_gcGeneration == s_nGeneration;
 }
 
 bool easy2d::GC::isClearing()
@@ -35,23 +60,132 @@ bool easy2d::GC::isClearing()
 	return s_bClearing;
 }
 
+const easy2d::GC::Stats& easy2d::GC::getStats()
+{
+	return s_Stats;
+}
+
 void easy2d::GC::clear()
 {
-	std::vector<Object*> releaseThings;
-	releaseThings.swap(s_vObjectPool);
+	E2D_PROFILE_SCOPE("GC::clear");
+
+	if (s_bClearing)
+		return;
+
+	// µһʼ֮ǰĶ GC 
+	s_vReleasePool.swap(s_vObjectPool);
+	++s_nGeneration;
 
 	s_bClearing = true;
-	for (auto pObj : releaseThings)
+	for (auto pObj : s_vReleasePool)
 	{
 		pObj->release();
 	}
 	s_bClearing = false;
+
+	const size_t pooled = s_vReleasePool.size();
+	s_vReleasePool.clear();
+
+	// ûдʱڴ
+	for (auto chunk : s_vChunks)
+	{
+		if (chunk->live == 0)
+		{
+			chunk->used = 0;
+		}
+	}
+	s_nCurrentChunk = 0;
+
+	s_Stats.createdCount = s_nCreatedCount.exchange(0);
+	s_Stats.destroyedCount = s_nDestroyedCount.exchange(0);
+	s_Stats.pooledCount = pooled;
+	s_Stats.temporaryBytes = s_nTemporaryBytes;
+	s_nTemporaryBytes = 0;
 }
 
 void easy2d::GC::trace(easy2d::Object * pObject)
 {
 	if (pObject)
 	{
+		// иʱڶ߳д
+		std::lock_guard<std::mutex> lock(s_PoolMutex);
+		pObject->_gcGeneration = s_nGeneration;
 		s_vObjectPool.push_back(pObject);
 	}
 }
+
+void* easy2d::GC::allocateTemporary(size_t size)
+{
+	const size_t required = TEMPORARY_HEADER + (size + TEMPORARY_ALIGN - 1) / TEMPORARY_ALIGN * TEMPORARY_ALIGN;
+
+	std::lock_guard<std::mutex> lock(s_PoolMutex);
+
+	// βʣռ㹻ڴ
+	TemporaryChunk* chunk = nullptr;
+	for (; s_nCurrentChunk < s_vChunks.size(); ++s_nCurrentChunk)
+	{
+		auto c = s_vChunks[s_nCurrentChunk];
+		if (c->capacity - c->used >= required)
+		{
+			chunk = c;
+			break;
+		}
+	}
+
+	if (chunk == nullptr)
+	{
+		const size_t capacity = max(required, TEMPORARY_CHUNK_SIZE);
+		char* data = static_cast<char*>(std::malloc(capacity));
+		if (data == nullptr)
+		{
+			return nullptr;
+		}
+
+		chunk = new (std::nothrow) TemporaryChunk;
+		if (chunk == nullptr)
+		{
+			std::free(data);
+			return nullptr;
+		}
+		chunk->data = data;
+		chunk->capacity = capacity;
+		chunk->used = 0;
+		chunk->live = 0;
+		s_nCurrentChunk = s_vChunks.size();
+		s_vChunks.push_back(chunk);
+	}
+
+	char* memory = chunk->data + chunk->used;
+	chunk->used += required;
+	++chunk->live;
+	s_nTemporaryBytes += required;
+
+	*reinterpret_cast<TemporaryChunk**>(memory) = chunk;
+	return memory + TEMPORARY_HEADER;
+}
+
+void easy2d::GC::__onCreated()
+{
+	++s_nCreatedCount;
+}
+
+void easy2d::GC::__onDestroyed()
+{
+	++s_nDestroyedCount;
+}
+
+void easy2d::GC::__markTemporary(Object* pObject)
+{
+	pObject->_temporary = true;
+}
+
+void easy2d::GC::__destroyTemporary(Object* pObject)
+{
+	// ʼַǷõĵַ
+	char* memory = static_cast<char*>(dynamic_cast<void*>(pObject));
+	pObject->~Object();
+
+	std::lock_guard<std::mutex> lock(s_PoolMutex);
+	auto chunk = *reinterpret_cast<TemporaryChunk**>(memory - TEMPORARY_HEADER);
+	--chunk->live;
+}
@@ -21,6 +21,7 @@ bool easy2d::Game::init(const String& title, int width, int height, const String
 		return false;
 	}
 
+#ifndef E2D_HEADLESS
 	if (!mutexName.empty())
 	{
 		// ̻
@@ -54,6 +55,10 @@ bool easy2d::Game::init(const String& title, int width, int height, const String
 		E2D_ERROR(L"Ⱦ豸޹Դʧ");
 		return false;
 	}
+#else
+	// ޴ģʽ²̻
+	(void)mutexName;
+#endif
 
 	// ʼ
 	if (!Window::__init(title, width, height))
@@ -62,12 +67,14 @@ bool easy2d::Game::init(const String& title, int width, int height, const String
 		return false;
 	}
 
+#ifndef E2D_HEADLESS
 	// 豸Դ
 	if (!Renderer::__createDeviceResources())
 	{
 		E2D_ERROR(L"Ⱦ豸Դʧ");
 		return false;
 	}
+#endif
 
 	// ʼ DirectInput
 	if (!Input::__init())
@@ -76,10 +83,10 @@ bool easy2d::Game::init(const String& title, int width, int height, const String
 		return false;
 	}
 
-	// ʼ
+	// ʼƵ
 	if (!Music::__init())
 	{
-		E2D_ERROR(L"ʼ XAudio2 ʧ");
+		E2D_ERROR(L"ʼƵʧ");
 		return false;
 	}
 
@@ -92,6 +99,9 @@ bool easy2d::Game::init(const String& title, int width, int height, const String
 	// Ϸ
 	s_sGameName = title;
 
+	// ־߳
+	Logger::__init();
+
 	// ʼɹ
 	s_bInitialized = true;
 
@@ -108,14 +118,18 @@ void easy2d::Game::start()
 
 	// ʼ
 	SceneManager::__init();
+#ifndef E2D_HEADLESS
 	// ʾ
 	::ShowWindow(Window::getHWnd(), SW_SHOWNORMAL);
 	// ˢ´
 	::UpdateWindow(Window::getHWnd());
+#endif
 	// Ϣ
 	Window::__poll();
 	// ʼʱ
 	Time::__init();
+	// ܷʾ߳
+	Profiler::setThreadName(L"Main");
 
 	s_bEndGame = false;
 
@@ -129,10 +143,21 @@ void easy2d::Game::start()
 		// жǷﵽˢ״̬
 		if (Time::__isReady())
 		{
+			E2D_PROFILE_SCOPE("Frame");
+
 			Input::__update();			// ȡû
-			Timer::__update();			// ¶ʱ
-			ActionManager::__update();	// ¶
-			SceneManager::__update();	// ³
+			Image::__update();			// 첽ɵ
+			Mixer::__update();			// ղŽ
+
+			// ̶ģʽһܸ֡¶
+			Time::__beginFrame();
+			while (Time::__step())
+			{
+				Timer::__update();			// ¶ʱ
+				ActionManager::__update();	// ¶
+				SceneManager::__update();	// ³
+			}
+
 			Renderer::__render();		// ȾϷ
 			GC::clear();				// ڴ
 
@@ -198,18 +223,30 @@ void easy2d::Game::destroy()
 	if (!s_bInitialized)
 		return;
 
-	// ͼƬ
+	// ȡ첽زͼƬ
+	Image::__uninit();
 	Image::clearCache();
-	// Դ
+	// رջԴ
+	Mixer::__uninit();
+	Sound::clearCache();
 	Music::__uninit();
+	// дش浵
+	Data::__uninit();
 	// ر
 	Input::__uninit();
 	// ȾԴ
 	Renderer::__discardResources();
+	// ߳
+	JobSystem::__uninit();
 	// ٴ
 	Window::__uninit();
 
+#ifndef E2D_HEADLESS
 	CoUninitialize();
+#endif
+
+	// дʣ־
+	Logger::__uninit();
 
 	s_bInitialized = false;
 }
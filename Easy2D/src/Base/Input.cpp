@@ -180,6 +180,8 @@ void Input::__uninit()
 
 void easy2d::Input::__update()
 {
+	E2D_PROFILE_SCOPE("Input::update");
+
 	if (s_KeyboardDevice)
 	{
 		HRESULT hr = s_KeyboardDevice->Poll();
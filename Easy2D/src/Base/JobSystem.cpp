@@ -0,0 +1,238 @@
+#include <easy2d/e2dbase.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+	// һ
+	struct Task
+	{
+		const std::function<void(size_t)>* func;
+		size_t begin;
+		size_t end;
+		std::atomic<size_t>* remaining;
+	};
+
+	// ÿ̵߳
+	// ߴβȡ̴߳ͷȡ
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	int s_nThreadCount = 0;
+	bool s_bRunning = false;
+	bool s_bQuit = false;
+	std::vector<std::thread> s_vThreads;
+	std::vector<std::thread::id> s_vThreadIds;	// һһӦ0 Ϊʼʱĵ߳
+	std::vector<WorkQueue*> s_vQueues;
+	std::atomic<size_t> s_nQueuedTasks(0);
+	std::mutex s_WakeMutex;
+	std::condition_variable s_WakeCondition;
+
+	size_t GetQueueIndex()
+	{
+		const std::thread::id id = std::this_thread::get_id();
+		for (size_t i = 1; i < s_vThreadIds.size(); ++i)
+		{
+			if (s_vThreadIds[i] == id)
+				return i;
+		}
+		// ̶߳ʹ 0 Ŷ
+		return 0;
+	}
+
+	bool PopTask(size_t index, Task& task)
+	{
+		// ȴԼĶβȡ
+		{
+			WorkQueue* queue = s_vQueues[index];
+			std::lock_guard<std::mutex> lock(queue->mutex);
+			if (!queue->tasks.empty())
+			{
+				task = queue->tasks.back();
+				queue->tasks.pop_back();
+				--s_nQueuedTasks;
+				return true;
+			}
+		}
+
+		// ٴ̵߳Ķͷȡ
+		const size_t count = s_vQueues.size();
+		for (size_t i = 1; i < count; ++i)
+		{
+			WorkQueue* queue = s_vQueues[(index + i) % count];
+			std::lock_guard<std::mutex> lock(queue->mutex);
+			if (!queue->tasks.empty())
+			{
+				task = queue->tasks.front();
+				queue->tasks.pop_front();
+				--s_nQueuedTasks;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void RunTask(const Task& task)
+	{
+		E2D_PROFILE_SCOPE("JobSystem::task");
+
+		for (size_t i = task.begin; i < task.end; ++i)
+		{
+			(*task.func)(i);
+		}
+		--(*task.remaining);
+	}
+
+	void WorkerLoop(size_t index)
+	{
+		easy2d::Profiler::setThreadName(easy2d::FormatString(L"Worker %u", static_cast<unsigned int>(index)));
+
+		while (true)
+		{
+			Task task;
+			if (PopTask(index, task))
+			{
+				RunTask(task);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(s_WakeMutex);
+			s_WakeCondition.wait(lock, []() { return s_bQuit || s_nQueuedTasks > 0; });
+			if (s_bQuit)
+				return;
+		}
+	}
+}
+
+void easy2d::JobSystem::setThreadCount(int threadCount)
+{
+	if (s_nThreadCount == threadCount)
+		return;
+
+	// ߳´ʹʱЧ
+	JobSystem::__uninit();
+	s_nThreadCount = threadCount;
+}
+
+int easy2d::JobSystem::getThreadCount()
+{
+	JobSystem::__init();
+	return static_cast<int>(s_vQueues.size());
+}
+
+void easy2d::JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+	if (count == 0 || !func)
+		return;
+
+	JobSystem::__init();
+
+	const size_t threads = s_vQueues.size();
+	if (threads <= 1 || count == 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			func(i);
+		}
+		return;
+	}
+
+	// ÿ̷ֵ߳񣬷߳ȡ
+	const size_t chunks = min(count, threads * 4);
+	const size_t chunkSize = (count + chunks - 1) / chunks;
+	const size_t taskCount = (count + chunkSize - 1) / chunkSize;
+
+	std::atomic<size_t> remaining(taskCount);
+	const size_t index = GetQueueIndex();
+	{
+		WorkQueue* queue = s_vQueues[index];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		for (size_t begin = 0; begin < count; begin += chunkSize)
+		{
+			Task task = { &func, begin, min(begin + chunkSize, count), &remaining };
+			queue->tasks.push_back(task);
+		}
+		s_nQueuedTasks += taskCount;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(s_WakeMutex);
+	}
+	s_WakeCondition.notify_all();
+
+	// ȴڼִже
+	while (remaining > 0)
+	{
+		Task task;
+		if (PopTask(index, task))
+		{
+			RunTask(task);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void easy2d::JobSystem::__init()
+{
+	if (s_bRunning)
+		return;
+
+	int threadCount = s_nThreadCount;
+	if (threadCount <= 0)
+	{
+		threadCount = max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+	}
+
+	s_bQuit = false;
+	s_bRunning = true;
+
+	s_vQueues.resize(threadCount);
+	s_vThreadIds.resize(threadCount);
+	for (int i = 0; i < threadCount; ++i)
+	{
+		s_vQueues[i] = new WorkQueue;
+	}
+	s_vThreadIds[0] = std::this_thread::get_id();
+
+	for (int i = 1; i < threadCount; ++i)
+	{
+		s_vThreads.push_back(std::thread(WorkerLoop, static_cast<size_t>(i)));
+		s_vThreadIds[i] = s_vThreads.back().get_id();
+	}
+}
+
+void easy2d::JobSystem::__uninit()
+{
+	if (!s_bRunning)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(s_WakeMutex);
+		s_bQuit = true;
+	}
+	s_WakeCondition.notify_all();
+
+	for (auto& thread : s_vThreads)
+	{
+		thread.join();
+	}
+	s_vThreads.clear();
+
+	for (auto queue : s_vQueues)
+	{
+		delete queue;
+	}
+	s_vQueues.clear();
+	s_vThreadIds.clear();
+	s_nQueuedTasks = 0;
+	s_bRunning = false;
+}
@@ -1,211 +1,471 @@
 #include <easy2d/e2dbase.h>
-#include <iostream>
-#include <fstream>
+#include <easy2d/e2dplatform.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cwchar>
+#include <mutex>
+#include <new>
+#include <thread>
 
 namespace
 {
-	bool s_bEnable = true;
+	const size_t QUEUE_SIZE = 512;		//  2 
+	const size_t INLINE_LENGTH = 256;	// ϶̵־ֱӱڲУڴ
 
-	std::streambuf* s_cinBuffer, * s_coutBuffer, * s_cerrBuffer;
-	std::fstream s_consoleInput, s_consoleOutput, s_consoleError;
-
-	std::wstreambuf* s_wcinBuffer, * s_wcoutBuffer, * s_wcerrBuffer;
-	std::wfstream s_wconsoleInput, s_wconsoleOutput, s_wconsoleError;
-}
-
-namespace 
-{
-	void Output(std::wostream& os, const wchar_t* prompt, const wchar_t* format, va_list args)
+	//  n Ȧʱ۵״̬2n ʾУ2n + 1 ʾд
+	// ȫֶڶ̬ʼ֮ǰѱ㣬Գʼ״̬蹹
+	struct Slot
+	{
+		std::atomic<size_t> state;
+		easy2d::Logger::Level level;
+		easy2d::String* longText;
+		wchar_t text[INLINE_LENGTH];
+	};
+
+	Slot s_slots[QUEUE_SIZE];
+	std::atomic<size_t> s_enqueuePos;
+	std::atomic<size_t> s_dropped;
+	std::atomic<size_t> s_droppedTotal;
+	std::atomic<bool> s_disabled;
+	std::atomic<bool> s_running;
+
+	// ±ֻڳ s_consumerMutex ʱ
+	// 룬ֹĿ־ʱ
+	std::recursive_mutex s_consumerMutex;
+	size_t s_dequeuePos = 0;
+	std::vector<easy2d::LogSink*> s_sinks;
+	bool s_sinksConfigured = false;
+
+	std::thread s_thread;
+
+	const wchar_t* GetPrompt(easy2d::Logger::Level level)
 	{
-		if (s_bEnable)
+		switch (level)
 		{
-			static wchar_t tempBuffer[1024 * 3 + 1];
+		case easy2d::Logger::Level::Warning:
+			return L"Warning: ";
+		case easy2d::Logger::Level::Error:
+			return L"Error: ";
+		default:
+			return L" ";
+		}
+	}
 
-			std::wstringstream ss;
+	easy2d::String FormatArgs(const wchar_t* format, va_list args)
+	{
+		easy2d::String result;
+#ifdef _MSC_VER
+		va_list argsCopy;
+		va_copy(argsCopy, args);
+		const int len = ::_vscwprintf(format, argsCopy);
+		va_end(argsCopy);
+		if (len > 0)
+		{
+			result.resize(static_cast<size_t>(len));
+			::_vsnwprintf_s(&result[0], len + 1, len, format, args);
+		}
+#else
+		for (size_t capacity = INLINE_LENGTH * 4; capacity <= 1024 * 1024; capacity *= 2)
+		{
+			result.resize(capacity);
 
-			if (prompt)
-				ss << prompt;
+			va_list argsCopy;
+			va_copy(argsCopy, args);
+			const int len = ::vswprintf(&result[0], capacity, format, argsCopy);
+			va_end(argsCopy);
 
-			if (format)
+			if (len >= 0)
 			{
-				const auto len = ::_vscwprintf(format, args) + 1;
-				::_vsnwprintf_s(tempBuffer, len, len, format, args);
+				result.resize(static_cast<size_t>(len));
+				return result;
+			}
+		}
+		result.clear();
+#endif
+		return result;
+	}
+
+	// ڵǰ̸߳ʽ־Уʱ false
+	bool Enqueue(easy2d::Logger::Level level, const wchar_t* format, va_list args)
+	{
+		size_t pos = s_enqueuePos.load(std::memory_order_relaxed);
+		Slot* slot = nullptr;
+		size_t lap = 0;
+
+		for (;;)
+		{
+			slot = &s_slots[pos & (QUEUE_SIZE - 1)];
+			lap = pos / QUEUE_SIZE * 2;
 
-				ss << tempBuffer << std::endl;
+			const size_t state = slot->state.load(std::memory_order_acquire);
+			const ptrdiff_t diff = static_cast<ptrdiff_t>(state - lap);
+			if (diff == 0)
+			{
+				if (s_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
 			}
+			else if (diff < 0)
+			{
+				// һȦ־ûд
+				return false;
+			}
+			else
+			{
+				pos = s_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
 
-			std::wstring output = ss.str();
-			os << output << std::flush;
-			::OutputDebugStringW(output.c_str());
+		slot->level = level;
+		slot->longText = nullptr;
+
+		va_list argsCopy;
+		va_copy(argsCopy, args);
+#ifdef _MSC_VER
+		const int len = ::_vsnwprintf_s(slot->text, INLINE_LENGTH, _TRUNCATE, format, argsCopy);
+#else
+		const int len = ::vswprintf(slot->text, INLINE_LENGTH, format, argsCopy);
+#endif
+		va_end(argsCopy);
+
+		if (len < 0)
+		{
+			// ݹڴ
+			slot->text[0] = L'\0';
+			slot->longText = new (std::nothrow) easy2d::String(FormatArgs(format, args));
 		}
+
+		slot->state.store(lap + 1, std::memory_order_release);
+		return true;
 	}
 
-	void RedirectStdIO()
+	// ûùĿʱʹĬϵĿ
+	void EnsureDefaultSinks()
 	{
-		s_cinBuffer = std::cin.rdbuf();
-		s_coutBuffer = std::cout.rdbuf();
-		s_cerrBuffer = std::cerr.rdbuf();
-		s_wcinBuffer = std::wcin.rdbuf();
-		s_wcoutBuffer = std::wcout.rdbuf();
-		s_wcerrBuffer = std::wcerr.rdbuf();
-
-		s_consoleInput.open("CONIN$", std::ios::in);
-		s_consoleOutput.open("CONOUT$", std::ios::out);
-		s_consoleError.open("CONOUT$", std::ios::out);
-		s_wconsoleInput.open("CONIN$", std::ios::in);
-		s_wconsoleOutput.open("CONOUT$", std::ios::out);
-		s_wconsoleError.open("CONOUT$", std::ios::out);
+		if (!s_sinksConfigured)
+		{
+			s_sinksConfigured = true;
+			s_sinks.push_back(new (std::nothrow) easy2d::ConsoleLogSink);
+#ifndef E2D_HEADLESS
+			s_sinks.push_back(new (std::nothrow) easy2d::DebugLogSink);
+#endif
+		}
+	}
 
-		FILE* dummy;
-		::freopen_s(&dummy, "CONOUT$", "w+t", stdout);
-		::freopen_s(&dummy, "CONIN$", "r+t", stdin);
-		::freopen_s(&dummy, "CONOUT$", "w+t", stderr);
-		(void)dummy;
+	void WriteToSinks(easy2d::Logger::Level level, const easy2d::String& text)
+	{
+		EnsureDefaultSinks();
 
-		std::cin.rdbuf(s_consoleInput.rdbuf());
-		std::cout.rdbuf(s_consoleOutput.rdbuf());
-		std::cerr.rdbuf(s_consoleError.rdbuf());
-		std::wcin.rdbuf(s_wconsoleInput.rdbuf());
-		std::wcout.rdbuf(s_wconsoleOutput.rdbuf());
-		std::wcerr.rdbuf(s_wconsoleError.rdbuf());
+		for (auto sink : s_sinks)
+		{
+			if (sink)
+			{
+				sink->write(level, text);
+			}
+		}
 	}
 
-	void ResetStdIO()
+	// ȡд־Ŀ꣬ǰ s_consumerMutex
+	size_t Drain()
 	{
-		s_consoleInput.close();
-		s_consoleOutput.close();
-		s_consoleError.close();
-		s_wconsoleInput.close();
-		s_wconsoleOutput.close();
-		s_wconsoleError.close();
+		size_t count = 0;
+		for (;;)
+		{
+			Slot& slot = s_slots[s_dequeuePos & (QUEUE_SIZE - 1)];
+			const size_t lap = s_dequeuePos / QUEUE_SIZE * 2;
+			if (slot.state.load(std::memory_order_acquire) != lap + 1)
+			{
+				break;
+			}
+
+			const easy2d::Logger::Level level = slot.level;
+			easy2d::String text(GetPrompt(level));
+			if (slot.longText)
+			{
+				text.append(*slot.longText);
+				delete slot.longText;
+				slot.longText = nullptr;
+			}
+			else
+			{
+				text.append(slot.text);
+			}
+			text.push_back(L'\n');
 
-		std::cin.rdbuf(s_cinBuffer);
-		std::cout.rdbuf(s_coutBuffer);
-		std::cerr.rdbuf(s_cerrBuffer);
-		std::wcin.rdbuf(s_wcinBuffer);
-		std::wcout.rdbuf(s_wcoutBuffer);
-		std::wcerr.rdbuf(s_wcerrBuffer);
+			// ȹ黹ִۣн
+			slot.state.store(lap + 2, std::memory_order_release);
+			++s_dequeuePos;
+			++count;
 
-		fclose(stdout);
-		fclose(stdin);
-		fclose(stderr);
+			WriteToSinks(level, text);
+		}
 
-		s_cinBuffer = nullptr;
-		s_coutBuffer = nullptr;
-		s_cerrBuffer = nullptr;
-		s_wcinBuffer = nullptr;
-		s_wcoutBuffer = nullptr;
-		s_wcerrBuffer = nullptr;
+		const size_t dropped = s_dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped)
+		{
+			WriteToSinks(
+				easy2d::Logger::Level::Warning,
+				easy2d::FormatString(L"Warning: %u log messages dropped.\n", static_cast<unsigned int>(dropped))
+			);
+			++count;
+		}
+		return count;
 	}
 
-	HWND allocated_console = nullptr;
+	void FlushSinks()
+	{
+		for (auto sink : s_sinks)
+		{
+			if (sink)
+			{
+				sink->flush();
+			}
+		}
+	}
 
-	HWND AllocateConsole()
+	void LoggerThread()
 	{
-		if (::AllocConsole())
+		while (s_running.load())
 		{
-			allocated_console = ::GetConsoleWindow();
+			size_t count = 0;
+			{
+				std::lock_guard<std::recursive_mutex> lock(s_consumerMutex);
+				count = Drain();
+				if (count)
+				{
+					FlushSinks();
+				}
+			}
 
-			if (allocated_console)
+			if (!count)
 			{
-				RedirectStdIO();
+				easy2d::platform::SleepFor(5);
 			}
 		}
-		return allocated_console;
 	}
 
-	void FreeAllocatedConsole()
+	void StopThread()
 	{
-		if (allocated_console)
+		if (s_running.exchange(false))
 		{
-			ResetStdIO();
-			::FreeConsole();
-			allocated_console = nullptr;
+			s_thread.join();
 		}
+		easy2d::Logger::flush();
 	}
 
-	HWND GetAllocatedConsole()
+	// δ Game::destroy ˳ʱ־߳
+	struct ThreadGuard
 	{
-		return allocated_console;
+		~ThreadGuard()
+		{
+			StopThread();
+		}
+	} s_threadGuard;
+
+	void Output(easy2d::Logger::Level level, const wchar_t* format, va_list args)
+	{
+		if (s_disabled.load(std::memory_order_relaxed) || !format)
+		{
+			return;
+		}
+
+		if (!Enqueue(level, format, args))
+		{
+			// Ϣܶڳк
+			if (level != easy2d::Logger::Level::Error)
+			{
+				s_dropped.fetch_add(1, std::memory_order_relaxed);
+				s_droppedTotal.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			easy2d::Logger::flush();
+			while (!Enqueue(level, format, args))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		// Ϣ־߳ǰ־ֱд
+		if (level == easy2d::Logger::Level::Error || !s_running.load())
+		{
+			easy2d::Logger::flush();
+		}
 	}
 }
 
 void easy2d::Logger::enable()
 {
-	s_bEnable = true;
+	s_disabled.store(false);
 }
 
 void easy2d::Logger::disable()
 {
-	s_bEnable = false;
+	s_disabled.store(true);
 }
 
 void easy2d::Logger::messageln(String format, ...)
 {
-	va_list args = nullptr;
+	va_list args;
 	va_start(args, format);
 
-	Output(std::wcout, L" ", format.c_str(), args);
+	Output(Level::Message, format.c_str(), args);
 
 	va_end(args);
 }
 
 void easy2d::Logger::warningln(String format, ...)
 {
-	va_list args = nullptr;
+	va_list args;
 	va_start(args, format);
 
-	Output(std::wcout, L"Warning: ", format.c_str(), args);
+	Output(Level::Warning, format.c_str(), args);
 
 	va_end(args);
 }
 
 void easy2d::Logger::errorln(String format, ...)
 {
-	va_list args = nullptr;
+	va_list args;
 	va_start(args, format);
 
-	Output(std::wcout, L"Error: ", format.c_str(), args);
+	Output(Level::Error, format.c_str(), args);
 
 	va_end(args);
 }
 
 void easy2d::Logger::showConsole(bool show)
 {
-	HWND currConsole = ::GetConsoleWindow();
-	if (show)
+	if (!platform::ShowConsole(show))
 	{
-		if (currConsole)
-		{
-			::ShowWindow(currConsole, SW_SHOW);
-		}
-		else
-		{
-			HWND console = ::AllocateConsole();
-			if (!console)
-			{
-				E2D_WARNING(L"AllocConsole failed");
-			}
-			else
-			{
-				// disable the close button of console
-				HMENU hmenu = ::GetSystemMenu(console, FALSE);
-				::RemoveMenu(hmenu, SC_CLOSE, MF_BYCOMMAND);
-			}
-		}
+		E2D_WARNING(L"AllocConsole failed");
 	}
-	else
+}
+
+void easy2d::Logger::addSink(LogSink* sink)
+{
+	if (!sink)
 	{
-		if (currConsole)
-		{
-			if (currConsole == GetAllocatedConsole())
-			{
-				FreeAllocatedConsole();
-			}
-			else
-			{
-				::ShowWindow(currConsole, SW_HIDE);
-			}
-		}
+		return;
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(s_consumerMutex);
+	// ֮ǰ־дԭĿ
+	Drain();
+	EnsureDefaultSinks();
+
+	GC::retain(sink);
+	s_sinks.push_back(sink);
+}
+
+void easy2d::Logger::removeSink(LogSink* sink)
+{
+	std::lock_guard<std::recursive_mutex> lock(s_consumerMutex);
+	Drain();
+
+	auto iter = std::find(s_sinks.begin(), s_sinks.end(), sink);
+	if (iter != s_sinks.end())
+	{
+		s_sinks.erase(iter);
+		sink->flush();
+		GC::release(sink);
+	}
+}
+
+void easy2d::Logger::clearSinks()
+{
+	std::lock_guard<std::recursive_mutex> lock(s_consumerMutex);
+	Drain();
+	FlushSinks();
+
+	for (auto sink : s_sinks)
+	{
+		GC::release(sink);
+	}
+	s_sinks.clear();
+	s_sinksConfigured = true;
+}
+
+void easy2d::Logger::flush()
+{
+	std::lock_guard<std::recursive_mutex> lock(s_consumerMutex);
+	Drain();
+	FlushSinks();
+}
+
+size_t easy2d::Logger::getDroppedCount()
+{
+	return s_droppedTotal.load(std::memory_order_relaxed);
+}
+
+void easy2d::Logger::__init()
+{
+	if (!s_running.exchange(true))
+	{
+		s_thread = std::thread(LoggerThread);
+	}
+}
+
+void easy2d::Logger::__uninit()
+{
+	StopThread();
+}
+
+
+void easy2d::ConsoleLogSink::write(Logger::Level level, const String& text)
+{
+	platform::WriteLog(text, level == Logger::Level::Error);
+}
+
+
+easy2d::FileLogSink::FileLogSink(const String& filePath, bool append)
+	: _file(platform::OpenFile(filePath, append ? "ab" : "wb"))
+{
+	if (!_file)
+	{
+		E2D_WARNING(L"FileLogSink: Cannot open log file.");
+	}
+}
+
+easy2d::FileLogSink::~FileLogSink()
+{
+	if (_file)
+	{
+		::fclose(_file);
+		_file = nullptr;
 	}
 }
+
+bool easy2d::FileLogSink::isOpened() const
+{
+	return _file != nullptr;
+}
+
+void easy2d::FileLogSink::write(Logger::Level /* level */, const String& text)
+{
+	if (_file)
+	{
+		const ByteString output = WideToUtf8(text);
+		::fwrite(output.data(), 1, output.size(), _file);
+	}
+}
+
+void easy2d::FileLogSink::flush()
+{
+	if (_file)
+	{
+		::fflush(_file);
+	}
+}
+
+
+#ifndef E2D_HEADLESS
+
+void easy2d::DebugLogSink::write(Logger::Level level, const String& text)
+{
+	platform::WriteDebugString(text);
+}
+
+#endif
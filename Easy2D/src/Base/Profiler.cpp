@@ -0,0 +1,229 @@
+#include <easy2d/e2dbase.h>
+#include <easy2d/e2dplatform.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+// VS2013 ֧ thread_localʹñչֲָ߳̾
+#ifdef _MSC_VER
+#	define E2D_THREAD_LOCAL __declspec(thread)
+#else
+#	define E2D_THREAD_LOCAL __thread
+#endif
+
+namespace
+{
+	struct Zone
+	{
+		const char* name;
+		long long begin;
+		long long end;
+	};
+
+	// ÿ߳һֻ߳д
+	struct ThreadBuffer
+	{
+		unsigned int threadId;
+		easy2d::String name;
+		std::vector<Zone> zones;
+		std::atomic<size_t> count;	// ʼ¼д
+	};
+
+	// б߳ƺͻС
+	std::mutex s_mutex;
+	std::vector<ThreadBuffer*> s_buffers;
+	size_t s_bufferSize = 64 * 1024;
+	long long s_startTicks = 0;
+	std::atomic<bool> s_running(false);
+
+	E2D_THREAD_LOCAL ThreadBuffer* t_buffer = nullptr;
+
+	ThreadBuffer* GetThreadBuffer()
+	{
+		if (!t_buffer)
+		{
+			// ߳̽󻺳Ȼʱܿļ¼
+			ThreadBuffer* buffer = new (std::nothrow) ThreadBuffer;
+			if (buffer)
+			{
+				std::lock_guard<std::mutex> lock(s_mutex);
+				buffer->threadId = static_cast<unsigned int>(s_buffers.size() + 1);
+				buffer->zones.resize(s_bufferSize);
+				buffer->count.store(0);
+				s_buffers.push_back(buffer);
+			}
+			t_buffer = buffer;
+		}
+		return t_buffer;
+	}
+
+	void WriteJsonString(FILE* file, const char* str)
+	{
+		::fputc('"', file);
+		for (const char* p = str; *p; ++p)
+		{
+			const unsigned char ch = static_cast<unsigned char>(*p);
+			if (ch == '"' || ch == '\\')
+			{
+				::fputc('\\', file);
+				::fputc(ch, file);
+			}
+			else if (ch < 0x20)
+			{
+				::fprintf(file, "\\u%04x", ch);
+			}
+			else
+			{
+				::fputc(ch, file);
+			}
+		}
+		::fputc('"', file);
+	}
+
+	void WriteMetadata(FILE* file, const char* type, unsigned int threadId, const easy2d::String& name, bool& first)
+	{
+		::fprintf(file, "%s\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"%s\",\"args\":{\"name\":", first ? "" : ",", threadId, type);
+		WriteJsonString(file, easy2d::WideToUtf8(name).c_str());
+		::fputs("}}", file);
+		first = false;
+	}
+}
+
+void easy2d::Profiler::start()
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+
+	for (auto buffer : s_buffers)
+	{
+		if (buffer->zones.size() != s_bufferSize)
+		{
+			buffer->zones.resize(s_bufferSize);
+		}
+		buffer->count.store(0);
+	}
+
+	s_startTicks = platform::GetTicks();
+	s_running.store(true);
+}
+
+void easy2d::Profiler::stop()
+{
+	s_running.store(false);
+}
+
+bool easy2d::Profiler::isRunning()
+{
+	return s_running.load(std::memory_order_relaxed);
+}
+
+void easy2d::Profiler::setBufferSize(size_t zoneCount)
+{
+	if (isRunning())
+	{
+		E2D_WARNING(L"Profiler::setBufferSize failed! Stop the profiler first.");
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_bufferSize = max(zoneCount, size_t(1));
+}
+
+void easy2d::Profiler::setThreadName(const String& name)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+	if (buffer)
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		buffer->name = name;
+	}
+}
+
+void easy2d::Profiler::record(const char* name, long long beginTicks, long long endTicks)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+	if (!buffer || !isRunning())
+	{
+		return;
+	}
+
+	const size_t index = buffer->count.load(std::memory_order_relaxed);
+	Zone& zone = buffer->zones[index % buffer->zones.size()];
+	zone.name = name;
+	zone.begin = beginTicks;
+	zone.end = endTicks;
+	buffer->count.store(index + 1, std::memory_order_release);
+}
+
+long long easy2d::Profiler::getTicks()
+{
+	return platform::GetTicks();
+}
+
+bool easy2d::Profiler::exportChromeTrace(const String& filePath)
+{
+	FILE* file = platform::OpenFile(filePath, "wb");
+	if (!file)
+	{
+		E2D_WARNING(L"Profiler::exportChromeTrace failed! Cannot create file.");
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+
+	// trace ʽʱ䵥λΪ΢
+	const double ticksToMicroseconds = 1000000.0 / static_cast<double>(platform::GetTickFrequency());
+	bool first = true;
+
+	::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+	WriteMetadata(file, "process_name", 0, Game::getName().empty() ? L"Easy2D" : Game::getName(), first);
+
+	std::vector<Zone> zones;
+	for (auto buffer : s_buffers)
+	{
+		WriteMetadata(
+			file,
+			"thread_name",
+			buffer->threadId,
+			buffer->name.empty() ? FormatString(L"Thread %u", buffer->threadId) : buffer->name,
+			first
+		);
+
+		// ƺټһΣڼܱǵ
+		const size_t capacity = buffer->zones.size();
+		const size_t count = buffer->count.load(std::memory_order_acquire);
+		const size_t begin = count > capacity ? count - capacity : 0;
+
+		zones.clear();
+		for (size_t i = begin; i < count; ++i)
+		{
+			zones.push_back(buffer->zones[i % capacity]);
+		}
+
+		const size_t newCount = buffer->count.load(std::memory_order_acquire);
+		const size_t valid = newCount > capacity ? newCount - capacity : 0;
+		for (size_t i = max(begin, valid); i < count; ++i)
+		{
+			const Zone& zone = zones[i - begin];
+			::fputs(",\n{\"ph\":\"X\",\"cat\":\"easy2d\",\"name\":", file);
+			WriteJsonString(file, zone.name);
+			::fprintf(
+				file,
+				",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				buffer->threadId,
+				static_cast<double>(zone.begin - s_startTicks) * ticksToMicroseconds,
+				static_cast<double>(zone.end - zone.begin) * ticksToMicroseconds
+			);
+		}
+	}
+
+	::fputs("\n]}\n", file);
+
+	const bool succeeded = ::ferror(file) == 0;
+	::fclose(file);
+
+	if (!succeeded)
+	{
+		E2D_WARNING(L"Profiler::exportChromeTrace failed! Cannot write file.");
+	}
+	return succeeded;
+}
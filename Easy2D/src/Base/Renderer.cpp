@@ -1,6 +1,9 @@
 #include <easy2d/e2dbase.h>
 #include <easy2d/e2dmanager.h>
 #include <easy2d/e2dnode.h>
+#include <easy2d/e2drender.h>
+
+#ifndef E2D_HEADLESS
 
 namespace easy2d
 {
@@ -485,13 +488,33 @@ STDMETHODIMP TextRenderer::QueryInterface(
 
 }
 
+#endif
+
 
 namespace
 {
 	bool s_bShowFps = false;
 	float s_fDpiScaleX = 0;
 	float s_fDpiScaleY = 0;
+	easy2d::Color s_nClearColor = easy2d::Color::Black;
+	easy2d::RenderDevice* s_pDevice = nullptr;
+	// ģʽ
+	bool s_bRetainedMode = true;
+	bool s_bInvalidated = true;
+	bool s_bRecording = false;
+	easy2d::RenderCommandList* s_pCommandList = nullptr;
+	easy2d::Scene* s_pRecordedScene = nullptr;
+	// ӿ޳
+	bool s_bCulling = true;
+	easy2d::Rect s_rcCulling;
+	easy2d::Rect s_rcViewport;
+	easy2d::Rect s_rcVisible;			// ӿµķΧ
+	easy2d::Matrix32 s_mView;
+	size_t s_nDrawnNodes = 0;
+	size_t s_nCulledNodes = 0;
+#ifndef E2D_HEADLESS
 	IDWriteTextFormat* s_pTextFormat = nullptr;
+	IDWriteTextLayout* s_pFpsTextLayout = nullptr;
 	ID2D1Factory* s_pDirect2dFactory = nullptr;
 	ID2D1HwndRenderTarget* s_pRenderTarget = nullptr;
 	ID2D1SolidColorBrush* s_pSolidBrush = nullptr;
@@ -501,13 +524,13 @@ namespace
 	ID2D1StrokeStyle* s_pMiterStrokeStyle = nullptr;
 	ID2D1StrokeStyle* s_pBevelStrokeStyle = nullptr;
 	ID2D1StrokeStyle* s_pRoundStrokeStyle = nullptr;
-	D2D1_COLOR_F s_nClearColor = D2D1::ColorF(D2D1::ColorF::Black);
+#endif
 }
 
+#ifndef E2D_HEADLESS
+
 bool easy2d::Renderer::__createDeviceIndependentResources()
 {
-	__discardResources();
-
 	// 豸޹Դǵںͳʱͬ
 	HRESULT hr = D2D1CreateFactory(
 		D2D1_FACTORY_TYPE_SINGLE_THREADED,
@@ -682,61 +705,149 @@ void easy2d::Renderer::__discardDeviceResources()
 	SafeRelease(s_pRoundStrokeStyle);
 }
 
+#endif
+
 void easy2d::Renderer::__discardResources()
 {
+	// Ⱦ豸еԴҪڹͷ
+	GC::release(s_pCommandList);
+	GC::release(s_pRecordedScene);
+	GC::release(s_pDevice);
+#ifndef E2D_HEADLESS
 	__discardDeviceResources();
+	SafeRelease(s_pFpsTextLayout);
 	SafeRelease(s_pTextFormat);
 	SafeRelease(s_pDirect2dFactory);
 	SafeRelease(s_pIWICFactory);
 	SafeRelease(s_pDWriteFactory);
+#endif
 }
 
 void easy2d::Renderer::__render()
 {
-	HRESULT hr = S_OK;
+	E2D_PROFILE_SCOPE("Renderer::render");
 
-	// 豸Դ
-	Renderer::__createDeviceResources();
+	RenderDevice* device = Renderer::getDevice();
+	if (!device)
+	{
+		return;
+	}
 
-	// ʼȾ
-	s_pRenderTarget->BeginDraw();
-	// ʹñɫĻ
-	s_pRenderTarget->Clear(s_nClearColor);
+	// ޳ʹõӿڣӿڸıʱ֮ǰ¼Ч
+	Rect viewport = s_rcCulling;
+	if (viewport.size.width <= 0 || viewport.size.height <= 0)
+	{
+		viewport = Rect(Point(), device->getSize());
+	}
 
-	// Ⱦ
-	SceneManager::__render();
+	if (!(viewport == s_rcViewport))
+	{
+		s_rcViewport = viewport;
+		s_bInvalidated = true;
+	}
 
-	// Ⱦ FPS
-	if (s_bShowFps && s_pTextFormat)
+	bool dirty = true;
+	if (s_bRetainedMode)
 	{
+		dirty = s_bInvalidated
+			|| !s_pCommandList
+			|| SceneManager::__isDirty()
+			|| SceneManager::getCurrentScene() != s_pRecordedScene;
+
+		// ûб仯豸һ֡Ļʱһ֡
+		// ¼˽ڵʱڵ onRender ÿܻ֡ͬݣ
+		if (!dirty && !s_bShowFps && !s_pCommandList->hasNodeCommands() && device->isFramePreserved())
+		{
+			return;
+		}
+	}
+
+	// ʼȾʹñɫĻ
+	if (!device->beginFrame(s_nClearColor))
+	{
+		return;
+	}
+
+	if (!s_bRetainedMode)
+	{
+		// ֱȾ
+		Renderer::__renderScene();
+	}
+	else
+	{
+		if (dirty)
+		{
+			if (!s_pCommandList)
+			{
+				s_pCommandList = new (std::nothrow) RenderCommandList;
+			}
+
+			if (s_pCommandList)
+			{
+				E2D_PROFILE_SCOPE("Renderer::record");
+
+				// ڵ¼Ⱦ
+				s_pCommandList->setTarget(device);
+				s_pCommandList->beginFrame(s_nClearColor);
+				s_bRecording = true;
+				Renderer::__renderScene();
+				s_bRecording = false;
+				s_pCommandList->setTarget(nullptr);
+
+				// תʱĻ治ܻط
+				Scene* scene = SceneManager::isTransitioning() ? nullptr : SceneManager::getCurrentScene();
+				GC::retain(scene);
+				GC::release(s_pRecordedScene);
+				s_pRecordedScene = scene;
+				s_bInvalidated = false;
+			}
+		}
+
+		// طȾ
+		if (s_pCommandList)
+		{
+			E2D_PROFILE_SCOPE("Renderer::replay");
+			s_pCommandList->replay(device);
+		}
+		else
+		{
+			Renderer::__renderScene();
+		}
+	}
+
+#ifndef E2D_HEADLESS
+	// Ⱦ FPSֻ Direct2D 豸
+	if (s_bShowFps && s_pTextFormat && dynamic_cast<D2DRenderDevice*>(device))
+	{
+		// ֱӻƵȾĿ꣬ύľ
+		device->flush();
+
 		static int s_nRenderTimes = 0;
 		static float s_fLastRenderTime = 0;
-		static String s_sFpsText;
 
 		++s_nRenderTimes;
 
+		// ݸıʱ´ı
 		float fDelay = Time::getTotalTime() - s_fLastRenderTime;
-		if (fDelay >= 0.3)
+		if (fDelay >= 0.3 || !s_pFpsTextLayout)
 		{
 			wchar_t fpsText[20] = { 0 };
-			::swprintf_s(fpsText, L"FPS: %.1lf", (1 / fDelay) * s_nRenderTimes);
-			s_sFpsText = fpsText;
+			::swprintf_s(fpsText, L"FPS: %.1lf", fDelay > 0 ? (1 / fDelay) * s_nRenderTimes : 0.0);
 			s_fLastRenderTime = Time::getTotalTime();
 			s_nRenderTimes = 0;
-		}
-
-		IDWriteTextLayout * pTextLayout = nullptr;
 
-		hr = s_pDWriteFactory->CreateTextLayout(
-			s_sFpsText.c_str(),
-			(UINT32)s_sFpsText.length(),
-			s_pTextFormat,
-			0,
-			0,
-			&pTextLayout
-		);
+			SafeRelease(s_pFpsTextLayout);
+			s_pDWriteFactory->CreateTextLayout(
+				fpsText,
+				(UINT32)::wcslen(fpsText),
+				s_pTextFormat,
+				0,
+				0,
+				&s_pFpsTextLayout
+			);
+		}
 
-		if (SUCCEEDED(hr))
+		if (s_pFpsTextLayout)
 		{
 			s_pRenderTarget->SetTransform(D2D1::Matrix3x2F::Identity());
 			s_pSolidBrush->SetOpacity(1.0f);
@@ -748,38 +859,153 @@ void easy2d::Renderer::__render()
 				D2D1_LINE_JOIN_ROUND
 			);
 
-			pTextLayout->Draw(nullptr, s_pTextRenderer, 10, 0);
-
-			SafeRelease(pTextLayout);
+			s_pFpsTextLayout->Draw(nullptr, s_pTextRenderer, 10, 0);
 		}
 	}
+#endif
 
 	// ֹȾ
-	hr = s_pRenderTarget->EndDraw();
+	E2D_PROFILE_SCOPE("Renderer::present");
+	device->endFrame();
+}
+
+
+easy2d::RenderDevice * easy2d::Renderer::getDevice()
+{
+	if (s_bRecording)
+	{
+		return s_pCommandList;
+	}
+
+#ifndef E2D_HEADLESS
+	if (!s_pDevice)
+	{
+		// Ĭʹ Direct2D 豸Ⱦ
+		s_pDevice = new (std::nothrow) D2DRenderDevice;
+	}
+#endif
+	return s_pDevice;
+}
 
-	if (hr == D2DERR_RECREATE_TARGET)
+void easy2d::Renderer::setDevice(RenderDevice * device)
+{
+	if (device == s_pDevice)
 	{
-		//  Direct3D 豸ִйʧǰ豸Դ
-		// һεʱؽԴ
-		hr = S_OK;
-		Renderer::__discardDeviceResources();
+		return;
 	}
 
-	if (FAILED(hr))
+	GC::retain(device);
+	GC::release(s_pDevice);
+	s_pDevice = device;
+	s_bInvalidated = true;
+}
+
+void easy2d::Renderer::setRetainedMode(bool enabled)
+{
+	s_bRetainedMode = enabled;
+	s_bInvalidated = true;
+	if (!enabled)
 	{
-		E2D_ERROR(L"Device loss recovery failed");
+		GC::release(s_pCommandList);
+		GC::release(s_pRecordedScene);
 	}
 }
 
+void easy2d::Renderer::invalidate()
+{
+	s_bInvalidated = true;
+}
+
+void easy2d::Renderer::setCulling(bool enabled)
+{
+	s_bCulling = enabled;
+	s_bInvalidated = true;
+}
+
+void easy2d::Renderer::setCullingRect(const Rect& rect)
+{
+	s_rcCulling = rect;
+}
+
+size_t easy2d::Renderer::getDrawnNodeCount()
+{
+	return s_nDrawnNodes;
+}
+
+size_t easy2d::Renderer::getCulledNodeCount()
+{
+	return s_nCulledNodes;
+}
+
+void easy2d::Renderer::__renderScene()
+{
+	s_nDrawnNodes = 0;
+	s_nCulledNodes = 0;
+	Renderer::__setViewMatrix(Matrix32());
+	SceneManager::__render();
+}
+
+void easy2d::Renderer::__setViewMatrix(const Matrix32& view)
+{
+	s_mView = view;
+	if (view.isIdentity())
+	{
+		s_rcVisible = s_rcViewport;
+	}
+	else
+	{
+		s_rcVisible = Matrix32::invert(view).transform(s_rcViewport);
+	}
+}
+
+const easy2d::Matrix32& easy2d::Renderer::__getViewMatrix()
+{
+	return s_mView;
+}
+
+bool easy2d::Renderer::__isNodeCulled(float left, float top, float right, float bottom)
+{
+	if (Renderer::__isSubtreeCulled(left, top, right, bottom))
+	{
+		return true;
+	}
+
+	++s_nDrawnNodes;
+	return false;
+}
+
+bool easy2d::Renderer::__isSubtreeCulled(float left, float top, float right, float bottom)
+{
+	// յİΧûҪƵ
+	if (left > right || top > bottom)
+	{
+		return true;
+	}
+
+	if (s_bCulling &&
+		(right < s_rcVisible.getLeft() || left > s_rcVisible.getRight() ||
+		bottom < s_rcVisible.getTop() || top > s_rcVisible.getBottom()))
+	{
+		++s_nCulledNodes;
+		return true;
+	}
+	return false;
+}
+
+easy2d::RenderCommandList * easy2d::Renderer::__getRecordingList()
+{
+	return s_bRecording ? s_pCommandList : nullptr;
+}
 
 easy2d::Color easy2d::Renderer::getBackgroundColor()
 {
-	return Color(s_nClearColor.r, s_nClearColor.g, s_nClearColor.b, s_nClearColor.a);
+	return s_nClearColor;
 }
 
 void easy2d::Renderer::setBackgroundColor(Color color)
 {
-	s_nClearColor = color.toD2DColorF();
+	s_nClearColor = color;
+	s_bInvalidated = true;
 }
 
 void easy2d::Renderer::showFps(bool show)
@@ -797,6 +1023,8 @@ float easy2d::Renderer::getDpiScaleY()
 	return s_fDpiScaleY;
 }
 
+#ifndef E2D_HEADLESS
+
 ID2D1Factory * easy2d::Renderer::getID2D1Factory()
 {
 	return s_pDirect2dFactory;
@@ -852,3 +1080,5 @@ ID2D1StrokeStyle * easy2d::Renderer::getRoundID2D1StrokeStyle()
 {
 	return s_pRoundStrokeStyle;
 }
+
+#endif
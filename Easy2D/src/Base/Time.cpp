@@ -1,57 +1,102 @@
 #include <easy2d/e2dbase.h>
-#include <thread>
-#include <chrono>
-using namespace std::chrono;
+#include <easy2d/e2dplatform.h>
 
 
-// Ϸʼʱ
-static steady_clock::time_point s_tStart;
-// ǰʱ
-static steady_clock::time_point s_tNow;
-// һ֡ˢʱ
-static steady_clock::time_point s_tLast;
-// ̶ˢʱ
-static steady_clock::time_point s_tFixed;
-// ÿһ֡
-static milliseconds s_tExceptedInvertal;
+// Ϸʼʱ䣨΢룩
+static long long s_tStart = 0;
+// ǰʱ䣨΢룩
+static long long s_tNow = 0;
+// һ֡ˢʱ䣨΢룩
+static long long s_tLast = 0;
+// ̶ˢʱ䣨΢룩
+static long long s_tFixed = 0;
+// ÿһ֡΢룩
+static long long s_tExceptedInvertal = 16000;
+
+// ģʱӵĵǰʱ䣨΢룩
+static long long s_tSimTime = 0;
+// ģʱһƽʱ΢룩
+static long long s_tSimDelta = 0;
+// ̶΢룩Ϊ 0 ʱÿ֡ģһ
+static long long s_tStep = 0;
+// ۻĻδģʱ䣨΢룩
+static long long s_tAccumulator = 0;
+// ÿ֡׷ϵĲ
+static int s_nMaxSteps = 5;
+// ֡ģĲ
+static int s_nPendingSteps = 0;
+// ģʱǷʵʱͬ
+static bool s_bRealTime = true;
 
 
 float easy2d::Time::getTotalTime()
 {
-	return duration_cast<microseconds>(s_tNow - s_tStart).count() / 1000.f / 1000.f;
+	return s_tSimTime / 1000.f / 1000.f;
 }
 
 unsigned int easy2d::Time::getTotalTimeMilliseconds()
 {
-	return static_cast<unsigned int>(duration_cast<milliseconds>(s_tNow - s_tStart).count());
+	return static_cast<unsigned int>(s_tSimTime / 1000);
 }
 
 float easy2d::Time::getDeltaTime()
 {
-	return duration_cast<microseconds>(s_tNow - s_tLast).count() / 1000.f / 1000.f;
+	return s_tSimDelta / 1000.f / 1000.f;
 }
 
 unsigned int easy2d::Time::getDeltaTimeMilliseconds()
 {
-	return static_cast<unsigned int>(duration_cast<milliseconds>(s_tNow - s_tLast).count());
+	return static_cast<unsigned int>(s_tSimDelta / 1000);
+}
+
+void easy2d::Time::setFrameInterval(float interval)
+{
+	s_tExceptedInvertal = static_cast<long long>(max(interval, 0) * 1000 * 1000);
+}
+
+void easy2d::Time::setFixedStep(float step, int maxSteps /* = 5 */)
+{
+	s_tStep = static_cast<long long>(max(step, 0) * 1000 * 1000);
+	s_nMaxSteps = max(maxSteps, 1);
+	s_tAccumulator = 0;
+}
+
+float easy2d::Time::getFixedStep()
+{
+	return s_tStep / 1000.f / 1000.f;
+}
+
+void easy2d::Time::setRealTime(bool realTime)
+{
+	s_bRealTime = realTime;
+}
+
+float easy2d::Time::getInterpolation()
+{
+	if (s_tStep == 0)
+		return 1.f;
+	return static_cast<float>(s_tAccumulator) / s_tStep;
 }
 
 bool easy2d::Time::__init()
 {
-	s_tStart = s_tFixed = s_tLast = s_tNow = steady_clock::now();
-	s_tExceptedInvertal = milliseconds(15);
+	s_tStart = s_tFixed = s_tLast = s_tNow = platform::GetTimestamp();
+	s_tSimTime = s_tSimDelta = s_tAccumulator = 0;
+	s_nPendingSteps = 0;
 	return true;
 }
 
 bool easy2d::Time::__isReady()
 {
-	return s_tExceptedInvertal < duration_cast<milliseconds>(s_tNow - s_tFixed);
+	if (!s_bRealTime)
+		return true;
+	return s_tExceptedInvertal <= s_tNow - s_tFixed;
 }
 
 void easy2d::Time::__updateNow()
 {
 	// ˢʱ
-	s_tNow = steady_clock::now();
+	s_tNow = platform::GetTimestamp();
 }
 
 void easy2d::Time::__updateLast()
@@ -59,22 +104,74 @@ void easy2d::Time::__updateLast()
 	s_tFixed += s_tExceptedInvertal;
 
 	s_tLast = s_tNow;
-	s_tNow = steady_clock::now();
+	s_tNow = platform::GetTimestamp();
+}
+
+void easy2d::Time::__beginFrame()
+{
+	if (s_tStep == 0)
+	{
+		// ÿ֡ģһΣģʱӸʵʱ
+		s_nPendingSteps = 1;
+		return;
+	}
+
+	if (!s_bRealTime)
+	{
+		// ͬʵʱʱÿֻ֡ģһ
+		s_nPendingSteps = 1;
+		s_tAccumulator = 0;
+		return;
+	}
+
+	s_tAccumulator += s_tNow - s_tLast;
+
+	long long steps = s_tAccumulator / s_tStep;
+	s_tAccumulator -= steps * s_tStep;
+
+	// ׷ϵĲʱʱ䣬ԽԽ
+	if (steps > s_nMaxSteps)
+	{
+		steps = s_nMaxSteps;
+	}
+	s_nPendingSteps = static_cast<int>(steps);
+}
+
+bool easy2d::Time::__step()
+{
+	if (s_nPendingSteps <= 0)
+		return false;
+
+	--s_nPendingSteps;
+
+	if (s_tStep == 0)
+	{
+		s_tSimDelta = s_tNow - s_tLast;
+		s_tSimTime = s_tNow - s_tStart;
+	}
+	else
+	{
+		s_tSimDelta = s_tStep;
+		s_tSimTime += s_tStep;
+	}
+	return true;
 }
 
 void easy2d::Time::__reset()
 {
-	s_tLast = s_tFixed = s_tNow = steady_clock::now();
+	s_tLast = s_tFixed = s_tNow = platform::GetTimestamp();
+	s_tAccumulator = 0;
 }
 
 void easy2d::Time::__sleep()
 {
 	// ʱ
-	int nWaitMS = 16 - static_cast<int>(duration_cast<milliseconds>(s_tNow - s_tFixed).count());
+	long long nWaitMS = (s_tExceptedInvertal - (s_tNow - s_tFixed)) / 1000;
 	
 	if (nWaitMS > 1)
 	{
 		// ̣߳ͷ CPU ռ
-		std::this_thread::sleep_for(milliseconds(nWaitMS));
+		E2D_PROFILE_SCOPE("Time::sleep");
+		platform::SleepFor(static_cast<unsigned int>(nWaitMS - 1));
 	}
 }
@@ -50,7 +50,29 @@ void easy2d::Color::_init(UINT rgb, float alpha)
 	a = float(alpha);
 }
 
+float easy2d::Color::getRed() const
+{
+	return r;
+}
+
+float easy2d::Color::getGreen() const
+{
+	return g;
+}
+
+float easy2d::Color::getBlue() const
+{
+	return b;
+}
+
+float easy2d::Color::getAlpha() const
+{
+	return a;
+}
+
+#ifndef E2D_HEADLESS
 D2D1_COLOR_F easy2d::Color::toD2DColorF() const
 {
 	return D2D1::ColorF(r, g, b, a);
 }
+#endif
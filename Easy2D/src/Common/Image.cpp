@@ -1,45 +1,456 @@
 #include <easy2d/e2dcommon.h>
 #include <easy2d/e2dbase.h>
 #include <easy2d/e2dtool.h>
+#include <easy2d/e2drender.h>
+#include <easy2d/e2dplatform.h>
 #include <map>
+#include <list>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 namespace
 {
-	std::map<size_t, ID2D1Bitmap*> s_mBitmapsFromFile;
-	std::map<int, ID2D1Bitmap*> s_mBitmapsFromResource;
+	// ļͼƬļʹ·Դʹƺ
+	struct CacheKey
+	{
+		bool fromResource;
+		int resNameId;
+		easy2d::String name;
+
+		bool operator< (const CacheKey& other) const
+		{
+			if (fromResource != other.fromResource) return fromResource < other.fromResource;
+			if (resNameId != other.resNameId) return resNameId < other.resNameId;
+			return name < other.name;
+		}
+	};
+
+	CacheKey MakeFileKey(const easy2d::String& filePath)
+	{
+		CacheKey key = { false, 0, filePath };
+		return key;
+	}
+
+	CacheKey MakeResourceKey(int resNameId, const easy2d::String& resType)
+	{
+		CacheKey key = { true, resNameId, resType };
+		return key;
+	}
+
+	struct CacheEntry
+	{
+		easy2d::Texture* texture;
+		size_t bytes;
+		std::list<CacheKey>::iterator recent;	// ʹбеλ
+	};
+
+	std::map<CacheKey, CacheEntry> s_mCache;
+	std::list<CacheKey> s_lRecentlyUsed;		// ʹõǰ
+	size_t s_nCacheBudget = 256 * 1024 * 1024;
+	size_t s_nCachedBytes = 0;
+	size_t s_nCacheHits = 0;
+	size_t s_nCacheMisses = 0;
+	size_t s_nCacheEvictions = 0;
+
+	// һΪʹ
+	easy2d::Texture* FindTexture(const CacheKey& key, bool countAccess)
+	{
+		auto iter = s_mCache.find(key);
+		if (iter == s_mCache.end())
+		{
+			if (countAccess) ++s_nCacheMisses;
+			return nullptr;
+		}
+
+		if (countAccess) ++s_nCacheHits;
+		s_lRecentlyUsed.splice(s_lRecentlyUsed.begin(), s_lRecentlyUsed, iter->second.recent);
+		return iter->second.texture;
+	}
+
+	// ̭ûбͼƬʹõֱڴԤ
+	// ʹõһŲᱻ̭֤ռصͼƬԱ
+	// δʹõһͷֱСԤ
+	// keepNewest Ϊ true ʱռ뻺
+	void TrimCache(size_t budget, bool keepNewest = true)
+	{
+		auto iter = s_lRecentlyUsed.end();
+		while (s_nCachedBytes > budget && iter != s_lRecentlyUsed.begin())
+		{
+			auto current = --iter;
+			if (keepNewest && current == s_lRecentlyUsed.begin())
+			{
+				break;
+			}
+
+			auto entry = s_mCache.find(*current);
+
+			// ֻлеͷ
+			if (entry->second.texture->getRefCount() <= 1)
+			{
+				++iter;
+				s_nCachedBytes -= entry->second.bytes;
+				++s_nCacheEvictions;
+				easy2d::GC::release(entry->second.texture);
+				s_mCache.erase(entry);
+				s_lRecentlyUsed.erase(current);
+			}
+		}
+	}
+
+	void AddTexture(const CacheKey& key, easy2d::Texture* texture)
+	{
+		s_lRecentlyUsed.push_front(key);
+
+		CacheEntry entry;
+		entry.texture = texture;
+		entry.bytes = static_cast<size_t>(texture->getWidth()) * static_cast<size_t>(texture->getHeight()) * 4;
+		entry.recent = s_lRecentlyUsed.begin();
+		s_mCache.insert(std::make_pair(key, entry));
+		s_nCachedBytes += entry.bytes;
+
+		TrimCache(s_nCacheBudget);
+	}
+
+	// ͼеͼƬ
+	struct AtlasRegion
+	{
+		easy2d::Texture* texture;
+		easy2d::Rect rect;
+	};
+	std::map<easy2d::String, AtlasRegion> s_mAtlasRegions;
+
+	// 첽󣬽ڹ߳ɣ߳
+	struct LoadRequest
+	{
+		easy2d::String filePath;		// ͼƬʱʹõ·Ҳǻļ
+		easy2d::String actualPath;		// ʵʵļ·
+		easy2d::Archive* archive;		// ͼƬԴΪʱԴжȡ
+		bool decoded;
+		int width;
+		int height;
+		std::vector<unsigned char> pixels;
+		std::vector<std::pair<easy2d::Image*, unsigned int>> images;	// ȴͼƬǵļرţ̷ֻ߳
+	};
+	typedef std::shared_ptr<LoadRequest> LoadRequestPtr;
+
+	std::map<easy2d::String, LoadRequestPtr> s_mLoadRequests;
+	std::deque<LoadRequestPtr> s_DecodeQueue;
+	std::deque<LoadRequestPtr> s_DecodedQueue;
+	std::mutex s_LoaderMutex;
+	std::condition_variable s_LoaderCondition;
+	std::vector<std::thread> s_vLoaderThreads;
+	bool s_bLoaderQuit = false;
+	long long s_nUploadBudget = 4000;		// ÿ֡ʱԤ㣨΢룩
+	unsigned int s_nLastLoadId = 0;
+
+	// ȡļ
+	bool ReadFileData(const easy2d::String& filePath, std::vector<unsigned char>& data)
+	{
+		FILE* file = easy2d::platform::OpenFile(filePath, "rb");
+		if (!file)
+		{
+			return false;
+		}
+
+		bool succeeded = ::fseek(file, 0, SEEK_END) == 0;
+		long size = succeeded ? ::ftell(file) : -1;
+		succeeded = size > 0 && ::fseek(file, 0, SEEK_SET) == 0;
+		if (succeeded)
+		{
+			data.resize(static_cast<size_t>(size));
+			succeeded = ::fread(data.data(), 1, data.size(), file) == data.size();
+		}
+		::fclose(file);
+		return succeeded;
+	}
+
+	void LoaderThread()
+	{
+		while (true)
+		{
+			LoadRequestPtr request;
+			{
+				std::unique_lock<std::mutex> lock(s_LoaderMutex);
+				s_LoaderCondition.wait(lock, []() { return s_bLoaderQuit || !s_DecodeQueue.empty(); });
+				if (s_bLoaderQuit)
+				{
+					return;
+				}
+				request = s_DecodeQueue.front();
+				s_DecodeQueue.pop_front();
+			}
+
+			// ֻʹýʽ̴߳
+			if (request->archive)
+			{
+				easy2d::Resource::Data data = request->archive->getData(request->filePath);
+				request->decoded = data.isValid()
+					&& easy2d::Image::decode(data.buffer, data.size, request->pixels, &request->width, &request->height);
+			}
+			else
+			{
+				std::vector<unsigned char> data;
+				request->decoded = ReadFileData(request->actualPath, data)
+					&& easy2d::Image::decode(data.data(), data.size(), request->pixels, &request->width, &request->height);
+			}
+
+			std::lock_guard<std::mutex> lock(s_LoaderMutex);
+			s_DecodedQueue.push_back(request);
+		}
+	}
+
+	// ͬһļĶϲҲļʱؿ
+	LoadRequestPtr RequestLoad(const easy2d::String& filePath)
+	{
+		auto iter = s_mLoadRequests.find(filePath);
+		if (iter != s_mLoadRequests.end())
+		{
+			return iter->second;
+		}
+
+		// ԴеͼƬֱӴӳڴн룬Դֱ
+		easy2d::Archive* archive = easy2d::Archive::search(filePath);
+		easy2d::String actualPath;
+		if (archive)
+		{
+			easy2d::GC::retain(archive);
+		}
+		else
+		{
+			actualPath = easy2d::Path::searchForFile(filePath);
+			if (actualPath.empty())
+			{
+				return nullptr;
+			}
+		}
+
+		LoadRequestPtr request = std::make_shared<LoadRequest>();
+		request->filePath = filePath;
+		request->actualPath = actualPath;
+		request->archive = archive;
+		request->decoded = false;
+		request->width = request->height = 0;
+		s_mLoadRequests.insert(std::make_pair(filePath, request));
+
+		// һʱ߳
+		if (s_vLoaderThreads.empty())
+		{
+			int threadCount = min(max(static_cast<int>(std::thread::hardware_concurrency()) / 2, 1), 4);
+			for (int i = 0; i < threadCount; ++i)
+			{
+				s_vLoaderThreads.push_back(std::thread(LoaderThread));
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_LoaderMutex);
+			s_DecodeQueue.push_back(request);
+		}
+		s_LoaderCondition.notify_one();
+		return request;
+	}
+
+#ifndef E2D_HEADLESS
+	//  WIC λͼΪ RGBA 
+	HRESULT DecodeWicSource(IWICBitmapSource* pSource, std::vector<BYTE>& pixels, UINT* pWidth, UINT* pHeight)
+	{
+		IWICFormatConverter *pConverter = nullptr;
+
+		// ͼƬʽת
+		HRESULT hr = easy2d::Renderer::getIWICImagingFactory()->CreateFormatConverter(&pConverter);
+
+		if (SUCCEEDED(hr))
+		{
+			// ͼƬʽת 32bppBGRA
+			hr = pConverter->Initialize(
+				pSource,
+				GUID_WICPixelFormat32bppBGRA,
+				WICBitmapDitherTypeNone,
+				nullptr,
+				0.f,
+				WICBitmapPaletteTypeMedianCut
+			);
+		}
+
+		UINT width = 0, height = 0;
+		if (SUCCEEDED(hr))
+		{
+			hr = pConverter->GetSize(&width, &height);
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			pixels.resize(static_cast<size_t>(width) * height * 4);
+			hr = pConverter->CopyPixels(nullptr, width * 4, static_cast<UINT>(pixels.size()), pixels.data());
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			// BGRA ת RGBA
+			for (size_t i = 0; i < pixels.size(); i += 4)
+			{
+				std::swap(pixels[i], pixels[i + 2]);
+			}
+			*pWidth = width;
+			*pHeight = height;
+		}
+
+		SafeRelease(pConverter);
+		return hr;
+	}
+
+	//  WIC λͼתΪǰȾ豸
+	easy2d::Texture* CreateTextureFromWicSource(IWICBitmapSource* pSource);
+#endif
+
+	// ڴеͼƬļ
+	easy2d::Texture* CreateTextureFromMemory(const void* data, size_t size)
+	{
+		auto device = easy2d::Renderer::getDevice();
+		if (!device)
+		{
+			return nullptr;
+		}
+
+		std::vector<unsigned char> pixels;
+		int width = 0, height = 0;
+		if (easy2d::Image::decode(data, size, pixels, &width, &height))
+		{
+			return device->createTexture(pixels.data(), width, height, width * 4);
+		}
+
+#ifdef E2D_HEADLESS
+		return nullptr;
+#else
+		// ýֵ֧ĸʽʹ WIC 
+		IWICBitmapDecoder *pDecoder = nullptr;
+		IWICBitmapFrameDecode *pSource = nullptr;
+		IWICStream *pStream = nullptr;
+		easy2d::Texture *pTexture = nullptr;
+
+		//  WIC 
+		HRESULT hr = easy2d::Renderer::getIWICImagingFactory()->CreateStream(&pStream);
+
+		if (SUCCEEDED(hr))
+		{
+			// ʼ
+			hr = pStream->InitializeFromMemory(
+				reinterpret_cast<BYTE*>(const_cast<void*>(data)),
+				static_cast<DWORD>(size)
+			);
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			// Ľ
+			hr = easy2d::Renderer::getIWICImagingFactory()->CreateDecoderFromStream(
+				pStream,
+				nullptr,
+				WICDecodeMetadataCacheOnLoad,
+				&pDecoder
+			);
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			// ʼ
+			hr = pDecoder->GetFrame(0, &pSource);
+		}
+
+		if (SUCCEEDED(hr))
+		{
+			// 
+			pTexture = CreateTextureFromWicSource(pSource);
+		}
+
+		// ͷԴ
+		SafeRelease(pDecoder);
+		SafeRelease(pSource);
+		SafeRelease(pStream);
+
+		return pTexture;
+#endif
+	}
+
+#ifndef E2D_HEADLESS
+	easy2d::Texture* CreateTextureFromWicSource(IWICBitmapSource* pSource)
+	{
+		auto device = easy2d::Renderer::getDevice();
+		if (!device)
+		{
+			return nullptr;
+		}
+
+		std::vector<BYTE> pixels;
+		UINT width = 0, height = 0;
+		if (FAILED(DecodeWicSource(pSource, pixels, &width, &height)))
+		{
+			return nullptr;
+		}
+		return device->createTexture(pixels.data(), int(width), int(height), int(width * 4));
+	}
+#endif
 }
 
 easy2d::Image::Image()
-	: _bitmap(nullptr)
-	, _cropRect()
+	: _cropRect()
+	, _sourceRect()
+	, _texture(nullptr)
+	, _state(State::Empty)
+	, _loadId(0)
 {
 }
 
+easy2d::Image::Image(Texture * texture)
+	: _cropRect()
+	, _sourceRect()
+	, _texture(nullptr)
+	, _state(State::Empty)
+	, _loadId(0)
+{
+	this->open(texture);
+}
+
 easy2d::Image::Image(const String& filePath)
-	: _bitmap(nullptr)
-	, _cropRect()
+	: _cropRect()
+	, _sourceRect()
+	, _texture(nullptr)
+	, _state(State::Empty)
+	, _loadId(0)
 {
 	this->open(filePath);
 }
 
 easy2d::Image::Image(int resNameId, const String& resType)
-	: _bitmap(nullptr)
-	, _cropRect()
+	: _cropRect()
+	, _sourceRect()
+	, _texture(nullptr)
+	, _state(State::Empty)
+	, _loadId(0)
 {
 	this->open(resNameId, resType);
 }
 
 easy2d::Image::Image(const String& filePath, const Rect& cropRect)
-	: _bitmap(nullptr)
-	, _cropRect()
+	: _cropRect()
+	, _sourceRect()
+	, _texture(nullptr)
+	, _state(State::Empty)
+	, _loadId(0)
 {
 	this->open(filePath);
 	this->crop(cropRect);
 }
 
 easy2d::Image::Image(int resNameId, const String& resType, const Rect& cropRect)
-	: _bitmap(nullptr)
-	, _cropRect()
+	: _cropRect()
+	, _sourceRect()
+	, _texture(nullptr)
+	, _state(State::Empty)
+	, _loadId(0)
 {
 	this->open(resNameId, resType);
 	this->crop(cropRect);
@@ -47,6 +458,7 @@ easy2d::Image::Image(int resNameId, const String& resType, const Rect& cropRect)
 
 easy2d::Image::~Image()
 {
+	GC::release(_texture);
 }
 
 bool easy2d::Image::open(const String& filePath)
@@ -56,13 +468,23 @@ bool easy2d::Image::open(const String& filePath)
 	if (filePath.empty())
 		return false;
 
+	// ʹͼе
+	auto region = s_mAtlasRegions.find(filePath);
+	if (region != s_mAtlasRegions.end())
+	{
+		this->_setTexture(region->second.texture, region->second.rect);
+		return true;
+	}
+
 	if (!Image::preload(filePath))
 	{
 		E2D_WARNING(L"Load Image from file failed!");
+		_loadId = 0;
+		_finishLoading(_texture ? State::Ready : State::Failed);
 		return false;
 	}
 
-	this->_setBitmap(s_mBitmapsFromFile.at(std::hash<String>{}(filePath)));
+	this->_setTexture(FindTexture(MakeFileKey(filePath), false));
 	return true;
 }
 
@@ -71,21 +493,99 @@ bool easy2d::Image::open(int resNameId, const String& resType)
 	if (!Image::preload(resNameId, resType))
 	{
 		E2D_WARNING(L"Load Image from file failed!");
+		_loadId = 0;
+		_finishLoading(_texture ? State::Ready : State::Failed);
+		return false;
+	}
+
+	this->_setTexture(FindTexture(MakeResourceKey(resNameId, resType), false));
+	return true;
+}
+
+bool easy2d::Image::open(Texture * texture)
+{
+	if (!texture)
+	{
+		E2D_WARNING(L"Image open failed! Invalid texture.");
 		return false;
 	}
 
-	this->_setBitmap(s_mBitmapsFromResource.at(resNameId));
+	this->_setTexture(texture);
+	return true;
+}
+
+bool easy2d::Image::openAsync(const String& filePath)
+{
+	if (filePath.empty())
+	{
+		E2D_WARNING(L"Image open failed! Invalid file name.");
+		return false;
+	}
+
+	// ѾعͼƬֱӴ
+	if (s_mAtlasRegions.find(filePath) != s_mAtlasRegions.end() ||
+		s_mCache.find(MakeFileKey(filePath)) != s_mCache.end())
+	{
+		return this->open(filePath);
+	}
+	++s_nCacheMisses;
+
+	LoadRequestPtr request = RequestLoad(filePath);
+	if (!request)
+	{
+		E2D_WARNING(L"Image open failed! File not found.");
+		_loadId = 0;
+		_finishLoading(_texture ? State::Ready : State::Failed);
+		return false;
+	}
+
+	GC::release(_texture);
+	_cropRect = _sourceRect = Rect();
+	_state = State::Loading;
+	_loadId = ++s_nLastLoadId;
+
+	// ؽǰͼƬ
+	this->retain();
+	request->images.push_back(std::make_pair(this, _loadId));
+
+	Renderer::invalidate();
 	return true;
 }
 
+easy2d::Image::State easy2d::Image::getState() const
+{
+	return _state;
+}
+
+void easy2d::Image::addLoadCallback(const LoadCallback& callback)
+{
+	if (!callback)
+		return;
+
+	if (_state == State::Loading)
+	{
+		_loadCallbacks.push_back(callback);
+	}
+	else
+	{
+		callback(this);
+	}
+}
+
 void easy2d::Image::crop(const Rect& cropRect)
 {
-	if (_bitmap)
+	if (_texture)
 	{
+		// üԴͼƬʱתΪ
 		_cropRect.origin.x = min(max(cropRect.origin.x, 0), this->getSourceWidth());
 		_cropRect.origin.y = min(max(cropRect.origin.y, 0), this->getSourceHeight());
 		_cropRect.size.width = min(max(cropRect.size.width, 0), this->getSourceWidth() - cropRect.origin.x);
 		_cropRect.size.height = min(max(cropRect.size.height, 0), this->getSourceHeight() - cropRect.origin.y);
+		_cropRect.origin.x += _sourceRect.origin.x;
+		_cropRect.origin.y += _sourceRect.origin.y;
+
+		// ͼƬܱ鹲Ҫ¼¼Ⱦ
+		Renderer::invalidate();
 	}
 }
 
@@ -106,77 +606,63 @@ easy2d::Size easy2d::Image::getSize() const
 
 float easy2d::Image::getSourceWidth() const
 {
-	if (_bitmap)
-	{
-		return _bitmap->GetSize().width;
-	}
-	else
-	{
-		return 0;
-	}
+	return _sourceRect.size.width;
 }
 
 float easy2d::Image::getSourceHeight() const
 {
-	if (_bitmap)
-	{
-		return _bitmap->GetSize().height;
-	}
-	else
-	{
-		return 0;
-	}
+	return _sourceRect.size.height;
 }
 
 easy2d::Size easy2d::Image::getSourceSize() const
 {
-	if (_bitmap)
-	{
-		return Size(getSourceWidth(), getSourceHeight());
-	}
-	else
-	{
-		return Size();
-	}
+	return _sourceRect.size;
 }
 
 float easy2d::Image::getCropX() const
 {
-	return _cropRect.origin.x;
+	return _cropRect.origin.x - _sourceRect.origin.x;
 }
 
 float easy2d::Image::getCropY() const
 {
-	return _cropRect.origin.y;
+	return _cropRect.origin.y - _sourceRect.origin.y;
 }
 
 easy2d::Point easy2d::Image::getCropPos() const
 {
-	return _cropRect.origin;
+	return Point(getCropX(), getCropY());
 }
 
 void easy2d::Image::draw(const Rect& destRect, float opacity) const
 {
-	if (_bitmap)
+	if (_texture)
 	{
-		// ĿκԴ
-		auto dest = D2D1::RectF(destRect.getLeft(), destRect.getTop(), destRect.getRight(), destRect.getBottom());
-		auto src = D2D1::RectF(_cropRect.getLeft(), _cropRect.getTop(), _cropRect.getRight(), _cropRect.getBottom());
 		// ȾͼƬ
-		Renderer::getRenderTarget()->DrawBitmap(
-			_bitmap,
-			dest,
-			opacity,
-			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
-			src
-		);
+		Renderer::getDevice()->drawTexture(_texture, destRect, _cropRect, opacity);
 	}
 }
 
 bool easy2d::Image::preload(const String& filePath)
 {
-	if (s_mBitmapsFromFile.find(std::hash<String>{}(filePath)) != s_mBitmapsFromFile.end())
+	if (s_mAtlasRegions.find(filePath) != s_mAtlasRegions.end() ||
+		FindTexture(MakeFileKey(filePath), true))
+	{
+		return true;
+	}
+
+	// ԴеͼƬֱӴӳڴн
+	Archive * archive = Archive::search(filePath);
+	if (archive)
 	{
+		Resource::Data data = archive->getData(filePath);
+		Texture *pTexture = data.isValid() ? CreateTextureFromMemory(data.buffer, data.size) : nullptr;
+		if (!pTexture)
+		{
+			return false;
+		}
+
+		AddTexture(MakeFileKey(filePath), pTexture);
 		return true;
 	}
 
@@ -186,13 +672,34 @@ bool easy2d::Image::preload(const String& filePath)
 		return false;
 	}
 
+#ifdef E2D_HEADLESS
+	auto device = Renderer::getDevice();
+	if (!device)
+	{
+		return false;
+	}
+
+	std::vector<unsigned char> pixels;
+	int width = 0, height = 0;
+	if (!Image::decode(filePath, pixels, &width, &height))
+	{
+		return false;
+	}
+
+	Texture *pTexture = device->createTexture(pixels.data(), width, height, width * 4);
+	if (!pTexture)
+	{
+		return false;
+	}
+
+	AddTexture(MakeFileKey(filePath), pTexture);
+	return true;
+#else
 	HRESULT hr = S_OK;
 
 	IWICBitmapDecoder *pDecoder = nullptr;
 	IWICBitmapFrameDecode *pSource = nullptr;
-	IWICStream *pStream = nullptr;
-	IWICFormatConverter *pConverter = nullptr;
-	ID2D1Bitmap *pBitmap = nullptr;
+	Texture *pTexture = nullptr;
 
 	// 
 	hr = Renderer::getIWICImagingFactory()->CreateDecoderFromFilename(
@@ -211,68 +718,39 @@ bool easy2d::Image::preload(const String& filePath)
 
 	if (SUCCEEDED(hr))
 	{
-		// ͼƬʽת
-		// (DXGI_FORMAT_B8G8R8A8_UNORM + D2D1_ALPHA_MODE_PREMULTIPLIED).
-		hr = Renderer::getIWICImagingFactory()->CreateFormatConverter(&pConverter);
-	}
-
-	if (SUCCEEDED(hr))
-	{
-		// ͼƬʽת 32bbpPBGRA
-		hr = pConverter->Initialize(
-			pSource,
-			GUID_WICPixelFormat32bppPBGRA,
-			WICBitmapDitherTypeNone,
-			nullptr,
-			0.f,
-			WICBitmapPaletteTypeMedianCut
-		);
-	}
-
-	if (SUCCEEDED(hr))
-	{
-		//  WIC λͼһ Direct2D λͼ
-		hr = Renderer::getRenderTarget()->CreateBitmapFromWicBitmap(
-			pConverter,
-			nullptr,
-			&pBitmap
-		);
+		// 
+		pTexture = CreateTextureFromWicSource(pSource);
+		hr = pTexture ? S_OK : E_FAIL;
 	}
 
 	if (SUCCEEDED(hr))
 	{
-		// ͼƬָͼƬ Hash 
-		s_mBitmapsFromFile.insert(
-			std::map<size_t, ID2D1Bitmap*>::value_type(
-				std::hash<String>{}(filePath),
-				pBitmap)
-		);
+		// ·Ϊ
+		AddTexture(MakeFileKey(filePath), pTexture);
 	}
 
 	// ͷԴ
 	SafeRelease(pDecoder);
 	SafeRelease(pSource);
-	SafeRelease(pStream);
-	SafeRelease(pConverter);
 
 	return SUCCEEDED(hr);
+#endif
 }
 
 bool easy2d::Image::preload(int resNameId, const String& resType)
 {
-	if (s_mBitmapsFromResource.find(resNameId) != s_mBitmapsFromResource.end())
+	if (FindTexture(MakeResourceKey(resNameId, resType), true))
 	{
 		return true;
 	}
 
+#ifdef E2D_HEADLESS
+	E2D_WARNING(L"Image::preload failed! Resources are not supported in headless build.");
+	return false;
+#else
 	HRESULT hr = S_OK;
 
-	IWICBitmapDecoder *pDecoder = nullptr;
-	IWICBitmapFrameDecode *pSource = nullptr;
-	IWICStream *pStream = nullptr;
-	IWICFormatConverter *pConverter = nullptr;
-	IWICBitmapScaler *pScaler = nullptr;
-	ID2D1Bitmap *pBitmap = nullptr;
+	Texture *pTexture = nullptr;
 
 	HRSRC imageResHandle = nullptr;
 	HGLOBAL imageResDataHandle = nullptr;
@@ -309,109 +787,344 @@ bool easy2d::Image::preload(int resNameId, const String& resType)
 
 	if (SUCCEEDED(hr))
 	{
-		//  WIC 
-		hr = Renderer::getIWICImagingFactory()->CreateStream(&pStream);
+		// 
+		pTexture = CreateTextureFromMemory(pImageFile, imageFileSize);
+		hr = pTexture ? S_OK : E_FAIL;
 	}
 
 	if (SUCCEEDED(hr))
 	{
-		// ʼ
-		hr = pStream->InitializeFromMemory(
-			reinterpret_cast<BYTE*>(pImageFile),
-			imageFileSize
-		);
+		AddTexture(MakeResourceKey(resNameId, resType), pTexture);
 	}
 
-	if (SUCCEEDED(hr))
+	return SUCCEEDED(hr);
+#endif
+}
+
+
+bool easy2d::Image::preload(const String& name, const Resource::Data& data)
+{
+	if (FindTexture(MakeFileKey(name), true))
 	{
-		// Ľ
-		hr = Renderer::getIWICImagingFactory()->CreateDecoderFromStream(
-			pStream,
-			nullptr,
-			WICDecodeMetadataCacheOnLoad,
-			&pDecoder
-		);
+		return true;
 	}
 
-	if (SUCCEEDED(hr))
+	if (!data.isValid())
 	{
-		// ʼ
-		hr = pDecoder->GetFrame(0, &pSource);
+		return false;
 	}
 
-	if (SUCCEEDED(hr))
+	Texture *pTexture = CreateTextureFromMemory(data.buffer, data.size);
+	if (!pTexture)
 	{
-		// ͼƬʽת
-		// (DXGI_FORMAT_B8G8R8A8_UNORM + D2D1_ALPHA_MODE_PREMULTIPLIED).
-		hr = Renderer::getIWICImagingFactory()->CreateFormatConverter(&pConverter);
+		return false;
+	}
+
+	AddTexture(MakeFileKey(name), pTexture);
+	return true;
+}
+
+void easy2d::Image::clearCache()
+{
+	for (auto entry : s_mCache)
+	{
+		GC::release(entry.second.texture);
+	}
+	s_mCache.clear();
+	s_lRecentlyUsed.clear();
+	s_nCachedBytes = 0;
+
+	for (auto region : s_mAtlasRegions)
+	{
+		GC::release(region.second.texture);
+	}
+	s_mAtlasRegions.clear();
+}
+
+bool easy2d::Image::decode(const String& filePath, std::vector<unsigned char>& pixels, int* width, int* height)
+{
+	Archive * archive = Archive::search(filePath);
+	if (archive)
+	{
+		Resource::Data data = archive->getData(filePath);
+		return data.isValid() && Image::decode(data.buffer, data.size, pixels, width, height);
 	}
 
+	String actualFilePath = Path::searchForFile(filePath);
+	if (actualFilePath.empty())
+	{
+		return false;
+	}
+
+#ifdef E2D_HEADLESS
+	std::vector<unsigned char> data;
+	if (!ReadFileData(actualFilePath, data))
+	{
+		return false;
+	}
+	return Image::decode(data.data(), data.size(), pixels, width, height);
+#else
+	IWICBitmapDecoder *pDecoder = nullptr;
+	IWICBitmapFrameDecode *pSource = nullptr;
+
+	// 
+	HRESULT hr = Renderer::getIWICImagingFactory()->CreateDecoderFromFilename(
+		actualFilePath.c_str(),
+		nullptr,
+		GENERIC_READ,
+		WICDecodeMetadataCacheOnLoad,
+		&pDecoder
+	);
+
 	if (SUCCEEDED(hr))
 	{
-		// ͼƬʽת 32bppPBGRA
-		hr = pConverter->Initialize(
-			pSource,
-			GUID_WICPixelFormat32bppPBGRA,
-			WICBitmapDitherTypeNone,
-			nullptr,
-			0.f,
-			WICBitmapPaletteTypeMedianCut
-		);
+		// ʼ
+		hr = pDecoder->GetFrame(0, &pSource);
 	}
 
+	UINT w = 0, h = 0;
 	if (SUCCEEDED(hr))
 	{
-		//  WIC λͼһ Direct2D λͼ
-		hr = Renderer::getRenderTarget()->CreateBitmapFromWicBitmap(
-			pConverter,
-			nullptr,
-			&pBitmap
-		);
+		hr = DecodeWicSource(pSource, pixels, &w, &h);
 	}
 
 	if (SUCCEEDED(hr))
 	{
-		s_mBitmapsFromResource.insert(std::pair<int, ID2D1Bitmap*>(resNameId, pBitmap));
+		*width = int(w);
+		*height = int(h);
 	}
 
-	// ͷԴ
 	SafeRelease(pDecoder);
 	SafeRelease(pSource);
-	SafeRelease(pStream);
-	SafeRelease(pConverter);
-	SafeRelease(pScaler);
 
 	return SUCCEEDED(hr);
+#endif
+}
+
+void easy2d::Image::_setTexture(Texture * texture)
+{
+	if (texture)
+	{
+		this->_setTexture(texture, Rect(0, 0, texture->getWidth(), texture->getHeight()));
+	}
 }
 
+void easy2d::Image::_setTexture(Texture * texture, const Rect& sourceRect)
+{
+	if (texture)
+	{
+		GC::retain(texture);
+		GC::release(_texture);
 
-void easy2d::Image::clearCache()
+		_texture = texture;
+		_sourceRect = sourceRect;
+		_cropRect = sourceRect;
+
+		// ֮ǰ첽زЧ
+		_loadId = 0;
+		_finishLoading(State::Ready);
+
+		Renderer::invalidate();
+	}
+}
+
+void easy2d::Image::_finishLoading(State state)
+{
+	_state = state;
+
+	std::vector<LoadCallback> callbacks;
+	callbacks.swap(_loadCallbacks);
+	for (const auto& callback : callbacks)
+	{
+		callback(this);
+	}
+}
+
+bool easy2d::Image::preloadAsync(const String& filePath)
+{
+	if (s_mAtlasRegions.find(filePath) != s_mAtlasRegions.end() ||
+		FindTexture(MakeFileKey(filePath), true))
+	{
+		return true;
+	}
+	return RequestLoad(filePath) != nullptr;
+}
+
+size_t easy2d::Image::getLoadingCount()
+{
+	return s_mLoadRequests.size();
+}
+
+void easy2d::Image::setUploadBudget(float seconds)
+{
+	s_nUploadBudget = static_cast<long long>(max(seconds, 0.f) * 1000000);
+}
+
+void easy2d::Image::setCacheBudget(size_t bytes)
+{
+	s_nCacheBudget = bytes;
+	TrimCache(s_nCacheBudget);
+}
+
+size_t easy2d::Image::getCacheBudget()
+{
+	return s_nCacheBudget;
+}
+
+easy2d::Image::CacheStats easy2d::Image::getCacheStats()
+{
+	CacheStats stats;
+	stats.hitCount = s_nCacheHits;
+	stats.missCount = s_nCacheMisses;
+	stats.evictionCount = s_nCacheEvictions;
+	stats.cachedCount = s_mCache.size();
+	stats.cachedBytes = s_nCachedBytes;
+	return stats;
+}
+
+void easy2d::Image::purgeCache()
+{
+	TrimCache(0, false);
+}
+
+void easy2d::Image::__update()
 {
-	for (auto bitmap : s_mBitmapsFromFile)
+	E2D_PROFILE_SCOPE("Image::update");
+
+	// һ֡ͷŵͼƬʹ泬Ԥ
+	TrimCache(s_nCacheBudget);
+
+	if (s_mLoadRequests.empty())
 	{
-		SafeRelease(bitmap.second);
+		return;
 	}
-	s_mBitmapsFromFile.clear();
 
-	for (auto bitmap : s_mBitmapsFromResource)
+	long long start = platform::GetTimestamp();
+	while (true)
 	{
-		SafeRelease(bitmap.second);
+		LoadRequestPtr request;
+		{
+			std::lock_guard<std::mutex> lock(s_LoaderMutex);
+			if (s_DecodedQueue.empty())
+			{
+				break;
+			}
+			request = s_DecodedQueue.front();
+			s_DecodedQueue.pop_front();
+		}
+		s_mLoadRequests.erase(request->filePath);
+		GC::release(request->archive);
+
+		// ͬһļѾͬ
+		const CacheKey key = MakeFileKey(request->filePath);
+		Texture * texture = FindTexture(key, false);
+		if (!texture && request->decoded)
+		{
+			auto device = Renderer::getDevice();
+			texture = device ? device->createTexture(request->pixels.data(), request->width, request->height, request->width * 4) : nullptr;
+			if (texture)
+			{
+				AddTexture(key, texture);
+			}
+		}
+#ifndef E2D_HEADLESS
+		else if (!texture && Image::preload(request->filePath))
+		{
+			// ýֵ֧ĸʽ߳ʹ WIC 
+			texture = FindTexture(key, false);
+		}
+#endif
+		std::vector<unsigned char>().swap(request->pixels);
+
+		if (!texture)
+		{
+			E2D_WARNING(L"Image::openAsync failed! Cannot decode the image file.");
+		}
+
+		for (const auto& waiting : request->images)
+		{
+			Image * image = waiting.first;
+			if (image->_loadId == waiting.second)
+			{
+				if (texture)
+				{
+					image->_setTexture(texture);
+				}
+				else
+				{
+					image->_loadId = 0;
+					image->_finishLoading(State::Failed);
+				}
+			}
+			image->release();
+		}
+
+		if (platform::GetTimestamp() - start >= s_nUploadBudget)
+		{
+			break;
+		}
 	}
-	s_mBitmapsFromResource.clear();
 }
 
-void easy2d::Image::_setBitmap(ID2D1Bitmap * bitmap)
+void easy2d::Image::__uninit()
 {
-	if (bitmap)
 	{
-		_bitmap = bitmap;
-		_cropRect.origin.x = _cropRect.origin.y = 0;
-		_cropRect.size.width = _bitmap->GetSize().width;
-		_cropRect.size.height = _bitmap->GetSize().height;
+		std::lock_guard<std::mutex> lock(s_LoaderMutex);
+		s_bLoaderQuit = true;
 	}
+	s_LoaderCondition.notify_all();
+	for (auto& thread : s_vLoaderThreads)
+	{
+		thread.join();
+	}
+	s_vLoaderThreads.clear();
+	s_bLoaderQuit = false;
+
+	s_DecodeQueue.clear();
+	s_DecodedQueue.clear();
+
+	// δɵļȫΪʧ
+	auto requests = std::move(s_mLoadRequests);
+	s_mLoadRequests.clear();
+	for (const auto& pair : requests)
+	{
+		GC::release(pair.second->archive);
+		for (const auto& waiting : pair.second->images)
+		{
+			Image * image = waiting.first;
+			if (image->_loadId == waiting.second)
+			{
+				image->_loadId = 0;
+				image->_finishLoading(State::Failed);
+			}
+			image->release();
+		}
+	}
+}
+
+void easy2d::Image::__addAtlasRegion(const String& name, Texture * texture, const Rect& sourceRect)
+{
+	auto iter = s_mAtlasRegions.find(name);
+	if (iter != s_mAtlasRegions.end())
+	{
+		GC::release(iter->second.texture);
+		s_mAtlasRegions.erase(iter);
+	}
+
+	AtlasRegion region = { texture, sourceRect };
+	GC::retain(region.texture);
+	s_mAtlasRegions.insert(std::make_pair(name, region));
+}
+
+easy2d::Texture * easy2d::Image::getTexture() const
+{
+	return _texture;
 }
 
+#ifndef E2D_HEADLESS
 ID2D1Bitmap * easy2d::Image::getBitmap()
 {
-	return _bitmap;
+	auto texture = dynamic_cast<D2DTexture*>(_texture);
+	return texture ? texture->getBitmap() : nullptr;
 }
+#endif
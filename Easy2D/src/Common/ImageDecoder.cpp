@@ -0,0 +1,976 @@
+#include <easy2d/e2dcommon.h>
+#include <cstring>
+
+// õ PNG  BMP κϵͳӿڣڹ߳ʹ
+
+namespace
+{
+	// ͼƬ߳
+	const int MAX_IMAGE_SIZE = 16384;
+
+	unsigned int ReadBE32(const unsigned char* p)
+	{
+		return (static_cast<unsigned int>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+	}
+
+	unsigned int ReadLE32(const unsigned char* p)
+	{
+		return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<unsigned int>(p[3]) << 24);
+	}
+
+	unsigned int ReadLE16(const unsigned char* p)
+	{
+		return p[0] | (p[1] << 8);
+	}
+
+	//
+	// Deflate ѹ
+	//
+
+	// λȡݣλǰ
+	struct BitReader
+	{
+		const unsigned char* data;
+		size_t size;
+		size_t pos;
+		unsigned int bitBuffer;
+		int bitCount;
+		bool error;
+
+		int bits(int count)
+		{
+			while (bitCount < count)
+			{
+				if (pos >= size)
+				{
+					error = true;
+					return 0;
+				}
+				bitBuffer |= static_cast<unsigned int>(data[pos++]) << bitCount;
+				bitCount += 8;
+			}
+			int value = static_cast<int>(bitBuffer & ((1u << count) - 1));
+			bitBuffer >>= count;
+			bitCount -= count;
+			return value;
+		}
+
+		// ڲԽǰ¾
+		void refill()
+		{
+			while (bitCount <= 24 && pos < size)
+			{
+				bitBuffer |= static_cast<unsigned int>(data[pos++]) << bitCount;
+				bitCount += 8;
+			}
+		}
+	};
+
+	// ʽ Huffman 
+	struct Huffman
+	{
+		static const int FAST_BITS = 9;
+
+		short count[16];			// ȵı
+		short symbol[288];			// ˳еķ
+		unsigned short fast[1 << FAST_BITS];	// ̱ĲұλΪţ 4 λΪ볤
+	};
+
+	int ReverseBits(int code, int length)
+	{
+		int result = 0;
+		for (int i = 0; i < length; ++i)
+		{
+			result = (result << 1) | (code & 1);
+			code >>= 1;
+		}
+		return result;
+	}
+
+	// ݱ볤ȹ Huffman 벻ʱȻ
+	bool BuildHuffman(Huffman& h, const unsigned char* lengths, int n)
+	{
+		::memset(h.count, 0, sizeof(h.count));
+		::memset(h.fast, 0, sizeof(h.fast));
+
+		for (int i = 0; i < n; ++i)
+		{
+			++h.count[lengths[i]];
+		}
+		if (h.count[0] == n)
+		{
+			return true;
+		}
+
+		// Ƿ񳬶
+		int left = 1;
+		for (int len = 1; len < 16; ++len)
+		{
+			left <<= 1;
+			left -= h.count[len];
+			if (left < 0)
+			{
+				return false;
+			}
+		}
+
+		short offsets[16];
+		int nextCode[16];
+		offsets[1] = 0;
+		nextCode[1] = 0;
+		for (int len = 1; len < 15; ++len)
+		{
+			offsets[len + 1] = offsets[len] + h.count[len];
+			nextCode[len + 1] = (nextCode[len] + h.count[len]) << 1;
+		}
+
+		for (int i = 0; i < n; ++i)
+		{
+			int len = lengths[i];
+			if (len == 0)
+				continue;
+
+			h.symbol[offsets[len]++] = static_cast<short>(i);
+
+			int code = nextCode[len]++;
+			if (len <= Huffman::FAST_BITS)
+			{
+				// еıλǰʱҪת
+				int reversed = ReverseBits(code, len);
+				for (int j = reversed; j < (1 << Huffman::FAST_BITS); j += (1 << len))
+				{
+					h.fast[j] = static_cast<unsigned short>((i << 4) | len);
+				}
+			}
+		}
+		return true;
+	}
+
+	int DecodeSymbol(BitReader& br, const Huffman& h)
+	{
+		br.refill();
+		if (br.bitCount >= Huffman::FAST_BITS)
+		{
+			unsigned short entry = h.fast[br.bitBuffer & ((1 << Huffman::FAST_BITS) - 1)];
+			if (entry)
+			{
+				int len = entry & 15;
+				br.bitBuffer >>= len;
+				br.bitCount -= len;
+				return entry >> 4;
+			}
+		}
+
+		// ĩβʱλ
+		int code = 0, first = 0, index = 0;
+		for (int len = 1; len < 16; ++len)
+		{
+			code |= br.bits(1);
+			if (br.error)
+			{
+				return -1;
+			}
+
+			int count = h.count[len];
+			if (code - count < first)
+			{
+				return h.symbol[index + (code - first)];
+			}
+			index += count;
+			first += count;
+			first <<= 1;
+			code <<= 1;
+		}
+		return -1;
+	}
+
+	const short LENGTH_BASE[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const short LENGTH_EXTRA[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const short DIST_BASE[30] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+		8193, 12289, 16385, 24577 };
+	const short DIST_EXTRA[30] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	bool InflateBlock(BitReader& br, std::vector<unsigned char>& out, const Huffman& lengthCode, const Huffman& distCode)
+	{
+		while (true)
+		{
+			int symbol = DecodeSymbol(br, lengthCode);
+			if (symbol < 0)
+			{
+				return false;
+			}
+
+			if (symbol < 256)
+			{
+				out.push_back(static_cast<unsigned char>(symbol));
+			}
+			else if (symbol == 256)
+			{
+				return true;
+			}
+			else
+			{
+				symbol -= 257;
+				if (symbol >= 29)
+				{
+					return false;
+				}
+				size_t length = LENGTH_BASE[symbol] + br.bits(LENGTH_EXTRA[symbol]);
+
+				symbol = DecodeSymbol(br, distCode);
+				if (symbol < 0 || symbol >= 30)
+				{
+					return false;
+				}
+				size_t distance = DIST_BASE[symbol] + br.bits(DIST_EXTRA[symbol]);
+				if (br.error || distance > out.size())
+				{
+					return false;
+				}
+
+				// ƵصҪֽڸ
+				size_t from = out.size() - distance;
+				size_t to = out.size();
+				out.resize(to + length);
+				unsigned char* dest = &out[0];
+				for (size_t i = 0; i < length; ++i)
+				{
+					dest[to + i] = dest[from + i];
+				}
+			}
+		}
+	}
+
+	// ̶ Huffman ھ̬ʼʱֻ߳ȡ
+	struct FixedHuffman
+	{
+		Huffman lengthCode;
+		Huffman distCode;
+
+		FixedHuffman()
+		{
+			unsigned char lengths[288];
+			int i = 0;
+			for (; i < 144; ++i) lengths[i] = 8;
+			for (; i < 256; ++i) lengths[i] = 9;
+			for (; i < 280; ++i) lengths[i] = 7;
+			for (; i < 288; ++i) lengths[i] = 8;
+			BuildHuffman(lengthCode, lengths, 288);
+
+			for (i = 0; i < 30; ++i) lengths[i] = 5;
+			BuildHuffman(distCode, lengths, 30);
+		}
+	};
+	const FixedHuffman s_FixedHuffman;
+
+	bool InflateFixed(BitReader& br, std::vector<unsigned char>& out)
+	{
+		return InflateBlock(br, out, s_FixedHuffman.lengthCode, s_FixedHuffman.distCode);
+	}
+
+	bool InflateDynamic(BitReader& br, std::vector<unsigned char>& out)
+	{
+		static const unsigned char ORDER[19] = {
+			16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+		int nlen = br.bits(5) + 257;
+		int ndist = br.bits(5) + 1;
+		int ncode = br.bits(4) + 4;
+		if (br.error || nlen > 286 || ndist > 30)
+		{
+			return false;
+		}
+
+		unsigned char lengths[320] = { 0 };
+		for (int i = 0; i < ncode; ++i)
+		{
+			lengths[ORDER[i]] = static_cast<unsigned char>(br.bits(3));
+		}
+
+		Huffman lengthCode, distCode;
+		if (!BuildHuffman(lengthCode, lengths, 19))
+		{
+			return false;
+		}
+
+		int index = 0;
+		while (index < nlen + ndist)
+		{
+			int symbol = DecodeSymbol(br, lengthCode);
+			if (symbol < 0)
+			{
+				return false;
+			}
+
+			if (symbol < 16)
+			{
+				lengths[index++] = static_cast<unsigned char>(symbol);
+				continue;
+			}
+
+			unsigned char value = 0;
+			int repeat = 0;
+			if (symbol == 16)
+			{
+				if (index == 0)
+				{
+					return false;
+				}
+				value = lengths[index - 1];
+				repeat = 3 + br.bits(2);
+			}
+			else if (symbol == 17)
+			{
+				repeat = 3 + br.bits(3);
+			}
+			else
+			{
+				repeat = 11 + br.bits(7);
+			}
+
+			if (br.error || index + repeat > nlen + ndist)
+			{
+				return false;
+			}
+			while (repeat--)
+			{
+				lengths[index++] = value;
+			}
+		}
+
+		// п
+		if (lengths[256] == 0)
+		{
+			return false;
+		}
+
+		if (!BuildHuffman(lengthCode, lengths, nlen) || !BuildHuffman(distCode, lengths + nlen, ndist))
+		{
+			return false;
+		}
+		return InflateBlock(br, out, lengthCode, distCode);
+	}
+
+	// ѹ zlib 
+	bool Inflate(const unsigned char* data, size_t size, std::vector<unsigned char>& out)
+	{
+		if (size < 2 || (data[0] & 0x0F) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20))
+		{
+			return false;
+		}
+
+		BitReader br = { data, size, 2, 0, 0, false };
+		int last = 0;
+		do
+		{
+			last = br.bits(1);
+			int type = br.bits(2);
+			if (br.error)
+			{
+				return false;
+			}
+
+			bool succeeded = false;
+			if (type == 0)
+			{
+				// δѹĿֽڱ߽翪ʼ˻ػδʹõֽ
+				br.pos -= br.bitCount / 8;
+				br.bitBuffer = 0;
+				br.bitCount = 0;
+				if (br.pos + 4 > br.size)
+				{
+					return false;
+				}
+				unsigned int len = ReadLE16(br.data + br.pos);
+				unsigned int nlen = ReadLE16(br.data + br.pos + 2);
+				br.pos += 4;
+				if (len != (~nlen & 0xFFFF) || br.pos + len > br.size)
+				{
+					return false;
+				}
+				out.insert(out.end(), br.data + br.pos, br.data + br.pos + len);
+				br.pos += len;
+				succeeded = true;
+			}
+			else if (type == 1)
+			{
+				succeeded = InflateFixed(br, out);
+			}
+			else if (type == 2)
+			{
+				succeeded = InflateDynamic(br, out);
+			}
+
+			if (!succeeded)
+			{
+				return false;
+			}
+		} while (!last);
+		return true;
+	}
+
+	//
+	// PNG
+	//
+
+	const unsigned char PNG_SIGNATURE[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+	int PaethPredictor(int a, int b, int c)
+	{
+		int p = a + b - c;
+		int pa = p > a ? p - a : a - p;
+		int pb = p > b ? p - b : b - p;
+		int pc = p > c ? p - c : c - p;
+		if (pa <= pb && pa <= pc) return a;
+		if (pb <= pc) return b;
+		return c;
+	}
+
+	// ԭһеĹˣprev ΪһУһʱΪգ
+	bool Unfilter(int filter, unsigned char* row, const unsigned char* prev, size_t rowBytes, size_t bpp)
+	{
+		switch (filter)
+		{
+		case 0:
+			break;
+		case 1:
+			for (size_t i = bpp; i < rowBytes; ++i)
+				row[i] = static_cast<unsigned char>(row[i] + row[i - bpp]);
+			break;
+		case 2:
+			if (prev)
+				for (size_t i = 0; i < rowBytes; ++i)
+					row[i] = static_cast<unsigned char>(row[i] + prev[i]);
+			break;
+		case 3:
+			for (size_t i = 0; i < rowBytes; ++i)
+			{
+				int left = i >= bpp ? row[i - bpp] : 0;
+				int up = prev ? prev[i] : 0;
+				row[i] = static_cast<unsigned char>(row[i] + ((left + up) >> 1));
+			}
+			break;
+		case 4:
+			for (size_t i = 0; i < rowBytes; ++i)
+			{
+				int left = i >= bpp ? row[i - bpp] : 0;
+				int up = prev ? prev[i] : 0;
+				int upLeft = (prev && i >= bpp) ? prev[i - bpp] : 0;
+				row[i] = static_cast<unsigned char>(row[i] + PaethPredictor(left, up, upLeft));
+			}
+			break;
+		default:
+			return false;
+		}
+		return true;
+	}
+
+	// ȡһе index ԭʼֵ
+	unsigned int ReadSample(const unsigned char* row, size_t index, int depth)
+	{
+		switch (depth)
+		{
+		case 16:
+			return (row[index * 2] << 8) | row[index * 2 + 1];
+		case 8:
+			return row[index];
+		default:
+		{
+			size_t bit = index * depth;
+			int shift = 8 - depth - static_cast<int>(bit & 7);
+			return (row[bit >> 3] >> shift) & ((1 << depth) - 1);
+		}
+		}
+	}
+
+	// Ѳֵŵ 8 λ
+	unsigned char ScaleSample(unsigned int value, int depth)
+	{
+		if (depth == 16) return static_cast<unsigned char>(value >> 8);
+		if (depth == 8) return static_cast<unsigned char>(value);
+		return static_cast<unsigned char>(value * 255 / ((1 << depth) - 1));
+	}
+
+	struct PngInfo
+	{
+		int width;
+		int height;
+		int depth;
+		int colorType;
+		int channels;
+		bool interlaced;
+		unsigned char palette[256][4];
+		int paletteSize;
+		bool hasColorKey;
+		unsigned int colorKey[3];
+	};
+
+	// ѽ˺һתΪ RGBA
+	void ConvertRow(const PngInfo& info, const unsigned char* row, int count, unsigned char* pixels, int x0, int y, int xStep)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			unsigned char* dest = pixels + (static_cast<size_t>(y) * info.width + x0 + i * xStep) * 4;
+			switch (info.colorType)
+			{
+			case 0:
+			{
+				unsigned int gray = ReadSample(row, i, info.depth);
+				dest[0] = dest[1] = dest[2] = ScaleSample(gray, info.depth);
+				dest[3] = (info.hasColorKey && gray == info.colorKey[0]) ? 0 : 255;
+				break;
+			}
+			case 2:
+			{
+				unsigned int r = ReadSample(row, i * 3, info.depth);
+				unsigned int g = ReadSample(row, i * 3 + 1, info.depth);
+				unsigned int b = ReadSample(row, i * 3 + 2, info.depth);
+				dest[0] = ScaleSample(r, info.depth);
+				dest[1] = ScaleSample(g, info.depth);
+				dest[2] = ScaleSample(b, info.depth);
+				dest[3] = (info.hasColorKey && r == info.colorKey[0] && g == info.colorKey[1] && b == info.colorKey[2]) ? 0 : 255;
+				break;
+			}
+			case 3:
+			{
+				unsigned int index = ReadSample(row, i, info.depth);
+				if (static_cast<int>(index) < info.paletteSize)
+				{
+					::memcpy(dest, info.palette[index], 4);
+				}
+				else
+				{
+					dest[0] = dest[1] = dest[2] = 0;
+					dest[3] = 255;
+				}
+				break;
+			}
+			case 4:
+				dest[0] = dest[1] = dest[2] = ScaleSample(ReadSample(row, i * 2, info.depth), info.depth);
+				dest[3] = ScaleSample(ReadSample(row, i * 2 + 1, info.depth), info.depth);
+				break;
+			case 6:
+				dest[0] = ScaleSample(ReadSample(row, i * 4, info.depth), info.depth);
+				dest[1] = ScaleSample(ReadSample(row, i * 4 + 1, info.depth), info.depth);
+				dest[2] = ScaleSample(ReadSample(row, i * 4 + 2, info.depth), info.depth);
+				dest[3] = ScaleSample(ReadSample(row, i * 4 + 3, info.depth), info.depth);
+				break;
+			}
+		}
+	}
+
+	bool DecodePng(const unsigned char* data, size_t size, std::vector<unsigned char>& pixels, int* width, int* height)
+	{
+		PngInfo info;
+		::memset(&info, 0, sizeof(info));
+
+		std::vector<unsigned char> compressed;
+		bool hasHeader = false;
+
+		size_t pos = 8;
+		while (pos + 12 <= size)
+		{
+			unsigned int length = ReadBE32(data + pos);
+			const unsigned char* type = data + pos + 4;
+			const unsigned char* chunk = data + pos + 8;
+			if (length > size - pos - 12)
+			{
+				return false;
+			}
+
+			if (::memcmp(type, "IHDR", 4) == 0)
+			{
+				if (length < 13)
+				{
+					return false;
+				}
+				info.width = static_cast<int>(ReadBE32(chunk));
+				info.height = static_cast<int>(ReadBE32(chunk + 4));
+				info.depth = chunk[8];
+				info.colorType = chunk[9];
+				info.interlaced = chunk[12] == 1;
+				if (chunk[10] != 0 || chunk[11] != 0 || chunk[12] > 1)
+				{
+					return false;
+				}
+				hasHeader = true;
+			}
+			else if (::memcmp(type, "PLTE", 4) == 0)
+			{
+				info.paletteSize = min(static_cast<int>(length / 3), 256);
+				for (int i = 0; i < info.paletteSize; ++i)
+				{
+					info.palette[i][0] = chunk[i * 3];
+					info.palette[i][1] = chunk[i * 3 + 1];
+					info.palette[i][2] = chunk[i * 3 + 2];
+					info.palette[i][3] = 255;
+				}
+			}
+			else if (::memcmp(type, "tRNS", 4) == 0)
+			{
+				if (info.colorType == 3)
+				{
+					for (unsigned int i = 0; i < length && i < 256; ++i)
+					{
+						info.palette[i][3] = chunk[i];
+					}
+				}
+				else if (info.colorType == 0 && length >= 2)
+				{
+					info.hasColorKey = true;
+					info.colorKey[0] = (chunk[0] << 8) | chunk[1];
+				}
+				else if (info.colorType == 2 && length >= 6)
+				{
+					info.hasColorKey = true;
+					for (int i = 0; i < 3; ++i)
+					{
+						info.colorKey[i] = (chunk[i * 2] << 8) | chunk[i * 2 + 1];
+					}
+				}
+			}
+			else if (::memcmp(type, "IDAT", 4) == 0)
+			{
+				compressed.insert(compressed.end(), chunk, chunk + length);
+			}
+			else if (::memcmp(type, "IEND", 4) == 0)
+			{
+				break;
+			}
+			pos += length + 12;
+		}
+
+		if (!hasHeader || compressed.empty() ||
+			info.width <= 0 || info.height <= 0 ||
+			info.width > MAX_IMAGE_SIZE || info.height > MAX_IMAGE_SIZE)
+		{
+			return false;
+		}
+
+		// ɫλ
+		switch (info.colorType)
+		{
+		case 0: info.channels = 1; break;
+		case 2: info.channels = 3; break;
+		case 3: info.channels = 1; break;
+		case 4: info.channels = 2; break;
+		case 6: info.channels = 4; break;
+		default: return false;
+		}
+
+		int depth = info.depth;
+		bool validDepth = (depth == 8 || depth == 16)
+			|| (info.colorType == 0 && (depth == 1 || depth == 2 || depth == 4))
+			|| (info.colorType == 3 && (depth == 1 || depth == 2 || depth == 4));
+		if (!validDepth || (info.colorType == 3 && (depth == 16 || info.paletteSize == 0)))
+		{
+			return false;
+		}
+
+		// ÿصֽһֽʱһֽڼ
+		const size_t bpp = max(static_cast<size_t>(info.channels * depth / 8), static_cast<size_t>(1));
+
+		static const int ADAM7[7][4] = {
+			{ 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 },
+			{ 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 } };
+		static const int NO_INTERLACE[1][4] = { { 0, 0, 1, 1 } };
+
+		const int passCount = info.interlaced ? 7 : 1;
+		const int (*passes)[4] = info.interlaced ? ADAM7 : NO_INTERLACE;
+
+		// ԤȼѹĴС
+		size_t expected = 0;
+		for (int p = 0; p < passCount; ++p)
+		{
+			int pw = (info.width - passes[p][0] + passes[p][2] - 1) / passes[p][2];
+			int ph = (info.height - passes[p][1] + passes[p][3] - 1) / passes[p][3];
+			if (pw > 0 && ph > 0)
+			{
+				expected += (1 + (static_cast<size_t>(pw) * info.channels * depth + 7) / 8) * ph;
+			}
+		}
+
+		std::vector<unsigned char> raw;
+		raw.reserve(expected);
+		if (!Inflate(compressed.data(), compressed.size(), raw) || raw.size() < expected)
+		{
+			return false;
+		}
+
+		pixels.assign(static_cast<size_t>(info.width) * info.height * 4, 0);
+
+		unsigned char* cursor = raw.data();
+		for (int p = 0; p < passCount; ++p)
+		{
+			int pw = (info.width - passes[p][0] + passes[p][2] - 1) / passes[p][2];
+			int ph = (info.height - passes[p][1] + passes[p][3] - 1) / passes[p][3];
+			if (pw <= 0 || ph <= 0)
+				continue;
+
+			const size_t rowBytes = (static_cast<size_t>(pw) * info.channels * depth + 7) / 8;
+			const unsigned char* prev = nullptr;
+			for (int y = 0; y < ph; ++y)
+			{
+				int filter = cursor[0];
+				unsigned char* row = cursor + 1;
+				if (!Unfilter(filter, row, prev, rowBytes, bpp))
+				{
+					return false;
+				}
+				ConvertRow(info, row, pw, pixels.data(), passes[p][0], passes[p][1] + y * passes[p][3], passes[p][2]);
+				prev = row;
+				cursor += rowBytes + 1;
+			}
+		}
+
+		*width = info.width;
+		*height = info.height;
+		return true;
+	}
+
+	//
+	// BMP
+	//
+
+	// ȡɫŵ 8 λ
+	unsigned char ExtractMasked(unsigned int value, unsigned int mask)
+	{
+		if (mask == 0)
+		{
+			return 0;
+		}
+
+		int shift = 0;
+		while (!((mask >> shift) & 1))
+		{
+			++shift;
+		}
+		unsigned int maxValue = mask >> shift;
+		return static_cast<unsigned char>(((value & mask) >> shift) * 255 / maxValue);
+	}
+
+	bool DecodeBmp(const unsigned char* data, size_t size, std::vector<unsigned char>& pixels, int* width, int* height)
+	{
+		if (size < 26)
+		{
+			return false;
+		}
+
+		const unsigned int dataOffset = ReadLE32(data + 10);
+		const unsigned int headerSize = ReadLE32(data + 14);
+		if (headerSize < 12 || 14 + static_cast<size_t>(headerSize) > size)
+		{
+			return false;
+		}
+
+		int w = 0, h = 0, bitCount = 0;
+		unsigned int compression = 0, colorsUsed = 0;
+		size_t paletteEntrySize = 4;
+		if (headerSize == 12)
+		{
+			// OS/2 λͼͷ
+			w = static_cast<int>(ReadLE16(data + 18));
+			h = static_cast<int>(ReadLE16(data + 20));
+			bitCount = static_cast<int>(ReadLE16(data + 24));
+			paletteEntrySize = 3;
+		}
+		else
+		{
+			if (headerSize < 40)
+			{
+				return false;
+			}
+			w = static_cast<int>(ReadLE32(data + 18));
+			h = static_cast<int>(ReadLE32(data + 22));
+			bitCount = static_cast<int>(ReadLE16(data + 28));
+			compression = ReadLE32(data + 30);
+			colorsUsed = ReadLE32(data + 46);
+		}
+
+		// ߶Ϊʱ´洢
+		bool topDown = h < 0;
+		if (topDown)
+		{
+			h = -h;
+		}
+
+		if (w <= 0 || h <= 0 || w > MAX_IMAGE_SIZE || h > MAX_IMAGE_SIZE)
+		{
+			return false;
+		}
+
+		// ֻ֧ѹλʽ
+		unsigned int masks[4] = { 0 };
+		if (compression == 3 || compression == 6)
+		{
+			if (bitCount != 16 && bitCount != 32)
+			{
+				return false;
+			}
+			int maskCount = (compression == 6 || headerSize >= 56) ? 4 : 3;
+			if (14 + 40 + static_cast<size_t>(maskCount) * 4 > size)
+			{
+				return false;
+			}
+			for (int i = 0; i < maskCount; ++i)
+			{
+				masks[i] = ReadLE32(data + 54 + i * 4);
+			}
+		}
+		else if (compression == 0)
+		{
+			if (bitCount == 16)
+			{
+				masks[0] = 0x7C00;
+				masks[1] = 0x03E0;
+				masks[2] = 0x001F;
+			}
+		}
+		else
+		{
+			return false;
+		}
+
+		if (bitCount != 1 && bitCount != 4 && bitCount != 8 && bitCount != 16 && bitCount != 24 && bitCount != 32)
+		{
+			return false;
+		}
+
+		// ȡɫ
+		unsigned char palette[256][4] = { { 0 } };
+		int paletteSize = 0;
+		if (bitCount <= 8)
+		{
+			paletteSize = (colorsUsed > 0 && colorsUsed <= 256u) ? static_cast<int>(colorsUsed) : (1 << bitCount);
+			size_t paletteOffset = 14 + headerSize + ((compression == 3) ? 12 : 0);
+			if (paletteOffset + paletteSize * paletteEntrySize > size)
+			{
+				return false;
+			}
+			for (int i = 0; i < paletteSize; ++i)
+			{
+				const unsigned char* entry = data + paletteOffset + i * paletteEntrySize;
+				palette[i][0] = entry[2];
+				palette[i][1] = entry[1];
+				palette[i][2] = entry[0];
+				palette[i][3] = 255;
+			}
+		}
+
+		const size_t stride = ((static_cast<size_t>(w) * bitCount + 31) / 32) * 4;
+		if (dataOffset > size || stride * h > size - dataOffset)
+		{
+			return false;
+		}
+
+		pixels.assign(static_cast<size_t>(w) * h * 4, 0);
+
+		// 32 λѹʽ alpha ͨû壬ȫΪʱΪ͸
+		bool hasAlpha = (bitCount == 32 && (compression == 0 || masks[3] != 0));
+		bool anyAlpha = false;
+
+		for (int y = 0; y < h; ++y)
+		{
+			const unsigned char* src = data + dataOffset + stride * (topDown ? y : h - 1 - y);
+			unsigned char* dest = &pixels[static_cast<size_t>(y) * w * 4];
+
+			for (int x = 0; x < w; ++x, dest += 4)
+			{
+				switch (bitCount)
+				{
+				case 1:
+				case 4:
+				case 8:
+				{
+					int index = static_cast<int>(ReadSample(src, x, bitCount));
+					if (index < paletteSize)
+					{
+						::memcpy(dest, palette[index], 4);
+					}
+					else
+					{
+						dest[3] = 255;
+					}
+					break;
+				}
+				case 16:
+				{
+					unsigned int value = ReadLE16(src + x * 2);
+					dest[0] = ExtractMasked(value, masks[0]);
+					dest[1] = ExtractMasked(value, masks[1]);
+					dest[2] = ExtractMasked(value, masks[2]);
+					dest[3] = masks[3] ? ExtractMasked(value, masks[3]) : 255;
+					break;
+				}
+				case 24:
+					dest[0] = src[x * 3 + 2];
+					dest[1] = src[x * 3 + 1];
+					dest[2] = src[x * 3];
+					dest[3] = 255;
+					break;
+				case 32:
+				{
+					const unsigned char* p = src + x * 4;
+					if (compression == 0)
+					{
+						dest[0] = p[2];
+						dest[1] = p[1];
+						dest[2] = p[0];
+						dest[3] = p[3];
+					}
+					else
+					{
+						unsigned int value = ReadLE32(p);
+						dest[0] = ExtractMasked(value, masks[0]);
+						dest[1] = ExtractMasked(value, masks[1]);
+						dest[2] = ExtractMasked(value, masks[2]);
+						dest[3] = masks[3] ? ExtractMasked(value, masks[3]) : 255;
+					}
+					anyAlpha = anyAlpha || dest[3] != 0;
+					break;
+				}
+				}
+			}
+		}
+
+		if (hasAlpha && !anyAlpha)
+		{
+			for (size_t i = 3; i < pixels.size(); i += 4)
+			{
+				pixels[i] = 255;
+			}
+		}
+
+		*width = w;
+		*height = h;
+		return true;
+	}
+}
+
+bool easy2d::Image::decode(const void* data, size_t size, std::vector<unsigned char>& pixels, int* width, int* height)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	if (!bytes || size < 8)
+	{
+		return false;
+	}
+
+	if (::memcmp(bytes, PNG_SIGNATURE, 8) == 0)
+	{
+		return DecodePng(bytes, size, pixels, width, height);
+	}
+
+	if (bytes[0] == 'B' && bytes[1] == 'M')
+	{
+		return DecodeBmp(bytes, size, pixels, width, height);
+	}
+	return false;
+}
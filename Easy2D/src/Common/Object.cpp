@@ -4,12 +4,16 @@
 
 easy2d::Object::Object()
 	: _refCount(1)
+	, _gcGeneration(0)
+	, _temporary(false)
 {
 	// ʱü 1
+	GC::__onCreated();
 }
 
 easy2d::Object::~Object()
 {
+	GC::__onDestroyed();
 }
 
 void easy2d::Object::autorelease()
@@ -35,7 +39,14 @@ void easy2d::Object::release()
 			E2D_ERROR(L"ͷüΪ 0 Ķʱ GC ");
 		}
 #endif
-		delete this;
+		if (_temporary)
+		{
+			GC::__destroyTemporary(this);
+		}
+		else
+		{
+			delete this;
+		}
 	}
 }
 
@@ -26,6 +26,9 @@ easy2d::Resource::Resource(int id, const String& type)
 
 easy2d::Resource::Data easy2d::Resource::loadData() const
 {
+#ifdef E2D_HEADLESS
+    E2D_WARNING(L"Resource::loadData failed! Resources are not supported in headless build.");
+#else
     do
     {
         if (_data.buffer && _data.size)
@@ -64,6 +67,7 @@ easy2d::Resource::Data easy2d::Resource::loadData() const
         _data.buffer = static_cast<void*>(buffer);
         _data.size = static_cast<int>(size);
     } while (0);
+#endif
 
     return _data;
 }
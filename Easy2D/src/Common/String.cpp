@@ -1,19 +1,35 @@
 #include <easy2d/e2dcommon.h>
+#include <easy2d/e2dplatform.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cwchar>
 
 easy2d::ByteString easy2d::FormatString(const char* format, ...)
 {
     easy2d::ByteString result;
     if (format)
     {
-        va_list args = nullptr;
+        va_list args;
         va_start(args, format);
 
+#ifdef _MSC_VER
         const auto len = static_cast<size_t>(::_vscprintf(format, args) + 1);
         if (len)
         {
             result.resize(len - 1);
             ::_vsnprintf_s(&result[0], len, len, format, args);
         }
+#else
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        const int len = ::vsnprintf(nullptr, 0, format, argsCopy);
+        va_end(argsCopy);
+        if (len > 0)
+        {
+            result.resize(static_cast<size_t>(len));
+            ::vsnprintf(&result[0], static_cast<size_t>(len) + 1, format, args);
+        }
+#endif
         va_end(args);
     }
     return result;
@@ -24,15 +40,39 @@ easy2d::String easy2d::FormatString(const wchar_t* format, ...)
     easy2d::String result;
     if (format)
     {
-        va_list args = nullptr;
+        va_list args;
         va_start(args, format);
 
+#ifdef _MSC_VER
         const auto len = static_cast<size_t>(::_vscwprintf(format, args) + 1);
         if (len)
         {
             result.resize(len - 1);
             ::_vsnwprintf_s(&result[0], len, len, format, args);
         }
+#else
+        // vswprintf ޷Ԥȼ㳤ȣʱ
+        for (size_t capacity = 256; ; capacity *= 2)
+        {
+            result.resize(capacity);
+
+            va_list argsCopy;
+            va_copy(argsCopy, args);
+            const int len = ::vswprintf(&result[0], capacity, format, argsCopy);
+            va_end(argsCopy);
+
+            if (len >= 0)
+            {
+                result.resize(static_cast<size_t>(len));
+                break;
+            }
+            if (capacity >= 1024 * 1024)
+            {
+                result.clear();
+                break;
+            }
+        }
+#endif
         va_end(args);
     }
     return result;
@@ -40,36 +80,98 @@ easy2d::String easy2d::FormatString(const wchar_t* format, ...)
 
 easy2d::ByteString easy2d::WideToNarrow(const easy2d::String& str)
 {
-    if (str.empty())
-        return easy2d::ByteString();
+    return easy2d::platform::WideToNarrow(str);
+}
 
-    int num = ::WideCharToMultiByte(CP_ACP, 0, str.c_str(), -1, NULL, 0, NULL, NULL);
-    if (num > 0)
+easy2d::String easy2d::NarrowToWide(const easy2d::ByteString& str)
+{
+    return easy2d::platform::NarrowToWide(str);
+}
+
+easy2d::ByteString easy2d::WideToUtf8(const easy2d::String& str)
+{
+    easy2d::ByteString result;
+    result.reserve(str.size());
+
+    for (size_t i = 0; i < str.size(); ++i)
     {
-        easy2d::ByteString result;
-        result.resize(num - 1);
+        unsigned long ch = static_cast<unsigned long>(str[i]);
 
-        // C++11 ַ֤ǿսβ
-        ::WideCharToMultiByte(CP_ACP, 0, str.c_str(), -1, &result[0], num, NULL, NULL);
-        return result;
+        // wchar_t Ϊ 16 λʱҪϲ
+        if (sizeof(wchar_t) == 2 && ch >= 0xD800 && ch <= 0xDBFF && i + 1 < str.size())
+        {
+            unsigned long low = static_cast<unsigned long>(str[i + 1]);
+            if (low >= 0xDC00 && low <= 0xDFFF)
+            {
+                ch = 0x10000 + ((ch - 0xD800) << 10) + (low - 0xDC00);
+                ++i;
+            }
+        }
+
+        if (ch < 0x80)
+        {
+            result.push_back(static_cast<char>(ch));
+        }
+        else if (ch < 0x800)
+        {
+            result.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+            result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+        }
+        else if (ch < 0x10000)
+        {
+            result.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+        }
+        else
+        {
+            result.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+        }
     }
-    return easy2d::ByteString();
+    return result;
 }
 
-easy2d::String easy2d::NarrowToWide(const easy2d::ByteString& str)
+easy2d::String easy2d::Utf8ToWide(const char* str, size_t size)
 {
-    if (str.empty())
-        return easy2d::String();
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(str);
+
+    easy2d::String result;
+    result.reserve(size);
 
-    int num = ::MultiByteToWideChar(CP_ACP, 0, str.c_str(), -1, NULL, 0);
-    if (num > 0)
+    size_t i = 0;
+    while (i < size)
     {
-        easy2d::String result;
-        result.resize(num - 1);
+        unsigned long ch = data[i];
+        size_t extra = 0;
+        if (ch >= 0xF0) { ch &= 0x07; extra = 3; }
+        else if (ch >= 0xE0) { ch &= 0x0F; extra = 2; }
+        else if (ch >= 0xC0) { ch &= 0x1F; extra = 1; }
+        else if (ch >= 0x80) { ch = 0xFFFD; }
 
-        // C++11 ַ֤ǿսβ
-        ::MultiByteToWideChar(CP_ACP, 0, str.c_str(), -1, &result[0], num);
-        return result;
+        ++i;
+        for (size_t j = 0; j < extra; ++j, ++i)
+        {
+            if (i >= size || (data[i] & 0xC0) != 0x80)
+            {
+                ch = 0xFFFD;
+                break;
+            }
+            ch = (ch << 6) | (data[i] & 0x3F);
+        }
+
+        if (sizeof(wchar_t) == 2 && ch >= 0x10000)
+        {
+            ch -= 0x10000;
+            result.push_back(static_cast<wchar_t>(0xD800 + (ch >> 10)));
+            result.push_back(static_cast<wchar_t>(0xDC00 + (ch & 0x3FF)));
+        }
+        else
+        {
+            result.push_back(static_cast<wchar_t>(ch));
+        }
     }
-    return easy2d::String();
+    return result;
 }
@@ -2,24 +2,41 @@
 #include <easy2d/e2daction.h>
 #include <easy2d/e2dnode.h>
 
-static std::vector<easy2d::Action*> s_vActions;
+namespace
+{
+	const size_t NO_INDEX = static_cast<size_t>(-1);
+
+	// еĶƳʱĩβĶλ
+	std::vector<easy2d::Action*> s_vActions;
+
+	// ڸ¶ʱƳĶֻ󶨣½ͳһ
+	bool s_bUpdating = false;
+}
 
 
 void easy2d::ActionManager::__update()
 {
+	E2D_PROFILE_SCOPE("ActionManager::update");
+
 	if (s_vActions.empty() || Game::isPaused())
 		return;
 
 	// ѭеĶ
+	// Ļص¶ÿζ»ȡ
+	s_bUpdating = true;
 	for (size_t i = 0; i < s_vActions.size(); ++i)
 	{
 		auto action = s_vActions[i];
+		if (action->_target == nullptr)
+		{
+			// ڱθбƳ
+			continue;
+		}
+
 		// ȡ״̬
 		if (action->_isDone())
 		{
-			action->release();
-			action->_target = nullptr;
-			s_vActions.erase(s_vActions.begin() + i);
+			ActionManager::__remove(action);
 		}
 		else
 		{
@@ -30,44 +47,133 @@ void easy2d::ActionManager::__update()
 			}
 		}
 	}
+	s_bUpdating = false;
+
+	// һԻձθƳĶද˳
+	size_t count = 0;
+	for (size_t i = 0; i < s_vActions.size(); ++i)
+	{
+		auto action = s_vActions[i];
+		if (action->_target == nullptr)
+		{
+			action->_index = NO_INDEX;
+			action->release();
+		}
+		else
+		{
+			action->_index = count;
+			s_vActions[count++] = action;
+		}
+	}
+	s_vActions.resize(count);
+}
+
+void easy2d::ActionManager::__remove(Action * action)
+{
+	// ӽڵĶƳ
+	if (action->_prevBinded)
+	{
+		action->_prevBinded->_nextBinded = action->_nextBinded;
+	}
+	else
+	{
+		action->_target->_actions = action->_nextBinded;
+	}
+
+	if (action->_nextBinded)
+	{
+		action->_nextBinded->_prevBinded = action->_prevBinded;
+	}
+
+	action->_prevBinded = nullptr;
+	action->_nextBinded = nullptr;
+	action->_target = nullptr;
+
+	if (s_bUpdating)
+	{
+		return;
+	}
+
+	// ĩβĶλ
+	size_t index = action->_index;
+	Action * last = s_vActions.back();
+	s_vActions[index] = last;
+	last->_index = index;
+	s_vActions.pop_back();
+
+	action->_index = NO_INDEX;
+	action->release();
 }
 
 void easy2d::ActionManager::__resumeAllBindedWith(Node * target)
 {
-	if (s_vActions.empty() || target == nullptr)
+	if (target == nullptr)
 		return;
 
-	for (auto action : s_vActions)
+	for (auto action = target->_actions; action; action = action->_nextBinded)
 	{
-		if (action->getTarget() == target)
+		action->resume();
+	}
+}
+
+void easy2d::ActionManager::__pauseAllBindedWith(Node * target)
+{
+	if (target == nullptr)
+		return;
+
+	for (auto action = target->_actions; action; action = action->_nextBinded)
+	{
+		action->pause();
+	}
+}
+
+void easy2d::ActionManager::__stopAllBindedWith(Node * target)
+{
+	if (target == nullptr)
+		return;
+
+	for (auto action = target->_actions; action; action = action->_nextBinded)
+	{
+		action->stop();
+	}
+}
+
+void easy2d::ActionManager::__resumeBindedWith(Node * target, const String& name)
+{
+	if (target == nullptr || name.empty())
+		return;
+
+	for (auto action = target->_actions; action; action = action->_nextBinded)
+	{
+		if (action->getName() == name)
 		{
 			action->resume();
 		}
 	}
 }
 
-void easy2d::ActionManager::__pauseAllBindedWith(Node * target)
+void easy2d::ActionManager::__pauseBindedWith(Node * target, const String& name)
 {
-	if (s_vActions.empty() || target == nullptr)
+	if (target == nullptr || name.empty())
 		return;
 
-	for (auto action : s_vActions)
+	for (auto action = target->_actions; action; action = action->_nextBinded)
 	{
-		if (action->getTarget() == target)
+		if (action->getName() == name)
 		{
 			action->pause();
 		}
 	}
 }
 
-void easy2d::ActionManager::__stopAllBindedWith(Node * target)
+void easy2d::ActionManager::__stopBindedWith(Node * target, const String& name)
 {
-	if (s_vActions.empty() || target == nullptr)
+	if (target == nullptr || name.empty())
 		return;
 
-	for (auto action : s_vActions)
+	for (auto action = target->_actions; action; action = action->_nextBinded)
 	{
-		if (action->getTarget() == target)
+		if (action->getName() == name)
 		{
 			action->stop();
 		}
@@ -83,12 +189,23 @@ void easy2d::ActionManager::start(Action * action, Node * target, bool paused)
 	{
 		if (action->_target == nullptr)
 		{
-			auto iter = std::find(s_vActions.begin(), s_vActions.end(), action);
-			if (iter == s_vActions.end())
+			action->_startWithTarget(target);
+			action->_running = !paused;
+
+			// ڵĶ
+			action->_prevBinded = nullptr;
+			action->_nextBinded = target->_actions;
+			if (target->_actions)
+			{
+				target->_actions->_prevBinded = action;
+			}
+			target->_actions = action;
+
+			// θиձƳĶУֱӸԭλ
+			if (action->_index == NO_INDEX)
 			{
-				action->_startWithTarget(target);
 				action->retain();
-				action->_running = !paused;
+				action->_index = s_vActions.size();
 				s_vActions.push_back(action);
 			}
 		}
@@ -145,18 +262,9 @@ void easy2d::ActionManager::__clearAllBindedWith(Node * target)
 {
 	if (target)
 	{
-		for (size_t i = 0; i < s_vActions.size();)
+		while (target->_actions)
 		{
-			auto a = s_vActions[i];
-			if (a->getTarget() == target)
-			{
-				GC::release(a);
-				s_vActions.erase(s_vActions.begin() + i);
-			}
-			else
-			{
-				++i;
-			}
+			ActionManager::__remove(target->_actions);
 		}
 	}
 }
@@ -165,6 +273,14 @@ void easy2d::ActionManager::__uninit()
 {
 	for (auto action : s_vActions)
 	{
+		if (action->_target)
+		{
+			action->_target->_actions = nullptr;
+		}
+		action->_prevBinded = nullptr;
+		action->_nextBinded = nullptr;
+		action->_target = nullptr;
+		action->_index = NO_INDEX;
 		GC::release(action);
 	}
 	s_vActions.clear();
@@ -175,7 +291,7 @@ std::vector<easy2d::Action*> easy2d::ActionManager::get(const String& name)
 	std::vector<Action*> actions;
 	for (auto action : s_vActions)
 	{
-		if (action->getName() == name)
+		if (action->_target && action->getName() == name)
 		{
 			actions.push_back(action);
 		}
@@ -102,6 +102,8 @@ void easy2d::SceneManager::dispatch(Event* evt)
 
 void easy2d::SceneManager::__update()
 {
+	E2D_PROFILE_SCOPE("SceneManager::update");
+
 	if (s_pTransition == nullptr)
 	{
 		// ³
@@ -109,6 +111,9 @@ void easy2d::SceneManager::__update()
 		{
 			s_pCurrScene->_update();
 		}
+
+		// ִвиڼƳٵĲ
+		Node::__flushDeferred();
 	}
 	else
 	{
@@ -152,6 +157,9 @@ void easy2d::SceneManager::__update()
 
 void easy2d::SceneManager::__render()
 {
+	// Ⱦǰͳһнڵ
+	Node::__updateTransforms();
+
 	if (s_pTransition)
 	{
 		s_pTransition->_render();
@@ -161,11 +169,17 @@ void easy2d::SceneManager::__render()
 		// Ƶǰ
 		if (s_pCurrScene)
 		{
-			s_pCurrScene->_render();
+			s_pCurrScene->_renderView();
 		}
 	}
 }
 
+bool easy2d::SceneManager::__isDirty()
+{
+	// תÿһ֡ı仭
+	return s_pTransition || !s_pCurrScene || s_pCurrScene->_dirtyContent;
+}
+
 bool easy2d::SceneManager::__init()
 {
 	// ϷʼʱΪգó
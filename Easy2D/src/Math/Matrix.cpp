@@ -19,11 +19,6 @@ easy2d::Matrix32::Matrix32(Matrix32 const& other)
 {
 }
 
-float easy2d::Matrix32::operator [](unsigned int index) const
-{
-	return m[index];
-}
-
 void easy2d::Matrix32::identity()
 {
 	_11 = 1.f; _12 = 0.f;
@@ -41,15 +36,20 @@ easy2d::Vector2 easy2d::Matrix32::transform(const Vector2& v) const
 
 easy2d::Rect easy2d::Matrix32::transform(const Rect& rect) const
 {
-	Vector2 top_left = transform(rect.getLeftTop());
-	Vector2 top_right = transform(rect.getRightTop());
-	Vector2 bottom_left = transform(rect.getLeftBottom());
-	Vector2 bottom_right = transform(rect.getRightBottom());
+	// 任ľԱ任ԭΪƽı
+	// ÿֻΪı߻СֵΪıֵҪֱ任ĸ
+	const float x = rect.origin.x, y = rect.origin.y;
+	const float w = rect.size.width, h = rect.size.height;
+
+	const float ox = x * _11 + y * _21 + _31;
+	const float oy = x * _12 + y * _22 + _32;
+	const float ax = w * _11, ay = w * _12;
+	const float bx = h * _21, by = h * _22;
 
-	float left = min(min(top_left.x, top_right.x), min(bottom_left.x, bottom_right.x));
-	float right = max(max(top_left.x, top_right.x), max(bottom_left.x, bottom_right.x));
-	float top = min(min(top_left.y, top_right.y), min(bottom_left.y, bottom_right.y));
-	float bottom = max(max(top_left.y, top_right.y), max(bottom_left.y, bottom_right.y));
+	const float left = ox + min(ax, 0.f) + min(bx, 0.f);
+	const float top = oy + min(ay, 0.f) + min(by, 0.f);
+	const float right = ox + max(ax, 0.f) + max(bx, 0.f);
+	const float bottom = oy + max(ay, 0.f) + max(by, 0.f);
 
 	return Rect{ left, top, (right - left), (bottom - top) };
 }
@@ -82,16 +82,18 @@ bool easy2d::Matrix32::isInvertible() const
 	return 0 != determinant();
 }
 
+#ifndef E2D_HEADLESS
 D2D1::Matrix3x2F const& easy2d::Matrix32::toD2DMatrix() const
 {
 	return reinterpret_cast<D2D1::Matrix3x2F const&>(*this);
 }
+#endif
 
 easy2d::Matrix32 easy2d::Matrix32::translation(
 	float x,
 	float y)
 {
-	return easy2d::Matrix32::Matrix32(
+	return easy2d::Matrix32(
 		1.f, 0.f,
 		0.f, 1.f,
 		x, y
@@ -103,7 +105,7 @@ easy2d::Matrix32 easy2d::Matrix32::scaling(
 	float y,
 	const Point& center)
 {
-	return easy2d::Matrix32::Matrix32(
+	return easy2d::Matrix32(
 		x, 0.f,
 		0.f, y,
 		center.x - x * center.x,
@@ -115,9 +117,9 @@ easy2d::Matrix32 easy2d::Matrix32::rotation(
 	float angle,
 	const Point& center)
 {
-	float s = math::Sin(angle);
-	float c = math::Cos(angle);
-	return easy2d::Matrix32::Matrix32(
+	float s, c;
+	math::FastSinCos(angle, s, c);
+	return easy2d::Matrix32(
 		c, s,
 		-s, c,
 		center.x * (1 - c) + center.y * s,
@@ -130,9 +132,9 @@ easy2d::Matrix32 easy2d::Matrix32::skewing(
 	float angle_y,
 	const Point& center)
 {
-	float tx = math::Tan(angle_x);
-	float ty = math::Tan(angle_y);
-	return easy2d::Matrix32::Matrix32(
+	float tx = math::FastTan(angle_x);
+	float ty = math::FastTan(angle_y);
+	return easy2d::Matrix32(
 		1.f, -ty,
 		-tx, 1.f,
 		center.y * tx, center.x * ty
@@ -143,7 +145,7 @@ easy2d::Matrix32 easy2d::Matrix32::invert(Matrix32 const& matrix)
 {
 	float det = 1.f / matrix.determinant();
 
-	return easy2d::Matrix32::Matrix32(
+	return easy2d::Matrix32(
 		det * matrix._22,
 		-det * matrix._12,
 		-det * matrix._21,
@@ -0,0 +1,477 @@
+#include <easy2d/e2dmath.h>
+
+// 
+// 󡢵;ζԭеڴ沼ţSIMD ʵֻʹ 128 λͨڵţ
+// AVX һδΡĸ㣬SSE2 һδһΡ
+// ʵֵļ˳ʵͬϲ˼ӣFMAʱλһ
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#	define E2D_MATRIX_X86
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#		define E2D_TARGET_SSE2
+#		define E2D_TARGET_AVX
+#	else
+#		define E2D_TARGET_SSE2 __attribute__((target("sse2")))
+#		define E2D_TARGET_AVX __attribute__((target("avx")))
+#	endif
+#	include <immintrin.h>
+#endif
+
+namespace
+{
+	using easy2d::Matrix32;
+	using easy2d::Vector2;
+	using easy2d::Rect;
+
+	static_assert(sizeof(Matrix32) == sizeof(float) * 6, "Matrix32 must be tightly packed");
+	static_assert(sizeof(Vector2) == sizeof(float) * 2, "Vector2 must be tightly packed");
+	static_assert(sizeof(Rect) == sizeof(float) * 4, "Rect must be tightly packed");
+
+	// rhsStep Ϊ 0 ʱо󶼳ͬһҾ
+	typedef void(*MultiplyKernel)(const Matrix32* lhs, const Matrix32* rhs, size_t rhsStep, Matrix32* out, size_t count);
+	typedef void(*InvertKernel)(const Matrix32* matrices, Matrix32* out, size_t count);
+	typedef void(*TransformPointsKernel)(const Matrix32& matrix, const Vector2* points, Vector2* out, size_t count);
+	typedef void(*TransformRectsKernel)(const Matrix32* matrices, const Rect* rects, Rect* out, size_t count);
+
+	struct Kernels
+	{
+		const char* name;
+		MultiplyKernel multiply;
+		InvertKernel invert;
+		TransformPointsKernel transformPoints;
+		TransformRectsKernel transformRects;
+	};
+
+	//
+	// ʵ
+	//
+
+	inline void MultiplyOne(const float* l, const float* r, float* o)
+	{
+		const float m0 = l[0] * r[0] + l[1] * r[2];
+		const float m1 = l[0] * r[1] + l[1] * r[3];
+		const float m2 = l[2] * r[0] + l[3] * r[2];
+		const float m3 = l[2] * r[1] + l[3] * r[3];
+		const float m4 = l[4] * r[0] + l[5] * r[2] + r[4];
+		const float m5 = l[4] * r[1] + l[5] * r[3] + r[5];
+		o[0] = m0; o[1] = m1; o[2] = m2; o[3] = m3; o[4] = m4; o[5] = m5;
+	}
+
+	inline void InvertOne(const float* m, float* o)
+	{
+		const float det = 1.f / (m[0] * m[3] - m[1] * m[2]);
+		const float m0 = det * m[3];
+		const float m1 = -det * m[1];
+		const float m2 = -det * m[2];
+		const float m3 = det * m[0];
+		const float m4 = det * (m[2] * m[5] - m[3] * m[4]);
+		const float m5 = det * (m[1] * m[4] - m[0] * m[5]);
+		o[0] = m0; o[1] = m1; o[2] = m2; o[3] = m3; o[4] = m4; o[5] = m5;
+	}
+
+	inline void TransformPointOne(const float* m, const float* p, float* o)
+	{
+		const float x = p[0] * m[0] + p[1] * m[2] + m[4];
+		const float y = p[0] * m[1] + p[1] * m[3] + m[5];
+		o[0] = x; o[1] = y;
+	}
+
+	inline void TransformRectOne(const float* m, const float* r, float* o)
+	{
+		const Rect rect = reinterpret_cast<const Matrix32*>(m)->transform(*reinterpret_cast<const Rect*>(r));
+		o[0] = rect.origin.x; o[1] = rect.origin.y; o[2] = rect.size.width; o[3] = rect.size.height;
+	}
+
+	void MultiplyScalar(const Matrix32* lhs, const Matrix32* rhs, size_t rhsStep, Matrix32* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			MultiplyOne(lhs[i].m, rhs[i * rhsStep].m, out[i].m);
+		}
+	}
+
+	void InvertScalar(const Matrix32* matrices, Matrix32* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			InvertOne(matrices[i].m, out[i].m);
+		}
+	}
+
+	void TransformPointsScalar(const Matrix32& matrix, const Vector2* points, Vector2* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			TransformPointOne(matrix.m, &points[i].x, &out[i].x);
+		}
+	}
+
+	void TransformRectsScalar(const Matrix32* matrices, const Rect* rects, Rect* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			TransformRectOne(matrices[i].m, &rects[i].origin.x, &out[i].origin.x);
+		}
+	}
+
+#ifdef E2D_MATRIX_X86
+
+	//
+	// SSE2 ʵ
+	//
+
+	E2D_TARGET_SSE2 inline __m128 LoadPair(const float* p)
+	{
+		return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+	}
+
+	E2D_TARGET_SSE2 inline void StorePair(float* p, __m128 v)
+	{
+		_mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+	}
+
+	E2D_TARGET_SSE2 void MultiplySse2(const Matrix32* lhs, const Matrix32* rhs, size_t rhsStep, Matrix32* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float* r = rhs[i * rhsStep].m;
+			const __m128 r4 = _mm_loadu_ps(r);
+			const __m128 r01 = _mm_movelh_ps(r4, r4);	// r0 r1 r0 r1
+			const __m128 r23 = _mm_movehl_ps(r4, r4);	// r2 r3 r2 r3
+			const __m128 rt = LoadPair(r + 4);
+
+			const __m128 l4 = _mm_loadu_ps(lhs[i].m);
+			const __m128 lt = LoadPair(lhs[i].m + 4);
+			const __m128 lx = _mm_shuffle_ps(l4, l4, _MM_SHUFFLE(2, 2, 0, 0));
+			const __m128 ly = _mm_shuffle_ps(l4, l4, _MM_SHUFFLE(3, 3, 1, 1));
+			const __m128 tx = _mm_shuffle_ps(lt, lt, _MM_SHUFFLE(0, 0, 0, 0));
+			const __m128 ty = _mm_shuffle_ps(lt, lt, _MM_SHUFFLE(1, 1, 1, 1));
+
+			const __m128 top = _mm_add_ps(_mm_mul_ps(lx, r01), _mm_mul_ps(ly, r23));
+			const __m128 bottom = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, r01), _mm_mul_ps(ty, r23)), rt);
+
+			_mm_storeu_ps(out[i].m, top);
+			StorePair(out[i].m + 4, bottom);
+		}
+	}
+
+	// Ĺ֣a b c d  q Уe f  t ĵλ
+	// ص top ΪǰĸԪأbottom ĵλΪԪ
+	//  SSE2  AVX йãPS Ϊָǰ׺
+#define E2D_INVERT_BODY(PS, VEC, q, t, top, bottom)												\
+	{																							\
+		const VEC qs = PS##_shuffle_ps(q, q, _MM_SHUFFLE(0, 1, 2, 3));		/* d c b a */		\
+		const VEC prod = PS##_mul_ps(q, qs);								/* ad bc cb da */	\
+		const VEC det = PS##_sub_ps(														\
+			PS##_shuffle_ps(prod, prod, _MM_SHUFFLE(0, 0, 0, 0)),							\
+			PS##_shuffle_ps(prod, prod, _MM_SHUFFLE(1, 1, 1, 1)));							\
+		const VEC inv = PS##_div_ps(PS##_set1_ps(1.f), det);									\
+		const VEC sign = PS##_setr_ps(E2D_INVERT_SIGN);										\
+		const VEC swapped = PS##_shuffle_ps(q, q, _MM_SHUFFLE(0, 2, 1, 3));	/* d b c a */		\
+		top = PS##_mul_ps(PS##_xor_ps(inv, sign), swapped);										\
+		const VEC cb = PS##_shuffle_ps(q, q, _MM_SHUFFLE(1, 2, 1, 2));		/* c b */			\
+		const VEC da = PS##_shuffle_ps(q, q, _MM_SHUFFLE(0, 3, 0, 3));		/* d a */			\
+		const VEC fe = PS##_shuffle_ps(t, t, _MM_SHUFFLE(0, 1, 0, 1));		/* f e */			\
+		bottom = PS##_mul_ps(inv, PS##_sub_ps(PS##_mul_ps(cb, fe), PS##_mul_ps(da, t)));		\
+	}
+
+	E2D_TARGET_SSE2 void InvertSse2(const Matrix32* matrices, Matrix32* out, size_t count)
+	{
+#define E2D_INVERT_SIGN 0.f, -0.f, -0.f, 0.f
+		for (size_t i = 0; i < count; ++i)
+		{
+			const __m128 q = _mm_loadu_ps(matrices[i].m);
+			const __m128 t = LoadPair(matrices[i].m + 4);
+			__m128 top, bottom;
+			E2D_INVERT_BODY(_mm, __m128, q, t, top, bottom);
+			_mm_storeu_ps(out[i].m, top);
+			StorePair(out[i].m + 4, bottom);
+		}
+#undef E2D_INVERT_SIGN
+	}
+
+	E2D_TARGET_SSE2 void TransformPointsSse2(const Matrix32& matrix, const Vector2* points, Vector2* out, size_t count)
+	{
+		const __m128 m4 = _mm_loadu_ps(matrix.m);
+		const __m128 m01 = _mm_movelh_ps(m4, m4);
+		const __m128 m23 = _mm_movehl_ps(m4, m4);
+		const __m128 mt = _mm_movelh_ps(LoadPair(matrix.m + 4), LoadPair(matrix.m + 4));
+
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2)
+		{
+			const __m128 p = _mm_loadu_ps(&points[i].x);
+			const __m128 px = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+			const __m128 py = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+			_mm_storeu_ps(&out[i].x, _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, m01), _mm_mul_ps(py, m23)), mt));
+		}
+
+		for (; i < count; ++i)
+		{
+			TransformPointOne(matrix.m, &points[i].x, &out[i].x);
+		}
+	}
+
+	// 任εĹ֣r Ϊ x y w hq Ϊ a b c dt ĵλΪ e f
+#define E2D_TRANSFORM_RECT_BODY(PS, VEC, q, t, r, result)										\
+	{																							\
+		const VEC m01 = PS##_shuffle_ps(q, q, _MM_SHUFFLE(1, 0, 1, 0));	/* a b a b */		\
+		const VEC m23 = PS##_shuffle_ps(q, q, _MM_SHUFFLE(3, 2, 3, 2));	/* c d c d */		\
+		const VEC xw = PS##_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 0, 0));		/* x x w w */		\
+		const VEC yh = PS##_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 1, 1));		/* y y h h */		\
+		const VEC v1 = PS##_mul_ps(xw, m01);								/* xa xb wa wb */	\
+		const VEC v2 = PS##_mul_ps(yh, m23);								/* yc yd hc hd */	\
+		const VEC o = PS##_add_ps(PS##_add_ps(v1, v2), t);									\
+		const VEC ea = PS##_shuffle_ps(v1, v1, _MM_SHUFFLE(3, 2, 3, 2));	/* wa wb */			\
+		const VEC eb = PS##_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 2, 3, 2));	/* hc hd */			\
+		const VEC zero = PS##_setzero_ps();													\
+		const VEC lo = PS##_add_ps(PS##_add_ps(o, PS##_min_ps(ea, zero)), PS##_min_ps(eb, zero));	\
+		const VEC hi = PS##_add_ps(PS##_add_ps(o, PS##_max_ps(ea, zero)), PS##_max_ps(eb, zero));	\
+		result = PS##_shuffle_ps(lo, PS##_sub_ps(hi, lo), _MM_SHUFFLE(1, 0, 1, 0));				\
+	}
+
+	E2D_TARGET_SSE2 void TransformRectsSse2(const Matrix32* matrices, const Rect* rects, Rect* out, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			const __m128 q = _mm_loadu_ps(matrices[i].m);
+			const __m128 t = LoadPair(matrices[i].m + 4);
+			const __m128 r = _mm_loadu_ps(&rects[i].origin.x);
+			__m128 result;
+			E2D_TRANSFORM_RECT_BODY(_mm, __m128, q, t, r, result);
+			_mm_storeu_ps(&out[i].origin.x, result);
+		}
+	}
+
+	//
+	// AVX ʵ
+	//
+
+	E2D_TARGET_AVX inline __m256 LoadQuads(const float* p0, const float* p1)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p0)), _mm_loadu_ps(p1), 1);
+	}
+
+	E2D_TARGET_AVX inline __m256 LoadPairs(const float* p0, const float* p1)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(LoadPair(p0)), LoadPair(p1), 1);
+	}
+
+	E2D_TARGET_AVX inline void StoreQuads(float* p0, float* p1, __m256 v)
+	{
+		_mm_storeu_ps(p0, _mm256_castps256_ps128(v));
+		_mm_storeu_ps(p1, _mm256_extractf128_ps(v, 1));
+	}
+
+	E2D_TARGET_AVX inline void StorePairs(float* p0, float* p1, __m256 v)
+	{
+		StorePair(p0, _mm256_castps256_ps128(v));
+		StorePair(p1, _mm256_extractf128_ps(v, 1));
+	}
+
+	E2D_TARGET_AVX void MultiplyAvx(const Matrix32* lhs, const Matrix32* rhs, size_t rhsStep, Matrix32* out, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2)
+		{
+			const float* r0 = rhs[i * rhsStep].m;
+			const float* r1 = rhs[(i + 1) * rhsStep].m;
+			const __m256 r4 = LoadQuads(r0, r1);
+			const __m256 r01 = _mm256_shuffle_ps(r4, r4, _MM_SHUFFLE(1, 0, 1, 0));
+			const __m256 r23 = _mm256_shuffle_ps(r4, r4, _MM_SHUFFLE(3, 2, 3, 2));
+			const __m256 rt = LoadPairs(r0 + 4, r1 + 4);
+
+			const __m256 l4 = LoadQuads(lhs[i].m, lhs[i + 1].m);
+			const __m256 lt = LoadPairs(lhs[i].m + 4, lhs[i + 1].m + 4);
+			const __m256 lx = _mm256_shuffle_ps(l4, l4, _MM_SHUFFLE(2, 2, 0, 0));
+			const __m256 ly = _mm256_shuffle_ps(l4, l4, _MM_SHUFFLE(3, 3, 1, 1));
+			const __m256 tx = _mm256_shuffle_ps(lt, lt, _MM_SHUFFLE(0, 0, 0, 0));
+			const __m256 ty = _mm256_shuffle_ps(lt, lt, _MM_SHUFFLE(1, 1, 1, 1));
+
+			const __m256 top = _mm256_add_ps(_mm256_mul_ps(lx, r01), _mm256_mul_ps(ly, r23));
+			const __m256 bottom = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, r01), _mm256_mul_ps(ty, r23)), rt);
+
+			StoreQuads(out[i].m, out[i + 1].m, top);
+			StorePairs(out[i].m + 4, out[i + 1].m + 4, bottom);
+		}
+		_mm256_zeroupper();
+
+		if (i < count)
+		{
+			MultiplySse2(lhs + i, rhs + i * rhsStep, rhsStep, out + i, count - i);
+		}
+	}
+
+	E2D_TARGET_AVX void InvertAvx(const Matrix32* matrices, Matrix32* out, size_t count)
+	{
+#define E2D_INVERT_SIGN 0.f, -0.f, -0.f, 0.f, 0.f, -0.f, -0.f, 0.f
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2)
+		{
+			const __m256 q = LoadQuads(matrices[i].m, matrices[i + 1].m);
+			const __m256 t = LoadPairs(matrices[i].m + 4, matrices[i + 1].m + 4);
+			__m256 top, bottom;
+			E2D_INVERT_BODY(_mm256, __m256, q, t, top, bottom);
+			StoreQuads(out[i].m, out[i + 1].m, top);
+			StorePairs(out[i].m + 4, out[i + 1].m + 4, bottom);
+		}
+		_mm256_zeroupper();
+#undef E2D_INVERT_SIGN
+
+		if (i < count)
+		{
+			InvertSse2(matrices + i, out + i, count - i);
+		}
+	}
+
+	E2D_TARGET_AVX void TransformPointsAvx(const Matrix32& matrix, const Vector2* points, Vector2* out, size_t count)
+	{
+		const __m256 m4 = LoadQuads(matrix.m, matrix.m);
+		const __m256 m01 = _mm256_shuffle_ps(m4, m4, _MM_SHUFFLE(1, 0, 1, 0));
+		const __m256 m23 = _mm256_shuffle_ps(m4, m4, _MM_SHUFFLE(3, 2, 3, 2));
+		const __m256 mt = _mm256_shuffle_ps(LoadPairs(matrix.m + 4, matrix.m + 4), LoadPairs(matrix.m + 4, matrix.m + 4), _MM_SHUFFLE(1, 0, 1, 0));
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m256 p = _mm256_loadu_ps(&points[i].x);
+			const __m256 px = _mm256_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+			const __m256 py = _mm256_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+			_mm256_storeu_ps(&out[i].x, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, m01), _mm256_mul_ps(py, m23)), mt));
+		}
+		_mm256_zeroupper();
+
+		if (i < count)
+		{
+			TransformPointsSse2(matrix, points + i, out + i, count - i);
+		}
+	}
+
+	E2D_TARGET_AVX void TransformRectsAvx(const Matrix32* matrices, const Rect* rects, Rect* out, size_t count)
+	{
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2)
+		{
+			const __m256 q = LoadQuads(matrices[i].m, matrices[i + 1].m);
+			const __m256 t = LoadPairs(matrices[i].m + 4, matrices[i + 1].m + 4);
+			const __m256 r = _mm256_loadu_ps(&rects[i].origin.x);
+			__m256 result;
+			E2D_TRANSFORM_RECT_BODY(_mm256, __m256, q, t, r, result);
+			_mm256_storeu_ps(&out[i].origin.x, result);
+		}
+		_mm256_zeroupper();
+
+		if (i < count)
+		{
+			TransformRectsSse2(matrices + i, rects + i, out + i, count - i);
+		}
+	}
+
+#undef E2D_INVERT_BODY
+#undef E2D_TRANSFORM_RECT_BODY
+
+	//  CPU ͲϵͳǷ֧ AVX
+	bool CpuHasAvx()
+	{
+#ifdef _MSC_VER
+		int info[4] = { 0 };
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		// ϵͳҪ߳лʱ YMM Ĵ
+		return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx") != 0;
+#endif
+	}
+
+	bool CpuHasSse2()
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		return true;
+#elif defined(_MSC_VER)
+		int info[4] = { 0 };
+		__cpuid(info, 1);
+		return (info[3] & (1 << 26)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("sse2") != 0;
+#endif
+	}
+
+#endif
+
+	Kernels SelectKernels()
+	{
+#ifdef E2D_MATRIX_X86
+		if (CpuHasAvx())
+		{
+			Kernels kernels = { "AVX", MultiplyAvx, InvertAvx, TransformPointsAvx, TransformRectsAvx };
+			return kernels;
+		}
+
+		if (CpuHasSse2())
+		{
+			Kernels kernels = { "SSE2", MultiplySse2, InvertSse2, TransformPointsSse2, TransformRectsSse2 };
+			return kernels;
+		}
+#endif
+		Kernels kernels = { "Scalar", MultiplyScalar, InvertScalar, TransformPointsScalar, TransformRectsScalar };
+		return kernels;
+	}
+
+	// ڵһʹʱѡ뵥Ԫľ̬ʼеҲǰȫ
+	// ߳ͬʱһεʱѡĽͬ
+	const Kernels& GetKernels()
+	{
+		static const Kernels kernels = SelectKernels();
+		return kernels;
+	}
+}
+
+void easy2d::Matrix32::multiply(const Matrix32* lhs, const Matrix32* rhs, Matrix32* out, size_t count)
+{
+	if (count)
+	{
+		GetKernels().multiply(lhs, rhs, 1, out, count);
+	}
+}
+
+void easy2d::Matrix32::multiply(const Matrix32* lhs, Matrix32 const& rhs, Matrix32* out, size_t count)
+{
+	if (count)
+	{
+		GetKernels().multiply(lhs, &rhs, 0, out, count);
+	}
+}
+
+void easy2d::Matrix32::invert(const Matrix32* matrices, Matrix32* out, size_t count)
+{
+	if (count)
+	{
+		GetKernels().invert(matrices, out, count);
+	}
+}
+
+void easy2d::Matrix32::transformPoints(Matrix32 const& matrix, const Vector2* points, Vector2* out, size_t count)
+{
+	if (count)
+	{
+		GetKernels().transformPoints(matrix, points, out, count);
+	}
+}
+
+void easy2d::Matrix32::transformRects(const Matrix32* matrices, const Rect* rects, Rect* out, size_t count)
+{
+	if (count)
+	{
+		GetKernels().transformRects(matrices, rects, out, count);
+	}
+}
+
+const char* easy2d::Matrix32::getBatchInstructionSet()
+{
+	return GetKernels().name;
+}
@@ -1,7 +1,7 @@
 #include <easy2d/e2dnode.h>
 #include <easy2d/e2dmanager.h>
 
-#define SAFE_SET(pointer, func, ...) if (pointer) { pointer->##func(__VA_ARGS__); }
+#define SAFE_SET(pointer, func, ...) if (pointer) { pointer->func(__VA_ARGS__); }
 
 
 easy2d::Button::Button()
@@ -16,7 +16,6 @@ easy2d::Button::Button()
 	, _selected(nullptr)
 	, _disabled(nullptr)
 {
-	addListener(std::bind(&Button::updateStatus, this, std::placeholders::_1), L"ťܼ");
 }
 
 easy2d::Button::Button(Node * normal, const Callback& func)
@@ -206,17 +205,13 @@ void easy2d::Button::_runCallback()
 	}
 }
 
-void easy2d::Button::updateStatus(Event* evt)
+void easy2d::Button::_updateStatus(Event* evt, bool hit)
 {
-	if (SceneManager::isTransitioning())
-		return;
-
 	if (_visible && _normal)
 	{
 		if (evt->type == Event::Type::MouseMove)
 		{
-			MouseMoveEvent* mme = dynamic_cast<MouseMoveEvent*>(evt);
-			if (!evt->target && containsPoint(Point{ mme->x, mme->y }))
+			if (!evt->target && hit)
 			{
 				evt->target = this;
 
@@ -0,0 +1,148 @@
+#include <easy2d/e2dnode.h>
+#include <easy2d/e2dbase.h>
+#include <easy2d/e2drender.h>
+
+namespace
+{
+	// ӿڴСΪȾĿĴСûȾ豸ʱʹôڴС
+	easy2d::Size GetViewSize()
+	{
+		easy2d::RenderDevice* device = easy2d::Renderer::getDevice();
+		return device ? device->getSize() : easy2d::Window::getSize();
+	}
+}
+
+easy2d::Camera::Camera()
+	: _posX(0)
+	, _posY(0)
+	, _zoom(1.f)
+	, _rotation(0)
+	, _anchorX(0)
+	, _anchorY(0)
+	, _scene(nullptr)
+{
+}
+
+easy2d::Camera::~Camera()
+{
+}
+
+easy2d::Point easy2d::Camera::getPos() const
+{
+	return Point(_posX, _posY);
+}
+
+float easy2d::Camera::getZoom() const
+{
+	return _zoom;
+}
+
+float easy2d::Camera::getRotation() const
+{
+	return _rotation;
+}
+
+float easy2d::Camera::getAnchorX() const
+{
+	return _anchorX;
+}
+
+float easy2d::Camera::getAnchorY() const
+{
+	return _anchorY;
+}
+
+void easy2d::Camera::setPos(const Point & point)
+{
+	setPos(point.x, point.y);
+}
+
+void easy2d::Camera::setPos(float x, float y)
+{
+	if (_posX == x && _posY == y)
+		return;
+
+	_posX = x;
+	_posY = y;
+	_setDirty();
+}
+
+void easy2d::Camera::movePos(float x, float y)
+{
+	setPos(_posX + x, _posY + y);
+}
+
+void easy2d::Camera::setZoom(float zoom)
+{
+	if (zoom <= 0)
+	{
+		E2D_WARNING(L"Camera::setZoom failed! Zoom must be greater than zero.");
+		return;
+	}
+
+	if (_zoom == zoom)
+		return;
+
+	_zoom = zoom;
+	_setDirty();
+}
+
+void easy2d::Camera::setRotation(float rotation)
+{
+	if (_rotation == rotation)
+		return;
+
+	_rotation = rotation;
+	_setDirty();
+}
+
+void easy2d::Camera::setAnchor(float anchorX, float anchorY)
+{
+	if (_anchorX == anchorX && _anchorY == anchorY)
+		return;
+
+	_anchorX = anchorX;
+	_anchorY = anchorY;
+	_setDirty();
+}
+
+easy2d::Matrix32 easy2d::Camera::getViewMatrix() const
+{
+	Size size = GetViewSize();
+
+	// ȰλƵԭ㣬תţƵӿڵê㴦
+	Matrix32 view = Matrix32::translation(-_posX, -_posY);
+	if (_rotation != 0)
+	{
+		view = view * Matrix32::rotation(-_rotation);
+	}
+	if (_zoom != 1.f)
+	{
+		view = view * Matrix32::scaling(_zoom, _zoom);
+	}
+	view = view * Matrix32::translation(size.width * _anchorX, size.height * _anchorY);
+	return view;
+}
+
+easy2d::Point easy2d::Camera::screenToWorld(const Point & point) const
+{
+	return Matrix32::invert(getViewMatrix()).transform(point);
+}
+
+easy2d::Point easy2d::Camera::worldToScreen(const Point & point) const
+{
+	return getViewMatrix().transform(point);
+}
+
+easy2d::Rect easy2d::Camera::getVisibleRect() const
+{
+	return Matrix32::invert(getViewMatrix()).transform(Rect(Point(), GetViewSize()));
+}
+
+void easy2d::Camera::_setDirty()
+{
+	if (_scene)
+	{
+		_scene->_setContentDirty();
+	}
+}
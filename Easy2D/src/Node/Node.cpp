@@ -1,37 +1,347 @@
 #include <easy2d/e2dnode.h>
+#include <easy2d/e2drender.h>
 #include <easy2d/e2dmanager.h>
 #include <easy2d/e2daction.h>
 #include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <functional>
+#include <mutex>
+#include <typeinfo>
 
 // Ĭĵλ
 static float s_fDefaultAnchorX = 0;
 static float s_fDefaultAnchorY = 0;
 
+namespace
+{
+	const size_t NO_PARENT = static_cast<size_t>(-1);
+
+	// ϵеİΧ
+	struct Bounds
+	{
+		float left, top, right, bottom;
+	};
+
+	// κ
+	const Bounds EMPTY_BOUNDS = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	// ƷΧδ֪Զᱻ޳
+	const Bounds INFINITE_BOUNDS = { -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX };
+
+	// ڵ任洢
+	// нڵı任ԺԽṹʽ洢
+	// λǰڵǰӽڵں˳УһԱɸ
+	struct TransformStore
+	{
+		std::vector<easy2d::Node*>		nodes;		// λӦĽڵ㣬вλΪ nullptr
+		std::vector<size_t>				parents;	// ڵλ
+		std::vector<float>				posX;
+		std::vector<float>				posY;
+		std::vector<float>				scaleX;
+		std::vector<float>				scaleY;
+		std::vector<float>				rotation;
+		std::vector<float>				skewX;
+		std::vector<float>				skewY;
+		std::vector<float>				anchorX;
+		std::vector<float>				anchorY;
+		std::vector<float>				width;
+		std::vector<float>				height;
+		std::vector<easy2d::Matrix32>	local;
+		std::vector<easy2d::Matrix32>	world;
+		std::vector<unsigned char>		dirty;			// ֲ޸
+		std::vector<unsigned char>		changed;		// θѸı
+		std::vector<unsigned char>		dirtyInverse;	// Ҫ¼
+		std::vector<unsigned char>		treeDirty;		// ĻƷΧҪ¼
+		std::vector<Bounds>				bounds;			// ڵĻƷΧ
+		std::vector<Bounds>				treeBounds;		// ڵ㼰ӽڵĻƷΧ
+		std::atomic<size_t>				firstDirty;		// һҪµĲλ
+		size_t							freeCount;		// вλ
+
+		TransformStore() : firstDirty(0), freeCount(0) {}
+	};
+
+	TransformStore s_store;
+	std::mutex s_TransformMutex;
+
+	// ڽеĲи
+	std::atomic<int> s_nParallelUpdates(0);
+
+	// иڼƳִеĲ
+	std::vector<std::function<void()>> s_vDeferredCalls;
+	std::mutex s_DeferredMutex;
+
+	// и¿ʼǰԤĲλиڼ䴴ڵ㲻ʹ洢·
+	// ԤĲλһβиǰԤӱ
+	size_t s_nParallelSlotReserve = 256;
+	bool s_bParallelSlotsExhausted = false;
+
+	// иڼ任ıĽڵ㣬ϺٸڳռеİΧ
+	std::vector<size_t> s_vPendingProxies;
+
+	// Ƴִһִǰض
+	void Defer(easy2d::Object * target, easy2d::Object * other, const std::function<void()>& func)
+	{
+		easy2d::GC::retain(target);
+		easy2d::GC::retain(other);
+
+		std::lock_guard<std::mutex> lock(s_DeferredMutex);
+		s_vDeferredCalls.push_back([=]() mutable
+		{
+			func();
+			easy2d::GC::release(target);
+			easy2d::GC::release(other);
+		});
+	}
+
+	void LowerFirstDirty(size_t slot)
+	{
+		// ߳̿ͬʱ
+		size_t first = s_store.firstDirty;
+		while (slot < first && !s_store.firstDirty.compare_exchange_weak(first, slot))
+		{
+		}
+	}
+
+	void MarkDirty(size_t slot)
+	{
+		s_store.dirty[slot] = 1;
+		LowerFirstDirty(slot);
+	}
+
+	// ӽڵ㱻ߺ󣬸ڵûиı䣬ĻƷΧҪ¼
+	void MarkTreeDirty(size_t slot)
+	{
+		s_store.treeDirty[slot] = 1;
+		LowerFirstDirty(slot);
+	}
+
+	// иڼ޸ı任洢ʱ̵߳ı任¶дһ
+	// иʱ̷ֻ߳ʴ洢Ҫ
+	class StoreLock
+	{
+	public:
+		StoreLock() : _locked(s_nParallelUpdates > 0)
+		{
+			if (_locked)
+			{
+				s_TransformMutex.lock();
+			}
+		}
+
+		~StoreLock()
+		{
+			if (_locked)
+			{
+				s_TransformMutex.unlock();
+			}
+		}
+
+	private:
+		bool _locked;
+	};
+
+	// θıĲλ
+	std::vector<size_t> s_vChangedSlots;
+
+	// ӽڵ㱻ߵĲλԼҪ¼ƷΧĲλȣ
+	std::vector<size_t> s_vTreeSlots;
+	std::vector<size_t> s_vTreeOrder;
+
+	// ƷΧʱʹõʱ
+	std::vector<easy2d::Rect> s_vBatchRects;
+
+	// ΪԤ
+	void ReserveSlots(size_t capacity)
+	{
+		auto& st = s_store;
+		st.nodes.reserve(capacity);
+		st.parents.reserve(capacity);
+		st.posX.reserve(capacity);
+		st.posY.reserve(capacity);
+		st.scaleX.reserve(capacity);
+		st.scaleY.reserve(capacity);
+		st.rotation.reserve(capacity);
+		st.skewX.reserve(capacity);
+		st.skewY.reserve(capacity);
+		st.anchorX.reserve(capacity);
+		st.anchorY.reserve(capacity);
+		st.width.reserve(capacity);
+		st.height.reserve(capacity);
+		st.local.reserve(capacity);
+		st.world.reserve(capacity);
+		st.dirty.reserve(capacity);
+		st.changed.reserve(capacity);
+		st.dirtyInverse.reserve(capacity);
+		st.treeDirty.reserve(capacity);
+		st.bounds.reserve(capacity);
+		st.treeBounds.reserve(capacity);
+	}
+
+	size_t AllocSlot(easy2d::Node * node)
+	{
+		auto& st = s_store;
+
+		// ߳̿ڶд洢±任
+		std::lock_guard<std::mutex> lock(s_TransformMutex);
+
+		if (s_nParallelUpdates > 0)
+		{
+			E2D_ERROR(L"Nodes cannot be created during a parallel update.");
+
+			// ԤĲλӻʹ洢·䣬̳߳еýʧЧ
+			if (st.nodes.size() == st.nodes.capacity())
+			{
+				s_bParallelSlotsExhausted = true;
+			}
+		}
+
+		st.nodes.push_back(node);
+		st.parents.push_back(NO_PARENT);
+		st.posX.push_back(0);
+		st.posY.push_back(0);
+		st.scaleX.push_back(1.f);
+		st.scaleY.push_back(1.f);
+		st.rotation.push_back(0);
+		st.skewX.push_back(0);
+		st.skewY.push_back(0);
+		st.anchorX.push_back(s_fDefaultAnchorX);
+		st.anchorY.push_back(s_fDefaultAnchorY);
+		st.width.push_back(0);
+		st.height.push_back(0);
+		st.local.push_back(easy2d::Matrix32());
+		st.world.push_back(easy2d::Matrix32());
+		st.dirty.push_back(1);
+		st.changed.push_back(0);
+		st.dirtyInverse.push_back(1);
+		st.treeDirty.push_back(0);
+		st.bounds.push_back(EMPTY_BOUNDS);
+		st.treeBounds.push_back(EMPTY_BOUNDS);
+
+		const size_t slot = st.nodes.size() - 1;
+		MarkDirty(slot);
+		return slot;
+	}
+
+	// ѲλݸƵ洢ĩβԭλΪ
+	size_t MoveSlot(size_t slot)
+	{
+		auto& st = s_store;
+		st.nodes.push_back(st.nodes[slot]);
+		st.parents.push_back(st.parents[slot]);
+		st.posX.push_back(st.posX[slot]);
+		st.posY.push_back(st.posY[slot]);
+		st.scaleX.push_back(st.scaleX[slot]);
+		st.scaleY.push_back(st.scaleY[slot]);
+		st.rotation.push_back(st.rotation[slot]);
+		st.skewX.push_back(st.skewX[slot]);
+		st.skewY.push_back(st.skewY[slot]);
+		st.anchorX.push_back(st.anchorX[slot]);
+		st.anchorY.push_back(st.anchorY[slot]);
+		st.width.push_back(st.width[slot]);
+		st.height.push_back(st.height[slot]);
+		st.local.push_back(st.local[slot]);
+		st.world.push_back(st.world[slot]);
+		st.dirty.push_back(1);
+		st.changed.push_back(0);
+		st.dirtyInverse.push_back(1);
+		st.treeDirty.push_back(0);
+		st.bounds.push_back(st.bounds[slot]);
+		st.treeBounds.push_back(st.treeBounds[slot]);
+
+		st.nodes[slot] = nullptr;
+		st.bounds[slot] = EMPTY_BOUNDS;
+		++st.freeCount;
+
+		const size_t newSlot = st.nodes.size() - 1;
+		MarkDirty(newSlot);
+		return newSlot;
+	}
+
+	// ֲ [x, x + w] * [y, y + h] аΧ
+	Bounds TransformBounds(const easy2d::Matrix32& m, float x, float y, float w, float h)
+	{
+		const float ax = m._11 * w, ay = m._12 * w;
+		const float bx = m._21 * h, by = m._22 * h;
+		const float ox = m._11 * x + m._21 * y + m._31;
+		const float oy = m._12 * x + m._22 * y + m._32;
+
+		Bounds b;
+		b.left = ox + min(ax, 0.f) + min(bx, 0.f);
+		b.top = oy + min(ay, 0.f) + min(by, 0.f);
+		b.right = ox + max(ax, 0.f) + max(bx, 0.f);
+		b.bottom = oy + max(ay, 0.f) + max(by, 0.f);
+		return b;
+	}
+
+	void FreeSlot(size_t slot)
+	{
+		s_store.nodes[slot] = nullptr;
+		s_store.bounds[slot] = EMPTY_BOUNDS;
+		++s_store.freeCount;
+	}
+
+	// λ [begin, end) ĻƷΧֲδ s_vBatchRects
+	void FlushBoundsRun(size_t begin, size_t end)
+	{
+		auto& st = s_store;
+		const size_t count = end - begin;
+		easy2d::Matrix32::transformRects(&st.world[begin], s_vBatchRects.data(), s_vBatchRects.data(), count);
+		for (size_t k = 0; k < count; ++k)
+		{
+			const easy2d::Rect& r = s_vBatchRects[k];
+			const Bounds b = { r.origin.x, r.origin.y, r.origin.x + r.size.width, r.origin.y + r.size.height };
+			st.bounds[begin + k] = b;
+		}
+		s_vBatchRects.clear();
+	}
+
+	//   * б * ת * ƽ ˳ֱչֲ󣬱ʱ
+	void ComputeLocal(size_t i)
+	{
+		auto& st = s_store;
+		// 󲿷ֽڵûתбУǺ
+		float s, c;
+		easy2d::math::FastSinCos(st.rotation[i], s, c);
+		const float tx = (st.skewX[i] == 0) ? 0.f : easy2d::math::FastTan(st.skewX[i]);
+		const float ty = (st.skewY[i] == 0) ? 0.f : easy2d::math::FastTan(st.skewY[i]);
+		const float sx = st.scaleX[i];
+		const float sy = st.scaleY[i];
+
+		easy2d::Matrix32& m = st.local[i];
+		m._11 = sx * (c + ty * s);
+		m._12 = sx * (s - ty * c);
+		m._21 = -sy * (tx * c + s);
+		m._22 = sy * (c - tx * s);
+
+		// ƽƵê
+		const float ox = -st.width[i] * st.anchorX[i];
+		const float oy = -st.height[i] * st.anchorY[i];
+		m._31 = st.posX[i] + m._11 * ox + m._21 * oy;
+		m._32 = st.posY[i] + m._12 * ox + m._22 * oy;
+	}
+}
+
 easy2d::Node::Node()
-	: _nOrder(0)
-	, _posX(0)
-	, _posY(0)
+	: _visible(true)
+	, _autoUpdate(true)
+	, _parallelUpdate(false)
+	, _needSort(false)
+	, _dirtyContent(true)
+	, _positionFixed(false)
+	, _updatingChildren(false)
+	, _childContentDirty(false)
 	, _width(0)
 	, _height(0)
-	, _scaleX(1.0f)
-	, _scaleY(1.0f)
-	, _rotation(0)
-	, _skewAngleX(0)
-	, _skewAngleY(0)
 	, _displayOpacity(1.0f)
 	, _realOpacity(1.0f)
-	, _anchorX(s_fDefaultAnchorX)
-	, _anchorY(s_fDefaultAnchorY)
-	, _transform()
-	, _visible(true)
-	, _parent(nullptr)
-	, _parentScene(nullptr)
+	, _nOrder(0)
+	, _slot(AllocSlot(this))
+	, _proxy(-1)
 	, _hashName(0)
-	, _needSort(false)
-	, _dirtyTransform(false)
-	, _dirtyInverseTransform(false)
-	, _autoUpdate(true)
-	, _positionFixed(false)
+	, _parentScene(nullptr)
+	, _parent(nullptr)
+	, _actions(nullptr)
 {
 }
 
@@ -43,15 +353,21 @@ easy2d::Node::~Node()
 	for (auto child : _children)
 	{
 		child->_parent = nullptr;
+		s_store.parents[child->_slot] = NO_PARENT;
+		MarkDirty(child->_slot);
+		if (child->_parentScene)
+		{
+			child->_setParentScene(nullptr);
+		}
 		GC::release(child);
 	}
+
+	_removeProxy();
+	FreeSlot(_slot);
 }
 
 void easy2d::Node::_update()
 {
-	// ת
-	_updateTransform();
-
 	if (_children.empty())
 	{
 		if (_autoUpdate && !Game::isPaused())
@@ -64,50 +380,141 @@ void easy2d::Node::_update()
 		// ӽڵ
 		_sortChildren();
 
-		// ӽڵ
+		// ҵһ Order СĽڵ
 		size_t size = _children.size();
-		size_t i;
-		for (i = 0; i < size; ++i)
+		size_t split = 0;
+		while (split < size && _children[split]->getOrder() < 0)
 		{
-			auto child = _children[i];
-			//  Order СĽڵ
-			if (child->getOrder() < 0)
-			{
-				child->_update();
-			}
-			else
-			{
-				break;
-			}
+			++split;
 		}
 
+		//  Order СĽڵ
+		_updateChildren(0, split);
+
 		if (_autoUpdate && !Game::isPaused())
 		{
 			this->onUpdate();
 		}
 
 		// ڵ
-		for (; i < size; ++i)
+		_updateChildren(split, size);
+	}
+}
+
+void easy2d::Node::_updateChildren(size_t begin, size_t end)
+{
+	if (_parallelUpdate && end - begin > 1)
+	{
+		if (s_nParallelUpdates == 0)
+		{
+			// Ԥλиڼ䲻·洢
+			std::lock_guard<std::mutex> lock(s_TransformMutex);
+			if (s_bParallelSlotsExhausted)
+			{
+				s_nParallelSlotReserve *= 2;
+				s_bParallelSlotsExhausted = false;
+			}
+			ReserveSlots(s_store.nodes.size() + s_nParallelSlotReserve);
+		}
+
+		// ཻڲͬ߳ͬʱ
+		_updatingChildren = true;
+		++s_nParallelUpdates;
+		JobSystem::parallelFor(end - begin, [this, begin](size_t i)
+		{
+			_children[begin + i]->_update();
+		});
+		--s_nParallelUpdates;
+		_updatingChildren = false;
+
+		// ӽڵڲииıʱϺϱ
+		if (_childContentDirty.exchange(false))
+		{
+			_setContentDirty();
+		}
+	}
+	else
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
 			_children[i]->_update();
+		}
+	}
+}
+
+bool easy2d::Node::__isUpdatingInParallel()
+{
+	return s_nParallelUpdates > 0;
+}
+
+void easy2d::Node::__flushPendingProxies()
+{
+	auto& st = s_store;
+	for (auto slot : s_vPendingProxies)
+	{
+		// ڵѱͷ
+		Node* node = st.nodes[slot];
+		if (node && node->_parentScene)
+		{
+			node->_updateProxy(st.world[slot], st.width[slot], st.height[slot]);
+		}
+	}
+	s_vPendingProxies.clear();
+}
+
+void easy2d::Node::__flushDeferred()
+{
+	{
+		std::lock_guard<std::mutex> lock(s_TransformMutex);
+		__flushPendingProxies();
+	}
+
+	// ƳٵĲٴƳµĲֱΪ
+	while (true)
+	{
+		std::vector<std::function<void()>> calls;
+		{
+			std::lock_guard<std::mutex> lock(s_DeferredMutex);
+			calls.swap(s_vDeferredCalls);
+		}
+
+		if (calls.empty())
+		{
+			break;
+		}
+
+		for (auto& call : calls)
+		{
+			call();
+		}
 	}
 }
 
 void easy2d::Node::_render()
 {
+	// ݱǣ֮޸Ļϱ
+	_dirtyContent = false;
+
+	// ʱҲҪӽڵıǣӽڵ֮޸Ĳϱ
+	// ӽڵӿӿʱģʽһֱطžɵ
 	if (!_visible)
 	{
+		_clearChildrenContentDirty();
 		return;
 	}
 
-	// ת
-	_updateTransform();
+	// ӿ֮ʱ
+	const Bounds& tree = s_store.treeBounds[_slot];
+	if (Renderer::__isSubtreeCulled(tree.left, tree.top, tree.right, tree.bottom))
+	{
+		_clearChildrenContentDirty();
+		return;
+	}
 
 	if (_children.empty())
 	{
-		// תȾĶά
-		Renderer::getRenderTarget()->SetTransform(_transform.toD2DMatrix());
 		// Ⱦ
-		this->onRender();
+		this->_renderSelf();
 	}
 	else
 	{
@@ -130,10 +537,8 @@ void easy2d::Node::_render()
 			}
 		}
 
-		// תȾĶά
-		Renderer::getRenderTarget()->SetTransform(_transform.toD2DMatrix());
 		// Ⱦ
-		this->onRender();
+		this->_renderSelf();
 
 		// ʣڵ
 		for (; i < size; ++i)
@@ -141,44 +546,390 @@ void easy2d::Node::_render()
 	}
 }
 
-void easy2d::Node::_updateTransform() const
+void easy2d::Node::_renderSelf()
 {
-	if (!_dirtyTransform)
+	// ӽڵʱܲӿ
+	const Bounds& bounds = s_store.bounds[_slot];
+	if (Renderer::__isNodeCulled(bounds.left, bounds.top, bounds.right, bounds.bottom))
+	{
 		return;
+	}
+
+	RenderDevice* device = Renderer::getDevice();
+	// תȾĶάͼͳһ
+	const Matrix32& view = Renderer::__getViewMatrix();
+	if (view.isIdentity())
+	{
+		device->setTransform(s_store.world[_slot]);
+	}
+	else
+	{
+		device->setTransform(Matrix32(s_store.world[_slot] * view));
+	}
 
-	// ־ִй任
-	_dirtyTransform = false;
-	_dirtyInverseTransform = true;
+	RenderCommandList* list = Renderer::__getRecordingList();
+	if (list && !this->_isRecordable())
+	{
+		// طʱִ onRender
+		list->addNode(this);
+	}
+	else
+	{
+		this->onRender();
+	}
+}
 
-	_transform = Matrix32::scaling(_scaleX, _scaleY)
-		* Matrix32::skewing(_skewAngleX, _skewAngleY)
-		* Matrix32::rotation(_rotation)
-		* Matrix32::translation(_posX, _posY);
+void easy2d::Node::_clearChildrenContentDirty()
+{
+	// δǵĽڵ㣬ӽڵҲδ
+	for (auto child : _children)
+	{
+		if (child->_dirtyContent)
+		{
+			child->_dirtyContent = false;
+			child->_clearChildrenContentDirty();
+		}
+	}
+}
 
-	_transform.translate(-_width * _anchorX, -_height * _anchorY);
+void easy2d::Node::_setContentDirty()
+{
+	// ڵѱʱҪϱ
+	for (Node* node = this; node && !node->_dirtyContent; node = node->_parent)
+	{
+		node->_dirtyContent = true;
 
-	if (_parent)
+		// ڵڲиӽڵʱ̻߳ͬʱ︸ڵ
+		// ֻ¼һ־ɸڵڻϺϱ
+		Node* parent = node->_parent;
+		if (parent && parent->_updatingChildren)
+		{
+			if (!parent->_childContentDirty.load(std::memory_order_relaxed))
+			{
+				parent->_childContentDirty.store(true, std::memory_order_relaxed);
+			}
+			break;
+		}
+	}
+}
+
+float easy2d::Node::_getRenderMargin() const
+{
+	if (_width > 0 && _height > 0)
+	{
+		return 0;
+	}
+
+	// ûдСԶڵλû
+	const std::type_info& type = typeid(*this);
+	return (type == typeid(Node) || type == typeid(Scene)) ? 0.f : -1.f;
+}
+
+void easy2d::Node::_setBoundsDirty()
+{
+	StoreLock lock;
+	MarkDirty(_slot);
+}
+
+bool easy2d::Node::_isRecordable() const
+{
+	// д onRender
+	const std::type_info& type = typeid(*this);
+	return type == typeid(Node) || type == typeid(Scene);
+}
+
+void easy2d::Node::_updateTransform() const
+{
+	// иʱ߳̿ڸ£жϲȴ
+	if (s_nParallelUpdates > 0)
 	{
-		_transform = _transform * _parent->_transform;
+		Node::__updateTransforms();
+		return;
 	}
 
-	// ֪ͨӽڵת
-	for (auto& child : _children)
+	// λ֮ǰĽڵ㶼û޸ʱ
+	if (s_store.firstDirty <= _slot)
 	{
-		child->_dirtyTransform = true;
+		Node::__updateTransforms();
 	}
 }
 
 void easy2d::Node::_updateInverseTransform() const
 {
 	_updateTransform();
-	if (_dirtyInverseTransform)
+	if (s_store.dirtyInverse[_slot])
 	{
-		_inverseTransform = Matrix32::invert(_transform);
-		_dirtyInverseTransform = false;
+		_inverseTransform = Matrix32::invert(s_store.world[_slot]);
+		s_store.dirtyInverse[_slot] = 0;
 	}
 }
 
+void easy2d::Node::_attachSlot()
+{
+	// ԭĸڵʧȥӽڵ
+	const size_t oldParent = s_store.parents[_slot];
+	if (oldParent != NO_PARENT && (!_parent || oldParent != _parent->_slot))
+	{
+		MarkTreeDirty(oldParent);
+	}
+
+	// ӽڵĲλλڸڵ֮
+	if (_parent && _slot < _parent->_slot)
+	{
+		_moveSlots();
+	}
+	s_store.parents[_slot] = _parent ? _parent->_slot : NO_PARENT;
+	MarkDirty(_slot);
+}
+
+void easy2d::Node::_moveSlots()
+{
+	// ֤ڵӽڵƶ
+	_slot = MoveSlot(_slot);
+	s_store.parents[_slot] = _parent ? _parent->_slot : NO_PARENT;
+	for (auto child : _children)
+	{
+		child->_moveSlots();
+	}
+}
+
+void easy2d::Node::__updateTransforms()
+{
+	auto& st = s_store;
+
+	// ие getTransform ʱж߳ͬʱ
+	std::lock_guard<std::mutex> lock(s_TransformMutex);
+
+	// ѹ洢ǰȴиڼƳٵİΧУλ±ȻЧ
+	if (s_nParallelUpdates == 0)
+	{
+		__flushPendingProxies();
+	}
+
+	// вλʱѹ洢ԭ˳
+	// иڼ߳ʹòλѹ
+	if (s_nParallelUpdates == 0 && st.freeCount > 64 && st.freeCount * 2 > st.nodes.size())
+	{
+		std::vector<size_t> remap(st.nodes.size(), NO_PARENT);
+		size_t count = 0;
+		for (size_t i = 0; i < st.nodes.size(); ++i)
+		{
+			if (!st.nodes[i])
+				continue;
+
+			remap[i] = count;
+			st.nodes[count] = st.nodes[i];
+			st.parents[count] = (st.parents[i] == NO_PARENT) ? NO_PARENT : remap[st.parents[i]];
+			st.posX[count] = st.posX[i];
+			st.posY[count] = st.posY[i];
+			st.scaleX[count] = st.scaleX[i];
+			st.scaleY[count] = st.scaleY[i];
+			st.rotation[count] = st.rotation[i];
+			st.skewX[count] = st.skewX[i];
+			st.skewY[count] = st.skewY[i];
+			st.anchorX[count] = st.anchorX[i];
+			st.anchorY[count] = st.anchorY[i];
+			st.width[count] = st.width[i];
+			st.height[count] = st.height[i];
+			st.local[count] = st.local[i];
+			st.world[count] = st.world[i];
+			st.dirty[count] = st.dirty[i];
+			st.changed[count] = st.changed[i];
+			st.dirtyInverse[count] = st.dirtyInverse[i];
+			st.treeDirty[count] = st.treeDirty[i];
+			st.bounds[count] = st.bounds[i];
+			st.treeBounds[count] = st.treeBounds[i];
+			st.nodes[count]->_slot = count;
+			++count;
+		}
+
+		if (st.firstDirty < st.nodes.size())
+		{
+			// ѹӵһЧλʼ
+			size_t first = count;
+			for (size_t i = st.firstDirty; i < st.nodes.size(); ++i)
+			{
+				if (remap[i] != NO_PARENT)
+				{
+					first = remap[i];
+					break;
+				}
+			}
+			st.firstDirty = first;
+		}
+
+		st.nodes.resize(count);
+		st.parents.resize(count);
+		st.posX.resize(count);
+		st.posY.resize(count);
+		st.scaleX.resize(count);
+		st.scaleY.resize(count);
+		st.rotation.resize(count);
+		st.skewX.resize(count);
+		st.skewY.resize(count);
+		st.anchorX.resize(count);
+		st.anchorY.resize(count);
+		st.width.resize(count);
+		st.height.resize(count);
+		st.local.resize(count);
+		st.world.resize(count);
+		st.dirty.resize(count);
+		st.changed.resize(count);
+		st.dirtyInverse.resize(count);
+		st.treeDirty.resize(count);
+		st.bounds.resize(count);
+		st.treeBounds.resize(count);
+		st.freeCount = 0;
+	}
+
+	// ڵӽڵ֮ǰӵһλʼԱһμ
+	// ǰ޸ firstDirty̲߳ȥȡδɵ
+	const size_t size = st.nodes.size();
+	const size_t first = st.firstDirty;
+	if (first >= size)
+	{
+		return;
+	}
+
+	s_vChangedSlots.clear();
+	s_vTreeSlots.clear();
+	for (size_t i = first; i < size; ++i)
+	{
+		if (!st.nodes[i])
+			continue;
+
+		// ΧҪµĲλԺͬһ¼
+		if (st.treeDirty[i] == 1)
+		{
+			s_vTreeSlots.push_back(i);
+		}
+
+		// һλ֮ǰĽڵڱθûиı
+		const size_t parent = st.parents[i];
+		const bool parentChanged = parent != NO_PARENT && parent >= first && st.changed[parent];
+
+		const bool dirty = st.dirty[i] != 0;
+		if (dirty)
+		{
+			st.dirty[i] = 0;
+			ComputeLocal(i);
+		}
+
+		if (dirty || parentChanged)
+		{
+			st.changed[i] = 1;
+			st.dirtyInverse[i] = 1;
+			s_vChangedSlots.push_back(i);
+		}
+		else
+		{
+			st.changed[i] = 0;
+		}
+	}
+
+	// ֵܽڵĲλͨڣڵͬλһ˷
+	// ڵЩλ֮ǰʱѾ
+	const size_t changedCount = s_vChangedSlots.size();
+	for (size_t k = 0; k < changedCount;)
+	{
+		const size_t begin = s_vChangedSlots[k];
+		const size_t parent = st.parents[begin];
+
+		size_t end = begin + 1;
+		for (++k; k < changedCount && s_vChangedSlots[k] == end && st.parents[end] == parent; ++k)
+		{
+			++end;
+		}
+
+		if (parent == NO_PARENT)
+		{
+			std::copy(&st.local[begin], &st.local[begin] + (end - begin), &st.world[begin]);
+		}
+		else
+		{
+			easy2d::Matrix32::multiply(&st.local[begin], st.world[parent], &st.world[begin], end - begin);
+		}
+	}
+
+	// ƷΧдСλһ任аΧ
+	size_t runBegin = 0, runEnd = 0;
+	for (auto i : s_vChangedSlots)
+	{
+		const float margin = st.nodes[i]->_getRenderMargin();
+		if (margin < 0)
+		{
+			st.bounds[i] = INFINITE_BOUNDS;
+		}
+		else if (st.width[i] <= 0 || st.height[i] <= 0)
+		{
+			st.bounds[i] = EMPTY_BOUNDS;
+		}
+		else
+		{
+			if (i != runEnd)
+			{
+				FlushBoundsRun(runBegin, runEnd);
+				runBegin = i;
+			}
+			runEnd = i + 1;
+			s_vBatchRects.push_back(easy2d::Rect(-margin, -margin, st.width[i] + margin * 2, st.height[i] + margin * 2));
+		}
+	}
+	FlushBoundsRun(runBegin, runEnd);
+
+	// ³ռеİΧ
+	// ߳̿ͨ getTransform ʱռ߳ʹãϺٸ
+	for (auto i : s_vChangedSlots)
+	{
+		Node * node = st.nodes[i];
+		if (node->_parentScene)
+		{
+			if (s_nParallelUpdates > 0)
+			{
+				s_vPendingProxies.push_back(i);
+			}
+			else
+			{
+				node->_updateProxy(st.world[i], st.width[i], st.height[i]);
+			}
+		}
+	}
+
+	// ĻƷΧֻŸıĲλϴ
+	// ǸıĲλȣѱǵĲλʱֹͣ
+	s_vTreeOrder.clear();
+	s_vTreeSlots.insert(s_vTreeSlots.end(), s_vChangedSlots.begin(), s_vChangedSlots.end());
+	for (auto slot : s_vTreeSlots)
+	{
+		for (size_t a = slot; a != NO_PARENT && st.treeDirty[a] != 2; a = st.parents[a])
+		{
+			st.treeDirty[a] = 2;
+			s_vTreeOrder.push_back(a);
+		}
+	}
+
+	// ӽڵĲλڸڵ֮󣬴ӺǰʱӽڵķΧ
+	std::sort(s_vTreeOrder.begin(), s_vTreeOrder.end(), std::greater<size_t>());
+	for (auto i : s_vTreeOrder)
+	{
+		Bounds tree = st.bounds[i];
+		for (auto child : st.nodes[i]->_children)
+		{
+			const Bounds& b = st.treeBounds[child->_slot];
+			tree.left = min(tree.left, b.left);
+			tree.top = min(tree.top, b.top);
+			tree.right = max(tree.right, b.right);
+			tree.bottom = max(tree.bottom, b.bottom);
+		}
+		st.treeBounds[i] = tree;
+		st.treeDirty[i] = 0;
+	}
+
+	// ޸Ĵ洢ʱڼ䲻µıǣ firstDirty ѱ
+	size_t expected = first;
+	st.firstDirty.compare_exchange_strong(expected, size);
+}
+
 void easy2d::Node::_sortChildren()
 {
 	if (_needSort)
@@ -222,27 +973,27 @@ size_t easy2d::Node::getHashName() const
 
 float easy2d::Node::getPosX() const
 {
-	return _posX;
+	return s_store.posX[_slot];
 }
 
 float easy2d::Node::getPosY() const
 {
-	return _posY;
+	return s_store.posY[_slot];
 }
 
 easy2d::Point easy2d::Node::getPos() const
 {
-	return Point(_posX, _posY);
+	return Point(s_store.posX[_slot], s_store.posY[_slot]);
 }
 
 float easy2d::Node::getWidth() const
 {
-	return _width * _scaleX;
+	return _width * s_store.scaleX[_slot];
 }
 
 float easy2d::Node::getHeight() const
 {
-	return _height * _scaleY;
+	return _height * s_store.scaleY[_slot];
 }
 
 float easy2d::Node::getRealWidth() const
@@ -262,12 +1013,12 @@ easy2d::Size easy2d::Node::getRealSize() const
 
 float easy2d::Node::getAnchorX() const
 {
-	return _anchorX;
+	return s_store.anchorX[_slot];
 }
 
 float easy2d::Node::getAnchorY() const
 {
-	return _anchorY;
+	return s_store.anchorY[_slot];
 }
 
 easy2d::Size easy2d::Node::getSize() const
@@ -277,27 +1028,27 @@ easy2d::Size easy2d::Node::getSize() const
 
 float easy2d::Node::getScaleX() const
 {
-	return _scaleX;
+	return s_store.scaleX[_slot];
 }
 
 float easy2d::Node::getScaleY() const
 {
-	return _scaleY;
+	return s_store.scaleY[_slot];
 }
 
 float easy2d::Node::getSkewX() const
 {
-	return _skewAngleX;
+	return s_store.skewX[_slot];
 }
 
 float easy2d::Node::getSkewY() const
 {
-	return _skewAngleY;
+	return s_store.skewY[_slot];
 }
 
 float easy2d::Node::getRotation() const
 {
-	return _rotation;
+	return s_store.rotation[_slot];
 }
 
 float easy2d::Node::getOpacity() const
@@ -309,18 +1060,18 @@ easy2d::Node::Property easy2d::Node::getProperty() const
 {
 	Property prop;
 	prop.visable = _visible;
-	prop.posX = _posX;
-	prop.posY = _posY;
+	prop.posX = s_store.posX[_slot];
+	prop.posY = s_store.posY[_slot];
 	prop.width = _width;
 	prop.height = _height;
 	prop.opacity = _realOpacity;
-	prop.anchorX = _anchorX;
-	prop.anchorY = _anchorY;
-	prop.scaleX = _scaleX;
-	prop.scaleY = _scaleY;
-	prop.rotation = _rotation;
-	prop.skewAngleX = _skewAngleX;
-	prop.skewAngleY = _skewAngleY;
+	prop.anchorX = s_store.anchorX[_slot];
+	prop.anchorY = s_store.anchorY[_slot];
+	prop.scaleX = s_store.scaleX[_slot];
+	prop.scaleY = s_store.scaleY[_slot];
+	prop.rotation = s_store.rotation[_slot];
+	prop.skewAngleX = s_store.skewX[_slot];
+	prop.skewAngleY = s_store.skewY[_slot];
 	return prop;
 }
 
@@ -341,17 +1092,35 @@ int easy2d::Node::getOrder() const
 
 void easy2d::Node::setOrder(int order)
 {
+	if (_nOrder == order)
+		return;
+
 	_nOrder = order;
+
+	// ڵһθ»Ⱦʱ
+	if (_parent)
+	{
+		if (s_nParallelUpdates > 0)
+		{
+			Node* parent = _parent;
+			Defer(parent, nullptr, [=]() { parent->_needSort = true; });
+		}
+		else
+		{
+			_parent->_needSort = true;
+		}
+	}
+	_setContentDirty();
 }
 
 void easy2d::Node::setPosX(float x)
 {
-	this->setPos(x, _posY);
+	this->setPos(x, s_store.posY[_slot]);
 }
 
 void easy2d::Node::setPosY(float y)
 {
-	this->setPos(_posX, y);
+	this->setPos(s_store.posX[_slot], y);
 }
 
 void easy2d::Node::setPos(const Point & p)
@@ -361,21 +1130,25 @@ void easy2d::Node::setPos(const Point & p)
 
 void easy2d::Node::setPos(float x, float y)
 {
-	if (_posX == x && _posY == y)
+	StoreLock lock;
+	if (s_store.posX[_slot] == x && s_store.posY[_slot] == y)
 		return;
 
-	_posX = float(x);
-	_posY = float(y);
-	_dirtyTransform = true;
+	s_store.posX[_slot] = float(x);
+	s_store.posY[_slot] = float(y);
+	MarkDirty(_slot);
+	_setContentDirty();
 }
 
 void easy2d::Node::setPosFixed(bool fixed)
 {
+	StoreLock lock;
 	if (_positionFixed == fixed)
 		return;
 
 	_positionFixed = fixed;
-	_dirtyTransform = true;
+	MarkDirty(_slot);
+	_setContentDirty();
 }
 
 void easy2d::Node::movePosX(float x)
@@ -390,7 +1163,7 @@ void easy2d::Node::movePosY(float y)
 
 void easy2d::Node::movePos(float x, float y)
 {
-	this->setPos(_posX + x, _posY + y);
+	this->setPos(s_store.posX[_slot] + x, s_store.posY[_slot] + y);
 }
 
 void easy2d::Node::movePos(const Vector2 & v)
@@ -400,12 +1173,12 @@ void easy2d::Node::movePos(const Vector2 & v)
 
 void easy2d::Node::setScaleX(float scaleX)
 {
-	this->setScale(scaleX, _scaleY);
+	this->setScale(scaleX, s_store.scaleY[_slot]);
 }
 
 void easy2d::Node::setScaleY(float scaleY)
 {
-	this->setScale(_scaleX, scaleY);
+	this->setScale(s_store.scaleX[_slot], scaleY);
 }
 
 void easy2d::Node::setScale(float scale)
@@ -415,41 +1188,47 @@ void easy2d::Node::setScale(float scale)
 
 void easy2d::Node::setScale(float scaleX, float scaleY)
 {
-	if (_scaleX == scaleX && _scaleY == scaleY)
+	StoreLock lock;
+	if (s_store.scaleX[_slot] == scaleX && s_store.scaleY[_slot] == scaleY)
 		return;
 
-	_scaleX = float(scaleX);
-	_scaleY = float(scaleY);
-	_dirtyTransform = true;
+	s_store.scaleX[_slot] = float(scaleX);
+	s_store.scaleY[_slot] = float(scaleY);
+	MarkDirty(_slot);
+	_setContentDirty();
 }
 
 void easy2d::Node::setSkewX(float angleX)
 {
-	this->setSkew(angleX, _skewAngleY);
+	this->setSkew(angleX, s_store.skewY[_slot]);
 }
 
 void easy2d::Node::setSkewY(float angleY)
 {
-	this->setSkew(_skewAngleX, angleY);
+	this->setSkew(s_store.skewX[_slot], angleY);
 }
 
 void easy2d::Node::setSkew(float angleX, float angleY)
 {
-	if (_skewAngleX == angleX && _skewAngleY == angleY)
+	StoreLock lock;
+	if (s_store.skewX[_slot] == angleX && s_store.skewY[_slot] == angleY)
 		return;
 
-	_skewAngleX = float(angleX);
-	_skewAngleY = float(angleY);
-	_dirtyTransform = true;
+	s_store.skewX[_slot] = float(angleX);
+	s_store.skewY[_slot] = float(angleY);
+	MarkDirty(_slot);
+	_setContentDirty();
 }
 
 void easy2d::Node::setRotation(float angle)
 {
-	if (_rotation == angle)
+	StoreLock lock;
+	if (s_store.rotation[_slot] == angle)
 		return;
 
-	_rotation = float(angle);
-	_dirtyTransform = true;
+	s_store.rotation[_slot] = float(angle);
+	MarkDirty(_slot);
+	_setContentDirty();
 }
 
 void easy2d::Node::setOpacity(float opacity)
@@ -460,26 +1239,29 @@ void easy2d::Node::setOpacity(float opacity)
 	_displayOpacity = _realOpacity = min(max(float(opacity), 0), 1);
 	// ½ڵ͸
 	_updateOpacity();
+	_setContentDirty();
 }
 
 void easy2d::Node::setAnchorX(float anchorX)
 {
-	this->setAnchor(anchorX, _anchorY);
+	this->setAnchor(anchorX, s_store.anchorY[_slot]);
 }
 
 void easy2d::Node::setAnchorY(float anchorY)
 {
-	this->setAnchor(_anchorX, anchorY);
+	this->setAnchor(s_store.anchorX[_slot], anchorY);
 }
 
 void easy2d::Node::setAnchor(float anchorX, float anchorY)
 {
-	if (_anchorX == anchorX && _anchorY == anchorY)
+	StoreLock lock;
+	if (s_store.anchorX[_slot] == anchorX && s_store.anchorY[_slot] == anchorY)
 		return;
 
-	_anchorX = min(max(float(anchorX), 0), 1);
-	_anchorY = min(max(float(anchorY), 0), 1);
-	_dirtyTransform = true;
+	s_store.anchorX[_slot] = min(max(float(anchorX), 0), 1);
+	s_store.anchorY[_slot] = min(max(float(anchorY), 0), 1);
+	MarkDirty(_slot);
+	_setContentDirty();
 }
 
 void easy2d::Node::setWidth(float width)
@@ -494,12 +1276,16 @@ void easy2d::Node::setHeight(float height)
 
 void easy2d::Node::setSize(float width, float height)
 {
+	StoreLock lock;
 	if (_width == width && _height == height)
 		return;
 
 	_width = float(width);
 	_height = float(height);
-	_dirtyTransform = true;
+	s_store.width[_slot] = _width;
+	s_store.height[_slot] = _height;
+	MarkDirty(_slot);
+	_setContentDirty();
 }
 
 void easy2d::Node::setSize(Size size)
@@ -523,6 +1309,12 @@ void easy2d::Node::addChild(Node * child, int order  /* = 0 */)
 {
 	if (child == nullptr) E2D_WARNING(L"Node::addChild NULL pointer exception.");
 
+	if (child && s_nParallelUpdates > 0)
+	{
+		Defer(this, child, [=]() { this->addChild(child, order); });
+		return;
+	}
+
 	if (child)
 	{
 		if (child->_parent != nullptr)
@@ -547,6 +1339,7 @@ void easy2d::Node::addChild(Node * child, int order  /* = 0 */)
 		child->retain();
 
 		child->_parent = this;
+		child->_attachSlot();
 
 		if (this->_parentScene)
 		{
@@ -555,10 +1348,9 @@ void easy2d::Node::addChild(Node * child, int order  /* = 0 */)
 
 		// ӽڵ͸
 		child->_updateOpacity();
-		// ½ڵת
-		child->_dirtyTransform = true;
 		// ӽڵ
 		_needSort = true;
+		_setContentDirty();
 	}
 }
 
@@ -573,7 +1365,7 @@ void easy2d::Node::addChild(const std::vector<Node*>& nodes, int order)
 easy2d::Matrix32 easy2d::Node::getTransform() const
 {
 	_updateTransform();
-	return _transform;
+	return s_store.world[_slot];
 }
 
 easy2d::Matrix32 easy2d::Node::getInverseTransform() const
@@ -597,10 +1389,103 @@ bool easy2d::Node::containsPoint(Point const& point)
 	if (_width == 0.f || _height == 0.f)
 		return false;
 
+	// ÿռеаΧпųһ
+	if (_proxy != -1)
+	{
+		_updateTransform();
+
+		Rect box = _parentScene->_spatialTree.getBounds(_proxy);
+		if (point.x < box.getLeft() - 1 || point.x > box.getRight() + 1 ||
+			point.y < box.getTop() - 1 || point.y > box.getBottom() + 1)
+		{
+			return false;
+		}
+	}
+
 	Point local = getInverseTransform().transform(point);
 	return getBounds().containsPoint(local);
 }
 
+bool easy2d::Node::intersectsRay(const Point& origin, const Vector2& direction, float maxDistance, float* distance)
+{
+	if (_width == 0.f || _height == 0.f)
+		return false;
+
+	float length = Point::distance(Point(), direction);
+	if (length == 0)
+		return false;
+
+	// 任ֱھֲϵеĲϵеľ
+	const Vector2 dir = direction / length;
+	const Matrix32 inverse = getInverseTransform();
+	const Point localOrigin = inverse.transform(origin);
+	const Vector2 localDir = inverse.transform(origin + dir) - localOrigin;
+
+	float tmin = 0, tmax = maxDistance;
+	const float lo[2] = { localOrigin.x, localOrigin.y };
+	const float ld[2] = { localDir.x, localDir.y };
+	const float extent[2] = { _width, _height };
+
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (ld[axis] == 0)
+		{
+			// ƽ
+			if (lo[axis] < 0 || lo[axis] > extent[axis])
+				return false;
+		}
+		else
+		{
+			float t1 = -lo[axis] / ld[axis];
+			float t2 = (extent[axis] - lo[axis]) / ld[axis];
+			tmin = max(tmin, min(t1, t2));
+			tmax = min(tmax, max(t1, t2));
+		}
+	}
+
+	if (tmin > tmax)
+		return false;
+
+	if (distance)
+	{
+		*distance = tmin;
+	}
+	return true;
+}
+
+void easy2d::Node::_updateProxy(const Matrix32& world, float width, float height)
+{
+	// 
+	if (_parentScene == nullptr || _parentScene == this)
+		return;
+
+	if (width <= 0 || height <= 0)
+	{
+		_removeProxy();
+		return;
+	}
+
+	const Bounds b = TransformBounds(world, 0, 0, width, height);
+	Rect box(b.left, b.top, b.right - b.left, b.bottom - b.top);
+	if (_proxy == -1)
+	{
+		_proxy = _parentScene->_spatialTree.createProxy(box, this);
+	}
+	else
+	{
+		_parentScene->_spatialTree.moveProxy(_proxy, box);
+	}
+}
+
+void easy2d::Node::_removeProxy()
+{
+	if (_proxy != -1)
+	{
+		_parentScene->_spatialTree.destroyProxy(_proxy);
+		_proxy = -1;
+	}
+}
+
 std::vector<easy2d::Node*> easy2d::Node::getChildren(const String& name) const
 {
 	std::vector<Node*> vChildren;
@@ -659,6 +1544,12 @@ bool easy2d::Node::removeChild(Node * child)
 		return false;
 	}
 
+	if (child && s_nParallelUpdates > 0)
+	{
+		Defer(this, child, [=]() { this->removeChild(child); });
+		return std::find(_children.begin(), _children.end(), child) != _children.end();
+	}
+
 	if (child)
 	{
 		auto iter = std::find(_children.begin(), _children.end(), child);
@@ -666,6 +1557,7 @@ bool easy2d::Node::removeChild(Node * child)
 		{
 			_children.erase(iter);
 			child->_parent = nullptr;
+			child->_attachSlot();
 
 			if (child->_parentScene)
 			{
@@ -673,6 +1565,7 @@ bool easy2d::Node::removeChild(Node * child)
 			}
 
 			child->release();
+			_setContentDirty();
 			return true;
 		}
 	}
@@ -688,6 +1581,12 @@ void easy2d::Node::removeChildren(const String& childName)
 		return;
 	}
 
+	if (s_nParallelUpdates > 0)
+	{
+		Defer(this, nullptr, [=]() { this->removeChildren(childName); });
+		return;
+	}
+
 	//  Hash ֵ
 	size_t hash = std::hash<String>{}(childName);
 
@@ -699,65 +1598,83 @@ void easy2d::Node::removeChildren(const String& childName)
 		{
 			_children.erase(_children.begin() + i);
 			child->_parent = nullptr;
+			child->_attachSlot();
 			if (child->_parentScene)
 			{
 				child->_setParentScene(nullptr);
 			}
 			child->release();
+			_setContentDirty();
 		}
 	}
 }
 
 void easy2d::Node::removeAllChildren()
 {
+	if (s_nParallelUpdates > 0)
+	{
+		Defer(this, nullptr, [=]() { this->removeAllChildren(); });
+		return;
+	}
+
 	// нڵüһ
 	for (auto child : _children)
 	{
+		child->_parent = nullptr;
+		child->_attachSlot();
+		if (child->_parentScene)
+		{
+			child->_setParentScene(nullptr);
+		}
 		child->release();
 	}
 	// մڵ
 	_children.clear();
+	_setContentDirty();
 }
 
 void easy2d::Node::runAction(Action * action)
 {
+	if (action && s_nParallelUpdates > 0)
+	{
+		Defer(this, action, [=]() { this->runAction(action); });
+		return;
+	}
+
 	ActionManager::start(action, this, false);
 }
 
 void easy2d::Node::resumeAction(const String& name)
 {
-	auto& actions = ActionManager::get(name);
-	for (auto action : actions)
+	if (s_nParallelUpdates > 0)
 	{
-		if (action->getTarget() == this)
-		{
-			action->resume();
-		}
+		Defer(this, nullptr, [=]() { this->resumeAction(name); });
+		return;
 	}
+
+	ActionManager::__resumeBindedWith(this, name);
 }
 
 void easy2d::Node::pauseAction(const String& name)
 {
-	auto& actions = ActionManager::get(name);
-	for (auto action : actions)
+	if (s_nParallelUpdates > 0)
 	{
-		if (action->getTarget() == this)
-		{
-			action->pause();
-		}
+		Defer(this, nullptr, [=]() { this->pauseAction(name); });
+		return;
 	}
+
+	ActionManager::__pauseBindedWith(this, name);
 }
 
 void easy2d::Node::stopAction(const String& name)
 {
-	auto& actions = ActionManager::get(name);
-	for (auto action : actions)
+	if (s_nParallelUpdates > 0)
 	{
-		if (action->getTarget() == this)
-		{
-			action->stop();
-		}
+		Defer(this, nullptr, [=]() { this->stopAction(name); });
+		return;
 	}
+
+	ActionManager::__stopBindedWith(this, name);
 }
 
 void easy2d::Node::setAutoUpdate(bool bAutoUpdate)
@@ -765,6 +1682,16 @@ void easy2d::Node::setAutoUpdate(bool bAutoUpdate)
 	_autoUpdate = bAutoUpdate;
 }
 
+void easy2d::Node::setParallelUpdate(bool parallel)
+{
+	_parallelUpdate = parallel;
+}
+
+bool easy2d::Node::isParallelUpdate() const
+{
+	return _parallelUpdate;
+}
+
 void easy2d::Node::setDefaultAnchor(float defaultAnchorX, float defaultAnchorY)
 {
 	s_fDefaultAnchorX = min(max(float(defaultAnchorX), 0), 1);
@@ -773,21 +1700,45 @@ void easy2d::Node::setDefaultAnchor(float defaultAnchorX, float defaultAnchorY)
 
 void easy2d::Node::resumeAllActions()
 {
+	if (s_nParallelUpdates > 0)
+	{
+		Defer(this, nullptr, [=]() { this->resumeAllActions(); });
+		return;
+	}
+
 	ActionManager::__resumeAllBindedWith(this);
 }
 
 void easy2d::Node::pauseAllActions()
 {
+	if (s_nParallelUpdates > 0)
+	{
+		Defer(this, nullptr, [=]() { this->pauseAllActions(); });
+		return;
+	}
+
 	ActionManager::__pauseAllBindedWith(this);
 }
 
 void easy2d::Node::stopAllActions()
 {
+	if (s_nParallelUpdates > 0)
+	{
+		Defer(this, nullptr, [=]() { this->stopAllActions(); });
+		return;
+	}
+
 	ActionManager::__stopAllBindedWith(this);
 }
 
 void easy2d::Node::dispatch(Event* evt)
 {
+	// ťֻµϢɳͨռַҪ
+	if (_parentScene == this)
+	{
+		static_cast<Scene*>(this)->_dispatchToButtons(evt);
+	}
+
 	__updateListeners(evt);
 
 	for (const auto& child : _children)
@@ -798,7 +1749,11 @@ void easy2d::Node::dispatch(Event* evt)
 
 void easy2d::Node::setVisible(bool value)
 {
+	if (_visible == value)
+		return;
+
 	_visible = value;
+	_setContentDirty();
 }
 
 void easy2d::Node::setName(const String& name)
@@ -816,7 +1771,18 @@ void easy2d::Node::setName(const String& name)
 
 void easy2d::Node::_setParentScene(Scene * scene)
 {
-	_parentScene = scene;
+	if (_parentScene != scene)
+	{
+		// 뿪ԭĳʱƳΧУ´θ±任ʱ³
+		_removeProxy();
+		if (_parentScene && _parentScene->_hoverButton == this)
+		{
+			_parentScene->_hoverButton = nullptr;
+		}
+		_parentScene = scene;
+		MarkDirty(_slot);
+	}
+
 	for (auto child : _children)
 	{
 		child->_setParentScene(scene);
@@ -1,12 +1,220 @@
 #include <easy2d/e2dbase.h>
 #include <easy2d/e2dnode.h>
 #include <easy2d/e2dmanager.h>
+#include <algorithm>
+
+namespace
+{
+	// a Ƿ b յ Node::dispatch ַϢ
+	// ڵӽڵ㣬ֵܽڵ㰴ӽڵбе˳
+	bool DispatchesBefore(easy2d::Node * a, easy2d::Node * b)
+	{
+		std::vector<easy2d::Node*> pathA, pathB;
+		for (auto node = a; node; node = node->getParent()) pathA.push_back(node);
+		for (auto node = b; node; node = node->getParent()) pathB.push_back(node);
+
+		// Ӹڵ㿪ʼҵһͬ
+		auto ia = pathA.rbegin(), ib = pathB.rbegin();
+		while (ia != pathA.rend() && ib != pathB.rend() && *ia == *ib)
+		{
+			++ia;
+			++ib;
+		}
+
+		if (ia == pathA.rend())
+			return true;	// a  b 
+		if (ib == pathB.rend())
+			return false;	// b  a 
+
+		const auto& siblings = (*(ia - 1))->getAllChildren();
+		return std::find(siblings.begin(), siblings.end(), *ia) < std::find(siblings.begin(), siblings.end(), *ib);
+	}
+}
 
 easy2d::Scene::Scene()
+	: _camera(nullptr)
+	, _hoverButton(nullptr)
 {
 	_setParentScene(this);
+	setCamera(gcnew Camera);
 }
 
 easy2d::Scene::~Scene()
 {
+	// ӽڵܱȳڵøãڿռǰƳǵİΧ
+	for (auto child : _children)
+	{
+		child->_setParentScene(nullptr);
+	}
+
+	if (_camera)
+	{
+		_camera->_scene = nullptr;
+		GC::release(_camera);
+	}
+}
+
+std::vector<easy2d::Node*> easy2d::Scene::queryPoint(const Point& point)
+{
+	Node::__updateTransforms();
+
+	std::vector<Node*> nodes;
+	_spatialTree.query(Rect(point, Size()), [&](Node* node)
+	{
+		if (node->containsPoint(point))
+		{
+			nodes.push_back(node);
+		}
+		return true;
+	});
+	return std::move(nodes);
+}
+
+std::vector<easy2d::Node*> easy2d::Scene::queryRect(const Rect& rect)
+{
+	Node::__updateTransforms();
+
+	std::vector<Node*> nodes;
+	_spatialTree.query(rect, [&](Node* node)
+	{
+		nodes.push_back(node);
+		return true;
+	});
+	return std::move(nodes);
+}
+
+std::vector<easy2d::Node*> easy2d::Scene::queryRay(const Point& origin, const Vector2& direction, float maxDistance)
+{
+	Node::__updateTransforms();
+
+	std::vector<std::pair<float, Node*>> hits;
+	_spatialTree.raycast(origin, direction, maxDistance, [&](Node* node)
+	{
+		float distance = 0;
+		if (node->intersectsRay(origin, direction, maxDistance, &distance))
+		{
+			hits.push_back(std::make_pair(distance, node));
+		}
+		return true;
+	});
+
+	std::sort(hits.begin(), hits.end(), [](const std::pair<float, Node*>& a, const std::pair<float, Node*>& b)
+	{
+		return a.first < b.first;
+	});
+
+	std::vector<Node*> nodes;
+	nodes.reserve(hits.size());
+	for (const auto& hit : hits)
+	{
+		nodes.push_back(hit.second);
+	}
+	return std::move(nodes);
+}
+
+const easy2d::SpatialTree& easy2d::Scene::getSpatialTree()
+{
+	Node::__updateTransforms();
+	return _spatialTree;
+}
+
+void easy2d::Scene::setCamera(Camera * camera)
+{
+	if (_camera == camera)
+		return;
+
+	if (camera && camera->_scene)
+	{
+		E2D_WARNING(L"Scene::setCamera failed! The camera already belongs to another scene.");
+		return;
+	}
+
+	if (_camera)
+	{
+		_camera->_scene = nullptr;
+		GC::release(_camera);
+	}
+
+	_camera = camera;
+	if (_camera)
+	{
+		_camera->_scene = this;
+		GC::retain(_camera);
+	}
+	_setContentDirty();
+}
+
+easy2d::Camera * easy2d::Scene::getCamera() const
+{
+	return _camera;
+}
+
+void easy2d::Scene::_renderView()
+{
+	if (!_camera)
+	{
+		_render();
+		return;
+	}
+
+	// ͼڳı任֮ǰתƶʱŵӰ
+	Matrix32 world = getTransform();
+	Matrix32 view = Matrix32::invert(world) * _camera->getViewMatrix() * world;
+
+	Matrix32 prevView = Renderer::__getViewMatrix();
+	Renderer::__setViewMatrix(Matrix32(view * prevView));
+	_render();
+	Renderer::__setViewMatrix(prevView);
+}
+
+void easy2d::Scene::_dispatchToButtons(Event * evt)
+{
+	if (SceneManager::isTransitioning() || Game::isPaused())
+		return;
+
+	if (evt->type == Event::Type::MouseMove)
+	{
+		// λĻ꣬ƶźҪתΪ
+		MouseMoveEvent* mme = dynamic_cast<MouseMoveEvent*>(evt);
+		Point pos = Point{ mme->x, mme->y };
+		if (_camera)
+		{
+			pos = _camera->screenToWorld(pos);
+		}
+
+		// ťصʱַʱһյϢİťӦ
+		Button* target = nullptr;
+		if (!evt->target)
+		{
+			Node::__updateTransforms();
+			_spatialTree.query(Rect(pos, Size()), [&](Node* node)
+			{
+				Button* button = dynamic_cast<Button*>(node);
+				if (button && button->_visible && button->_normal && button->containsPoint(pos))
+				{
+					if (!target || DispatchesBefore(button, target))
+					{
+						target = button;
+					}
+				}
+				return true;
+			});
+		}
+
+		if (_hoverButton && _hoverButton != target)
+		{
+			_hoverButton->_updateStatus(evt, false);
+		}
+
+		if (target)
+		{
+			target->_updateStatus(evt, true);
+		}
+		_hoverButton = target;
+	}
+	else if (_hoverButton && (evt->type == Event::Type::MouseDown || evt->type == Event::Type::MouseUp))
+	{
+		// ֻͣİťܱ
+		_hoverButton->_updateStatus(evt, true);
+	}
 }
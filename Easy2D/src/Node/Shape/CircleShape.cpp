@@ -1,4 +1,5 @@
 #include <easy2d/e2dshape.h>
+#include <easy2d/e2drender.h>
 
 easy2d::CircleShape::CircleShape()
 	: _radius(0)
@@ -34,20 +35,23 @@ void easy2d::CircleShape::setRadius(float radius)
 	Node::setSize(radius * 2, radius * 2);
 }
 
-void easy2d::CircleShape::_renderLine()
+void easy2d::CircleShape::_renderLine(const Color& color)
 {
-	Renderer::getRenderTarget()->DrawEllipse(
-		D2D1::Ellipse(D2D1::Point2F(_radius, _radius), _radius, _radius),
-		Renderer::getSolidColorBrush(),
-		_strokeWidth,
-		_strokeStyle
+	Renderer::getDevice()->drawEllipse(
+		Point(_radius, _radius),
+		_radius,
+		_radius,
+		color,
+		_strokeWidth
 	);
 }
 
-void easy2d::CircleShape::_renderFill()
+void easy2d::CircleShape::_renderFill(const Color& color)
 {
-	Renderer::getRenderTarget()->FillEllipse(
-		D2D1::Ellipse(D2D1::Point2F(_radius, _radius), _radius, _radius),
-		Renderer::getSolidColorBrush()
+	Renderer::getDevice()->fillEllipse(
+		Point(_radius, _radius),
+		_radius,
+		_radius,
+		color
 	);
 }
@@ -1,4 +1,5 @@
 #include <easy2d/e2dshape.h>
+#include <easy2d/e2drender.h>
 
 easy2d::EllipseShape::EllipseShape()
 	: _radiusX(0)
@@ -48,20 +49,23 @@ void easy2d::EllipseShape::setRadiusY(float radiusY)
 	Node::setHeight(radiusY * 2);
 }
 
-void easy2d::EllipseShape::_renderLine()
+void easy2d::EllipseShape::_renderLine(const Color& color)
 {
-	Renderer::getRenderTarget()->DrawEllipse(
-		D2D1::Ellipse(D2D1::Point2F(_radiusX, _radiusY), _radiusX, _radiusY),
-		Renderer::getSolidColorBrush(),
-		_strokeWidth,
-		_strokeStyle
+	Renderer::getDevice()->drawEllipse(
+		Point(_radiusX, _radiusY),
+		_radiusX,
+		_radiusY,
+		color,
+		_strokeWidth
 	);
 }
 
-void easy2d::EllipseShape::_renderFill()
+void easy2d::EllipseShape::_renderFill(const Color& color)
 {
-	Renderer::getRenderTarget()->FillEllipse(
-		D2D1::Ellipse(D2D1::Point2F(_radiusX, _radiusY), _radiusX, _radiusY),
-		Renderer::getSolidColorBrush()
+	Renderer::getDevice()->fillEllipse(
+		Point(_radiusX, _radiusY),
+		_radiusX,
+		_radiusY,
+		color
 	);
 }
@@ -1,4 +1,5 @@
 #include <easy2d/e2dshape.h>
+#include <easy2d/e2drender.h>
 
 easy2d::RectShape::RectShape()
 {
@@ -20,20 +21,20 @@ easy2d::RectShape::~RectShape()
 {
 }
 
-void easy2d::RectShape::_renderLine()
+void easy2d::RectShape::_renderLine(const Color& color)
 {
-	Renderer::getRenderTarget()->DrawRectangle(
-		D2D1::RectF(0, 0, _width, _height),
-		Renderer::getSolidColorBrush(),
+	Renderer::getDevice()->drawRect(
+		Rect(0, 0, _width, _height),
+		color,
 		_strokeWidth,
-		_strokeStyle
+		_lineJoin
 	);
 }
 
-void easy2d::RectShape::_renderFill()
+void easy2d::RectShape::_renderFill(const Color& color)
 {
-	Renderer::getRenderTarget()->FillRectangle(
-		D2D1::RectF(0, 0, _width, _height),
-		Renderer::getSolidColorBrush()
+	Renderer::getDevice()->fillRect(
+		Rect(0, 0, _width, _height),
+		color
 	);
 }
@@ -1,4 +1,5 @@
 #include <easy2d/e2dshape.h>
+#include <easy2d/e2drender.h>
 
 easy2d::RoundRectShape::RoundRectShape()
 	: _radiusX(0)
@@ -39,27 +40,33 @@ float easy2d::RoundRectShape::getRadiusY() const
 void easy2d::RoundRectShape::setRadiusX(float radiusX)
 {
 	_radiusX = float(radiusX);
+	_setContentDirty();
 }
 
 void easy2d::RoundRectShape::setRadiusY(float radiusY)
 {
 	_radiusY = float(radiusY);
+	_setContentDirty();
 }
 
-void easy2d::RoundRectShape::_renderLine()
+void easy2d::RoundRectShape::_renderLine(const Color& color)
 {
-	Renderer::getRenderTarget()->DrawRoundedRectangle(
-		D2D1::RoundedRect(D2D1::RectF(0, 0, _width, _height), _radiusX, _radiusY),
-		Renderer::getSolidColorBrush(),
+	Renderer::getDevice()->drawRoundedRect(
+		Rect(0, 0, _width, _height),
+		_radiusX,
+		_radiusY,
+		color,
 		_strokeWidth,
-		_strokeStyle
+		_lineJoin
 	);
 }
 
-void easy2d::RoundRectShape::_renderFill()
+void easy2d::RoundRectShape::_renderFill(const Color& color)
 {
-	Renderer::getRenderTarget()->FillRoundedRectangle(
-		D2D1::RoundedRect(D2D1::RectF(0, 0, _width, _height), _radiusX, _radiusY),
-		Renderer::getSolidColorBrush()
+	Renderer::getDevice()->fillRoundedRect(
+		Rect(0, 0, _width, _height),
+		_radiusX,
+		_radiusY,
+		color
 	);
 }
@@ -1,11 +1,12 @@
 #include <easy2d/e2dshape.h>
+#include <typeinfo>
 
 easy2d::Shape::Shape()
 	: _style(Style::Solid)
 	, _fillColor(0x6090A0U)
 	, _lineColor(0x78B7D0U)
 	, _strokeWidth(2)
-	, _strokeStyle(nullptr)
+	, _lineJoin(LineJoin::Miter)
 {
 }
 
@@ -15,32 +16,28 @@ easy2d::Shape::~Shape()
 
 void easy2d::Shape::onRender()
 {
-	auto pBrush = Renderer::getSolidColorBrush();
-	pBrush->SetOpacity(_displayOpacity);
+	// ɫ͸ڵʾ͸
+	const Color fillColor(_fillColor.getRed(), _fillColor.getGreen(), _fillColor.getBlue(), _fillColor.getAlpha() * _displayOpacity);
+	const Color lineColor(_lineColor.getRed(), _lineColor.getGreen(), _lineColor.getBlue(), _lineColor.getAlpha() * _displayOpacity);
 
 	switch (_style)
 	{
 	case Style::Fill:
 	{
-		pBrush->SetColor(_fillColor.toD2DColorF());
-		this->_renderFill();
-
-		pBrush->SetColor(_lineColor.toD2DColorF());
-		this->_renderLine();
+		this->_renderFill(fillColor);
+		this->_renderLine(lineColor);
 		break;
 	}
 
 	case Style::Round:
 	{
-		pBrush->SetColor(_lineColor.toD2DColorF());
-		this->_renderLine();
+		this->_renderLine(lineColor);
 		break;
 	}
 
 	case Style::Solid:
 	{
-		pBrush->SetColor(_fillColor.toD2DColorF());
-		this->_renderFill();
+		this->_renderFill(fillColor);
 		break;
 	}
 
@@ -72,38 +69,45 @@ easy2d::Shape::Style easy2d::Shape::getStyle() const
 void easy2d::Shape::setFillColor(Color fillColor)
 {
 	_fillColor = fillColor;
+	_setContentDirty();
 }
 
 void easy2d::Shape::setLineColor(Color lineColor)
 {
 	_lineColor = lineColor;
+	_setContentDirty();
 }
 
 void easy2d::Shape::setStrokeWidth(float strokeWidth)
 {
 	_strokeWidth = float(strokeWidth) * 2;
+	_setBoundsDirty();
+	_setContentDirty();
 }
 
 void easy2d::Shape::setStyle(Style style)
 {
 	_style = style;
+	_setContentDirty();
 }
 
 void easy2d::Shape::setLineJoin(LineJoin lineJoin)
 {
-	switch (lineJoin)
-	{
-	case LineJoin::Miter:
-		_strokeStyle = Renderer::getMiterID2D1StrokeStyle();
-		break;
-	case LineJoin::Bevel:
-		_strokeStyle = Renderer::getBevelID2D1StrokeStyle();
-		break;
-	case LineJoin::Round:
-		_strokeStyle = Renderer::getRoundID2D1StrokeStyle();
-		break;
-	default:
-		_strokeStyle = nullptr;
-		break;
-	}
+	_lineJoin = lineJoin;
+	_setContentDirty();
+}
+
+float easy2d::Shape::_getRenderMargin() const
+{
+	return _strokeWidth / 2;
+}
+
+bool easy2d::Shape::_isRecordable() const
+{
+	// д onRender
+	const std::type_info& type = typeid(*this);
+	return type == typeid(RectShape)
+		|| type == typeid(RoundRectShape)
+		|| type == typeid(CircleShape)
+		|| type == typeid(EllipseShape);
 }
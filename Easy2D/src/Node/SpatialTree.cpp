@@ -0,0 +1,444 @@
+#include <easy2d/e2dnode.h>
+
+namespace
+{
+	const int NULL_NODE = -1;
+
+	// Χľ룬ڵСƶʱҪ²
+	const float FAT_MARGIN = 8.f;
+
+	inline float Perimeter(float minX, float minY, float maxX, float maxY)
+	{
+		return 2.f * ((maxX - minX) + (maxY - minY));
+	}
+
+	// ΧеཻԣؽΧʱľ
+	inline bool RayHitsBox(
+		const easy2d::Point& origin,
+		const easy2d::Vector2& invDir,
+		float maxDistance,
+		float minX, float minY, float maxX, float maxY
+	)
+	{
+		float t1 = (minX - origin.x) * invDir.x;
+		float t2 = (maxX - origin.x) * invDir.x;
+		float tmin = min(t1, t2);
+		float tmax = max(t1, t2);
+
+		t1 = (minY - origin.y) * invDir.y;
+		t2 = (maxY - origin.y) * invDir.y;
+		tmin = max(tmin, min(t1, t2));
+		tmax = min(tmax, max(t1, t2));
+
+		return tmax >= max(tmin, 0.f) && tmin <= maxDistance;
+	}
+}
+
+easy2d::SpatialTree::SpatialTree()
+	: _root(NULL_NODE)
+	, _freeList(NULL_NODE)
+	, _proxyCount(0)
+{
+}
+
+int easy2d::SpatialTree::createProxy(const Rect& bounds, Node * node)
+{
+	int id = _allocateNode();
+	_nodes[id].node = node;
+	_nodes[id].bounds = bounds;
+	_nodes[id].height = 0;
+	_setFatBounds(id, bounds);
+
+	_insertLeaf(id);
+	++_proxyCount;
+	return id;
+}
+
+void easy2d::SpatialTree::destroyProxy(int proxy)
+{
+	_removeLeaf(proxy);
+	_freeNode(proxy);
+	--_proxyCount;
+}
+
+bool easy2d::SpatialTree::moveProxy(int proxy, const Rect& bounds)
+{
+	auto& leaf = _nodes[proxy];
+	leaf.bounds = bounds;
+
+	// İΧʱҪ
+	if (bounds.getLeft() >= leaf.minX && bounds.getTop() >= leaf.minY &&
+		bounds.getRight() <= leaf.maxX && bounds.getBottom() <= leaf.maxY)
+	{
+		return false;
+	}
+
+	_removeLeaf(proxy);
+	_setFatBounds(proxy, bounds);
+	_insertLeaf(proxy);
+	return true;
+}
+
+easy2d::Node * easy2d::SpatialTree::getNode(int proxy) const
+{
+	return _nodes[proxy].node;
+}
+
+easy2d::Rect easy2d::SpatialTree::getBounds(int proxy) const
+{
+	return _nodes[proxy].bounds;
+}
+
+void easy2d::SpatialTree::query(const Rect& rect, const QueryCallback& callback) const
+{
+	if (_root == NULL_NODE)
+		return;
+
+	const float minX = rect.getLeft(), minY = rect.getTop();
+	const float maxX = rect.getRight(), maxY = rect.getBottom();
+
+	std::vector<int> stack;
+	stack.push_back(_root);
+
+	while (!stack.empty())
+	{
+		const auto& node = _nodes[stack.back()];
+		stack.pop_back();
+
+		if (node.maxX < minX || node.minX > maxX || node.maxY < minY || node.minY > maxY)
+			continue;
+
+		if (node.isLeaf())
+		{
+			// ҶʵʵİΧмһ
+			const Rect& b = node.bounds;
+			if (b.getRight() >= minX && b.getLeft() <= maxX && b.getBottom() >= minY && b.getTop() <= maxY)
+			{
+				if (!callback(node.node))
+					return;
+			}
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+void easy2d::SpatialTree::raycast(const Point& origin, const Vector2& direction, float maxDistance, const QueryCallback& callback) const
+{
+	if (_root == NULL_NODE)
+		return;
+
+	float length = Point::distance(Point(), direction);
+	if (length == 0)
+		return;
+
+	// ΪʱΪ󣬱ȽϽȻȷ
+	Vector2 dir = direction / length;
+	Vector2 invDir(1.f / dir.x, 1.f / dir.y);
+
+	std::vector<int> stack;
+	stack.push_back(_root);
+
+	while (!stack.empty())
+	{
+		const auto& node = _nodes[stack.back()];
+		stack.pop_back();
+
+		if (!RayHitsBox(origin, invDir, maxDistance, node.minX, node.minY, node.maxX, node.maxY))
+			continue;
+
+		if (node.isLeaf())
+		{
+			const Rect& b = node.bounds;
+			if (RayHitsBox(origin, invDir, maxDistance, b.getLeft(), b.getTop(), b.getRight(), b.getBottom()))
+			{
+				if (!callback(node.node))
+					return;
+			}
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+size_t easy2d::SpatialTree::getProxyCount() const
+{
+	return _proxyCount;
+}
+
+int easy2d::SpatialTree::getHeight() const
+{
+	return (_root == NULL_NODE) ? 0 : _nodes[_root].height;
+}
+
+int easy2d::SpatialTree::_allocateNode()
+{
+	if (_freeList == NULL_NODE)
+	{
+		TreeNode node;
+		node.parent = NULL_NODE;
+		_nodes.push_back(node);
+		_freeList = static_cast<int>(_nodes.size()) - 1;
+	}
+
+	int id = _freeList;
+	auto& node = _nodes[id];
+	_freeList = node.parent;
+	node.parent = NULL_NODE;
+	node.child1 = NULL_NODE;
+	node.child2 = NULL_NODE;
+	node.height = 0;
+	node.node = nullptr;
+	return id;
+}
+
+void easy2d::SpatialTree::_freeNode(int id)
+{
+	_nodes[id].parent = _freeList;
+	_nodes[id].height = -1;
+	_nodes[id].node = nullptr;
+	_freeList = id;
+}
+
+void easy2d::SpatialTree::_setFatBounds(int id, const Rect& bounds)
+{
+	auto& node = _nodes[id];
+	node.minX = bounds.getLeft() - FAT_MARGIN;
+	node.minY = bounds.getTop() - FAT_MARGIN;
+	node.maxX = bounds.getRight() + FAT_MARGIN;
+	node.maxY = bounds.getBottom() + FAT_MARGIN;
+}
+
+void easy2d::SpatialTree::_combine(int id, int child1, int child2)
+{
+	auto& node = _nodes[id];
+	const auto& a = _nodes[child1];
+	const auto& b = _nodes[child2];
+	node.minX = min(a.minX, b.minX);
+	node.minY = min(a.minY, b.minY);
+	node.maxX = max(a.maxX, b.maxX);
+	node.maxY = max(a.maxY, b.maxY);
+	node.height = 1 + max(a.height, b.height);
+}
+
+void easy2d::SpatialTree::_insertLeaf(int leaf)
+{
+	if (_root == NULL_NODE)
+	{
+		_root = leaf;
+		_nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// ܳ²ʵֵܽڵ
+	const auto& leafNode = _nodes[leaf];
+	const float lminX = leafNode.minX, lminY = leafNode.minY;
+	const float lmaxX = leafNode.maxX, lmaxY = leafNode.maxY;
+
+	int index = _root;
+	while (!_nodes[index].isLeaf())
+	{
+		const auto& node = _nodes[index];
+		const int child1 = node.child1;
+		const int child2 = node.child2;
+
+		const float area = Perimeter(node.minX, node.minY, node.maxX, node.maxY);
+		const float combinedArea = Perimeter(
+			min(node.minX, lminX), min(node.minY, lminY),
+			max(node.maxX, lmaxX), max(node.maxY, lmaxY)
+		);
+
+		// ﴴµĸڵĴ
+		const float cost = 2.f * combinedArea;
+		// ʱҪĴ
+		const float inheritanceCost = 2.f * (combinedArea - area);
+
+		float cost1, cost2;
+		{
+			const auto& c = _nodes[child1];
+			float newArea = Perimeter(min(c.minX, lminX), min(c.minY, lminY), max(c.maxX, lmaxX), max(c.maxY, lmaxY));
+			cost1 = c.isLeaf() ? newArea + inheritanceCost : (newArea - Perimeter(c.minX, c.minY, c.maxX, c.maxY)) + inheritanceCost;
+		}
+		{
+			const auto& c = _nodes[child2];
+			float newArea = Perimeter(min(c.minX, lminX), min(c.minY, lminY), max(c.maxX, lmaxX), max(c.maxY, lmaxY));
+			cost2 = c.isLeaf() ? newArea + inheritanceCost : (newArea - Perimeter(c.minX, c.minY, c.maxX, c.maxY)) + inheritanceCost;
+		}
+
+		if (cost < cost1 && cost < cost2)
+			break;
+
+		index = (cost1 < cost2) ? child1 : child2;
+	}
+
+	const int sibling = index;
+
+	// µĸڵ
+	const int oldParent = _nodes[sibling].parent;
+	const int newParent = _allocateNode();
+	_nodes[newParent].parent = oldParent;
+	_nodes[newParent].child1 = sibling;
+	_nodes[newParent].child2 = leaf;
+	_combine(newParent, sibling, leaf);
+	_nodes[sibling].parent = newParent;
+	_nodes[leaf].parent = newParent;
+
+	if (oldParent != NULL_NODE)
+	{
+		if (_nodes[oldParent].child1 == sibling)
+			_nodes[oldParent].child1 = newParent;
+		else
+			_nodes[oldParent].child2 = newParent;
+	}
+	else
+	{
+		_root = newParent;
+	}
+
+	// ϸ°Χк͸߶
+	index = _nodes[leaf].parent;
+	while (index != NULL_NODE)
+	{
+		index = _balance(index);
+		_combine(index, _nodes[index].child1, _nodes[index].child2);
+		index = _nodes[index].parent;
+	}
+}
+
+void easy2d::SpatialTree::_removeLeaf(int leaf)
+{
+	if (leaf == _root)
+	{
+		_root = NULL_NODE;
+		return;
+	}
+
+	const int parent = _nodes[leaf].parent;
+	const int grandParent = _nodes[parent].parent;
+	const int sibling = (_nodes[parent].child1 == leaf) ? _nodes[parent].child2 : _nodes[parent].child1;
+
+	if (grandParent != NULL_NODE)
+	{
+		// ֵܽڵ游ڵ
+		if (_nodes[grandParent].child1 == parent)
+			_nodes[grandParent].child1 = sibling;
+		else
+			_nodes[grandParent].child2 = sibling;
+		_nodes[sibling].parent = grandParent;
+		_freeNode(parent);
+
+		int index = grandParent;
+		while (index != NULL_NODE)
+		{
+			index = _balance(index);
+			_combine(index, _nodes[index].child1, _nodes[index].child2);
+			index = _nodes[index].parent;
+		}
+	}
+	else
+	{
+		_root = sibling;
+		_nodes[sibling].parent = NULL_NODE;
+		_freeNode(parent);
+	}
+}
+
+int easy2d::SpatialTree::_balance(int iA)
+{
+	// ߶ 1 ʱתתĸ
+	auto* A = &_nodes[iA];
+	if (A->isLeaf() || A->height < 2)
+		return iA;
+
+	const int iB = A->child1;
+	const int iC = A->child2;
+	const int balance = _nodes[iC].height - _nodes[iB].height;
+
+	if (balance > 1)
+	{
+		//  C 
+		const int iF = _nodes[iC].child1;
+		const int iG = _nodes[iC].child2;
+
+		_nodes[iC].child1 = iA;
+		_nodes[iC].parent = A->parent;
+		A->parent = iC;
+
+		if (_nodes[iC].parent != NULL_NODE)
+		{
+			auto& p = _nodes[_nodes[iC].parent];
+			if (p.child1 == iA)
+				p.child1 = iC;
+			else
+				p.child2 = iC;
+		}
+		else
+		{
+			_root = iC;
+		}
+
+		if (_nodes[iF].height > _nodes[iG].height)
+		{
+			_nodes[iC].child2 = iF;
+			A->child2 = iG;
+			_nodes[iG].parent = iA;
+		}
+		else
+		{
+			_nodes[iC].child2 = iG;
+			A->child2 = iF;
+			_nodes[iF].parent = iA;
+		}
+		_combine(iA, A->child1, A->child2);
+		_combine(iC, _nodes[iC].child1, _nodes[iC].child2);
+		return iC;
+	}
+
+	if (balance < -1)
+	{
+		//  B 
+		const int iD = _nodes[iB].child1;
+		const int iE = _nodes[iB].child2;
+
+		_nodes[iB].child1 = iA;
+		_nodes[iB].parent = A->parent;
+		A->parent = iB;
+
+		if (_nodes[iB].parent != NULL_NODE)
+		{
+			auto& p = _nodes[_nodes[iB].parent];
+			if (p.child1 == iA)
+				p.child1 = iB;
+			else
+				p.child2 = iB;
+		}
+		else
+		{
+			_root = iB;
+		}
+
+		if (_nodes[iD].height > _nodes[iE].height)
+		{
+			_nodes[iB].child2 = iD;
+			A->child1 = iE;
+			_nodes[iE].parent = iA;
+		}
+		else
+		{
+			_nodes[iB].child2 = iE;
+			A->child1 = iD;
+			_nodes[iD].parent = iA;
+		}
+		_combine(iA, A->child1, A->child2);
+		_combine(iB, _nodes[iB].child1, _nodes[iB].child2);
+		return iB;
+	}
+
+	return iA;
+}
@@ -1,4 +1,5 @@
 #include <easy2d/e2dnode.h>
+#include <typeinfo>
 
 
 easy2d::Sprite::Sprite()
@@ -52,6 +53,22 @@ bool easy2d::Sprite::open(Image * image)
 		_image->retain();
 
 		Node::setSize(_image->getWidth(), _image->getHeight());
+		_setContentDirty();
+
+		if (_image->getState() == Image::State::Loading)
+		{
+			// ͼƬɺ¾С
+			this->retain();
+			_image->addLoadCallback([this](Image* loaded)
+			{
+				if (_image == loaded)
+				{
+					Node::setSize(loaded->getWidth(), loaded->getHeight());
+					_setContentDirty();
+				}
+				this->release();
+			});
+		}
 		return true;
 	}
 	return false;
@@ -68,6 +85,7 @@ bool easy2d::Sprite::open(const String& filePath)
 	if (_image->open(filePath))
 	{
 		Node::setSize(_image->getWidth(), _image->getHeight());
+		_setContentDirty();
 		return true;
 	}
 	return false;
@@ -84,6 +102,7 @@ bool easy2d::Sprite::open(int resNameId, const String& resType)
 	if (_image->open(resNameId, resType))
 	{
 		Node::setSize(_image->getWidth(), _image->getHeight());
+		_setContentDirty();
 		return true;
 	}
 	return false;
@@ -96,6 +115,7 @@ void easy2d::Sprite::crop(const Rect& cropRect)
 		min(max(cropRect.size.width, 0), _image->getSourceWidth() - _image->getCropX()),
 		min(max(cropRect.size.height, 0), _image->getSourceHeight() - _image->getCropY())
 	);
+	_setContentDirty();
 }
 
 easy2d::Image * easy2d::Sprite::getImage() const
@@ -110,3 +130,9 @@ void easy2d::Sprite::onRender()
 		_image->draw(Rect(0, 0, _width, _height), _displayOpacity);
 	}
 }
+
+bool easy2d::Sprite::_isRecordable() const
+{
+	// д onRender
+	return typeid(*this) == typeid(Sprite);
+}
@@ -1,4 +1,5 @@
 #include <easy2d/e2dnode.h>
+#include <easy2d/e2drender.h>
 
 //-------------------------------------------------------
 // Style
@@ -289,8 +290,11 @@ void easy2d::Text::setOutlineJoin(LineJoin outlineJoin)
 
 void easy2d::Text::onRender()
 {
-	if (_textLayout)
+	// ֻ Direct2D 豸
+	if (_textLayout && dynamic_cast<D2DRenderDevice*>(Renderer::getDevice()))
 	{
+		// ֱӻƵȾĿ꣬ύľ
+		Renderer::getDevice()->flush();
 		// ûˢɫ͸
 		Renderer::getSolidColorBrush()->SetOpacity(_displayOpacity);
 		// ıȾʽ
@@ -0,0 +1,77 @@
+#include <easy2d/e2dbase.h>
+
+// ޴ģʽû豸аΪδ
+
+bool easy2d::Input::__init()
+{
+	return true;
+}
+
+void easy2d::Input::__uninit()
+{
+}
+
+void easy2d::Input::__update()
+{
+	E2D_PROFILE_SCOPE("Input::update");
+}
+
+bool easy2d::Input::isDown(KeyCode::Value key)
+{
+	return false;
+}
+
+bool easy2d::Input::isPress(KeyCode::Value key)
+{
+	return false;
+}
+
+bool easy2d::Input::isRelease(KeyCode::Value key)
+{
+	return false;
+}
+
+bool easy2d::Input::isDown(MouseCode::Value code)
+{
+	return false;
+}
+
+bool easy2d::Input::isPress(MouseCode::Value code)
+{
+	return false;
+}
+
+bool easy2d::Input::isRelease(MouseCode::Value code)
+{
+	return false;
+}
+
+float easy2d::Input::getMouseX()
+{
+	return 0.f;
+}
+
+float easy2d::Input::getMouseY()
+{
+	return 0.f;
+}
+
+easy2d::Point easy2d::Input::getMousePos()
+{
+	return Point();
+}
+
+float easy2d::Input::getMouseDeltaX()
+{
+	return 0.f;
+}
+
+float easy2d::Input::getMouseDeltaY()
+{
+	return 0.f;
+}
+
+float easy2d::Input::getMouseDeltaZ()
+{
+	return 0.f;
+}
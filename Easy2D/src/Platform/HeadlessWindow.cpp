@@ -0,0 +1,89 @@
+#include <easy2d/e2dbase.h>
+
+// ޴ģʽµĴʵ
+// ֻ¼ԣʾϢ־
+
+static easy2d::String s_sTitle;
+static easy2d::Size s_windowSize;
+static easy2d::Window::Cursor s_currentCursor = easy2d::Window::Cursor::Normal;
+
+
+bool easy2d::Window::__init(const String& title, int nWidth, int nHeight)
+{
+	s_sTitle = title;
+	s_windowSize = Size(float(nWidth), float(nHeight));
+	return true;
+}
+
+void easy2d::Window::__uninit()
+{
+}
+
+void easy2d::Window::__poll()
+{
+}
+
+void easy2d::Window::__updateCursor()
+{
+}
+
+float easy2d::Window::getWidth()
+{
+	return getSize().width;
+}
+
+float easy2d::Window::getHeight()
+{
+	return getSize().height;
+}
+
+easy2d::Size easy2d::Window::getSize()
+{
+	return s_windowSize;
+}
+
+void easy2d::Window::setSize(int width, int height)
+{
+	s_windowSize = Size(float(width), float(height));
+}
+
+void easy2d::Window::setTitle(const String& title)
+{
+	s_sTitle = title;
+}
+
+void easy2d::Window::setIcon(int iconID)
+{
+}
+
+void easy2d::Window::setCursor(Cursor cursor)
+{
+	s_currentCursor = cursor;
+}
+
+easy2d::String easy2d::Window::getTitle()
+{
+	return s_sTitle;
+}
+
+void easy2d::Window::setTypewritingEnable(bool enable)
+{
+}
+
+void easy2d::Window::info(const String & text, const String & title)
+{
+	Logger::messageln(L"%ls: %ls", title.c_str(), text.c_str());
+	Game::reset();
+}
+
+void easy2d::Window::warning(const String& text, const String& title)
+{
+	Logger::warningln(L"%ls: %ls", title.c_str(), text.c_str());
+	Game::reset();
+}
+
+void easy2d::Window::error(const String & text, const String & title)
+{
+	Logger::errorln(L"%ls: %ls", title.c_str(), text.c_str());
+	Game::reset();
+}
@@ -0,0 +1,295 @@
+#include <easy2d/e2dplatform.h>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+
+long long easy2d::platform::GetTimestamp()
+{
+	timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<long long>(ts.tv_sec) * 1000000LL + ts.tv_nsec / 1000;
+}
+
+long long easy2d::platform::GetTicks()
+{
+	timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+long long easy2d::platform::GetTickFrequency()
+{
+	return 1000000000LL;
+}
+
+void easy2d::platform::SleepFor(unsigned int milliseconds)
+{
+	timespec req;
+	req.tv_sec = milliseconds / 1000;
+	req.tv_nsec = static_cast<long>(milliseconds % 1000) * 1000000L;
+
+	// źŴʱ˯ʣʱ
+	while (::nanosleep(&req, &req) == -1 && errno == EINTR)
+	{
+	}
+}
+
+wchar_t easy2d::platform::GetPathSeparator()
+{
+	return L'/';
+}
+
+bool easy2d::platform::FileExists(const String & path)
+{
+	if (path.empty())
+	{
+		return false;
+	}
+	return ::access(WideToNarrow(path).c_str(), F_OK) == 0;
+}
+
+bool easy2d::platform::MakeDirectory(const String & dirPath)
+{
+	return ::mkdir(WideToNarrow(dirPath).c_str(), 0755) == 0;
+}
+
+FILE* easy2d::platform::OpenFile(const String & filePath, const char * mode)
+{
+	return ::fopen(WideToNarrow(filePath).c_str(), mode);
+}
+
+bool easy2d::platform::SyncFile(FILE * file)
+{
+	return ::fflush(file) == 0 && ::fsync(::fileno(file)) == 0;
+}
+
+bool easy2d::platform::RenameFile(const String & srcPath, const String & destPath)
+{
+	// rename ͬһļϵͳԭӲ
+	return ::rename(WideToNarrow(srcPath).c_str(), WideToNarrow(destPath).c_str()) == 0;
+}
+
+const void* easy2d::platform::MapFile(const String & filePath, size_t * size, void ** handle)
+{
+	int fd = ::open(WideToNarrow(filePath).c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		return nullptr;
+	}
+
+	struct stat st;
+	void* data = MAP_FAILED;
+	if (::fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+		data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+
+	// ӳ佨Ҫļ
+	::close(fd);
+	if (data == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	*size = static_cast<size_t>(st.st_size);
+	*handle = nullptr;
+	return data;
+}
+
+void easy2d::platform::UnmapFile(const void * data, size_t size, void * handle)
+{
+	if (data)
+	{
+		::munmap(const_cast<void*>(data), size);
+	}
+}
+
+easy2d::String easy2d::platform::GetLocalDataDirectory()
+{
+	// ѭ XDG 淶ĬΪ ~/.local/share
+	const char* xdgDataHome = ::getenv("XDG_DATA_HOME");
+	if (xdgDataHome && *xdgDataHome)
+	{
+		return NarrowToWide(xdgDataHome);
+	}
+
+	const char* home = ::getenv("HOME");
+	if (home && *home)
+	{
+		return NarrowToWide(home) + L"/.local/share";
+	}
+	return String();
+}
+
+easy2d::String easy2d::platform::GetTempDirectory()
+{
+	const char* tmpDir = ::getenv("TMPDIR");
+	if (tmpDir && *tmpDir)
+	{
+		return NarrowToWide(tmpDir);
+	}
+	return L"/tmp";
+}
+
+easy2d::String easy2d::platform::GetExecutablePath()
+{
+	char szPath[4096] = { 0 };
+	ssize_t length = ::readlink("/proc/self/exe", szPath, sizeof(szPath) - 1);
+	if (length > 0)
+	{
+		return NarrowToWide(ByteString(szPath, static_cast<size_t>(length)));
+	}
+	return String();
+}
+
+void easy2d::platform::WriteLog(const String & text, bool isError)
+{
+	// ʹ std::wcoutַ޷תַ״̬
+	FILE* stream = isError ? stderr : stdout;
+	const ByteString output = WideToNarrow(text);
+	::fwrite(output.data(), 1, output.size(), stream);
+	::fflush(stream);
+}
+
+void easy2d::platform::WriteDebugString(const String & text)
+{
+}
+
+bool easy2d::platform::ShowConsole(bool show)
+{
+	// ޴ڳʼն
+	return true;
+}
+
+easy2d::ByteString easy2d::platform::WideToNarrow(const String& str)
+{
+	// ضֽڱ̶Ϊ UTF-8
+	ByteString result;
+	result.reserve(str.size());
+
+	for (size_t i = 0; i < str.size(); ++i)
+	{
+		unsigned long ch = static_cast<unsigned long>(str[i]);
+
+		// wchar_t Ϊ 16 λʱҪϲ
+		if (sizeof(wchar_t) == 2 && ch >= 0xD800 && ch <= 0xDBFF && i + 1 < str.size())
+		{
+			unsigned long low = static_cast<unsigned long>(str[i + 1]);
+			if (low >= 0xDC00 && low <= 0xDFFF)
+			{
+				ch = 0x10000 + ((ch - 0xD800) << 10) + (low - 0xDC00);
+				++i;
+			}
+		}
+
+		if (ch < 0x80)
+		{
+			result.push_back(static_cast<char>(ch));
+		}
+		else if (ch < 0x800)
+		{
+			result.push_back(static_cast<char>(0xC0 | (ch >> 6)));
+			result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+		}
+		else if (ch < 0x10000)
+		{
+			result.push_back(static_cast<char>(0xE0 | (ch >> 12)));
+			result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+		}
+		else
+		{
+			result.push_back(static_cast<char>(0xF0 | (ch >> 18)));
+			result.push_back(static_cast<char>(0x80 | ((ch >> 12) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | ((ch >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (ch & 0x3F)));
+		}
+	}
+	return result;
+}
+
+easy2d::String easy2d::platform::NarrowToWide(const ByteString& str)
+{
+	String result;
+	result.reserve(str.size());
+
+	size_t i = 0;
+	while (i < str.size())
+	{
+		const unsigned char lead = static_cast<unsigned char>(str[i]);
+
+		unsigned long ch = 0;
+		size_t extra = 0;
+		if (lead < 0x80)
+		{
+			ch = lead;
+		}
+		else if ((lead & 0xE0) == 0xC0)
+		{
+			ch = lead & 0x1F;
+			extra = 1;
+		}
+		else if ((lead & 0xF0) == 0xE0)
+		{
+			ch = lead & 0x0F;
+			extra = 2;
+		}
+		else if ((lead & 0xF8) == 0xF0)
+		{
+			ch = lead & 0x07;
+			extra = 3;
+		}
+		else
+		{
+			// Ƿֽڣ滻Ϊ U+FFFD
+			result.push_back(static_cast<wchar_t>(0xFFFD));
+			++i;
+			continue;
+		}
+
+		if (i + extra >= str.size())
+		{
+			result.push_back(static_cast<wchar_t>(0xFFFD));
+			break;
+		}
+
+		bool valid = true;
+		for (size_t j = 1; j <= extra; ++j)
+		{
+			const unsigned char trail = static_cast<unsigned char>(str[i + j]);
+			if ((trail & 0xC0) != 0x80)
+			{
+				valid = false;
+				break;
+			}
+			ch = (ch << 6) | (trail & 0x3F);
+		}
+
+		if (!valid)
+		{
+			result.push_back(static_cast<wchar_t>(0xFFFD));
+			++i;
+			continue;
+		}
+
+		if (sizeof(wchar_t) == 2 && ch >= 0x10000)
+		{
+			ch -= 0x10000;
+			result.push_back(static_cast<wchar_t>(0xD800 + (ch >> 10)));
+			result.push_back(static_cast<wchar_t>(0xDC00 + (ch & 0x3FF)));
+		}
+		else
+		{
+			result.push_back(static_cast<wchar_t>(ch));
+		}
+		i += extra + 1;
+	}
+	return result;
+}
@@ -0,0 +1,369 @@
+#include <easy2d/e2dplatform.h>
+
+#ifdef E2D_HEADLESS
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#endif
+
+#include <objbase.h>
+#include <iostream>
+#include <fstream>
+#include <io.h>
+#include <direct.h>
+
+#define DEFINE_KNOWN_FOLDER(name, l, w1, w2, b1, b2, b3, b4, b5, b6, b7, b8) \
+	EXTERN_C const GUID DECLSPEC_SELECTANY name \
+	= { l, w1, w2,{ b1, b2,  b3,  b4,  b5,  b6,  b7,  b8 } }
+
+DEFINE_KNOWN_FOLDER(FOLDERID_LocalAppData, 0xF1B32785, 0x6FBA, 0x4FCF, 0x9D, 0x55, 0x7B, 0x8E, 0x7F, 0x15, 0x70, 0x91);
+
+
+namespace
+{
+	std::streambuf* s_cinBuffer, * s_coutBuffer, * s_cerrBuffer;
+	std::fstream s_consoleInput, s_consoleOutput, s_consoleError;
+
+	std::wstreambuf* s_wcinBuffer, * s_wcoutBuffer, * s_wcerrBuffer;
+	std::wfstream s_wconsoleInput, s_wconsoleOutput, s_wconsoleError;
+
+	HWND allocated_console = nullptr;
+
+	void RedirectStdIO()
+	{
+		s_cinBuffer = std::cin.rdbuf();
+		s_coutBuffer = std::cout.rdbuf();
+		s_cerrBuffer = std::cerr.rdbuf();
+		s_wcinBuffer = std::wcin.rdbuf();
+		s_wcoutBuffer = std::wcout.rdbuf();
+		s_wcerrBuffer = std::wcerr.rdbuf();
+
+		s_consoleInput.open("CONIN$", std::ios::in);
+		s_consoleOutput.open("CONOUT$", std::ios::out);
+		s_consoleError.open("CONOUT$", std::ios::out);
+		s_wconsoleInput.open("CONIN$", std::ios::in);
+		s_wconsoleOutput.open("CONOUT$", std::ios::out);
+		s_wconsoleError.open("CONOUT$", std::ios::out);
+
+		FILE* dummy;
+		::freopen_s(&dummy, "CONOUT$", "w+t", stdout);
+		::freopen_s(&dummy, "CONIN$", "r+t", stdin);
+		::freopen_s(&dummy, "CONOUT$", "w+t", stderr);
+		(void)dummy;
+
+		std::cin.rdbuf(s_consoleInput.rdbuf());
+		std::cout.rdbuf(s_consoleOutput.rdbuf());
+		std::cerr.rdbuf(s_consoleError.rdbuf());
+		std::wcin.rdbuf(s_wconsoleInput.rdbuf());
+		std::wcout.rdbuf(s_wconsoleOutput.rdbuf());
+		std::wcerr.rdbuf(s_wconsoleError.rdbuf());
+	}
+
+	void ResetStdIO()
+	{
+		s_consoleInput.close();
+		s_consoleOutput.close();
+		s_consoleError.close();
+		s_wconsoleInput.close();
+		s_wconsoleOutput.close();
+		s_wconsoleError.close();
+
+		std::cin.rdbuf(s_cinBuffer);
+		std::cout.rdbuf(s_coutBuffer);
+		std::cerr.rdbuf(s_cerrBuffer);
+		std::wcin.rdbuf(s_wcinBuffer);
+		std::wcout.rdbuf(s_wcoutBuffer);
+		std::wcerr.rdbuf(s_wcerrBuffer);
+
+		fclose(stdout);
+		fclose(stdin);
+		fclose(stderr);
+
+		s_cinBuffer = nullptr;
+		s_coutBuffer = nullptr;
+		s_cerrBuffer = nullptr;
+		s_wcinBuffer = nullptr;
+		s_wcoutBuffer = nullptr;
+		s_wcerrBuffer = nullptr;
+	}
+
+	HWND AllocateConsole()
+	{
+		if (::AllocConsole())
+		{
+			allocated_console = ::GetConsoleWindow();
+
+			if (allocated_console)
+			{
+				RedirectStdIO();
+			}
+		}
+		return allocated_console;
+	}
+
+	void FreeAllocatedConsole()
+	{
+		if (allocated_console)
+		{
+			ResetStdIO();
+			::FreeConsole();
+			allocated_console = nullptr;
+		}
+	}
+}
+
+long long easy2d::platform::GetTimestamp()
+{
+	static LARGE_INTEGER s_freq = { 0 };
+	if (s_freq.QuadPart == 0)
+	{
+		::QueryPerformanceFrequency(&s_freq);
+	}
+
+	LARGE_INTEGER counter;
+	::QueryPerformanceCounter(&counter);
+
+	// 㣬˷
+	const long long seconds = counter.QuadPart / s_freq.QuadPart;
+	const long long remainder = counter.QuadPart % s_freq.QuadPart;
+	return seconds * 1000000LL + remainder * 1000000LL / s_freq.QuadPart;
+}
+
+long long easy2d::platform::GetTicks()
+{
+	LARGE_INTEGER counter;
+	::QueryPerformanceCounter(&counter);
+	return counter.QuadPart;
+}
+
+long long easy2d::platform::GetTickFrequency()
+{
+	LARGE_INTEGER freq;
+	::QueryPerformanceFrequency(&freq);
+	return freq.QuadPart;
+}
+
+void easy2d::platform::SleepFor(unsigned int milliseconds)
+{
+	::Sleep(milliseconds);
+}
+
+wchar_t easy2d::platform::GetPathSeparator()
+{
+	return L'\\';
+}
+
+bool easy2d::platform::FileExists(const String & path)
+{
+	if (path.empty() || path.length() >= MAX_PATH)
+	{
+		return false;
+	}
+	return ::_waccess(path.c_str(), 0) == 0;
+}
+
+bool easy2d::platform::MakeDirectory(const String & dirPath)
+{
+	return ::_wmkdir(dirPath.c_str()) == 0;
+}
+
+FILE* easy2d::platform::OpenFile(const String & filePath, const char * mode)
+{
+	FILE* file = nullptr;
+	if (::_wfopen_s(&file, filePath.c_str(), NarrowToWide(mode).c_str()) != 0)
+	{
+		return nullptr;
+	}
+	return file;
+}
+
+bool easy2d::platform::SyncFile(FILE * file)
+{
+	return ::fflush(file) == 0 && ::_commit(::_fileno(file)) == 0;
+}
+
+bool easy2d::platform::RenameFile(const String & srcPath, const String & destPath)
+{
+	return ::MoveFileExW(srcPath.c_str(), destPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+}
+
+const void* easy2d::platform::MapFile(const String & filePath, size_t * size, void ** handle)
+{
+	HANDLE hFile = ::CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+
+	LARGE_INTEGER fileSize = { 0 };
+	HANDLE hMapping = nullptr;
+	if (::GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0)
+	{
+		hMapping = ::CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+
+	// ӳᱣļ
+	::CloseHandle(hFile);
+	if (!hMapping)
+	{
+		return nullptr;
+	}
+
+	const void* data = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		::CloseHandle(hMapping);
+		return nullptr;
+	}
+
+	*size = static_cast<size_t>(fileSize.QuadPart);
+	*handle = hMapping;
+	return data;
+}
+
+void easy2d::platform::UnmapFile(const void * data, size_t size, void * handle)
+{
+	if (data)
+	{
+		::UnmapViewOfFile(data);
+	}
+	if (handle)
+	{
+		::CloseHandle(static_cast<HANDLE>(handle));
+	}
+}
+
+easy2d::String easy2d::platform::GetLocalDataDirectory()
+{
+	// ȡ AppData\Local ļе·
+	typedef HRESULT(WINAPI* pFunSHGetKnownFolderPath)(const GUID& rfid, DWORD dwFlags, HANDLE hToken, PWSTR *ppszPath);
+
+	HMODULE hModule = ::LoadLibraryW(L"shell32.dll");
+	if (!hModule)
+	{
+		return String();
+	}
+
+	String result;
+	pFunSHGetKnownFolderPath SHGetKnownFolderPath = (pFunSHGetKnownFolderPath)::GetProcAddress(hModule, "SHGetKnownFolderPath");
+	if (SHGetKnownFolderPath)
+	{
+		PWSTR pszPath = nullptr;
+		if (SUCCEEDED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &pszPath)))
+		{
+			result = pszPath;
+			::CoTaskMemFree(pszPath);
+		}
+	}
+	::FreeLibrary(hModule);
+	return result;
+}
+
+easy2d::String easy2d::platform::GetTempDirectory()
+{
+	wchar_t path[_MAX_PATH] = { 0 };
+	if (0 == ::GetTempPathW(_MAX_PATH, path))
+	{
+		return String();
+	}
+	return String(path);
+}
+
+easy2d::String easy2d::platform::GetExecutablePath()
+{
+	wchar_t szPath[_MAX_PATH] = { 0 };
+	if (::GetModuleFileNameW(nullptr, szPath, _MAX_PATH) != 0)
+	{
+		return String(szPath);
+	}
+	return String();
+}
+
+void easy2d::platform::WriteLog(const String & text, bool isError)
+{
+	std::wcout << text << std::flush;
+}
+
+void easy2d::platform::WriteDebugString(const String & text)
+{
+	::OutputDebugStringW(text.c_str());
+}
+
+bool easy2d::platform::ShowConsole(bool show)
+{
+	HWND currConsole = ::GetConsoleWindow();
+	if (show)
+	{
+		if (currConsole)
+		{
+			::ShowWindow(currConsole, SW_SHOW);
+		}
+		else
+		{
+			HWND console = AllocateConsole();
+			if (!console)
+			{
+				return false;
+			}
+
+			// disable the close button of console
+			HMENU hmenu = ::GetSystemMenu(console, FALSE);
+			::RemoveMenu(hmenu, SC_CLOSE, MF_BYCOMMAND);
+		}
+	}
+	else
+	{
+		if (currConsole)
+		{
+			if (currConsole == allocated_console)
+			{
+				FreeAllocatedConsole();
+			}
+			else
+			{
+				::ShowWindow(currConsole, SW_HIDE);
+			}
+		}
+	}
+	return true;
+}
+
+easy2d::ByteString easy2d::platform::WideToNarrow(const String& str)
+{
+	if (str.empty())
+		return ByteString();
+
+	int num = ::WideCharToMultiByte(CP_ACP, 0, str.c_str(), -1, NULL, 0, NULL, NULL);
+	if (num > 0)
+	{
+		ByteString result;
+		result.resize(num - 1);
+
+		// C++11 ַ֤ǿսβ
+		::WideCharToMultiByte(CP_ACP, 0, str.c_str(), -1, &result[0], num, NULL, NULL);
+		return result;
+	}
+	return ByteString();
+}
+
+easy2d::String easy2d::platform::NarrowToWide(const ByteString& str)
+{
+	if (str.empty())
+		return String();
+
+	int num = ::MultiByteToWideChar(CP_ACP, 0, str.c_str(), -1, NULL, 0);
+	if (num > 0)
+	{
+		String result;
+		result.resize(num - 1);
+
+		// C++11 ַ֤ǿսβ
+		::MultiByteToWideChar(CP_ACP, 0, str.c_str(), -1, &result[0], num);
+		return result;
+	}
+	return String();
+}
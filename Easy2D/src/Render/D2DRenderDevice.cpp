@@ -0,0 +1,485 @@
+#include <easy2d/e2drender.h>
+#include <easy2d/e2dbase.h>
+
+// ID2D1SpriteBatch Ҫ Windows 10 SDKĿϵͳ汾 Windows 10 1511
+#if defined(NTDDI_WIN10_TH2) && NTDDI_VERSION >= NTDDI_WIN10_TH2
+#	include <d2d1_3.h>
+#	define E2D_D2D_SPRITE_BATCH
+#endif
+
+
+easy2d::D2DTexture::D2DTexture(ID2D1Bitmap * bitmap)
+	: _bitmap(bitmap)
+{
+}
+
+easy2d::D2DTexture::~D2DTexture()
+{
+	SafeRelease(_bitmap);
+}
+
+float easy2d::D2DTexture::getWidth() const
+{
+	return _bitmap ? _bitmap->GetSize().width : 0;
+}
+
+float easy2d::D2DTexture::getHeight() const
+{
+	return _bitmap ? _bitmap->GetSize().height : 0;
+}
+
+ID2D1Bitmap * easy2d::D2DTexture::getBitmap() const
+{
+	return _bitmap;
+}
+
+
+easy2d::D2DRenderDevice::D2DRenderDevice()
+	: _layerDepth(0)
+	, _spriteTarget(nullptr)
+	, _spriteContext(nullptr)
+	, _spriteBatch(nullptr)
+{
+}
+
+easy2d::D2DRenderDevice::~D2DRenderDevice()
+{
+	for (auto& layer : _layers)
+	{
+		SafeRelease(layer);
+	}
+	_discardSpriteBatch();
+}
+
+bool easy2d::D2DRenderDevice::beginFrame(const Color & clearColor)
+{
+	// 豸Դ
+	Renderer::__createDeviceResources();
+
+	auto pRT = Renderer::getRenderTarget();
+	if (!pRT)
+	{
+		return false;
+	}
+
+	// ʼȾ
+	pRT->BeginDraw();
+	// ʹñɫĻ
+	pRT->Clear(clearColor.toD2DColorF());
+
+	_layerDepth = 0;
+	_transform = Matrix32();
+	_resetStats();
+	return true;
+}
+
+void easy2d::D2DRenderDevice::endFrame()
+{
+	_flushSprites(FlushReason::EndFrame);
+
+	// ֹȾ
+	HRESULT hr = Renderer::getRenderTarget()->EndDraw();
+
+	if (hr == D2DERR_RECREATE_TARGET)
+	{
+		//  Direct3D 豸ִйʧǰ豸Դ
+		// һεʱؽԴ
+		hr = S_OK;
+
+		for (auto& layer : _layers)
+		{
+			SafeRelease(layer);
+		}
+		_layers.clear();
+		_discardSpriteBatch();
+
+		Renderer::__discardDeviceResources();
+	}
+
+	if (FAILED(hr))
+	{
+		E2D_ERROR(L"Device loss recovery failed");
+	}
+}
+
+easy2d::Size easy2d::D2DRenderDevice::getSize() const
+{
+	auto pRT = Renderer::getRenderTarget();
+	if (!pRT)
+	{
+		return Size();
+	}
+
+	D2D1_SIZE_F size = pRT->GetSize();
+	return Size(size.width, size.height);
+}
+
+void easy2d::D2DRenderDevice::setTransform(const Matrix32 & matrix)
+{
+	// еľԱ˱任޸ı任Ҫύ
+	_transform = matrix;
+	Renderer::getRenderTarget()->SetTransform(matrix.toD2DMatrix());
+}
+
+easy2d::Texture * easy2d::D2DRenderDevice::createTexture(const void * pixels, int width, int height, int pitch)
+{
+	if (!pixels || width <= 0 || height <= 0)
+	{
+		E2D_WARNING(L"D2DRenderDevice::createTexture failed! Invalid pixel data.");
+		return nullptr;
+	}
+
+	// ڵһ֡Ⱦǰ
+	if (!Renderer::__createDeviceResources())
+	{
+		return nullptr;
+	}
+
+	// תΪԤ alpha  BGRA ʽ
+	std::vector<unsigned char> buffer(static_cast<size_t>(width) * height * 4);
+	const unsigned char* src = static_cast<const unsigned char*>(pixels);
+	unsigned char* dest = buffer.data();
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* line = src + static_cast<size_t>(y) * pitch;
+		for (int x = 0; x < width; ++x, dest += 4)
+		{
+			const unsigned int a = line[x * 4 + 3];
+			dest[0] = static_cast<unsigned char>((line[x * 4 + 2] * a + 127) / 255);
+			dest[1] = static_cast<unsigned char>((line[x * 4 + 1] * a + 127) / 255);
+			dest[2] = static_cast<unsigned char>((line[x * 4] * a + 127) / 255);
+			dest[3] = static_cast<unsigned char>(a);
+		}
+	}
+
+	ID2D1Bitmap* pBitmap = nullptr;
+	HRESULT hr = Renderer::getRenderTarget()->CreateBitmap(
+		D2D1::SizeU(width, height),
+		buffer.data(),
+		width * 4,
+		D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)),
+		&pBitmap
+	);
+
+	if (FAILED(hr))
+	{
+		E2D_WARNING(L"Create ID2D1Bitmap failed!");
+		return nullptr;
+	}
+
+	auto texture = new (std::nothrow) D2DTexture(pBitmap);
+	if (!texture)
+	{
+		SafeRelease(pBitmap);
+	}
+	return texture;
+}
+
+void easy2d::D2DRenderDevice::drawTexture(Texture * texture, const Rect & destRect, const Rect & srcRect, float opacity)
+{
+	// ֻıʱ
+	if (texture != _batchTexture)
+	{
+		auto d2dTexture = dynamic_cast<D2DTexture*>(texture);
+		if (!d2dTexture || !d2dTexture->getBitmap())
+		{
+			E2D_WARNING(L"D2DRenderDevice::drawTexture failed! Texture is not created by this device.");
+			return;
+		}
+	}
+
+	_addSprite(texture, _transform, destRect, srcRect, opacity);
+}
+
+void easy2d::D2DRenderDevice::fillRect(const Rect & rect, const Color & color)
+{
+	_flushSprites(FlushReason::StateChanged);
+
+	Renderer::getRenderTarget()->FillRectangle(
+		D2D1::RectF(rect.getLeft(), rect.getTop(), rect.getRight(), rect.getBottom()),
+		_getBrush(color)
+	);
+}
+
+void easy2d::D2DRenderDevice::drawRect(const Rect & rect, const Color & color, float strokeWidth, LineJoin lineJoin)
+{
+	_flushSprites(FlushReason::StateChanged);
+
+	Renderer::getRenderTarget()->DrawRectangle(
+		D2D1::RectF(rect.getLeft(), rect.getTop(), rect.getRight(), rect.getBottom()),
+		_getBrush(color),
+		strokeWidth,
+		_getStrokeStyle(lineJoin)
+	);
+}
+
+void easy2d::D2DRenderDevice::fillRoundedRect(const Rect & rect, float radiusX, float radiusY, const Color & color)
+{
+	_flushSprites(FlushReason::StateChanged);
+
+	Renderer::getRenderTarget()->FillRoundedRectangle(
+		D2D1::RoundedRect(D2D1::RectF(rect.getLeft(), rect.getTop(), rect.getRight(), rect.getBottom()), radiusX, radiusY),
+		_getBrush(color)
+	);
+}
+
+void easy2d::D2DRenderDevice::drawRoundedRect(const Rect & rect, float radiusX, float radiusY, const Color & color, float strokeWidth, LineJoin lineJoin)
+{
+	_flushSprites(FlushReason::StateChanged);
+
+	Renderer::getRenderTarget()->DrawRoundedRectangle(
+		D2D1::RoundedRect(D2D1::RectF(rect.getLeft(), rect.getTop(), rect.getRight(), rect.getBottom()), radiusX, radiusY),
+		_getBrush(color),
+		strokeWidth,
+		_getStrokeStyle(lineJoin)
+	);
+}
+
+void easy2d::D2DRenderDevice::fillEllipse(const Point & center, float radiusX, float radiusY, const Color & color)
+{
+	_flushSprites(FlushReason::StateChanged);
+
+	Renderer::getRenderTarget()->FillEllipse(
+		D2D1::Ellipse(D2D1::Point2F(center.x, center.y), radiusX, radiusY),
+		_getBrush(color)
+	);
+}
+
+void easy2d::D2DRenderDevice::drawEllipse(const Point & center, float radiusX, float radiusY, const Color & color, float strokeWidth)
+{
+	_flushSprites(FlushReason::StateChanged);
+
+	Renderer::getRenderTarget()->DrawEllipse(
+		D2D1::Ellipse(D2D1::Point2F(center.x, center.y), radiusX, radiusY),
+		_getBrush(color),
+		strokeWidth,
+		nullptr
+	);
+}
+
+void easy2d::D2DRenderDevice::pushLayer(const LayerParam & param)
+{
+	_flushSprites(FlushReason::LayerChanged);
+
+	auto pRT = Renderer::getRenderTarget();
+
+	// ÿһǶȸͬһ ID2D1Layer
+	if (_layerDepth >= _layers.size())
+	{
+		ID2D1Layer* pLayer = nullptr;
+		if (FAILED(pRT->CreateLayer(&pLayer)))
+		{
+			E2D_WARNING(L"Create ID2D1Layer failed!");
+			return;
+		}
+		_layers.push_back(pLayer);
+	}
+
+	// üʹ豸
+	D2D1_MATRIX_3X2_F transform;
+	pRT->GetTransform(&transform);
+	pRT->SetTransform(D2D1::Matrix3x2F::Identity());
+
+	const Rect& clip = param.clipRect;
+	pRT->PushLayer(
+		D2D1::LayerParameters(
+			D2D1::RectF(clip.getLeft(), clip.getTop(), clip.getRight(), clip.getBottom()),
+			nullptr,
+			D2D1_ANTIALIAS_MODE_PER_PRIMITIVE,
+			D2D1::IdentityMatrix(),
+			param.opacity
+		),
+		_layers[_layerDepth]
+	);
+	++_layerDepth;
+
+	pRT->SetTransform(transform);
+}
+
+void easy2d::D2DRenderDevice::popLayer()
+{
+	if (_layerDepth == 0)
+	{
+		E2D_WARNING(L"D2DRenderDevice::popLayer failed! Layer stack is empty.");
+		return;
+	}
+
+	_flushSprites(FlushReason::LayerChanged);
+	Renderer::getRenderTarget()->PopLayer();
+	--_layerDepth;
+}
+
+void easy2d::D2DRenderDevice::_drawSprites(Texture * texture, const SpriteQuad * quads, size_t count)
+{
+	auto pRT = Renderer::getRenderTarget();
+	auto pBitmap = static_cast<D2DTexture*>(texture)->getBitmap();
+
+	// ϵͳ֧ʱһύ
+	if (count > 1 && _drawSpriteBatch(pBitmap, quads, count))
+	{
+		return;
+	}
+
+	// ͬһλͼ
+	// ֻƽƺŵľֱӰĿα任꣬õλ任ÿñ任
+	bool identity = false;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SpriteQuad& quad = quads[i];
+		const Matrix32& m = quad.transform;
+		const Rect& dest = quad.destRect;
+
+		D2D1_RECT_F destRect;
+		if (m._12 == 0 && m._21 == 0 && m._11 > 0 && m._22 > 0)
+		{
+			if (!identity)
+			{
+				pRT->SetTransform(D2D1::Matrix3x2F::Identity());
+				identity = true;
+			}
+			destRect = D2D1::RectF(
+				dest.getLeft() * m._11 + m._31,
+				dest.getTop() * m._22 + m._32,
+				dest.getRight() * m._11 + m._31,
+				dest.getBottom() * m._22 + m._32
+			);
+		}
+		else
+		{
+			pRT->SetTransform(m.toD2DMatrix());
+			identity = false;
+			destRect = D2D1::RectF(dest.getLeft(), dest.getTop(), dest.getRight(), dest.getBottom());
+		}
+
+		pRT->DrawBitmap(
+			pBitmap,
+			destRect,
+			quad.opacity,
+			D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
+			D2D1::RectF(quad.srcRect.getLeft(), quad.srcRect.getTop(), quad.srcRect.getRight(), quad.srcRect.getBottom())
+		);
+	}
+
+	// ָǰ任
+	pRT->SetTransform(_transform.toD2DMatrix());
+}
+
+#ifdef E2D_D2D_SPRITE_BATCH
+
+bool easy2d::D2DRenderDevice::_drawSpriteBatch(ID2D1Bitmap * bitmap, const SpriteQuad * quads, size_t count)
+{
+	auto pRT = Renderer::getRenderTarget();
+
+	// ȾĿı»ȡӿڣ֧ʱͬһȾĿ겻ٳ
+	if (_spriteTarget != pRT)
+	{
+		_discardSpriteBatch();
+		_spriteTarget = pRT;
+
+		ID2D1DeviceContext3 * pContext = nullptr;
+		if (SUCCEEDED(pRT->QueryInterface(__uuidof(ID2D1DeviceContext3), reinterpret_cast<void**>(&pContext))))
+		{
+			ID2D1SpriteBatch * pBatch = nullptr;
+			if (SUCCEEDED(pContext->CreateSpriteBatch(&pBatch)))
+			{
+				_spriteContext = pContext;
+				_spriteBatch = pBatch;
+			}
+			else
+			{
+				SafeRelease(pContext);
+			}
+		}
+	}
+
+	if (!_spriteBatch)
+	{
+		return false;
+	}
+
+	_spriteDestRects.resize(count);
+	_spriteSrcRects.resize(count);
+	_spriteColors.resize(count);
+	_spriteTransforms.resize(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SpriteQuad& quad = quads[i];
+
+		// εԴرʾ
+		const float left = quad.srcRect.getLeft(), top = quad.srcRect.getTop();
+		const float right = quad.srcRect.getRight(), bottom = quad.srcRect.getBottom();
+		if (left < 0 || top < 0 || left != ::floorf(left) || top != ::floorf(top) || right != ::floorf(right) || bottom != ::floorf(bottom))
+		{
+			return false;
+		}
+
+		_spriteDestRects[i] = D2D1::RectF(quad.destRect.getLeft(), quad.destRect.getTop(), quad.destRect.getRight(), quad.destRect.getBottom());
+		_spriteSrcRects[i] = D2D1::RectU(UINT32(left), UINT32(top), UINT32(right), UINT32(bottom));
+		_spriteColors[i] = D2D1::ColorF(1.f, 1.f, 1.f, quad.opacity);
+		_spriteTransforms[i] = quad.transform.toD2DMatrix();
+	}
+
+	auto pContext = static_cast<ID2D1DeviceContext3*>(_spriteContext);
+	auto pBatch = static_cast<ID2D1SpriteBatch*>(_spriteBatch);
+
+	pBatch->Clear();
+	HRESULT hr = pBatch->AddSprites(
+		UINT32(count),
+		_spriteDestRects.data(),
+		_spriteSrcRects.data(),
+		_spriteColors.data(),
+		_spriteTransforms.data()
+	);
+	if (FAILED(hr))
+	{
+		return false;
+	}
+
+	// ֻڹرտʱƣı任뵱ǰ任
+	const D2D1_ANTIALIAS_MODE antialiasMode = pContext->GetAntialiasMode();
+	pContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+	pContext->SetTransform(D2D1::Matrix3x2F::Identity());
+	pContext->DrawSpriteBatch(pBatch, bitmap, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, D2D1_SPRITE_OPTIONS_NONE);
+	pContext->SetAntialiasMode(antialiasMode);
+	pContext->SetTransform(_transform.toD2DMatrix());
+	return true;
+}
+
+#else
+
+bool easy2d::D2DRenderDevice::_drawSpriteBatch(ID2D1Bitmap * /* bitmap */, const SpriteQuad * /* quads */, size_t /* count */)
+{
+	return false;
+}
+
+#endif
+
+void easy2d::D2DRenderDevice::_discardSpriteBatch()
+{
+	SafeRelease(_spriteBatch);
+	SafeRelease(_spriteContext);
+	_spriteTarget = nullptr;
+}
+
+ID2D1StrokeStyle * easy2d::D2DRenderDevice::_getStrokeStyle(LineJoin lineJoin) const
+{
+	switch (lineJoin)
+	{
+	case LineJoin::Miter:
+		return Renderer::getMiterID2D1StrokeStyle();
+	case LineJoin::Bevel:
+		return Renderer::getBevelID2D1StrokeStyle();
+	case LineJoin::Round:
+		return Renderer::getRoundID2D1StrokeStyle();
+	default:
+		return nullptr;
+	}
+}
+
+ID2D1SolidColorBrush * easy2d::D2DRenderDevice::_getBrush(const Color & color) const
+{
+	auto pBrush = Renderer::getSolidColorBrush();
+	pBrush->SetOpacity(1.f);
+	pBrush->SetColor(color.toD2DColorF());
+	return pBrush;
+}
@@ -0,0 +1,14 @@
+#include <easy2d/e2drender.h>
+#include <cfloat>
+
+easy2d::LayerParam::LayerParam()
+	: clipRect(-FLT_MAX / 4, -FLT_MAX / 4, FLT_MAX / 2, FLT_MAX / 2)
+	, opacity(1.f)
+{
+}
+
+easy2d::LayerParam::LayerParam(const Rect & clipRect, float opacity)
+	: clipRect(clipRect)
+	, opacity(opacity)
+{
+}
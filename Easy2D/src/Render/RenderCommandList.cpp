@@ -0,0 +1,246 @@
+#include <easy2d/e2drender.h>
+#include <easy2d/e2dbase.h>
+#include <easy2d/e2dnode.h>
+
+
+easy2d::RenderCommandList::Command::Command()
+	: type(Type::SetTransform)
+	, rect()
+	, srcRect()
+	, radiusX(0)
+	, radiusY(0)
+	, strokeWidth(0)
+	, opacity(1.f)
+	, color()
+	, lineJoin(LineJoin::Miter)
+	, matrix(0)
+	, object(nullptr)
+{
+}
+
+easy2d::RenderCommandList::RenderCommandList()
+	: _target(nullptr)
+	, _nodeCount(0)
+{
+}
+
+easy2d::RenderCommandList::~RenderCommandList()
+{
+	this->clear();
+}
+
+void easy2d::RenderCommandList::clear()
+{
+	for (auto& cmd : _commands)
+	{
+		GC::release(cmd.object);
+	}
+	_commands.clear();
+	_matrices.clear();
+	_nodeCount = 0;
+}
+
+size_t easy2d::RenderCommandList::getCommandCount() const
+{
+	return _commands.size();
+}
+
+void easy2d::RenderCommandList::setTarget(RenderDevice * target)
+{
+	_target = target;
+}
+
+void easy2d::RenderCommandList::addNode(Node * node)
+{
+	if (node)
+	{
+		auto& cmd = _addCommand(Command::Type::RenderNode);
+		cmd.object = node;
+		node->retain();
+		++_nodeCount;
+	}
+}
+
+bool easy2d::RenderCommandList::hasNodeCommands() const
+{
+	return _nodeCount != 0;
+}
+
+void easy2d::RenderCommandList::replay(RenderDevice * device) const
+{
+	if (!device)
+	{
+		return;
+	}
+
+	for (const auto& cmd : _commands)
+	{
+		switch (cmd.type)
+		{
+		case Command::Type::SetTransform:
+			device->setTransform(_matrices[cmd.matrix]);
+			break;
+		case Command::Type::DrawTexture:
+			device->drawTexture(static_cast<Texture*>(cmd.object), cmd.rect, cmd.srcRect, cmd.opacity);
+			break;
+		case Command::Type::FillRect:
+			device->fillRect(cmd.rect, cmd.color);
+			break;
+		case Command::Type::DrawRect:
+			device->drawRect(cmd.rect, cmd.color, cmd.strokeWidth, cmd.lineJoin);
+			break;
+		case Command::Type::FillRoundedRect:
+			device->fillRoundedRect(cmd.rect, cmd.radiusX, cmd.radiusY, cmd.color);
+			break;
+		case Command::Type::DrawRoundedRect:
+			device->drawRoundedRect(cmd.rect, cmd.radiusX, cmd.radiusY, cmd.color, cmd.strokeWidth, cmd.lineJoin);
+			break;
+		case Command::Type::FillEllipse:
+			device->fillEllipse(cmd.rect.origin, cmd.radiusX, cmd.radiusY, cmd.color);
+			break;
+		case Command::Type::DrawEllipse:
+			device->drawEllipse(cmd.rect.origin, cmd.radiusX, cmd.radiusY, cmd.color, cmd.strokeWidth);
+			break;
+		case Command::Type::PushLayer:
+			device->pushLayer(LayerParam(cmd.rect, cmd.opacity));
+			break;
+		case Command::Type::PopLayer:
+			device->popLayer();
+			break;
+		case Command::Type::RenderNode:
+			static_cast<Node*>(cmd.object)->onRender();
+			break;
+		}
+	}
+}
+
+bool easy2d::RenderCommandList::beginFrame(const Color & /* clearColor */)
+{
+	this->clear();
+	return true;
+}
+
+void easy2d::RenderCommandList::endFrame()
+{
+}
+
+easy2d::Size easy2d::RenderCommandList::getSize() const
+{
+	return _target ? _target->getSize() : Size();
+}
+
+void easy2d::RenderCommandList::setTransform(const Matrix32 & matrix)
+{
+	// ı任ֻһ
+	if (!_commands.empty() && _commands.back().type == Command::Type::SetTransform)
+	{
+		_matrices[_commands.back().matrix] = matrix;
+		return;
+	}
+
+	auto& cmd = _addCommand(Command::Type::SetTransform);
+	cmd.matrix = _matrices.size();
+	_matrices.push_back(matrix);
+}
+
+easy2d::Texture * easy2d::RenderCommandList::createTexture(const void * pixels, int width, int height, int pitch)
+{
+	if (!_target)
+	{
+		E2D_WARNING(L"RenderCommandList::createTexture failed! No target device.");
+		return nullptr;
+	}
+	return _target->createTexture(pixels, width, height, pitch);
+}
+
+void easy2d::RenderCommandList::drawTexture(Texture * texture, const Rect & destRect, const Rect & srcRect, float opacity)
+{
+	if (texture)
+	{
+		auto& cmd = _addCommand(Command::Type::DrawTexture);
+		cmd.rect = destRect;
+		cmd.srcRect = srcRect;
+		cmd.opacity = opacity;
+		cmd.object = texture;
+		texture->retain();
+	}
+}
+
+void easy2d::RenderCommandList::fillRect(const Rect & rect, const Color & color)
+{
+	auto& cmd = _addCommand(Command::Type::FillRect);
+	cmd.rect = rect;
+	cmd.color = color;
+}
+
+void easy2d::RenderCommandList::drawRect(const Rect & rect, const Color & color, float strokeWidth, LineJoin lineJoin)
+{
+	auto& cmd = _addCommand(Command::Type::DrawRect);
+	cmd.rect = rect;
+	cmd.color = color;
+	cmd.strokeWidth = strokeWidth;
+	cmd.lineJoin = lineJoin;
+}
+
+void easy2d::RenderCommandList::fillRoundedRect(const Rect & rect, float radiusX, float radiusY, const Color & color)
+{
+	auto& cmd = _addCommand(Command::Type::FillRoundedRect);
+	cmd.rect = rect;
+	cmd.radiusX = radiusX;
+	cmd.radiusY = radiusY;
+	cmd.color = color;
+}
+
+void easy2d::RenderCommandList::drawRoundedRect(const Rect & rect, float radiusX, float radiusY, const Color & color, float strokeWidth, LineJoin lineJoin)
+{
+	auto& cmd = _addCommand(Command::Type::DrawRoundedRect);
+	cmd.rect = rect;
+	cmd.radiusX = radiusX;
+	cmd.radiusY = radiusY;
+	cmd.color = color;
+	cmd.strokeWidth = strokeWidth;
+	cmd.lineJoin = lineJoin;
+}
+
+void easy2d::RenderCommandList::fillEllipse(const Point & center, float radiusX, float radiusY, const Color & color)
+{
+	auto& cmd = _addCommand(Command::Type::FillEllipse);
+	cmd.rect.origin = center;
+	cmd.radiusX = radiusX;
+	cmd.radiusY = radiusY;
+	cmd.color = color;
+}
+
+void easy2d::RenderCommandList::drawEllipse(const Point & center, float radiusX, float radiusY, const Color & color, float strokeWidth)
+{
+	auto& cmd = _addCommand(Command::Type::DrawEllipse);
+	cmd.rect.origin = center;
+	cmd.radiusX = radiusX;
+	cmd.radiusY = radiusY;
+	cmd.color = color;
+	cmd.strokeWidth = strokeWidth;
+}
+
+void easy2d::RenderCommandList::pushLayer(const LayerParam & param)
+{
+	auto& cmd = _addCommand(Command::Type::PushLayer);
+	cmd.rect = param.clipRect;
+	cmd.opacity = param.opacity;
+}
+
+void easy2d::RenderCommandList::popLayer()
+{
+	_addCommand(Command::Type::PopLayer);
+}
+
+void easy2d::RenderCommandList::_drawSprites(Texture * /* texture */, const SpriteQuad * /* quads */, size_t /* count */)
+{
+	// ֱӼ¼Ϊ
+}
+
+easy2d::RenderCommandList::Command & easy2d::RenderCommandList::_addCommand(Command::Type type)
+{
+	_commands.push_back(Command());
+	_commands.back().type = type;
+	return _commands.back();
+}
@@ -0,0 +1,109 @@
+#include <easy2d/e2drender.h>
+#include <easy2d/e2dbase.h>
+
+
+easy2d::RenderStats::RenderStats()
+	: spriteCount(0)
+	, batchCount(0)
+{
+	for (auto& count : flushCount)
+	{
+		count = 0;
+	}
+}
+
+size_t easy2d::RenderStats::getFlushCount(FlushReason reason) const
+{
+	if (reason < FlushReason::TextureChanged || reason >= FlushReason::Count)
+	{
+		return 0;
+	}
+	return flushCount[static_cast<int>(reason)];
+}
+
+
+easy2d::RenderDevice::RenderDevice()
+	: _batchTexture(nullptr)
+	, _batchQuads()
+	, _maxBatchSize(4096)
+	, _stats()
+{
+}
+
+easy2d::RenderDevice::~RenderDevice()
+{
+	GC::release(_batchTexture);
+}
+
+void easy2d::RenderDevice::flush()
+{
+	_flushSprites(FlushReason::Manual);
+}
+
+const easy2d::RenderStats & easy2d::RenderDevice::getStats() const
+{
+	return _stats;
+}
+
+void easy2d::RenderDevice::setMaxBatchSize(size_t size)
+{
+	_maxBatchSize = max(size, size_t(1));
+}
+
+size_t easy2d::RenderDevice::getMaxBatchSize() const
+{
+	return _maxBatchSize;
+}
+
+bool easy2d::RenderDevice::isFramePreserved() const
+{
+	return false;
+}
+
+void easy2d::RenderDevice::_resetStats()
+{
+	_stats = RenderStats();
+}
+
+void easy2d::RenderDevice::_addSprite(Texture * texture, const Matrix32 & transform, const Rect & destRect, const Rect & srcRect, float opacity)
+{
+	if (!texture || opacity <= 0)
+	{
+		return;
+	}
+
+	if (texture != _batchTexture)
+	{
+		_flushSprites(FlushReason::TextureChanged);
+
+		GC::retain(texture);
+		GC::release(_batchTexture);
+		_batchTexture = texture;
+	}
+	else if (_batchQuads.size() >= _maxBatchSize)
+	{
+		_flushSprites(FlushReason::BatchFull);
+	}
+
+	SpriteQuad quad;
+	quad.transform = transform;
+	quad.destRect = destRect;
+	quad.srcRect = srcRect;
+	quad.opacity = opacity;
+	_batchQuads.push_back(quad);
+	++_stats.spriteCount;
+}
+
+void easy2d::RenderDevice::_flushSprites(FlushReason reason)
+{
+	if (_batchQuads.empty())
+	{
+		return;
+	}
+
+	_drawSprites(_batchTexture, _batchQuads.data(), _batchQuads.size());
+	_batchQuads.clear();
+
+	++_stats.batchCount;
+	++_stats.flushCount[static_cast<int>(reason)];
+}
@@ -0,0 +1,706 @@
+#include <easy2d/e2drender.h>
+#include <easy2d/e2dbase.h>
+#include <easy2d/e2dplatform.h>
+#include <thread>
+#include <cstring>
+
+
+namespace
+{
+	// Ԥ alpha  RGBA ʽ
+	class SoftwareTexture :
+		public easy2d::Texture
+	{
+	public:
+		SoftwareTexture(int width, int height)
+			: width(width)
+			, height(height)
+			, pixels(static_cast<size_t>(width) * height * 4)
+		{
+		}
+
+		virtual float getWidth() const override { return float(width); }
+
+		virtual float getHeight() const override { return float(height); }
+
+	public:
+		int width;
+		int height;
+		std::vector<unsigned char> pixels;
+	};
+
+	inline unsigned char ToByte(float value)
+	{
+		if (value <= 0) return 0;
+		if (value >= 1) return 255;
+		return static_cast<unsigned char>(value * 255.f + 0.5f);
+	}
+
+	// εĽཻʱؿվ
+	easy2d::Rect Intersect(const easy2d::Rect& a, const easy2d::Rect& b)
+	{
+		float left = max(a.getLeft(), b.getLeft());
+		float top = max(a.getTop(), b.getTop());
+		float right = min(a.getRight(), b.getRight());
+		float bottom = min(a.getBottom(), b.getBottom());
+		if (right <= left || bottom <= top)
+		{
+			return easy2d::Rect();
+		}
+		return easy2d::Rect(left, top, right - left, bottom - top);
+	}
+
+	// ǷԲǾڣcenter  half ֱΪߴ
+	inline bool InRoundedRect(float x, float y, float cx, float cy, float hw, float hh, float rx, float ry)
+	{
+		float dx = ::fabsf(x - cx);
+		float dy = ::fabsf(y - cy);
+		if (dx > hw || dy > hh)
+		{
+			return false;
+		}
+
+		float qx = dx - (hw - rx);
+		float qy = dy - (hh - ry);
+		if (qx <= 0 || qy <= 0 || rx <= 0 || ry <= 0)
+		{
+			return true;
+		}
+		return (qx * qx) / (rx * rx) + (qy * qy) / (ry * ry) <= 1.f;
+	}
+
+	inline bool InEllipse(float dx, float dy, float rx, float ry)
+	{
+		if (rx <= 0 || ry <= 0)
+		{
+			return false;
+		}
+		return (dx * dx) / (rx * rx) + (dy * dy) / (ry * ry) <= 1.f;
+	}
+
+	// Ƿھڣ䴦ཻʽ
+	inline bool InStrokeOuter(float x, float y, const easy2d::Rect& rect, float half, easy2d::LineJoin lineJoin)
+	{
+		float dx = max(max(rect.getLeft() - x, x - rect.getRight()), 0.f);
+		float dy = max(max(rect.getTop() - y, y - rect.getBottom()), 0.f);
+		if (dx > half || dy > half)
+		{
+			return false;
+		}
+
+		switch (lineJoin)
+		{
+		case easy2d::LineJoin::Round:
+			return dx * dx + dy * dy <= half * half;
+		case easy2d::LineJoin::Bevel:
+			return dx + dy <= half;
+		default:
+			return true;
+		}
+	}
+
+	// Ԥ alpha ԴػϵĿ
+	inline void Blend(unsigned char* dest, const unsigned char* src)
+	{
+		const unsigned int inv = 255 - src[3];
+		if (inv == 0)
+		{
+			dest[0] = src[0];
+			dest[1] = src[1];
+			dest[2] = src[2];
+			dest[3] = src[3];
+		}
+		else
+		{
+			dest[0] = static_cast<unsigned char>(src[0] + (dest[0] * inv + 127) / 255);
+			dest[1] = static_cast<unsigned char>(src[1] + (dest[1] * inv + 127) / 255);
+			dest[2] = static_cast<unsigned char>(src[2] + (dest[2] * inv + 127) / 255);
+			dest[3] = static_cast<unsigned char>(src[3] + (dest[3] * inv + 127) / 255);
+		}
+	}
+}
+
+
+easy2d::SoftwareRenderDevice::Command::Command()
+	: type(Type::FillRect)
+	, inverse()
+	, left(0)
+	, top(0)
+	, right(0)
+	, bottom(0)
+	, rect()
+	, radiusX(0)
+	, radiusY(0)
+	, strokeWidth(0)
+	, lineJoin(LineJoin::Miter)
+	, texture(nullptr)
+	, firstSprite(0)
+	, spriteCount(0)
+{
+	color[0] = color[1] = color[2] = color[3] = 0;
+}
+
+
+easy2d::SoftwareRenderDevice::SoftwareRenderDevice(int width, int height, int threadCount)
+	: _width(max(width, 1))
+	, _height(max(height, 1))
+	, _threadCount(1)
+	, _drawing(false)
+	, _transform()
+	, _framebuffer(static_cast<size_t>(_width) * _height * 4, 0)
+{
+	_clearColor[0] = _clearColor[1] = _clearColor[2] = 0;
+	_clearColor[3] = 255;
+	setThreadCount(threadCount);
+}
+
+easy2d::SoftwareRenderDevice::~SoftwareRenderDevice()
+{
+	for (auto& cmd : _commands)
+	{
+		if (cmd.texture) cmd.texture->release();
+	}
+}
+
+int easy2d::SoftwareRenderDevice::getWidth() const
+{
+	return _width;
+}
+
+int easy2d::SoftwareRenderDevice::getHeight() const
+{
+	return _height;
+}
+
+const unsigned char * easy2d::SoftwareRenderDevice::getPixels() const
+{
+	return _framebuffer.data();
+}
+
+void easy2d::SoftwareRenderDevice::setThreadCount(int threadCount)
+{
+	if (threadCount <= 0)
+	{
+		threadCount = static_cast<int>(std::thread::hardware_concurrency());
+	}
+	_threadCount = min(max(threadCount, 1), _height);
+}
+
+int easy2d::SoftwareRenderDevice::getThreadCount() const
+{
+	return _threadCount;
+}
+
+bool easy2d::SoftwareRenderDevice::saveBitmap(const String & filePath) const
+{
+	FILE* file = platform::OpenFile(filePath, "wb");
+	if (!file)
+	{
+		E2D_WARNING(L"SoftwareRenderDevice::saveBitmap failed! Cannot open file.");
+		return false;
+	}
+
+	// 24 λ BMPݰ 4 ֽڶ룬ϴ洢
+	const unsigned int rowSize = (static_cast<unsigned int>(_width) * 3 + 3) & ~3u;
+	const unsigned int imageSize = rowSize * _height;
+
+	unsigned char header[54] = { 0 };
+	auto put32 = [&header](int offset, unsigned int value)
+	{
+		header[offset] = value & 0xFF;
+		header[offset + 1] = (value >> 8) & 0xFF;
+		header[offset + 2] = (value >> 16) & 0xFF;
+		header[offset + 3] = (value >> 24) & 0xFF;
+	};
+	header[0] = 'B';
+	header[1] = 'M';
+	put32(2, 54 + imageSize);
+	put32(10, 54);
+	put32(14, 40);
+	put32(18, _width);
+	put32(22, _height);
+	header[26] = 1;
+	header[28] = 24;
+	put32(34, imageSize);
+
+	bool succeeded = ::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+	std::vector<unsigned char> row(rowSize, 0);
+	for (int y = _height - 1; succeeded && y >= 0; --y)
+	{
+		const unsigned char* src = &_framebuffer[static_cast<size_t>(y) * _width * 4];
+		for (int x = 0; x < _width; ++x)
+		{
+			row[x * 3] = src[x * 4 + 2];
+			row[x * 3 + 1] = src[x * 4 + 1];
+			row[x * 3 + 2] = src[x * 4];
+		}
+		succeeded = ::fwrite(row.data(), 1, rowSize, file) == rowSize;
+	}
+
+	::fclose(file);
+	return succeeded;
+}
+
+bool easy2d::SoftwareRenderDevice::beginFrame(const Color & clearColor)
+{
+	if (_drawing)
+	{
+		E2D_WARNING(L"SoftwareRenderDevice::beginFrame called twice!");
+		return false;
+	}
+
+	const float alpha = clearColor.getAlpha();
+	_clearColor[0] = ToByte(clearColor.getRed() * alpha);
+	_clearColor[1] = ToByte(clearColor.getGreen() * alpha);
+	_clearColor[2] = ToByte(clearColor.getBlue() * alpha);
+	_clearColor[3] = ToByte(alpha);
+
+	_drawing = true;
+	_transform = Matrix32();
+	_resetStats();
+	_layers.clear();
+	_layers.push_back(LayerParam(Rect(0, 0, float(_width), float(_height)), 1.f));
+	return true;
+}
+
+void easy2d::SoftwareRenderDevice::endFrame()
+{
+	if (!_drawing)
+	{
+		return;
+	}
+
+	_flushSprites(FlushReason::EndFrame);
+	_drawing = false;
+
+	// а֡廮Ϊÿ˳ִȫ
+	// ϵͳĳפ߳ɣÿ֡߳
+	const int bandHeight = (_height + _threadCount - 1) / _threadCount;
+	const size_t bandCount = static_cast<size_t>((_height + bandHeight - 1) / bandHeight);
+	JobSystem::parallelFor(bandCount, [this, bandHeight](size_t band)
+	{
+		const int top = static_cast<int>(band) * bandHeight;
+		_rasterize(top, min(top + bandHeight, _height));
+	});
+
+	for (auto& cmd : _commands)
+	{
+		if (cmd.texture) cmd.texture->release();
+	}
+	_commands.clear();
+	_sprites.clear();
+}
+
+easy2d::Size easy2d::SoftwareRenderDevice::getSize() const
+{
+	return Size(float(_width), float(_height));
+}
+
+void easy2d::SoftwareRenderDevice::setTransform(const Matrix32 & matrix)
+{
+	_transform = matrix;
+}
+
+easy2d::Texture * easy2d::SoftwareRenderDevice::createTexture(const void * pixels, int width, int height, int pitch)
+{
+	if (!pixels || width <= 0 || height <= 0)
+	{
+		E2D_WARNING(L"SoftwareRenderDevice::createTexture failed! Invalid pixel data.");
+		return nullptr;
+	}
+
+	auto texture = new (std::nothrow) SoftwareTexture(width, height);
+	if (!texture)
+	{
+		return nullptr;
+	}
+
+	// תΪԤ alpha ʽ
+	const unsigned char* src = static_cast<const unsigned char*>(pixels);
+	unsigned char* dest = texture->pixels.data();
+	for (int y = 0; y < height; ++y)
+	{
+		const unsigned char* line = src + static_cast<size_t>(y) * pitch;
+		for (int x = 0; x < width; ++x, dest += 4)
+		{
+			const unsigned int a = line[x * 4 + 3];
+			dest[0] = static_cast<unsigned char>((line[x * 4] * a + 127) / 255);
+			dest[1] = static_cast<unsigned char>((line[x * 4 + 1] * a + 127) / 255);
+			dest[2] = static_cast<unsigned char>((line[x * 4 + 2] * a + 127) / 255);
+			dest[3] = static_cast<unsigned char>(a);
+		}
+	}
+	return texture;
+}
+
+void easy2d::SoftwareRenderDevice::drawTexture(Texture * texture, const Rect & destRect, const Rect & srcRect, float opacity)
+{
+	if (!_drawing)
+	{
+		E2D_WARNING(L"SoftwareRenderDevice: drawing outside beginFrame / endFrame!");
+		return;
+	}
+
+	// ֻıʱ
+	if (texture != _batchTexture && !dynamic_cast<SoftwareTexture*>(texture))
+	{
+		E2D_WARNING(L"SoftwareRenderDevice::drawTexture failed! Texture is not created by this device.");
+		return;
+	}
+
+	_addSprite(texture, _transform, destRect, srcRect, opacity);
+}
+
+void easy2d::SoftwareRenderDevice::fillRect(const Rect & rect, const Color & color)
+{
+	Command cmd;
+	cmd.type = Command::Type::FillRect;
+	cmd.rect = rect;
+	_setColor(cmd, color);
+	_addCommand(cmd, rect);
+}
+
+void easy2d::SoftwareRenderDevice::drawRect(const Rect & rect, const Color & color, float strokeWidth, LineJoin lineJoin)
+{
+	Command cmd;
+	cmd.type = Command::Type::StrokeRect;
+	cmd.rect = rect;
+	cmd.strokeWidth = strokeWidth;
+	cmd.lineJoin = lineJoin;
+	_setColor(cmd, color);
+
+	const float half = strokeWidth / 2;
+	_addCommand(cmd, Rect(rect.getLeft() - half, rect.getTop() - half, rect.size.width + strokeWidth, rect.size.height + strokeWidth));
+}
+
+void easy2d::SoftwareRenderDevice::fillRoundedRect(const Rect & rect, float radiusX, float radiusY, const Color & color)
+{
+	Command cmd;
+	cmd.type = Command::Type::FillRoundedRect;
+	cmd.rect = rect;
+	cmd.radiusX = min(radiusX, rect.size.width / 2);
+	cmd.radiusY = min(radiusY, rect.size.height / 2);
+	_setColor(cmd, color);
+	_addCommand(cmd, rect);
+}
+
+void easy2d::SoftwareRenderDevice::drawRoundedRect(const Rect & rect, float radiusX, float radiusY, const Color & color, float strokeWidth, LineJoin lineJoin)
+{
+	Command cmd;
+	cmd.type = Command::Type::StrokeRoundedRect;
+	cmd.rect = rect;
+	cmd.radiusX = min(radiusX, rect.size.width / 2);
+	cmd.radiusY = min(radiusY, rect.size.height / 2);
+	cmd.strokeWidth = strokeWidth;
+	cmd.lineJoin = lineJoin;
+	_setColor(cmd, color);
+
+	const float half = strokeWidth / 2;
+	_addCommand(cmd, Rect(rect.getLeft() - half, rect.getTop() - half, rect.size.width + strokeWidth, rect.size.height + strokeWidth));
+}
+
+void easy2d::SoftwareRenderDevice::fillEllipse(const Point & center, float radiusX, float radiusY, const Color & color)
+{
+	Command cmd;
+	cmd.type = Command::Type::FillEllipse;
+	cmd.rect = Rect(center.x - radiusX, center.y - radiusY, radiusX * 2, radiusY * 2);
+	cmd.radiusX = radiusX;
+	cmd.radiusY = radiusY;
+	_setColor(cmd, color);
+	_addCommand(cmd, cmd.rect);
+}
+
+void easy2d::SoftwareRenderDevice::drawEllipse(const Point & center, float radiusX, float radiusY, const Color & color, float strokeWidth)
+{
+	Command cmd;
+	cmd.type = Command::Type::StrokeEllipse;
+	cmd.rect = Rect(center.x - radiusX, center.y - radiusY, radiusX * 2, radiusY * 2);
+	cmd.radiusX = radiusX;
+	cmd.radiusY = radiusY;
+	cmd.strokeWidth = strokeWidth;
+	_setColor(cmd, color);
+
+	const float half = strokeWidth / 2;
+	_addCommand(cmd, Rect(cmd.rect.getLeft() - half, cmd.rect.getTop() - half, cmd.rect.size.width + strokeWidth, cmd.rect.size.height + strokeWidth));
+}
+
+void easy2d::SoftwareRenderDevice::pushLayer(const LayerParam & param)
+{
+	if (!_drawing)
+	{
+		E2D_WARNING(L"SoftwareRenderDevice::pushLayer called outside beginFrame / endFrame!");
+		return;
+	}
+
+	_flushSprites(FlushReason::LayerChanged);
+
+	// ͼϲĲüͲ͸
+	const LayerParam& parent = _layers.back();
+	_layers.push_back(LayerParam(Intersect(parent.clipRect, param.clipRect), parent.opacity * param.opacity));
+}
+
+void easy2d::SoftwareRenderDevice::popLayer()
+{
+	if (_layers.size() <= 1)
+	{
+		E2D_WARNING(L"SoftwareRenderDevice::popLayer failed! Layer stack is empty.");
+		return;
+	}
+
+	_flushSprites(FlushReason::LayerChanged);
+	_layers.pop_back();
+}
+
+bool easy2d::SoftwareRenderDevice::isFramePreserved() const
+{
+	// ֻ֡ endFrame ʱ¹դ
+	return true;
+}
+
+void easy2d::SoftwareRenderDevice::_drawSprites(Texture * texture, const SpriteQuad * quads, size_t count)
+{
+	const LayerParam& layer = _layers.back();
+
+	Command cmd;
+	cmd.type = Command::Type::Texture;
+	cmd.texture = texture;
+	cmd.firstSprite = _sprites.size();
+	cmd.left = _width;
+	cmd.top = _height;
+
+	// һֻ¼һİΧΪоΧеĲ
+	for (size_t i = 0; i < count; ++i)
+	{
+		const SpriteQuad& quad = quads[i];
+		if (!quad.transform.isInvertible())
+		{
+			continue;
+		}
+
+		Sprite sprite;
+		sprite.opacity = ToByte(quad.opacity * layer.opacity);
+		if (sprite.opacity == 0)
+		{
+			continue;
+		}
+
+		Rect deviceRect = Intersect(quad.transform.transform(quad.destRect), layer.clipRect);
+		sprite.left = max(static_cast<int>(::floorf(deviceRect.getLeft())), 0);
+		sprite.top = max(static_cast<int>(::floorf(deviceRect.getTop())), 0);
+		sprite.right = min(static_cast<int>(::ceilf(deviceRect.getRight())), _width);
+		sprite.bottom = min(static_cast<int>(::ceilf(deviceRect.getBottom())), _height);
+		if (sprite.left >= sprite.right || sprite.top >= sprite.bottom)
+		{
+			continue;
+		}
+
+		sprite.inverse = Matrix32::invert(quad.transform);
+		sprite.destRect = quad.destRect;
+		sprite.srcRect = quad.srcRect;
+		_sprites.push_back(sprite);
+
+		cmd.left = min(cmd.left, sprite.left);
+		cmd.top = min(cmd.top, sprite.top);
+		cmd.right = max(cmd.right, sprite.right);
+		cmd.bottom = max(cmd.bottom, sprite.bottom);
+	}
+
+	cmd.spriteCount = _sprites.size() - cmd.firstSprite;
+	if (cmd.spriteCount == 0)
+	{
+		return;
+	}
+
+	texture->retain();
+	_commands.push_back(cmd);
+}
+
+void easy2d::SoftwareRenderDevice::_setColor(Command & cmd, const Color & color) const
+{
+	const float alpha = color.getAlpha() * _layers.back().opacity;
+	cmd.color[0] = ToByte(color.getRed() * alpha);
+	cmd.color[1] = ToByte(color.getGreen() * alpha);
+	cmd.color[2] = ToByte(color.getBlue() * alpha);
+	cmd.color[3] = ToByte(alpha);
+}
+
+void easy2d::SoftwareRenderDevice::_addCommand(Command & cmd, const Rect & bounds)
+{
+	if (!_drawing)
+	{
+		E2D_WARNING(L"SoftwareRenderDevice: drawing outside beginFrame / endFrame!");
+		return;
+	}
+
+	// ֤˳ύ֮ǰľ
+	_flushSprites(FlushReason::StateChanged);
+
+	// ȫ͸任棨Ϊ 0ʱ
+	if (cmd.color[3] == 0 || !_transform.isInvertible())
+	{
+		return;
+	}
+
+	// 豸µİΧУõǰͼü
+	Rect deviceRect = Intersect(_transform.transform(bounds), _layers.back().clipRect);
+	cmd.left = max(static_cast<int>(::floorf(deviceRect.getLeft())), 0);
+	cmd.top = max(static_cast<int>(::floorf(deviceRect.getTop())), 0);
+	cmd.right = min(static_cast<int>(::ceilf(deviceRect.getRight())), _width);
+	cmd.bottom = min(static_cast<int>(::ceilf(deviceRect.getBottom())), _height);
+
+	if (cmd.left >= cmd.right || cmd.top >= cmd.bottom)
+	{
+		return;
+	}
+
+	cmd.inverse = Matrix32::invert(_transform);
+	_commands.push_back(cmd);
+}
+
+void easy2d::SoftwareRenderDevice::_rasterize(int bandTop, int bandBottom)
+{
+	// ձ
+	for (int y = bandTop; y < bandBottom; ++y)
+	{
+		unsigned char* line = &_framebuffer[static_cast<size_t>(y) * _width * 4];
+		for (int x = 0; x < _width; ++x)
+		{
+			::memcpy(line + x * 4, _clearColor, 4);
+		}
+	}
+
+	for (const auto& cmd : _commands)
+	{
+		const int top = max(cmd.top, bandTop);
+		const int bottom = min(cmd.bottom, bandBottom);
+		if (top >= bottom)
+		{
+			continue;
+		}
+
+		if (cmd.type == Command::Type::Texture)
+		{
+			_rasterizeSprites(cmd, top, bottom);
+			continue;
+		}
+
+		const Matrix32& inv = cmd.inverse;
+		const Rect& rect = cmd.rect;
+		const float cx = rect.origin.x + rect.size.width / 2;
+		const float cy = rect.origin.y + rect.size.height / 2;
+		const float hw = rect.size.width / 2;
+		const float hh = rect.size.height / 2;
+		const float half = cmd.strokeWidth / 2;
+
+		for (int y = top; y < bottom; ++y)
+		{
+			unsigned char* dest = &_framebuffer[(static_cast<size_t>(y) * _width + cmd.left) * 4];
+
+			// Ŀʼ x زֲ
+			Vector2 local = inv.transform(Vector2(cmd.left + 0.5f, y + 0.5f));
+			float lx = local.x;
+			float ly = local.y;
+
+			for (int x = cmd.left; x < cmd.right; ++x, dest += 4, lx += inv._11, ly += inv._12)
+			{
+				bool covered = false;
+				switch (cmd.type)
+				{
+				default:
+					break;
+				case Command::Type::FillRect:
+					covered = lx >= rect.getLeft() && lx < rect.getRight() && ly >= rect.getTop() && ly < rect.getBottom();
+					break;
+				case Command::Type::StrokeRect:
+					covered = InStrokeOuter(lx, ly, rect, half, cmd.lineJoin)
+						&& !(::fabsf(lx - cx) < hw - half && ::fabsf(ly - cy) < hh - half);
+					break;
+				case Command::Type::FillRoundedRect:
+					covered = InRoundedRect(lx, ly, cx, cy, hw, hh, cmd.radiusX, cmd.radiusY);
+					break;
+				case Command::Type::StrokeRoundedRect:
+					covered = InRoundedRect(lx, ly, cx, cy, hw + half, hh + half, cmd.radiusX + half, cmd.radiusY + half)
+						&& !(hw > half && hh > half && InRoundedRect(lx, ly, cx, cy, hw - half, hh - half, cmd.radiusX - half, cmd.radiusY - half));
+					break;
+				case Command::Type::FillEllipse:
+					covered = InEllipse(lx - cx, ly - cy, cmd.radiusX, cmd.radiusY);
+					break;
+				case Command::Type::StrokeEllipse:
+					covered = InEllipse(lx - cx, ly - cy, cmd.radiusX + half, cmd.radiusY + half)
+						&& !InEllipse(lx - cx, ly - cy, cmd.radiusX - half, cmd.radiusY - half);
+					break;
+				}
+
+				if (covered)
+				{
+					Blend(dest, cmd.color);
+				}
+			}
+		}
+	}
+}
+
+void easy2d::SoftwareRenderDevice::_rasterizeSprites(const Command & cmd, int bandTop, int bandBottom)
+{
+	const SoftwareTexture* texture = static_cast<const SoftwareTexture*>(cmd.texture);
+
+	for (size_t i = cmd.firstSprite; i < cmd.firstSprite + cmd.spriteCount; ++i)
+	{
+		const Sprite& sprite = _sprites[i];
+		const int top = max(sprite.top, bandTop);
+		const int bottom = min(sprite.bottom, bandBottom);
+		if (top >= bottom)
+		{
+			continue;
+		}
+
+		const Matrix32& inv = sprite.inverse;
+		const Rect& rect = sprite.destRect;
+		const Rect& src = sprite.srcRect;
+		const float scaleX = src.size.width / rect.size.width;
+		const float scaleY = src.size.height / rect.size.height;
+		const unsigned int opacity = sprite.opacity;
+
+		for (int y = top; y < bottom; ++y)
+		{
+			unsigned char* dest = &_framebuffer[(static_cast<size_t>(y) * _width + sprite.left) * 4];
+
+			Vector2 local = inv.transform(Vector2(sprite.left + 0.5f, y + 0.5f));
+			float lx = local.x;
+			float ly = local.y;
+
+			for (int x = sprite.left; x < sprite.right; ++x, dest += 4, lx += inv._11, ly += inv._12)
+			{
+				if (lx < rect.getLeft() || lx >= rect.getRight() || ly < rect.getTop() || ly >= rect.getBottom())
+				{
+					continue;
+				}
+
+				// ڲ
+				int u = static_cast<int>(src.origin.x + (lx - rect.origin.x) * scaleX);
+				int v = static_cast<int>(src.origin.y + (ly - rect.origin.y) * scaleY);
+				u = min(max(u, 0), texture->width - 1);
+				v = min(max(v, 0), texture->height - 1);
+
+				const unsigned char* texel = &texture->pixels[(static_cast<size_t>(v) * texture->width + u) * 4];
+				unsigned char color[4];
+				if (opacity == 255)
+				{
+					::memcpy(color, texel, 4);
+				}
+				else
+				{
+					color[0] = static_cast<unsigned char>((texel[0] * opacity + 127) / 255);
+					color[1] = static_cast<unsigned char>((texel[1] * opacity + 127) / 255);
+					color[2] = static_cast<unsigned char>((texel[2] * opacity + 127) / 255);
+					color[3] = static_cast<unsigned char>((texel[3] * opacity + 127) / 255);
+				}
+				if (color[3] != 0)
+				{
+					Blend(dest, color);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,563 @@
+#include <easy2d/e2drender.h>
+#include <easy2d/e2dbase.h>
+#include <easy2d/e2dplatform.h>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	// ͼļıʶͰ汾
+	const unsigned char ATLAS_MAGIC[4] = { 'E', '2', 'D', 'A' };
+	const unsigned int ATLAS_VERSION = 1;
+
+	// Сд 32 λ
+	bool WriteUInt(FILE* file, unsigned int value)
+	{
+		unsigned char bytes[4] = {
+			static_cast<unsigned char>(value & 0xFF),
+			static_cast<unsigned char>((value >> 8) & 0xFF),
+			static_cast<unsigned char>((value >> 16) & 0xFF),
+			static_cast<unsigned char>((value >> 24) & 0xFF)
+		};
+		return ::fwrite(bytes, 1, 4, file) == 4;
+	}
+
+	// Сȡ 32 λ
+	bool ReadUInt(FILE* file, unsigned int* value)
+	{
+		unsigned char bytes[4];
+		if (::fread(bytes, 1, 4, file) != 4)
+		{
+			return false;
+		}
+		*value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<unsigned int>(bytes[3]) << 24);
+		return true;
+	}
+}
+
+easy2d::TextureAtlas::TextureAtlas()
+	: _pageWidth(2048)
+	, _pageHeight(2048)
+	, _padding(1)
+	, _packed(false)
+{
+}
+
+easy2d::TextureAtlas::TextureAtlas(int pageWidth, int pageHeight, int padding /* = 1 */)
+	: _pageWidth(max(pageWidth, 1))
+	, _pageHeight(max(pageHeight, 1))
+	, _padding(max(padding, 0))
+	, _packed(false)
+{
+}
+
+easy2d::TextureAtlas::~TextureAtlas()
+{
+	_clearPages();
+}
+
+bool easy2d::TextureAtlas::add(const String& name, const void* pixels, int width, int height, int pitch)
+{
+	if (_packed)
+	{
+		E2D_WARNING(L"TextureAtlas::add failed! The atlas has already been packed.");
+		return false;
+	}
+
+	if (!pixels || width <= 0 || height <= 0 || pitch < width * 4)
+	{
+		E2D_WARNING(L"TextureAtlas::add failed! Invalid pixel data.");
+		return false;
+	}
+
+	if (width + _padding * 2 > _pageWidth || height + _padding * 2 > _pageHeight)
+	{
+		E2D_WARNING(L"TextureAtlas::add failed! The image is larger than an atlas page.");
+		return false;
+	}
+
+	if (contains(name))
+	{
+		E2D_WARNING(L"TextureAtlas::add failed! An image with the same name already exists.");
+		return false;
+	}
+
+	Entry entry;
+	entry.name = name;
+	entry.page = -1;
+	entry.x = entry.y = 0;
+	entry.width = width;
+	entry.height = height;
+	entry.pixels.resize(static_cast<size_t>(width) * height * 4);
+
+	const unsigned char* src = static_cast<const unsigned char*>(pixels);
+	for (int y = 0; y < height; ++y)
+	{
+		::memcpy(&entry.pixels[static_cast<size_t>(y) * width * 4], src + static_cast<size_t>(y) * pitch, static_cast<size_t>(width) * 4);
+	}
+
+	_entries.push_back(std::move(entry));
+	return true;
+}
+
+bool easy2d::TextureAtlas::add(const String& filePath)
+{
+	std::vector<unsigned char> pixels;
+	int width = 0, height = 0;
+	if (!Image::decode(filePath, pixels, &width, &height))
+	{
+		E2D_WARNING(L"TextureAtlas::add failed! Cannot decode the image file.");
+		return false;
+	}
+	return add(filePath, pixels.data(), width, height, width * 4);
+}
+
+bool easy2d::TextureAtlas::build()
+{
+	if (_entries.empty())
+	{
+		E2D_WARNING(L"TextureAtlas::build failed! The atlas is empty.");
+		return false;
+	}
+
+	if (!_packed && !_pack())
+	{
+		return false;
+	}
+	return _createTextures();
+}
+
+bool easy2d::TextureAtlas::save(const String& filePath)
+{
+	if (!_packed && !_pack())
+	{
+		return false;
+	}
+
+	for (const auto& page : _pages)
+	{
+		if (page.pixels.empty())
+		{
+			E2D_WARNING(L"TextureAtlas::save failed! Pixel data has been released after build.");
+			return false;
+		}
+	}
+
+	FILE* file = platform::OpenFile(filePath, "wb");
+	if (!file)
+	{
+		E2D_WARNING(L"TextureAtlas::save failed! Cannot open file.");
+		return false;
+	}
+
+	// ļͷͼƬǸҳݣʱҪ
+	bool succeeded = ::fwrite(ATLAS_MAGIC, 1, 4, file) == 4
+		&& WriteUInt(file, ATLAS_VERSION)
+		&& WriteUInt(file, static_cast<unsigned int>(_entries.size()))
+		&& WriteUInt(file, static_cast<unsigned int>(_pages.size()));
+
+	for (size_t i = 0; succeeded && i < _entries.size(); ++i)
+	{
+		const Entry& entry = _entries[i];
+		succeeded = WriteUInt(file, static_cast<unsigned int>(entry.name.size()));
+		for (size_t j = 0; succeeded && j < entry.name.size(); ++j)
+		{
+			succeeded = WriteUInt(file, static_cast<unsigned int>(entry.name[j]));
+		}
+		succeeded = succeeded
+			&& WriteUInt(file, static_cast<unsigned int>(entry.page))
+			&& WriteUInt(file, static_cast<unsigned int>(entry.x))
+			&& WriteUInt(file, static_cast<unsigned int>(entry.y))
+			&& WriteUInt(file, static_cast<unsigned int>(entry.width))
+			&& WriteUInt(file, static_cast<unsigned int>(entry.height));
+	}
+
+	for (size_t i = 0; succeeded && i < _pages.size(); ++i)
+	{
+		const Page& page = _pages[i];
+		succeeded = WriteUInt(file, static_cast<unsigned int>(page.width))
+			&& WriteUInt(file, static_cast<unsigned int>(page.height))
+			&& ::fwrite(page.pixels.data(), 1, page.pixels.size(), file) == page.pixels.size();
+	}
+
+	::fclose(file);
+
+	if (!succeeded)
+	{
+		E2D_WARNING(L"TextureAtlas::save failed! Cannot write file.");
+	}
+	return succeeded;
+}
+
+bool easy2d::TextureAtlas::load(const String& filePath)
+{
+	FILE* file = platform::OpenFile(filePath, "rb");
+	if (!file)
+	{
+		E2D_WARNING(L"TextureAtlas::load failed! Cannot open file.");
+		return false;
+	}
+
+	_clearPages();
+	_entries.clear();
+	_packed = false;
+
+	unsigned char magic[4] = { 0 };
+	unsigned int version = 0, entryCount = 0, pageCount = 0;
+	bool succeeded = ::fread(magic, 1, 4, file) == 4
+		&& ::memcmp(magic, ATLAS_MAGIC, 4) == 0
+		&& ReadUInt(file, &version)
+		&& version == ATLAS_VERSION
+		&& ReadUInt(file, &entryCount)
+		&& ReadUInt(file, &pageCount);
+
+	for (unsigned int i = 0; succeeded && i < entryCount; ++i)
+	{
+		Entry entry;
+		unsigned int length = 0;
+		succeeded = ReadUInt(file, &length);
+		for (unsigned int j = 0; succeeded && j < length; ++j)
+		{
+			unsigned int ch = 0;
+			succeeded = ReadUInt(file, &ch);
+			entry.name.push_back(static_cast<wchar_t>(ch));
+		}
+
+		unsigned int values[5] = { 0 };
+		for (int j = 0; succeeded && j < 5; ++j)
+		{
+			succeeded = ReadUInt(file, &values[j]);
+		}
+
+		if (succeeded)
+		{
+			entry.page = int(values[0]);
+			entry.x = int(values[1]);
+			entry.y = int(values[2]);
+			entry.width = int(values[3]);
+			entry.height = int(values[4]);
+			succeeded = values[0] < pageCount;
+			_entries.push_back(std::move(entry));
+		}
+	}
+
+	for (unsigned int i = 0; succeeded && i < pageCount; ++i)
+	{
+		Page page;
+		unsigned int width = 0, height = 0;
+		succeeded = ReadUInt(file, &width)
+			&& ReadUInt(file, &height)
+			&& width > 0 && height > 0
+			&& width <= 16384 && height <= 16384;
+
+		if (succeeded)
+		{
+			page.width = int(width);
+			page.height = int(height);
+			page.texture = nullptr;
+			page.pixels.resize(static_cast<size_t>(width) * height * 4);
+			succeeded = ::fread(page.pixels.data(), 1, page.pixels.size(), file) == page.pixels.size();
+			_pages.push_back(std::move(page));
+		}
+	}
+
+	::fclose(file);
+
+	// ͼƬҳ֮
+	for (size_t i = 0; succeeded && i < _entries.size(); ++i)
+	{
+		const Entry& entry = _entries[i];
+		const Page& page = _pages[entry.page];
+		succeeded = entry.x >= 0 && entry.y >= 0
+			&& entry.x + entry.width <= page.width
+			&& entry.y + entry.height <= page.height;
+	}
+
+	if (!succeeded)
+	{
+		E2D_WARNING(L"TextureAtlas::load failed! Invalid atlas file.");
+		_clearPages();
+		_entries.clear();
+		return false;
+	}
+
+	_packed = true;
+	return _createTextures();
+}
+
+bool easy2d::TextureAtlas::contains(const String& name) const
+{
+	for (const auto& entry : _entries)
+	{
+		if (entry.name == name)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+easy2d::Image * easy2d::TextureAtlas::getImage(const String& name) const
+{
+	for (const auto& entry : _entries)
+	{
+		if (entry.name != name)
+			continue;
+
+		Texture * texture = (entry.page >= 0) ? _pages[entry.page].texture : nullptr;
+		if (!texture)
+		{
+			E2D_WARNING(L"TextureAtlas::getImage failed! The atlas has not been built.");
+			return nullptr;
+		}
+
+		auto image = gcnew Image;
+		image->_setTexture(texture, Rect(float(entry.x), float(entry.y), float(entry.width), float(entry.height)));
+		return image;
+	}
+	return nullptr;
+}
+
+size_t easy2d::TextureAtlas::getImageCount() const
+{
+	return _entries.size();
+}
+
+size_t easy2d::TextureAtlas::getPageCount() const
+{
+	return _pages.size();
+}
+
+easy2d::Texture * easy2d::TextureAtlas::getPage(size_t index) const
+{
+	return (index < _pages.size()) ? _pages[index].texture : nullptr;
+}
+
+float easy2d::TextureAtlas::getOccupancy() const
+{
+	double used = 0, total = 0;
+	for (const auto& entry : _entries)
+	{
+		used += double(entry.width) * entry.height;
+	}
+	for (const auto& page : _pages)
+	{
+		total += double(page.width) * page.height;
+	}
+	return total > 0 ? float(used / total) : 0.f;
+}
+
+bool easy2d::TextureAtlas::_pack()
+{
+	_clearPages();
+
+	// Ӹߵηã㷨˳˷ѵĿռ
+	std::vector<size_t> order(_entries.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+	{
+		const Entry& ea = _entries[a];
+		const Entry& eb = _entries[b];
+		return ea.height != eb.height ? ea.height > eb.height : ea.width > eb.width;
+	});
+
+	for (size_t i : order)
+	{
+		Entry& entry = _entries[i];
+		int width = entry.width + _padding * 2;
+		int height = entry.height + _padding * 2;
+
+		int x = 0, y = 0;
+		size_t index = 0;
+		size_t pageIndex = 0;
+		for (; pageIndex < _pages.size(); ++pageIndex)
+		{
+			if (_findPosition(_pages[pageIndex], width, height, &x, &y, &index))
+				break;
+		}
+
+		if (pageIndex == _pages.size())
+		{
+			// ҳ涼Ųʱҳ
+			Page page;
+			page.width = _pageWidth;
+			page.height = 0;
+			page.texture = nullptr;
+			Skyline ground = { 0, 0, _pageWidth };
+			page.skyline.push_back(ground);
+			_pages.push_back(std::move(page));
+
+			if (!_findPosition(_pages.back(), width, height, &x, &y, &index))
+			{
+				E2D_WARNING(L"TextureAtlas::build failed! Cannot place an image.");
+				_clearPages();
+				return false;
+			}
+		}
+
+		Page& page = _pages[pageIndex];
+		_placeRect(page, index, x, y, width, height);
+		page.height = max(page.height, y + height);
+
+		entry.page = int(pageIndex);
+		entry.x = x + _padding;
+		entry.y = y + _padding;
+	}
+
+	// ҳ߶ֻȡʵõĲ
+	for (auto& page : _pages)
+	{
+		page.pixels.assign(static_cast<size_t>(page.width) * page.height * 4, 0);
+		page.skyline.clear();
+	}
+
+	for (auto& entry : _entries)
+	{
+		Page& page = _pages[entry.page];
+		const size_t pagePitch = static_cast<size_t>(page.width) * 4;
+		const size_t rowBytes = static_cast<size_t>(entry.width) * 4;
+
+		// ѱԵ쵽УԹʱͼƬ
+		for (int row = -_padding; row < entry.height + _padding; ++row)
+		{
+			int srcRow = min(max(row, 0), entry.height - 1);
+			const unsigned char* src = &entry.pixels[srcRow * rowBytes];
+			unsigned char* dest = &page.pixels[(entry.y + row) * pagePitch + entry.x * 4];
+
+			::memcpy(dest, src, rowBytes);
+			for (int col = 1; col <= _padding; ++col)
+			{
+				::memcpy(dest - col * 4, src, 4);
+				::memcpy(dest + rowBytes + (col - 1) * 4, src + rowBytes - 4, 4);
+			}
+		}
+
+		std::vector<unsigned char>().swap(entry.pixels);
+	}
+
+	_packed = true;
+	return true;
+}
+
+bool easy2d::TextureAtlas::_findPosition(const Page& page, int width, int height, int* x, int* y, size_t* index) const
+{
+	// ѡú󶥲͵λãͬʱѡλ
+	int bestTop = _pageHeight + 1;
+	bool found = false;
+
+	const auto& skyline = page.skyline;
+	for (size_t i = 0; i < skyline.size(); ++i)
+	{
+		int left = skyline[i].x;
+		if (left + width > _pageWidth)
+			break;
+
+		// θǵжߵһξø߶
+		int top = skyline[i].y;
+		int remaining = width;
+		for (size_t j = i; remaining > 0; ++j)
+		{
+			top = max(top, skyline[j].y);
+			remaining -= skyline[j].width;
+		}
+
+		if (top + height <= _pageHeight && top + height < bestTop)
+		{
+			bestTop = top + height;
+			*x = left;
+			*y = top;
+			*index = i;
+			found = true;
+		}
+	}
+	return found;
+}
+
+void easy2d::TextureAtlas::_placeRect(Page& page, size_t index, int x, int y, int width, int height)
+{
+	auto& skyline = page.skyline;
+
+	Skyline node = { x, y + height, width };
+	skyline.insert(skyline.begin() + index, node);
+
+	// ¾סĶ̻ɾ
+	for (size_t i = index + 1; i < skyline.size();)
+	{
+		const Skyline& prev = skyline[i - 1];
+		int overlap = prev.x + prev.width - skyline[i].x;
+		if (overlap <= 0)
+			break;
+
+		skyline[i].x += overlap;
+		skyline[i].width -= overlap;
+		if (skyline[i].width > 0)
+			break;
+
+		skyline.erase(skyline.begin() + i);
+	}
+
+	// ϲ߶ͬڶ
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+bool easy2d::TextureAtlas::_createTextures()
+{
+	RenderDevice* device = Renderer::getDevice();
+	if (!device)
+	{
+		E2D_WARNING(L"TextureAtlas::build failed! No render device.");
+		return false;
+	}
+
+	for (auto& page : _pages)
+	{
+		if (page.texture)
+			continue;
+
+		page.texture = device->createTexture(page.pixels.data(), page.width, page.height, page.width * 4);
+		if (!page.texture)
+		{
+			E2D_WARNING(L"TextureAtlas::build failed! Cannot create texture.");
+			return false;
+		}
+	}
+
+	for (const auto& entry : _entries)
+	{
+		Image::__addAtlasRegion(
+			entry.name,
+			_pages[entry.page].texture,
+			Rect(float(entry.x), float(entry.y), float(entry.width), float(entry.height))
+		);
+	}
+
+	// Ҫ
+	for (auto& page : _pages)
+	{
+		std::vector<unsigned char>().swap(page.pixels);
+	}
+	return true;
+}
+
+void easy2d::TextureAtlas::_clearPages()
+{
+	for (auto& page : _pages)
+	{
+		GC::release(page.texture);
+	}
+	_pages.clear();
+}
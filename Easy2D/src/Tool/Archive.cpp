@@ -0,0 +1,650 @@
+#include <easy2d/e2dtool.h>
+#include <easy2d/e2dplatform.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+
+namespace
+{
+	// ԴļʽС򣩣
+	// ļͷ   "E2DP"汾Ŀֶ
+	// Ŀ¼     ÿĿλáƳȡλá洢СԭʼС־
+	// Ʊ   UTF-8 Ŀ
+	//      ÿĿݣʼλð 16 ֽڶ
+	const char ARCHIVE_MAGIC[4] = { 'E', '2', 'D', 'P' };
+	const unsigned int ARCHIVE_VERSION = 1;
+	const size_t HEADER_SIZE = 16;
+	const size_t ENTRY_SIZE = 24;
+	const size_t DATA_ALIGNMENT = 16;
+	const unsigned int FLAG_LZ4 = 1;
+
+	struct EntryInfo
+	{
+		unsigned int nameOffset;
+		unsigned int nameLength;
+		unsigned int offset;
+		unsigned int size;
+		unsigned int originalSize;
+		unsigned int flags;
+	};
+
+	std::vector<easy2d::Archive*> s_vMountedArchives;
+
+	// ѹĿĽѹ߳ҲȡԴ
+	std::mutex s_DecompressMutex;
+
+	unsigned int ReadU32(const unsigned char* p)
+	{
+		return unsigned(p[0]) | (unsigned(p[1]) << 8) | (unsigned(p[2]) << 16) | (unsigned(p[3]) << 24);
+	}
+
+	void WriteU32(std::vector<unsigned char>& out, unsigned int value)
+	{
+		out.push_back(static_cast<unsigned char>(value));
+		out.push_back(static_cast<unsigned char>(value >> 8));
+		out.push_back(static_cast<unsigned char>(value >> 16));
+		out.push_back(static_cast<unsigned char>(value >> 24));
+	}
+
+	EntryInfo ReadEntry(const unsigned char* data, size_t index)
+	{
+		const unsigned char* p = data + HEADER_SIZE + index * ENTRY_SIZE;
+		EntryInfo info;
+		info.nameOffset = ReadU32(p);
+		info.nameLength = ReadU32(p + 4);
+		info.offset = ReadU32(p + 8);
+		info.size = ReadU32(p + 12);
+		info.originalSize = ReadU32(p + 16);
+		info.flags = ReadU32(p + 20);
+		return info;
+	}
+
+	easy2d::String FromUtf8(const unsigned char* data, size_t size)
+	{
+		//  BOM
+		if (size >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF)
+		{
+			data += 3;
+			size -= 3;
+		}
+		return easy2d::Utf8ToWide(reinterpret_cast<const char*>(data), size);
+	}
+
+	// ͳһʹ '/' Ϊָȥͷ "./"
+	easy2d::ByteString NormalizeName(const easy2d::String& name)
+	{
+		easy2d::ByteString result = easy2d::WideToUtf8(name);
+		std::replace(result.begin(), result.end(), '\\', '/');
+		while (result.compare(0, 2, "./") == 0)
+		{
+			result.erase(0, 2);
+		}
+		return result;
+	}
+
+	bool ReadFileData(const easy2d::String& filePath, std::vector<unsigned char>& data)
+	{
+		FILE* file = easy2d::platform::OpenFile(filePath, "rb");
+		if (!file)
+		{
+			return false;
+		}
+
+		bool succeeded = ::fseek(file, 0, SEEK_END) == 0;
+		long size = succeeded ? ::ftell(file) : -1;
+		succeeded = size >= 0 && ::fseek(file, 0, SEEK_SET) == 0;
+		if (succeeded)
+		{
+			data.resize(static_cast<size_t>(size));
+			succeeded = data.empty() || ::fread(data.data(), 1, data.size(), file) == data.size();
+		}
+		::fclose(file);
+		return succeeded;
+	}
+
+	//
+	// LZ4 ʽ
+	// ÿɱֽڡƥɣһֻ
+	//
+
+	const size_t LZ4_MIN_MATCH = 4;
+	const size_t LZ4_LAST_LITERALS = 5;		//  5 ֽڱ
+	const size_t LZ4_MF_LIMIT = 12;			// һƥھβ 12 ֽ֮ǰʼ
+	const int LZ4_HASH_BITS = 12;
+
+	void Lz4WriteLength(std::vector<unsigned char>& dst, size_t length)
+	{
+		while (length >= 255)
+		{
+			dst.push_back(255);
+			length -= 255;
+		}
+		dst.push_back(static_cast<unsigned char>(length));
+	}
+
+	void Lz4WriteSequence(std::vector<unsigned char>& dst, const unsigned char* literals, size_t literalLength, size_t offset, size_t matchLength)
+	{
+		size_t matchCode = matchLength ? matchLength - LZ4_MIN_MATCH : 0;
+		unsigned char token = static_cast<unsigned char>((min(literalLength, size_t(15)) << 4) | min(matchCode, size_t(15)));
+		dst.push_back(token);
+		if (literalLength >= 15)
+		{
+			Lz4WriteLength(dst, literalLength - 15);
+		}
+		dst.insert(dst.end(), literals, literals + literalLength);
+
+		if (matchLength)
+		{
+			dst.push_back(static_cast<unsigned char>(offset));
+			dst.push_back(static_cast<unsigned char>(offset >> 8));
+			if (matchCode >= 15)
+			{
+				Lz4WriteLength(dst, matchCode - 15);
+			}
+		}
+	}
+
+	void Lz4Compress(const unsigned char* src, size_t size, std::vector<unsigned char>& dst)
+	{
+		dst.clear();
+		dst.reserve(size + size / 255 + 16);
+
+		size_t anchor = 0;
+		if (size > LZ4_MF_LIMIT)
+		{
+			std::vector<size_t> table(size_t(1) << LZ4_HASH_BITS, size_t(-1));
+			const size_t matchLimit = size - LZ4_LAST_LITERALS;
+			const size_t startLimit = size - LZ4_MF_LIMIT;
+
+			size_t ip = 0;
+			while (ip < startLimit)
+			{
+				unsigned int sequence;
+				::memcpy(&sequence, src + ip, 4);
+				size_t hash = (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+				size_t ref = table[hash];
+				table[hash] = ip;
+
+				if (ref != size_t(-1) && ip - ref <= 65535 && ::memcmp(src + ref, src + ip, 4) == 0)
+				{
+					size_t length = LZ4_MIN_MATCH;
+					while (ip + length < matchLimit && src[ref + length] == src[ip + length])
+					{
+						++length;
+					}
+
+					Lz4WriteSequence(dst, src + anchor, ip - anchor, ip - ref, length);
+					ip += length;
+					anchor = ip;
+				}
+				else
+				{
+					++ip;
+				}
+			}
+		}
+
+		Lz4WriteSequence(dst, src + anchor, size - anchor, 0, 0);
+	}
+
+	bool Lz4ReadLength(const unsigned char* src, size_t size, size_t* ip, size_t* length)
+	{
+		unsigned char byte;
+		do
+		{
+			if (*ip >= size)
+			{
+				return false;
+			}
+			byte = src[(*ip)++];
+			*length += byte;
+		} while (byte == 255);
+		return true;
+	}
+
+	bool Lz4Decompress(const unsigned char* src, size_t srcSize, unsigned char* dst, size_t dstSize)
+	{
+		size_t ip = 0, op = 0;
+		while (ip < srcSize)
+		{
+			unsigned int token = src[ip++];
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15 && !Lz4ReadLength(src, srcSize, &ip, &literalLength))
+			{
+				return false;
+			}
+			if (literalLength > srcSize - ip || literalLength > dstSize - op)
+			{
+				return false;
+			}
+			::memcpy(dst + op, src + ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			// һûƥ
+			if (ip == srcSize)
+			{
+				break;
+			}
+
+			if (srcSize - ip < 2)
+			{
+				return false;
+			}
+			size_t offset = src[ip] | (size_t(src[ip + 1]) << 8);
+			ip += 2;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !Lz4ReadLength(src, srcSize, &ip, &matchLength))
+			{
+				return false;
+			}
+			matchLength += LZ4_MIN_MATCH;
+
+			if (offset == 0 || offset > op || matchLength > dstSize - op)
+			{
+				return false;
+			}
+
+			// ƥصֽڸ
+			const unsigned char* match = dst + op - offset;
+			for (size_t i = 0; i < matchLength; ++i)
+			{
+				dst[op + i] = match[i];
+			}
+			op += matchLength;
+		}
+		return op == dstSize;
+	}
+}
+
+
+easy2d::Archive::Archive()
+	: _data(nullptr)
+	, _size(0)
+	, _mapping(nullptr)
+	, _entryCount(0)
+{
+}
+
+easy2d::Archive::Archive(const String& filePath)
+	: Archive()
+{
+	this->open(filePath);
+}
+
+easy2d::Archive::~Archive()
+{
+	close();
+}
+
+bool easy2d::Archive::open(const String& filePath)
+{
+	close();
+
+	String actualFilePath = Path::searchForFile(filePath);
+	if (actualFilePath.empty())
+	{
+		E2D_WARNING(L"Archive::open failed! File not found.");
+		return false;
+	}
+
+	size_t size = 0;
+	void* mapping = nullptr;
+	const unsigned char* data = static_cast<const unsigned char*>(platform::MapFile(actualFilePath, &size, &mapping));
+	if (!data)
+	{
+		E2D_WARNING(L"Archive::open failed! Cannot map file.");
+		return false;
+	}
+
+	// ļͷĿ¼֮ȡĿʱټ߽
+	bool valid = size >= HEADER_SIZE
+		&& ::memcmp(data, ARCHIVE_MAGIC, 4) == 0
+		&& ReadU32(data + 4) == ARCHIVE_VERSION;
+
+	size_t entryCount = valid ? ReadU32(data + 8) : 0;
+	valid = valid && entryCount <= (size - HEADER_SIZE) / ENTRY_SIZE;
+
+	for (size_t i = 0; valid && i < entryCount; ++i)
+	{
+		EntryInfo info = ReadEntry(data, i);
+		valid = size_t(info.nameOffset) + info.nameLength <= size
+			&& size_t(info.offset) + info.size <= size
+			&& info.size <= 0x7FFFFFFF
+			&& info.originalSize <= 0x7FFFFFFF
+			&& ((info.flags & FLAG_LZ4) || info.size == info.originalSize);
+	}
+
+	if (!valid)
+	{
+		E2D_WARNING(L"Archive::open failed! Invalid archive file.");
+		platform::UnmapFile(data, size, mapping);
+		return false;
+	}
+
+	_data = data;
+	_size = size;
+	_mapping = mapping;
+	_entryCount = entryCount;
+	_decompressed.resize(entryCount);
+	return true;
+}
+
+void easy2d::Archive::close()
+{
+	if (_data)
+	{
+		platform::UnmapFile(_data, _size, _mapping);
+	}
+	_data = nullptr;
+	_size = 0;
+	_mapping = nullptr;
+	_entryCount = 0;
+	_decompressed.clear();
+}
+
+bool easy2d::Archive::isOpened() const
+{
+	return _data != nullptr;
+}
+
+bool easy2d::Archive::contains(const String& name) const
+{
+	return _find(name) >= 0;
+}
+
+easy2d::Resource::Data easy2d::Archive::getData(const String& name)
+{
+	Resource::Data data;
+
+	int index = _find(name);
+	if (index < 0)
+	{
+		return data;
+	}
+
+	EntryInfo info = ReadEntry(_data, index);
+	if (!(info.flags & FLAG_LZ4))
+	{
+		// ֱָӳļݣ߲޸
+		data.buffer = const_cast<unsigned char*>(_data + info.offset);
+		data.size = static_cast<int>(info.size);
+		return data;
+	}
+
+	std::lock_guard<std::mutex> lock(s_DecompressMutex);
+
+	std::vector<unsigned char>& buffer = _decompressed[index];
+	if (buffer.empty() && info.originalSize)
+	{
+		buffer.resize(info.originalSize);
+		if (!Lz4Decompress(_data + info.offset, info.size, buffer.data(), buffer.size()))
+		{
+			E2D_WARNING(L"Archive::getData failed! Corrupted entry.");
+			buffer.clear();
+			return data;
+		}
+	}
+
+	data.buffer = buffer.data();
+	data.size = static_cast<int>(buffer.size());
+	return data;
+}
+
+easy2d::String easy2d::Archive::getText(const String& name)
+{
+	Resource::Data data = getData(name);
+	if (!data.isValid())
+	{
+		return String();
+	}
+	return FromUtf8(static_cast<const unsigned char*>(data.buffer), data.size);
+}
+
+size_t easy2d::Archive::getEntryCount() const
+{
+	return _entryCount;
+}
+
+easy2d::String easy2d::Archive::getEntryName(size_t index) const
+{
+	if (index >= _entryCount)
+	{
+		return String();
+	}
+
+	EntryInfo info = ReadEntry(_data, index);
+	return FromUtf8(_data + info.nameOffset, info.nameLength);
+}
+
+int easy2d::Archive::_find(const String& name) const
+{
+	if (!_data)
+	{
+		return -1;
+	}
+
+	const ByteString key = NormalizeName(name);
+
+	// Ŀ¼򣬶ֲ
+	size_t low = 0, high = _entryCount;
+	while (low < high)
+	{
+		size_t mid = (low + high) / 2;
+		EntryInfo info = ReadEntry(_data, mid);
+
+		size_t length = min(size_t(info.nameLength), key.size());
+		int result = ::memcmp(_data + info.nameOffset, key.data(), length);
+		if (result == 0)
+		{
+			result = (info.nameLength < key.size()) ? -1 : (info.nameLength > key.size() ? 1 : 0);
+		}
+
+		if (result == 0)
+		{
+			return static_cast<int>(mid);
+		}
+		else if (result < 0)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+	return -1;
+}
+
+void easy2d::Archive::mount(Archive * archive)
+{
+	if (!archive)
+	{
+		return;
+	}
+
+	if (std::find(s_vMountedArchives.begin(), s_vMountedArchives.end(), archive) == s_vMountedArchives.end())
+	{
+		GC::retain(archive);
+		s_vMountedArchives.push_back(archive);
+	}
+}
+
+void easy2d::Archive::unmount(Archive * archive)
+{
+	auto iter = std::find(s_vMountedArchives.begin(), s_vMountedArchives.end(), archive);
+	if (iter != s_vMountedArchives.end())
+	{
+		s_vMountedArchives.erase(iter);
+		GC::release(archive);
+	}
+}
+
+void easy2d::Archive::unmountAll()
+{
+	for (auto archive : s_vMountedArchives)
+	{
+		GC::release(archive);
+	}
+	s_vMountedArchives.clear();
+}
+
+easy2d::Archive * easy2d::Archive::search(const String& name)
+{
+	for (auto iter = s_vMountedArchives.rbegin(); iter != s_vMountedArchives.rend(); ++iter)
+	{
+		if ((*iter)->contains(name))
+		{
+			return *iter;
+		}
+	}
+	return nullptr;
+}
+
+easy2d::String easy2d::Archive::loadText(const String& filePath)
+{
+	Archive* archive = Archive::search(filePath);
+	if (archive)
+	{
+		return archive->getText(filePath);
+	}
+
+	String actualFilePath = Path::searchForFile(filePath);
+	std::vector<unsigned char> data;
+	if (actualFilePath.empty() || !ReadFileData(actualFilePath, data))
+	{
+		E2D_WARNING(L"Archive::loadText failed! File not found.");
+		return String();
+	}
+	return FromUtf8(data.data(), data.size());
+}
+
+bool easy2d::Archive::pack(const String& archivePath, const std::vector<std::pair<String, String>>& files, bool compress)
+{
+	struct PackEntry
+	{
+		ByteString name;
+		unsigned int originalSize;
+		unsigned int flags;
+		std::vector<unsigned char> data;
+	};
+
+	std::vector<PackEntry> entries(files.size());
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		PackEntry& entry = entries[i];
+		entry.name = NormalizeName(files[i].first);
+
+		std::vector<unsigned char> data;
+		String actualFilePath = Path::searchForFile(files[i].second);
+		if (actualFilePath.empty() || !ReadFileData(actualFilePath, data) || data.size() > 0x7FFFFFFF)
+		{
+			E2D_WARNING(L"Archive::pack failed! Cannot read file %ls", files[i].second.c_str());
+			return false;
+		}
+
+		entry.originalSize = static_cast<unsigned int>(data.size());
+		entry.flags = 0;
+
+		// ѹԱСѹ㸴ƶȡ
+		if (compress && !data.empty())
+		{
+			std::vector<unsigned char> compressed;
+			Lz4Compress(data.data(), data.size(), compressed);
+			if (compressed.size() < data.size() - data.size() / 8)
+			{
+				entry.data.swap(compressed);
+				entry.flags |= FLAG_LZ4;
+			}
+		}
+		if (!(entry.flags & FLAG_LZ4))
+		{
+			entry.data.swap(data);
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const PackEntry& a, const PackEntry& b) { return a.name < b.name; });
+	for (size_t i = 1; i < entries.size(); ++i)
+	{
+		if (entries[i].name == entries[i - 1].name)
+		{
+			E2D_WARNING(L"Archive::pack failed! Duplicate entry name.");
+			return false;
+		}
+	}
+
+	// ļͷĿ¼Ʊ
+	std::vector<unsigned char> header;
+	header.insert(header.end(), ARCHIVE_MAGIC, ARCHIVE_MAGIC + 4);
+	WriteU32(header, ARCHIVE_VERSION);
+	WriteU32(header, static_cast<unsigned int>(entries.size()));
+	WriteU32(header, 0);
+
+	size_t nameOffset = HEADER_SIZE + entries.size() * ENTRY_SIZE;
+	size_t dataOffset = nameOffset;
+	for (const auto& entry : entries)
+	{
+		dataOffset += entry.name.size();
+	}
+
+	std::vector<size_t> offsets(entries.size());
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		dataOffset = (dataOffset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+		offsets[i] = dataOffset;
+		dataOffset += entries[i].data.size();
+	}
+
+	if (dataOffset > 0xFFFFFFFF)
+	{
+		E2D_WARNING(L"Archive::pack failed! Archive is larger than 4 GB.");
+		return false;
+	}
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		WriteU32(header, static_cast<unsigned int>(nameOffset));
+		WriteU32(header, static_cast<unsigned int>(entries[i].name.size()));
+		WriteU32(header, static_cast<unsigned int>(offsets[i]));
+		WriteU32(header, static_cast<unsigned int>(entries[i].data.size()));
+		WriteU32(header, entries[i].originalSize);
+		WriteU32(header, entries[i].flags);
+		nameOffset += entries[i].name.size();
+	}
+	for (const auto& entry : entries)
+	{
+		header.insert(header.end(), entry.name.begin(), entry.name.end());
+	}
+
+	FILE* file = platform::OpenFile(archivePath, "wb");
+	if (!file)
+	{
+		E2D_WARNING(L"Archive::pack failed! Cannot create file.");
+		return false;
+	}
+
+	bool succeeded = ::fwrite(header.data(), 1, header.size(), file) == header.size();
+
+	const unsigned char padding[DATA_ALIGNMENT] = { 0 };
+	size_t position = header.size();
+	for (size_t i = 0; succeeded && i < entries.size(); ++i)
+	{
+		size_t paddingSize = offsets[i] - position;
+		succeeded = ::fwrite(padding, 1, paddingSize, file) == paddingSize;
+		if (succeeded && !entries[i].data.empty())
+		{
+			succeeded = ::fwrite(entries[i].data.data(), 1, entries[i].data.size(), file) == entries[i].data.size();
+		}
+		position = offsets[i] + entries[i].data.size();
+	}
+
+	succeeded = (::fclose(file) == 0) && succeeded;
+	if (!succeeded)
+	{
+		E2D_WARNING(L"Archive::pack failed! Cannot write file.");
+	}
+	return succeeded;
+}
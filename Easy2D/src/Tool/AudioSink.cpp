@@ -0,0 +1,287 @@
+#include <easy2d/e2dtool.h>
+#include <easy2d/e2dplatform.h>
+#include <atomic>
+#include <thread>
+
+#ifndef E2D_HEADLESS
+#	include <xaudio2.h>
+
+#	pragma comment(lib, "xaudio2.lib")
+#endif
+
+
+namespace
+{
+	const int BLOCK_FRAMES = easy2d::Mixer::SAMPLE_RATE / 100;	// ÿȡ 10 
+
+	void WriteU16(FILE* file, unsigned int value)
+	{
+		unsigned char bytes[2] = { static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8) };
+		::fwrite(bytes, 1, 2, file);
+	}
+
+	void WriteU32(FILE* file, unsigned int value)
+	{
+		WriteU16(file, value & 0xFFFF);
+		WriteU16(file, value >> 16);
+	}
+
+	// д 16 λ WAV ļͷݴСڽʱд
+	void WriteWaveHeader(FILE* file, unsigned int dataSize)
+	{
+		::fwrite("RIFF", 1, 4, file);
+		WriteU32(file, 36 + dataSize);
+		::fwrite("WAVEfmt ", 1, 8, file);
+		WriteU32(file, 16);
+		WriteU16(file, 1);
+		WriteU16(file, 2);
+		WriteU32(file, easy2d::Mixer::SAMPLE_RATE);
+		WriteU32(file, easy2d::Mixer::SAMPLE_RATE * 4);
+		WriteU16(file, 4);
+		WriteU16(file, 16);
+		::fwrite("data", 1, 4, file);
+		WriteU32(file, dataSize);
+	}
+}
+
+
+class easy2d::NullAudioSink::Context
+{
+public:
+	String filePath;
+	FILE* file;
+	unsigned int dataSize;
+	std::thread thread;
+	std::atomic<bool> running;
+
+	Context(const String& waveFilePath)
+		: filePath(waveFilePath)
+		, file(nullptr)
+		, dataSize(0)
+		, running(false)
+	{
+	}
+
+	void run()
+	{
+		std::vector<float> block(BLOCK_FRAMES * 2);
+
+		long long next = platform::GetTimestamp();
+		while (running.load())
+		{
+			Mixer::mix(block.data(), BLOCK_FRAMES);
+
+			if (file)
+			{
+				//  [-1, 1] 
+				for (size_t i = 0; i < block.size(); ++i)
+				{
+					WriteU16(file, static_cast<unsigned short>(static_cast<short>(block[i] * 32767.f)));
+				}
+				dataSize += static_cast<unsigned int>(block.size() * 2);
+			}
+
+			// ʵʱȡ̫ʱ׷
+			next += 1000000 / (Mixer::SAMPLE_RATE / BLOCK_FRAMES);
+			long long now = platform::GetTimestamp();
+			if (next > now)
+			{
+				platform::SleepFor(static_cast<unsigned int>((next - now) / 1000));
+			}
+			else if (now - next > 100000)
+			{
+				next = now;
+			}
+		}
+	}
+};
+
+easy2d::NullAudioSink::NullAudioSink(const String& waveFilePath)
+	: _context(new Context(waveFilePath))
+{
+}
+
+easy2d::NullAudioSink::~NullAudioSink()
+{
+	stop();
+	delete _context;
+	_context = nullptr;
+}
+
+bool easy2d::NullAudioSink::start()
+{
+	if (_context->running.load())
+	{
+		return true;
+	}
+
+	if (!_context->filePath.empty())
+	{
+		_context->file = platform::OpenFile(_context->filePath, "wb");
+		if (!_context->file)
+		{
+			E2D_WARNING(L"NullAudioSink::start failed! Cannot create wave file.");
+			return false;
+		}
+		_context->dataSize = 0;
+		WriteWaveHeader(_context->file, 0);
+	}
+
+	_context->running.store(true);
+	_context->thread = std::thread(&Context::run, _context);
+	return true;
+}
+
+void easy2d::NullAudioSink::stop()
+{
+	if (!_context->running.load())
+	{
+		return;
+	}
+
+	_context->running.store(false);
+	_context->thread.join();
+
+	if (_context->file)
+	{
+		::fseek(_context->file, 0, SEEK_SET);
+		WriteWaveHeader(_context->file, _context->dataSize);
+		::fclose(_context->file);
+		_context->file = nullptr;
+	}
+}
+
+
+#ifndef E2D_HEADLESS
+
+class easy2d::XAudio2AudioSink::Context :
+	public IXAudio2VoiceCallback
+{
+public:
+	static const int BLOCK_COUNT = 3;
+
+	IXAudio2* xaudio2;
+	IXAudio2MasteringVoice* masteringVoice;
+	IXAudio2SourceVoice* sourceVoice;
+	std::atomic<bool> running;
+	float blocks[BLOCK_COUNT][BLOCK_FRAMES * 2];
+
+	Context()
+		: xaudio2(nullptr)
+		, masteringVoice(nullptr)
+		, sourceVoice(nullptr)
+		, running(false)
+	{
+	}
+
+	// һݲύ XAudio2
+	void submit(int index)
+	{
+		Mixer::mix(blocks[index], BLOCK_FRAMES);
+
+		XAUDIO2_BUFFER buffer = { 0 };
+		buffer.AudioBytes = sizeof(blocks[index]);
+		buffer.pAudioData = reinterpret_cast<const BYTE*>(blocks[index]);
+		buffer.pContext = reinterpret_cast<void*>(static_cast<intptr_t>(index));
+		sourceVoice->SubmitSourceBuffer(&buffer);
+	}
+
+	// һݲһ
+	STDMETHOD_(void, OnBufferEnd)(void* context)
+	{
+		if (running.load())
+		{
+			submit(static_cast<int>(reinterpret_cast<intptr_t>(context)));
+		}
+	}
+
+	STDMETHOD_(void, OnVoiceProcessingPassStart)(UINT32) {}
+	STDMETHOD_(void, OnVoiceProcessingPassEnd)() {}
+	STDMETHOD_(void, OnStreamEnd)() {}
+	STDMETHOD_(void, OnBufferStart)(void*) {}
+	STDMETHOD_(void, OnLoopEnd)(void*) {}
+	STDMETHOD_(void, OnVoiceError)(void*, HRESULT) {}
+};
+
+easy2d::XAudio2AudioSink::XAudio2AudioSink()
+	: _context(new Context())
+{
+}
+
+easy2d::XAudio2AudioSink::~XAudio2AudioSink()
+{
+	stop();
+	delete _context;
+	_context = nullptr;
+}
+
+bool easy2d::XAudio2AudioSink::start()
+{
+	if (_context->running.load())
+	{
+		return true;
+	}
+
+	HRESULT hr = XAudio2Create(&_context->xaudio2, 0);
+
+	if (SUCCEEDED(hr))
+	{
+		hr = _context->xaudio2->CreateMasteringVoice(&_context->masteringVoice);
+	}
+
+	if (SUCCEEDED(hr))
+	{
+		//  32 λ
+		WAVEFORMATEX wfx = { 0 };
+		wfx.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+		wfx.nChannels = 2;
+		wfx.nSamplesPerSec = Mixer::SAMPLE_RATE;
+		wfx.wBitsPerSample = 32;
+		wfx.nBlockAlign = wfx.nChannels * wfx.wBitsPerSample / 8;
+		wfx.nAvgBytesPerSec = wfx.nSamplesPerSec * wfx.nBlockAlign;
+
+		hr = _context->xaudio2->CreateSourceVoice(&_context->sourceVoice, &wfx, 0, XAUDIO2_DEFAULT_FREQ_RATIO, _context);
+	}
+
+	if (SUCCEEDED(hr))
+	{
+		_context->running.store(true);
+		for (int i = 0; i < Context::BLOCK_COUNT; ++i)
+		{
+			_context->submit(i);
+		}
+		hr = _context->sourceVoice->Start(0);
+	}
+
+	if (FAILED(hr))
+	{
+		E2D_WARNING(L"XAudio2AudioSink::start failed! (%#X)", hr);
+		stop();
+		return false;
+	}
+	return true;
+}
+
+void easy2d::XAudio2AudioSink::stop()
+{
+	// ֹͣصеύDestroyVoice غлص
+	_context->running.store(false);
+
+	if (_context->sourceVoice)
+	{
+		_context->sourceVoice->Stop();
+		_context->sourceVoice->FlushSourceBuffers();
+		_context->sourceVoice->DestroyVoice();
+		_context->sourceVoice = nullptr;
+	}
+
+	if (_context->masteringVoice)
+	{
+		_context->masteringVoice->DestroyVoice();
+		_context->masteringVoice = nullptr;
+	}
+
+	SafeRelease(_context->xaudio2);
+}
+
+#endif
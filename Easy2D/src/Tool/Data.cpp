@@ -1,48 +1,584 @@
 #include <easy2d/e2dtool.h>
+#include <easy2d/e2dplatform.h>
+#include <cstring>
+#include <cwchar>
+#include <unordered_map>
+
+
+namespace
+{
+	// 浵ļħ汾š¼Ȼȫ¼
+	// ־ļħ汾ţȻ׷Ӽ¼ĩβļ¼ᱻ
+	const char STORE_MAGIC[4] = { 'E', '2', 'D', 'S' };
+	const char JOURNAL_MAGIC[4] = { 'E', '2', 'D', 'J' };
+	const unsigned int VERSION = 1;
+
+	enum ValueType
+	{
+		TYPE_INT = 1,
+		TYPE_FLOAT,
+		TYPE_BOOL,
+		TYPE_STRING
+	};
+
+	struct Value
+	{
+		unsigned char type;
+		int intValue;		// int  bool 
+		float floatValue;
+		easy2d::String stringValue;
+
+		Value() : type(TYPE_INT), intValue(0), floatValue(0) {}
+	};
+
+	// ֶͼƴӶɣм '\0' ָ
+	std::unordered_map<easy2d::String, Value> s_values;
+	easy2d::String s_filePath;
+	FILE* s_journal = nullptr;
+	bool s_loaded = false;
+	bool s_dirty = false;
+
+	easy2d::String MakeKey(const easy2d::String& field, const easy2d::String& key)
+	{
+		easy2d::String result;
+		result.reserve(field.size() + key.size() + 1);
+		result.append(field).push_back(L'\0');
+		result.append(key);
+		return result;
+	}
+
+	easy2d::String GetJournalPath()
+	{
+		return s_filePath + L".log";
+	}
+
+	void AppendU32(easy2d::ByteString& buffer, unsigned int value)
+	{
+		buffer.push_back(static_cast<char>(value & 0xFF));
+		buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+		buffer.push_back(static_cast<char>((value >> 16) & 0xFF));
+		buffer.push_back(static_cast<char>((value >> 24) & 0xFF));
+	}
+
+	void AppendString(easy2d::ByteString& buffer, const easy2d::String& str)
+	{
+		easy2d::ByteString utf8 = easy2d::WideToUtf8(str);
+		AppendU32(buffer, static_cast<unsigned int>(utf8.size()));
+		buffer.append(utf8);
+	}
+
+	void AppendHeader(easy2d::ByteString& buffer, const char* magic)
+	{
+		buffer.append(magic, 4);
+		AppendU32(buffer, VERSION);
+	}
+
+	void AppendRecord(easy2d::ByteString& buffer, const easy2d::String& fullKey, const Value& value)
+	{
+		size_t separator = fullKey.find(L'\0');
+
+		buffer.push_back(static_cast<char>(value.type));
+		AppendString(buffer, fullKey.substr(0, separator));
+		AppendString(buffer, fullKey.substr(separator + 1));
+
+		switch (value.type)
+		{
+		case TYPE_INT:
+			AppendU32(buffer, static_cast<unsigned int>(value.intValue));
+			break;
+		case TYPE_FLOAT:
+		{
+			unsigned int bits = 0;
+			::memcpy(&bits, &value.floatValue, sizeof(bits));
+			AppendU32(buffer, bits);
+			break;
+		}
+		case TYPE_BOOL:
+			buffer.push_back(value.intValue ? 1 : 0);
+			break;
+		default:
+			AppendString(buffer, value.stringValue);
+			break;
+		}
+	}
+
+	// ˳ȡ¼Խʱ false
+	class Reader
+	{
+	public:
+		Reader(const std::vector<unsigned char>& data)
+			: _data(data)
+			, _pos(0)
+		{
+		}
+
+		bool atEnd() const
+		{
+			return _pos >= _data.size();
+		}
+
+		bool readU8(unsigned char& value)
+		{
+			if (_data.size() - _pos < 1)
+				return false;
+			value = _data[_pos++];
+			return true;
+		}
+
+		bool readU32(unsigned int& value)
+		{
+			if (_data.size() - _pos < 4)
+				return false;
+			const unsigned char* p = &_data[_pos];
+			value = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<unsigned int>(p[3]) << 24);
+			_pos += 4;
+			return true;
+		}
+
+		bool readString(easy2d::String& str)
+		{
+			unsigned int length = 0;
+			if (!readU32(length) || _data.size() - _pos < length)
+				return false;
+			str = easy2d::Utf8ToWide(reinterpret_cast<const char*>(_data.data() + _pos), length);
+			_pos += length;
+			return true;
+		}
+
+		bool readHeader(const char* magic)
+		{
+			unsigned int version = 0;
+			if (_data.size() < 4 || ::memcmp(_data.data(), magic, 4) != 0)
+				return false;
+			_pos = 4;
+			return readU32(version) && version == VERSION;
+		}
+
+		bool readRecord(easy2d::String& fullKey, Value& value)
+		{
+			easy2d::String field, key;
+			if (!readU8(value.type) || !readString(field) || !readString(key))
+				return false;
+
+			bool succeeded = false;
+			switch (value.type)
+			{
+			case TYPE_INT:
+			{
+				unsigned int bits = 0;
+				succeeded = readU32(bits);
+				value.intValue = static_cast<int>(bits);
+				break;
+			}
+			case TYPE_FLOAT:
+			{
+				unsigned int bits = 0;
+				succeeded = readU32(bits);
+				::memcpy(&value.floatValue, &bits, sizeof(bits));
+				break;
+			}
+			case TYPE_BOOL:
+			{
+				unsigned char flag = 0;
+				succeeded = readU8(flag);
+				value.intValue = flag ? 1 : 0;
+				break;
+			}
+			case TYPE_STRING:
+				succeeded = readString(value.stringValue);
+				break;
+			}
+
+			if (succeeded)
+			{
+				fullKey = MakeKey(field, key);
+			}
+			return succeeded;
+		}
+
+	private:
+		const std::vector<unsigned char>& _data;
+		size_t _pos;
+	};
+
+	bool ReadWholeFile(const easy2d::String& filePath, std::vector<unsigned char>& data)
+	{
+		FILE* file = easy2d::platform::OpenFile(filePath, "rb");
+		if (!file)
+		{
+			return false;
+		}
+
+		data.clear();
+		unsigned char buffer[4096];
+		size_t count = 0;
+		while ((count = ::fread(buffer, 1, sizeof(buffer), file)) > 0)
+		{
+			data.insert(data.end(), buffer, buffer + count);
+		}
+		::fclose(file);
+		return true;
+	}
+
+	bool WriteWholeFile(const easy2d::String& filePath, const easy2d::ByteString& data)
+	{
+		FILE* file = easy2d::platform::OpenFile(filePath, "wb");
+		if (!file)
+		{
+			return false;
+		}
+
+		bool succeeded = ::fwrite(data.data(), 1, data.size(), file) == data.size();
+		succeeded = easy2d::platform::SyncFile(file) && succeeded;
+		::fclose(file);
+		return succeeded;
+	}
+
+	// µĿ־֮ǰ־Ѿд浵
+	void ResetJournal()
+	{
+		if (s_journal)
+		{
+			::fclose(s_journal);
+		}
+
+		s_journal = easy2d::platform::OpenFile(GetJournalPath(), "wb");
+		if (!s_journal)
+		{
+			E2D_WARNING(L"Data: Cannot create journal file.");
+			return;
+		}
+
+		easy2d::ByteString header;
+		AppendHeader(header, JOURNAL_MAGIC);
+		::fwrite(header.data(), 1, header.size(), s_journal);
+		easy2d::platform::SyncFile(s_journal);
+	}
+
+#ifndef E2D_HEADLESS
+	// ɰ汾ʹõ INI 浵ַʽ
+	void ImportIniFile(const easy2d::String& iniPath)
+	{
+		if (!easy2d::platform::FileExists(iniPath))
+		{
+			return;
+		}
+
+		std::vector<wchar_t> names(1024);
+		while (::GetPrivateProfileSectionNamesW(names.data(), static_cast<DWORD>(names.size()), iniPath.c_str()) == names.size() - 2)
+		{
+			names.resize(names.size() * 2);
+		}
+
+		std::vector<wchar_t> section(4096);
+		for (const wchar_t* name = names.data(); *name; name += ::wcslen(name) + 1)
+		{
+			while (::GetPrivateProfileSectionW(name, section.data(), static_cast<DWORD>(section.size()), iniPath.c_str()) == section.size() - 2)
+			{
+				section.resize(section.size() * 2);
+			}
+
+			// ÿһеĸʽΪ key=value
+			for (const wchar_t* line = section.data(); *line; line += ::wcslen(line) + 1)
+			{
+				const wchar_t* equal = ::wcschr(line, L'=');
+				if (!equal)
+				{
+					continue;
+				}
+
+				Value value;
+				value.type = TYPE_STRING;
+				value.stringValue = equal + 1;
+				s_values[MakeKey(name, easy2d::String(line, equal))] = value;
+				s_dirty = true;
+			}
+		}
+	}
+#endif
+
+	void EnsureLoaded()
+	{
+		if (s_loaded)
+		{
+			return;
+		}
+		s_loaded = true;
+
+		// Ϸδʼʱֻڴ
+		s_filePath = easy2d::Path::getDataSavePath();
+		if (s_filePath.empty())
+		{
+			return;
+		}
+
+		std::vector<unsigned char> data;
+		easy2d::String fullKey;
+		Value value;
+
+		if (ReadWholeFile(s_filePath, data))
+		{
+			Reader reader(data);
+			unsigned int count = 0;
+			if (!reader.readHeader(STORE_MAGIC) || !reader.readU32(count))
+			{
+				E2D_WARNING(L"Data: Invalid save file.");
+			}
+			else
+			{
+				for (unsigned int i = 0; i < count; ++i)
+				{
+					if (!reader.readRecord(fullKey, value))
+					{
+						E2D_WARNING(L"Data: Save file is truncated.");
+						break;
+					}
+					s_values[fullKey] = value;
+				}
+			}
+		}
+#ifndef E2D_HEADLESS
+		else
+		{
+			size_t separator = s_filePath.find_last_of(L"\\/");
+			ImportIniFile(s_filePath.substr(0, separator + 1) + L"Data.ini");
+		}
+#endif
+
+		// طϴγ쳣˳ǰδдش浵޸
+		if (ReadWholeFile(GetJournalPath(), data))
+		{
+			Reader reader(data);
+			if (reader.readHeader(JOURNAL_MAGIC))
+			{
+				while (!reader.atEnd() && reader.readRecord(fullKey, value))
+				{
+					s_values[fullKey] = value;
+					s_dirty = true;
+				}
+			}
+		}
+	}
+
+	void Save(const easy2d::String& key, const easy2d::String& field, const Value& value)
+	{
+		EnsureLoaded();
+
+		easy2d::String fullKey = MakeKey(field, key);
+		s_values[fullKey] = value;
+		s_dirty = true;
+
+		if (s_journal)
+		{
+			easy2d::ByteString record;
+			AppendRecord(record, fullKey, value);
+			::fwrite(record.data(), 1, record.size(), s_journal);
+			::fflush(s_journal);
+		}
+	}
+
+	const Value* Find(const easy2d::String& key, const easy2d::String& field)
+	{
+		EnsureLoaded();
+
+		auto iter = s_values.find(MakeKey(field, key));
+		if (iter == s_values.end())
+		{
+			return nullptr;
+		}
+		return &iter->second;
+	}
+}
 
 
 void easy2d::Data::saveInt(const String& key, int value, const String& field)
 {
-	::WritePrivateProfileString(field.c_str(), key.c_str(), std::to_wstring(value).c_str(), Path::getDataSavePath().c_str());
+	Value v;
+	v.type = TYPE_INT;
+	v.intValue = value;
+	Save(key, field, v);
 }
 
 void easy2d::Data::saveDouble(const String& key, float value, const String& field)
 {
-	::WritePrivateProfileString(field.c_str(), key.c_str(), std::to_wstring(value).c_str(), Path::getDataSavePath().c_str());
+	Value v;
+	v.type = TYPE_FLOAT;
+	v.floatValue = value;
+	Save(key, field, v);
 }
 
 void easy2d::Data::saveBool(const String& key, bool value, const String& field)
 {
-	::WritePrivateProfileString(field.c_str(), key.c_str(), (value ? L"1" : L"0"), Path::getDataSavePath().c_str());
+	Value v;
+	v.type = TYPE_BOOL;
+	v.intValue = value ? 1 : 0;
+	Save(key, field, v);
 }
 
 void easy2d::Data::saveString(const String& key, const String& value, const String& field)
 {
-	::WritePrivateProfileString(field.c_str(), key.c_str(), value.c_str(), Path::getDataSavePath().c_str());
+	Value v;
+	v.type = TYPE_STRING;
+	v.stringValue = value;
+	Save(key, field, v);
 }
 
 int easy2d::Data::getInt(const String& key, int defaultValue, const String& field)
 {
-	return ::GetPrivateProfileInt(field.c_str(), key.c_str(), defaultValue, Path::getDataSavePath().c_str());
+	const Value* value = Find(key, field);
+	if (!value)
+	{
+		return defaultValue;
+	}
+
+	switch (value->type)
+	{
+	case TYPE_FLOAT:
+		return static_cast<int>(value->floatValue);
+	case TYPE_STRING:
+	{
+		// ַӾɴ浵ݣֽ
+		const wchar_t* begin = value->stringValue.c_str();
+		wchar_t* end = nullptr;
+		long result = ::wcstol(begin, &end, 10);
+		return end == begin ? defaultValue : static_cast<int>(result);
+	}
+	default:
+		return value->intValue;
+	}
 }
 
 float easy2d::Data::getDouble(const String& key, float defaultValue, const String& field)
 {
-	wchar_t temp[32] = { 0 };
-	::GetPrivateProfileString(field.c_str(), key.c_str(), std::to_wstring(defaultValue).c_str(), temp, 31, Path::getDataSavePath().c_str());
-	return std::stof(temp);
+	const Value* value = Find(key, field);
+	if (!value)
+	{
+		return defaultValue;
+	}
+
+	switch (value->type)
+	{
+	case TYPE_FLOAT:
+		return value->floatValue;
+	case TYPE_STRING:
+	{
+		const wchar_t* begin = value->stringValue.c_str();
+		wchar_t* end = nullptr;
+		double result = ::wcstod(begin, &end);
+		return end == begin ? defaultValue : static_cast<float>(result);
+	}
+	default:
+		return static_cast<float>(value->intValue);
+	}
 }
 
 bool easy2d::Data::getBool(const String& key, bool defaultValue, const String& field)
 {
-	int nDefaultValue = defaultValue ? 1 : 0;
-	int nValue = ::GetPrivateProfileInt(field.c_str(), key.c_str(), nDefaultValue, Path::getDataSavePath().c_str());
-	return nValue != 0;
+	return getInt(key, defaultValue ? 1 : 0, field) != 0;
 }
 
 easy2d::String easy2d::Data::getString(const String& key, const String& defaultValue, const String& field)
 {
-	wchar_t temp[256] = { 0 };
-	::GetPrivateProfileString(field.c_str(), key.c_str(), defaultValue.c_str(), temp, 255, Path::getDataSavePath().c_str());
-	return temp;
-}
\ No newline at end of file
+	const Value* value = Find(key, field);
+	if (!value)
+	{
+		return defaultValue;
+	}
+
+	switch (value->type)
+	{
+	case TYPE_FLOAT:
+		return std::to_wstring(value->floatValue);
+	case TYPE_STRING:
+		return value->stringValue;
+	default:
+		return std::to_wstring(value->intValue);
+	}
+}
+
+bool easy2d::Data::flush()
+{
+	if (!s_dirty)
+	{
+		return true;
+	}
+
+	if (s_filePath.empty())
+	{
+		E2D_WARNING(L"Data::flush failed! Data save path is unavailable.");
+		return false;
+	}
+
+	ByteString buffer;
+	AppendHeader(buffer, STORE_MAGIC);
+	AppendU32(buffer, static_cast<unsigned int>(s_values.size()));
+	for (const auto& pair : s_values)
+	{
+		AppendRecord(buffer, pair.first, pair.second);
+	}
+
+	// ´浵д̺滻ɴ浵
+	String tempPath = s_filePath + L".tmp";
+	if (!WriteWholeFile(tempPath, buffer) || !platform::RenameFile(tempPath, s_filePath))
+	{
+		E2D_WARNING(L"Data::flush failed! Cannot write save file.");
+		return false;
+	}
+	s_dirty = false;
+
+	// ־е޸Ķд浵
+	if (s_journal)
+	{
+		ResetJournal();
+	}
+	else if (platform::FileExists(GetJournalPath()))
+	{
+		WriteWholeFile(GetJournalPath(), ByteString());
+	}
+	return true;
+}
+
+void easy2d::Data::setJournalEnabled(bool enabled)
+{
+	EnsureLoaded();
+
+	if (enabled == (s_journal != nullptr) || s_filePath.empty())
+	{
+		return;
+	}
+
+	if (enabled)
+	{
+		// ־ֻ¼֮޸ģде޸
+		if (!flush())
+		{
+			return;
+		}
+		ResetJournal();
+	}
+	else
+	{
+		::fclose(s_journal);
+		s_journal = nullptr;
+	}
+}
+
+void easy2d::Data::__uninit()
+{
+	if (!s_loaded)
+	{
+		return;
+	}
+
+	flush();
+
+	if (s_journal)
+	{
+		::fclose(s_journal);
+		s_journal = nullptr;
+	}
+
+	s_values.clear();
+	s_filePath.clear();
+	s_loaded = false;
+}
@@ -0,0 +1,1035 @@
+#include <easy2d/e2dtool.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define E2D_MIXER_SSE
+#	include <emmintrin.h>
+#endif
+
+
+namespace
+{
+	const int VOICE_COUNT = easy2d::Mixer::VOICE_COUNT;
+	const unsigned int COMMAND_CAPACITY = 1024;		//  2 
+	const int RAMP_FRAMES = 64;						// 仯ʱĽ֡ⱬ
+	const unsigned long long FIXED_ONE = 1ULL << 32;
+	const int STREAM_BLOCK_FRAMES = 4096;			// ÿ֡
+	const unsigned int STREAM_BLOCK_COUNT = 4;		// Ļ
+	const int STREAM_POLL_INTERVAL = 10;			// ̼߳黺ļ룩
+
+	enum class CommandType
+	{
+		Play,
+		Stop,
+		Pause,
+		Resume,
+		SetGain,
+		StopAll
+	};
+
+	// һ
+	// һ֡һһ֡ԲֵҪԽ
+	struct StreamBlock
+	{
+		std::vector<float> samples;
+		int frameCount;
+		bool last;						// ǷΪһ
+	};
+
+	// һβʹõ
+	// ߳деĻƵ̰߳˳ȡͨͬ
+	struct Stream
+	{
+		easy2d::AudioDecoder* decoder;
+		int channelCount;
+		int loopCount;					// ֻڽ߳з
+		bool ended;						// ֻڽ߳з
+		float history[2];				// һһ֡
+		StreamBlock blocks[STREAM_BLOCK_COUNT];
+		std::atomic<unsigned int> readCount;	// Ƶ߳Ļ
+		std::atomic<unsigned int> writeCount;	// ߳Ļ
+	};
+
+	struct Command
+	{
+		CommandType type;
+		int slot;
+		unsigned int generation;
+		const float* samples;
+		int frameCount;
+		int channelCount;
+		int sampleRate;
+		float volume;
+		float pan;
+		int loopCount;
+		Stream* stream;
+	};
+
+	// Ƶ߳е״̬
+	struct Voice
+	{
+		bool active;
+		bool paused;
+		bool stopping;					// 䵽
+		unsigned int generation;
+		const float* samples;
+		int frameCount;
+		int channelCount;
+		unsigned long long position;	// 32.32 ʾ֡λ
+		unsigned long long step;
+		int loopCount;
+		Stream* stream;					// ʱΪ
+		bool hasBlock;					// ǷڶȡĻ
+		float volume;
+		float pan;
+		float targetLeft;
+		float targetRight;
+		float gainLeft;
+		float gainRight;
+		float deltaLeft;
+		float deltaRight;
+		int rampFrames;
+	};
+
+	// Ƶ߳Ϸ̹߳
+	struct VoiceSignal
+	{
+		std::atomic<unsigned int> started;		// Ѿʼŵ´
+		std::atomic<unsigned int> finished;		// Ѿŵ´
+	};
+
+	// Ϸ߳е¼
+	struct Slot
+	{
+		unsigned int generation;
+		easy2d::Sound* sound;
+		Stream* stream;
+		bool busy;
+		bool paused;
+		bool stopping;
+		unsigned long long order;
+	};
+
+	// ռƵ̴߳µĲ֮ǰԻȡɵ
+	struct PendingRelease
+	{
+		int slot;
+		unsigned int generation;
+		easy2d::Sound* sound;
+		Stream* stream;
+	};
+
+	Command s_Commands[COMMAND_CAPACITY];
+	std::atomic<unsigned int> s_nCommandHead(0);	// Ƶ̶߳ȡλ
+	std::atomic<unsigned int> s_nCommandTail(0);	// Ϸ߳дλ
+	std::atomic<float> s_fMasterGain(1.f);
+
+	Voice s_Voices[VOICE_COUNT];					// ֻƵ߳з
+	VoiceSignal s_Signals[VOICE_COUNT];
+	Slot s_Slots[VOICE_COUNT];						// ֻϷ߳з
+	std::vector<PendingRelease> s_vPendingReleases;
+	unsigned long long s_nPlayOrder = 0;
+	float s_fMasterVolume = 1.f;
+
+	easy2d::AudioSink* s_pSink = nullptr;
+	bool s_bSinkStarted = false;
+
+	std::vector<Stream*> s_vStreams;				// ڽ
+	std::mutex s_StreamMutex;
+	std::condition_variable s_StreamCondition;
+	std::thread s_StreamThread;
+	bool s_bStreaming = false;
+
+	// ŵĵ 8 λţ 24 λǴ
+	unsigned int MakeHandle(int slot, unsigned int generation)
+	{
+		return ((generation & 0xFFFFFF) << 8) | unsigned(slot);
+	}
+
+	// ҵŶӦѱջռʱ -1
+	int FindSlot(unsigned int handle)
+	{
+		int slot = int(handle & 0xFF);
+		if (handle == 0 || slot >= VOICE_COUNT)
+		{
+			return -1;
+		}
+
+		const Slot& record = s_Slots[slot];
+		if (!record.busy || MakeHandle(slot, record.generation) != handle)
+		{
+			return -1;
+		}
+		return slot;
+	}
+
+	bool HasReached(unsigned int progress, unsigned int generation)
+	{
+		return static_cast<int>(progress - generation) >= 0;
+	}
+
+	bool PushCommand(const Command& command)
+	{
+		unsigned int tail = s_nCommandTail.load(std::memory_order_relaxed);
+		unsigned int head = s_nCommandHead.load(std::memory_order_acquire);
+		if (tail - head >= COMMAND_CAPACITY)
+		{
+			E2D_WARNING(L"Mixer command queue is full!");
+			return false;
+		}
+
+		s_Commands[tail & (COMMAND_CAPACITY - 1)] = command;
+		s_nCommandTail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	Command MakeCommand(CommandType type, int slot)
+	{
+		Command command = Command();
+		command.type = type;
+		command.slot = slot;
+		command.generation = (slot >= 0) ? s_Slots[slot].generation : 0;
+		return command;
+	}
+
+	// ȷڹ豸״βʱʹĬ豸
+	bool EnsureSink()
+	{
+		if (!s_pSink)
+		{
+#ifdef E2D_HEADLESS
+			easy2d::AudioSink* sink = new (std::nothrow) easy2d::NullAudioSink;
+#else
+			easy2d::AudioSink* sink = new (std::nothrow) easy2d::XAudio2AudioSink;
+#endif
+			easy2d::Mixer::setSink(sink);
+			easy2d::GC::release(sink);
+		}
+		return s_bSinkStarted;
+	}
+
+	// һеĻûпеĻѾʱ false
+	bool FillStreamBlock(Stream* stream)
+	{
+		const unsigned int write = stream->writeCount.load(std::memory_order_relaxed);
+		if (stream->ended || write - stream->readCount.load(std::memory_order_acquire) >= STREAM_BLOCK_COUNT)
+		{
+			return false;
+		}
+
+		const int channels = stream->channelCount;
+		StreamBlock& block = stream->blocks[write % STREAM_BLOCK_COUNT];
+		float* samples = block.samples.data();
+		::memcpy(samples, stream->history, sizeof(float) * channels);
+
+		int frames = 0;
+		bool rewound = false;
+		while (frames < STREAM_BLOCK_FRAMES)
+		{
+			const int count = stream->decoder->read(samples + (frames + 1) * channels, STREAM_BLOCK_FRAMES - frames);
+			if (count > 0)
+			{
+				frames += count;
+				rewound = false;
+				continue;
+			}
+
+			// ѭʱصͷͬһѭ֮ûз϶
+			if (stream->loopCount != 0 && !rewound && stream->decoder->rewind())
+			{
+				if (stream->loopCount > 0)
+				{
+					--stream->loopCount;
+				}
+				rewound = true;
+				continue;
+			}
+
+			stream->ended = true;
+			break;
+		}
+
+		if (frames > 0)
+		{
+			::memcpy(stream->history, samples + frames * channels, sizeof(float) * channels);
+		}
+		block.frameCount = frames;
+		block.last = stream->ended;
+		stream->writeCount.store(write + 1, std::memory_order_release);
+		return !stream->ended;
+	}
+
+	Stream* CreateStream(easy2d::AudioDecoder* decoder, int loopCount)
+	{
+		Stream* stream = new Stream;
+		stream->decoder = decoder;
+		stream->channelCount = decoder->getChannelCount();
+		stream->loopCount = loopCount;
+		stream->ended = false;
+		stream->history[0] = stream->history[1] = 0.f;
+		stream->readCount.store(0);
+		stream->writeCount.store(0);
+		for (auto& block : stream->blocks)
+		{
+			block.samples.resize((STREAM_BLOCK_FRAMES + 1) * stream->channelCount);
+			block.frameCount = 0;
+			block.last = false;
+		}
+		easy2d::GC::retain(stream->decoder);
+
+		// Ϸ߳ʼʱҪȴ߳
+		while (FillStreamBlock(stream)) {}
+		return stream;
+	}
+
+	void StreamLoop()
+	{
+#ifndef E2D_HEADLESS
+		// Media Foundation Ҫʼ COM
+		::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+		std::unique_lock<std::mutex> lock(s_StreamMutex);
+		while (s_bStreaming)
+		{
+			for (auto stream : s_vStreams)
+			{
+				while (FillStreamBlock(stream)) {}
+			}
+			s_StreamCondition.wait_for(lock, std::chrono::milliseconds(STREAM_POLL_INTERVAL));
+		}
+#ifndef E2D_HEADLESS
+		::CoUninitialize();
+#endif
+	}
+
+	// ̼߳
+	void AddStream(Stream* stream)
+	{
+		std::lock_guard<std::mutex> lock(s_StreamMutex);
+		s_vStreams.push_back(stream);
+		if (!s_bStreaming)
+		{
+			s_bStreaming = true;
+			s_StreamThread = std::thread(StreamLoop);
+		}
+	}
+
+	// ӽ߳Ƴɾ
+	void DeleteStream(Stream*& stream)
+	{
+		if (!stream)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_StreamMutex);
+			s_vStreams.erase(std::remove(s_vStreams.begin(), s_vStreams.end(), stream), s_vStreams.end());
+		}
+		easy2d::GC::release(stream->decoder);
+		delete stream;
+		stream = nullptr;
+	}
+
+	void StopStreamThread()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_StreamMutex);
+			if (!s_bStreaming)
+			{
+				return;
+			}
+			s_bStreaming = false;
+		}
+		s_StreamCondition.notify_one();
+		s_StreamThread.join();
+	}
+
+	// Ϸ߳ռһͲûпʱռ翪ʼŵ
+	unsigned int StartVoice(Command& command, easy2d::Sound* sound, Stream* stream)
+	{
+		int slot = -1;
+		for (int i = 0; i < VOICE_COUNT; ++i)
+		{
+			if (!s_Slots[i].busy)
+			{
+				slot = i;
+				break;
+			}
+			if (slot < 0 || s_Slots[i].order < s_Slots[slot].order)
+			{
+				slot = i;
+			}
+		}
+
+		Slot& record = s_Slots[slot];
+		command.type = CommandType::Play;
+		command.slot = slot;
+		command.generation = record.generation + 1;
+		if ((command.generation & 0xFFFFFF) == 0)
+		{
+			// ŲΪ 0
+			++command.generation;
+		}
+		command.stream = stream;
+
+		if (!PushCommand(command))
+		{
+			return 0;
+		}
+
+		if (record.busy)
+		{
+			PendingRelease pending = { slot, command.generation, record.sound, record.stream };
+			s_vPendingReleases.push_back(pending);
+		}
+
+		easy2d::GC::retain(sound);
+		record.generation = command.generation;
+		record.sound = sound;
+		record.stream = stream;
+		record.busy = true;
+		record.paused = false;
+		record.stopping = false;
+		record.order = ++s_nPlayOrder;
+		return MakeHandle(slot, record.generation);
+	}
+
+	void FinishVoice(int slot)
+	{
+		Voice& voice = s_Voices[slot];
+		voice.active = false;
+		s_Signals[slot].finished.store(voice.generation, std::memory_order_release);
+	}
+
+	// лһûнûѾʱ false
+	bool NextStreamBlock(int slot)
+	{
+		Voice& voice = s_Voices[slot];
+		Stream* stream = voice.stream;
+		unsigned int read = stream->readCount.load(std::memory_order_relaxed);
+
+		if (voice.hasBlock)
+		{
+			if (stream->blocks[read % STREAM_BLOCK_COUNT].last)
+			{
+				FinishVoice(slot);
+				return false;
+			}
+
+			voice.position -= static_cast<unsigned long long>(voice.frameCount) << 32;
+			voice.frameCount = 0;
+			voice.hasBlock = false;
+			stream->readCount.store(++read, std::memory_order_release);
+		}
+
+		if (stream->writeCount.load(std::memory_order_acquire) == read)
+		{
+			return false;
+		}
+
+		const StreamBlock& block = stream->blocks[read % STREAM_BLOCK_COUNT];
+		voice.samples = block.samples.data();
+		voice.frameCount = block.frameCount;
+		voice.hasBlock = true;
+
+		// ֻһǿյ
+		if (block.frameCount == 0)
+		{
+			FinishVoice(slot);
+			return false;
+		}
+		return true;
+	}
+
+	void StartRamp(Voice& voice, float left, float right)
+	{
+		voice.targetLeft = left;
+		voice.targetRight = right;
+		voice.deltaLeft = (left - voice.gainLeft) / RAMP_FRAMES;
+		voice.deltaRight = (right - voice.gainRight) / RAMP_FRAMES;
+		voice.rampFrames = RAMP_FRAMES;
+	}
+
+	// 
+	void UpdateGain(Voice& voice)
+	{
+		const float pan = min(max(voice.pan, -1.f), 1.f);
+		StartRamp(voice, voice.volume * (pan > 0.f ? 1.f - pan : 1.f), voice.volume * (pan < 0.f ? 1.f + pan : 1.f));
+	}
+
+	// ֱͣӽ䵽
+	void StopVoice(int slot)
+	{
+		Voice& voice = s_Voices[slot];
+		if (voice.paused)
+		{
+			FinishVoice(slot);
+		}
+		else
+		{
+			voice.stopping = true;
+			StartRamp(voice, 0.f, 0.f);
+		}
+	}
+
+	void ExecuteCommand(const Command& command)
+	{
+		if (command.type == CommandType::StopAll)
+		{
+			for (int i = 0; i < VOICE_COUNT; ++i)
+			{
+				if (s_Voices[i].active)
+				{
+					StopVoice(i);
+				}
+			}
+			return;
+		}
+
+		Voice& voice = s_Voices[command.slot];
+		if (command.type == CommandType::Play)
+		{
+			// ռֱӽ
+			if (voice.active)
+			{
+				FinishVoice(command.slot);
+			}
+
+			voice.active = true;
+			voice.paused = false;
+			voice.stopping = false;
+			voice.generation = command.generation;
+			voice.samples = command.samples;
+			voice.frameCount = command.frameCount;
+			voice.channelCount = command.channelCount;
+			voice.position = 0;
+			voice.step = (static_cast<unsigned long long>(command.sampleRate) << 32) / easy2d::Mixer::SAMPLE_RATE;
+			voice.loopCount = command.loopCount;
+			voice.stream = command.stream;
+			voice.hasBlock = false;
+			voice.volume = command.volume;
+			voice.pan = command.pan;
+			voice.gainLeft = voice.gainRight = 0.f;
+			UpdateGain(voice);
+
+			s_Signals[command.slot].started.store(command.generation, std::memory_order_release);
+			return;
+		}
+
+		// ֻͬһβ
+		if (!voice.active || voice.generation != command.generation)
+		{
+			return;
+		}
+
+		switch (command.type)
+		{
+		case CommandType::Stop:
+			StopVoice(command.slot);
+			break;
+		case CommandType::Pause:
+			voice.paused = true;
+			break;
+		case CommandType::Resume:
+			if (voice.paused)
+			{
+				// 
+				voice.paused = false;
+				voice.gainLeft = voice.gainRight = 0.f;
+				StartRamp(voice, voice.targetLeft, voice.targetRight);
+			}
+			break;
+		case CommandType::SetGain:
+			// ޸ĵһΪ NaN
+			voice.volume = std::isnan(command.volume) ? voice.volume : command.volume;
+			voice.pan = std::isnan(command.pan) ? voice.pan : command.pan;
+			if (!voice.stopping)
+			{
+				UpdateGain(voice);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	// ֡Ա仯ۼӵ
+	void MixStereo(float* output, const float* source, int frameCount, float left, float right, float deltaLeft, float deltaRight)
+	{
+		int i = 0;
+#ifdef E2D_MIXER_SSE
+		__m128 gain = _mm_setr_ps(left, right, left + deltaLeft, right + deltaRight);
+		const __m128 delta = _mm_setr_ps(2 * deltaLeft, 2 * deltaRight, 2 * deltaLeft, 2 * deltaRight);
+		for (; i + 2 <= frameCount; i += 2)
+		{
+			__m128 mixed = _mm_add_ps(_mm_loadu_ps(output + i * 2), _mm_mul_ps(_mm_loadu_ps(source + i * 2), gain));
+			_mm_storeu_ps(output + i * 2, mixed);
+			gain = _mm_add_ps(gain, delta);
+		}
+		left += deltaLeft * i;
+		right += deltaRight * i;
+#endif
+		for (; i < frameCount; ++i)
+		{
+			output[i * 2] += source[i * 2] * left;
+			output[i * 2 + 1] += source[i * 2 + 1] * right;
+			left += deltaLeft;
+			right += deltaRight;
+		}
+	}
+
+	// Ƶ
+	void MixMono(float* output, const float* source, int frameCount, float left, float right, float deltaLeft, float deltaRight)
+	{
+		int i = 0;
+#ifdef E2D_MIXER_SSE
+		__m128 gain = _mm_setr_ps(left, right, left + deltaLeft, right + deltaRight);
+		const __m128 delta = _mm_setr_ps(2 * deltaLeft, 2 * deltaRight, 2 * deltaLeft, 2 * deltaRight);
+		for (; i + 2 <= frameCount; i += 2)
+		{
+			__m128 samples = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(source + i)));
+			samples = _mm_unpacklo_ps(samples, samples);
+			__m128 mixed = _mm_add_ps(_mm_loadu_ps(output + i * 2), _mm_mul_ps(samples, gain));
+			_mm_storeu_ps(output + i * 2, mixed);
+			gain = _mm_add_ps(gain, delta);
+		}
+		left += deltaLeft * i;
+		right += deltaRight * i;
+#endif
+		for (; i < frameCount; ++i)
+		{
+			output[i * 2] += source[i] * left;
+			output[i * 2 + 1] += source[i] * right;
+			left += deltaLeft;
+			right += deltaRight;
+		}
+	}
+
+	// ʲͬʱʹԲֵʵʻϵ֡
+	int MixResampled(float* output, Voice& voice, int frameCount, float left, float right, float deltaLeft, float deltaRight)
+	{
+		const unsigned long long end = static_cast<unsigned long long>(voice.frameCount) << 32;
+		const int channels = voice.channelCount;
+
+		int i = 0;
+		for (; i < frameCount && voice.position < end; ++i)
+		{
+			const int index = static_cast<int>(voice.position >> 32);
+			const float t = static_cast<float>(voice.position & 0xFFFFFFFF) * (1.f / 4294967296.f);
+
+			// һ֡뿪ͷֵѭʱûз϶Ļĩβһ֡
+			const int next = (index + 1 < voice.frameCount || voice.stream) ? index + 1 : (voice.loopCount != 0 ? 0 : index);
+
+			const float* a = voice.samples + index * channels;
+			const float* b = voice.samples + next * channels;
+			const float sampleLeft = a[0] + (b[0] - a[0]) * t;
+			const float sampleRight = (channels == 2) ? a[1] + (b[1] - a[1]) * t : sampleLeft;
+
+			output[i * 2] += sampleLeft * left;
+			output[i * 2 + 1] += sampleRight * right;
+			left += deltaLeft;
+			right += deltaRight;
+			voice.position += voice.step;
+		}
+		return i;
+	}
+
+	void MixVoice(int slot, float* output, int frameCount)
+	{
+		Voice& voice = s_Voices[slot];
+
+		int done = 0;
+		while (done < frameCount && voice.active)
+		{
+			if (voice.stream && (voice.position >> 32) >= static_cast<unsigned long long>(voice.frameCount))
+			{
+				// ûнʱʣµĲ
+				if (!NextStreamBlock(slot))
+				{
+					break;
+				}
+				continue;
+			}
+
+			int frames = frameCount - done;
+			float deltaLeft = 0.f, deltaRight = 0.f;
+			if (voice.rampFrames > 0)
+			{
+				frames = min(frames, voice.rampFrames);
+				deltaLeft = voice.deltaLeft;
+				deltaRight = voice.deltaRight;
+			}
+
+			if (voice.step == FIXED_ONE)
+			{
+				const int index = static_cast<int>(voice.position >> 32);
+				frames = min(frames, voice.frameCount - index);
+
+				const float* source = voice.samples + index * voice.channelCount;
+				if (voice.channelCount == 2)
+				{
+					MixStereo(output + done * 2, source, frames, voice.gainLeft, voice.gainRight, deltaLeft, deltaRight);
+				}
+				else
+				{
+					MixMono(output + done * 2, source, frames, voice.gainLeft, voice.gainRight, deltaLeft, deltaRight);
+				}
+				voice.position += static_cast<unsigned long long>(frames) << 32;
+			}
+			else
+			{
+				frames = MixResampled(output + done * 2, voice, frames, voice.gainLeft, voice.gainRight, deltaLeft, deltaRight);
+			}
+
+			if (voice.rampFrames > 0)
+			{
+				voice.rampFrames -= frames;
+				if (voice.rampFrames == 0)
+				{
+					voice.gainLeft = voice.targetLeft;
+					voice.gainRight = voice.targetRight;
+				}
+				else
+				{
+					voice.gainLeft += deltaLeft * frames;
+					voice.gainRight += deltaRight * frames;
+				}
+			}
+			done += frames;
+
+			if (voice.stopping && voice.rampFrames == 0)
+			{
+				FinishVoice(slot);
+			}
+			else if (!voice.stream && (voice.position >> 32) >= static_cast<unsigned long long>(voice.frameCount))
+			{
+				if (voice.loopCount == 0)
+				{
+					FinishVoice(slot);
+				}
+				else
+				{
+					voice.position -= static_cast<unsigned long long>(voice.frameCount) << 32;
+					if (voice.loopCount > 0)
+					{
+						--voice.loopCount;
+					}
+				}
+			}
+		}
+	}
+
+	void ApplyMasterGain(float* output, int sampleCount, float gain)
+	{
+		int i = 0;
+#ifdef E2D_MIXER_SSE
+		const __m128 factor = _mm_set1_ps(gain);
+		const __m128 upper = _mm_set1_ps(1.f);
+		const __m128 lower = _mm_set1_ps(-1.f);
+		for (; i + 4 <= sampleCount; i += 4)
+		{
+			__m128 samples = _mm_mul_ps(_mm_loadu_ps(output + i), factor);
+			_mm_storeu_ps(output + i, _mm_max_ps(_mm_min_ps(samples, upper), lower));
+		}
+#endif
+		for (; i < sampleCount; ++i)
+		{
+			output[i] = min(max(output[i] * gain, -1.f), 1.f);
+		}
+	}
+}
+
+
+void easy2d::Mixer::setSink(AudioSink * sink)
+{
+	if (sink == s_pSink)
+	{
+		return;
+	}
+
+	if (s_pSink && s_bSinkStarted)
+	{
+		s_pSink->stop();
+	}
+	GC::release(s_pSink);
+	s_bSinkStarted = false;
+
+	if (sink)
+	{
+		GC::retain(sink);
+		s_pSink = sink;
+		s_bSinkStarted = sink->start();
+		if (!s_bSinkStarted)
+		{
+			E2D_WARNING(L"Mixer::setSink failed! Cannot start audio sink.");
+		}
+	}
+}
+
+easy2d::AudioSink * easy2d::Mixer::getSink()
+{
+	return s_pSink;
+}
+
+unsigned int easy2d::Mixer::play(Sound * sound, float volume, float pan, int loopCount)
+{
+	if (!sound || !sound->isOpened())
+	{
+		E2D_WARNING(L"Mixer::play failed! Invalid sound.");
+		return 0;
+	}
+
+	if (!EnsureSink())
+	{
+		return 0;
+	}
+
+	Mixer::__update();
+
+	Command command = Command();
+	command.samples = sound->_samples.data();
+	command.frameCount = sound->_frameCount;
+	command.channelCount = sound->_channelCount;
+	command.sampleRate = sound->_sampleRate;
+	command.volume = volume;
+	command.pan = pan;
+	command.loopCount = loopCount;
+	return StartVoice(command, sound, nullptr);
+}
+
+unsigned int easy2d::Mixer::play(SoundStream * stream, float volume, float pan, int loopCount)
+{
+	if (!stream || !stream->isOpened())
+	{
+		E2D_WARNING(L"Mixer::play failed! Invalid sound stream.");
+		return 0;
+	}
+
+	if (!EnsureSink())
+	{
+		return 0;
+	}
+
+	AudioDecoder * decoder = stream->createDecoder();
+	if (!decoder)
+	{
+		E2D_WARNING(L"Mixer::play failed! Cannot decode sound stream.");
+		return 0;
+	}
+
+	Mixer::__update();
+
+	// ѭɽ̴ֻ߳ǰ˳򲥷Ÿ
+	Stream* buffers = CreateStream(decoder, loopCount);
+
+	Command command = Command();
+	command.channelCount = buffers->channelCount;
+	command.sampleRate = decoder->getSampleRate();
+	command.volume = volume;
+	command.pan = pan;
+
+	unsigned int handle = StartVoice(command, nullptr, buffers);
+	if (handle)
+	{
+		AddStream(buffers);
+	}
+	else
+	{
+		DeleteStream(buffers);
+	}
+	return handle;
+}
+
+void easy2d::Mixer::stop(unsigned int voice)
+{
+	int slot = FindSlot(voice);
+	if (slot >= 0 && PushCommand(MakeCommand(CommandType::Stop, slot)))
+	{
+		s_Slots[slot].stopping = true;
+	}
+}
+
+void easy2d::Mixer::pause(unsigned int voice)
+{
+	int slot = FindSlot(voice);
+	if (slot >= 0 && PushCommand(MakeCommand(CommandType::Pause, slot)))
+	{
+		s_Slots[slot].paused = true;
+	}
+}
+
+void easy2d::Mixer::resume(unsigned int voice)
+{
+	int slot = FindSlot(voice);
+	if (slot >= 0 && PushCommand(MakeCommand(CommandType::Resume, slot)))
+	{
+		s_Slots[slot].paused = false;
+	}
+}
+
+void easy2d::Mixer::setVolume(unsigned int voice, float volume)
+{
+	int slot = FindSlot(voice);
+	if (slot >= 0)
+	{
+		Command command = MakeCommand(CommandType::SetGain, slot);
+		command.volume = volume;
+		command.pan = NAN;
+		PushCommand(command);
+	}
+}
+
+void easy2d::Mixer::setPan(unsigned int voice, float pan)
+{
+	int slot = FindSlot(voice);
+	if (slot >= 0)
+	{
+		Command command = MakeCommand(CommandType::SetGain, slot);
+		command.volume = NAN;
+		command.pan = pan;
+		PushCommand(command);
+	}
+}
+
+bool easy2d::Mixer::isPlaying(unsigned int voice)
+{
+	int slot = FindSlot(voice);
+	if (slot < 0)
+	{
+		return false;
+	}
+
+	const Slot& record = s_Slots[slot];
+	return !record.paused && !record.stopping
+		&& !HasReached(s_Signals[slot].finished.load(std::memory_order_acquire), record.generation);
+}
+
+void easy2d::Mixer::stopAll()
+{
+	if (PushCommand(MakeCommand(CommandType::StopAll, -1)))
+	{
+		for (int i = 0; i < VOICE_COUNT; ++i)
+		{
+			s_Slots[i].stopping = s_Slots[i].busy;
+		}
+	}
+}
+
+void easy2d::Mixer::setMasterVolume(float volume)
+{
+	s_fMasterVolume = volume;
+	s_fMasterGain.store(volume, std::memory_order_relaxed);
+}
+
+float easy2d::Mixer::getMasterVolume()
+{
+	return s_fMasterVolume;
+}
+
+int easy2d::Mixer::getActiveVoiceCount()
+{
+	Mixer::__update();
+
+	int count = 0;
+	for (int i = 0; i < VOICE_COUNT; ++i)
+	{
+		if (s_Slots[i].busy)
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
+void easy2d::Mixer::mix(float * output, int frameCount)
+{
+	::memset(output, 0, sizeof(float) * 2 * frameCount);
+
+	// ִϷ̷߳
+	unsigned int head = s_nCommandHead.load(std::memory_order_relaxed);
+	const unsigned int tail = s_nCommandTail.load(std::memory_order_acquire);
+	for (; head != tail; ++head)
+	{
+		ExecuteCommand(s_Commands[head & (COMMAND_CAPACITY - 1)]);
+	}
+	s_nCommandHead.store(head, std::memory_order_release);
+
+	for (int i = 0; i < VOICE_COUNT; ++i)
+	{
+		if (s_Voices[i].active && !s_Voices[i].paused)
+		{
+			MixVoice(i, output, frameCount);
+		}
+	}
+
+	ApplyMasterGain(output, frameCount * 2, s_fMasterGain.load(std::memory_order_relaxed));
+}
+
+void easy2d::Mixer::__update()
+{
+	E2D_PROFILE_SCOPE("Mixer::update");
+
+	for (int i = 0; i < VOICE_COUNT; ++i)
+	{
+		Slot& record = s_Slots[i];
+		if (record.busy && HasReached(s_Signals[i].finished.load(std::memory_order_acquire), record.generation))
+		{
+			GC::release(record.sound);
+			DeleteStream(record.stream);
+			record.busy = false;
+		}
+	}
+
+	for (size_t i = 0; i < s_vPendingReleases.size();)
+	{
+		PendingRelease& pending = s_vPendingReleases[i];
+		if (HasReached(s_Signals[pending.slot].started.load(std::memory_order_acquire), pending.generation))
+		{
+			GC::release(pending.sound);
+			DeleteStream(pending.stream);
+			s_vPendingReleases[i] = s_vPendingReleases.back();
+			s_vPendingReleases.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+void easy2d::Mixer::__uninit()
+{
+	// ֹͣ豸Ƶ̲߳ٷ
+	Mixer::setSink(nullptr);
+	StopStreamThread();
+
+	s_nCommandHead.store(s_nCommandTail.load());
+	for (int i = 0; i < VOICE_COUNT; ++i)
+	{
+		Slot& record = s_Slots[i];
+		if (record.busy)
+		{
+			GC::release(record.sound);
+			DeleteStream(record.stream);
+			record.busy = false;
+		}
+		s_Voices[i].active = false;
+		s_Signals[i].started.store(record.generation);
+		s_Signals[i].finished.store(record.generation);
+	}
+
+	for (auto& pending : s_vPendingReleases)
+	{
+		GC::release(pending.sound);
+		DeleteStream(pending.stream);
+	}
+	s_vPendingReleases.clear();
+}
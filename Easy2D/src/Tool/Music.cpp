@@ -1,51 +1,19 @@
 #include <easy2d/e2dtool.h>
 
-#if !defined(E2D_USE_MCI)
+#if !defined(E2D_USE_MCI) || defined(E2D_HEADLESS)
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 //
-// Music with XAudio2
+// Music with Mixer
 //
 ///////////////////////////////////////////////////////////////////////////////////////////
 
-#include <xaudio2.h>
-#include <mfapi.h>
-#include <mfidl.h>
-#include <mfreadwrite.h>
-#include <shlwapi.h>
+#ifndef E2D_HEADLESS
+#	include <mfapi.h>
 
-#pragma comment(lib, "xaudio2.lib")
-#pragma comment(lib, "Mfplat.lib")
-#pragma comment(lib, "Mfreadwrite.lib")
-#pragma comment(lib, "Shlwapi.lib")
-
-
-#ifndef SAFE_DELETE
-#define SAFE_DELETE(p)       { if (p) { delete (p);     (p)=nullptr; } }
+#	pragma comment(lib, "Mfplat.lib")
 #endif
-#ifndef SAFE_DELETE_ARRAY
-#define SAFE_DELETE_ARRAY(p) { if (p) { delete[] (p);   (p)=nullptr; } }
-#endif
-
 
-namespace
-{
-	IXAudio2* s_pXAudio2 = nullptr;
-	IXAudio2MasteringVoice* s_pMasteringVoice = nullptr;
-}
-
-
-inline bool TraceError(wchar_t* sPrompt)
-{
-	E2D_WARNING(L"%s!", sPrompt);
-	return false;
-}
-
-inline bool TraceError(wchar_t* sPrompt, HRESULT hr)
-{
-	E2D_WARNING(L"%s (%#X)", sPrompt, hr);
-	return false;
-}
 
 class easy2d::Music::Media
 {
@@ -63,6 +31,10 @@ public:
 		const String& resType
 	);
 
+	bool open(
+		const Resource::Data& data
+	);
+
 	bool play(
 		int nLoopCount = 0
 	);
@@ -82,35 +54,20 @@ public:
 	);
 
 private:
-	HRESULT _loadMediaFile(
-		String const& file_path
-	);
-
-	HRESULT _loadMediaResource(
-		LPVOID buffer,
-		DWORD bufferSize
-	);
-
-	HRESULT _readSource(
-		IMFSourceReader* reader
+	bool _attach(
+		SoundStream* stream
 	);
 
 private:
-	bool _opened;
-	mutable bool _playing;
-	BYTE* _waveData;
-	DWORD _waveDataSize;
-	WAVEFORMATEX* _wfx;
-	IXAudio2SourceVoice* _voice;
+	SoundStream* _stream;
+	unsigned int _voice;
+	float _volume;
 };
 
 easy2d::Music::Media::Media()
-	: _opened(false)
-	, _playing(false)
-	, _wfx(nullptr)
-	, _waveData(nullptr)
-	, _waveDataSize(0)
-	, _voice(nullptr)
+	: _stream(nullptr)
+	, _voice(0)
+	, _volume(1.f)
 {
 }
 
@@ -121,7 +78,7 @@ easy2d::Music::Media::~Media()
 
 bool easy2d::Music::Media::open(const easy2d::String& filePath)
 {
-	if (_opened)
+	if (_stream)
 	{
 		E2D_WARNING(L"MusicInfo can be opened only once!");
 		return false;
@@ -133,488 +90,122 @@ bool easy2d::Music::Media::open(const easy2d::String& filePath)
 		return false;
 	}
 
-	String actualFilePath = Path::searchForFile(filePath);
-	if (actualFilePath.empty())
+	// ڲʱ룬һռôڴ
+	SoundStream* stream = gcnew SoundStream;
+	if (!stream->open(filePath))
 	{
-		E2D_WARNING(L"MusicInfo::open File not found.");
 		return false;
 	}
-
-	if (!s_pXAudio2)
-	{
-		E2D_WARNING(L"IXAudio2 nullptr pointer error!");
-		return false;
-	}
-
-	if (FAILED(_loadMediaFile(actualFilePath)))
-	{
-		TraceError(L"Failed to read WAV data");
-		SAFE_DELETE_ARRAY(_waveData);
-		return false;
-	}
-
-	// Դ
-	HRESULT hr;
-	if (FAILED(hr = s_pXAudio2->CreateSourceVoice(&_voice, _wfx, 0, XAUDIO2_DEFAULT_FREQ_RATIO, nullptr)))
-	{
-		TraceError(L"Create source voice error", hr);
-		SAFE_DELETE_ARRAY(_waveData);
-		return false;
-	}
-
-	_opened = true;
-	_playing = false;
-	return true;
+	return _attach(stream);
 }
 
 bool easy2d::Music::Media::open(int resNameId, const easy2d::String& resType)
 {
-	HRSRC hResInfo;
-	HGLOBAL hResData;
-	DWORD dwSize;
-	void* pvRes;
-
-	if (_opened)
+	if (_stream)
 	{
 		E2D_WARNING(L"MusicInfo can be opened only once!");
 		return false;
 	}
 
-	if (!s_pXAudio2)
-	{
-		E2D_WARNING(L"IXAudio2 nullptr pointer error!");
-		return false;
-	}
-
-	if (nullptr == (hResInfo = FindResourceW(HINST_THISCOMPONENT, MAKEINTRESOURCE(resNameId), resType.c_str())))
-		return TraceError(L"FindResource");
-
-	if (nullptr == (hResData = LoadResource(HINST_THISCOMPONENT, hResInfo)))
-		return TraceError(L"LoadResource");
-
-	if (0 == (dwSize = SizeofResource(HINST_THISCOMPONENT, hResInfo)))
-		return TraceError(L"SizeofResource");
-
-	if (nullptr == (pvRes = LockResource(hResData)))
-		return TraceError(L"LockResource");
+	return open(Resource(resNameId, resType).loadData());
+}
 
-	if (FAILED(_loadMediaResource(pvRes, dwSize)))
+bool easy2d::Music::Media::open(const Resource::Data& data)
+{
+	if (_stream)
 	{
-		TraceError(L"Failed to read WAV data");
-		SAFE_DELETE_ARRAY(_waveData);
+		E2D_WARNING(L"MusicInfo can be opened only once!");
 		return false;
 	}
 
-	// Դ
-	HRESULT hr;
-	if (FAILED(hr = s_pXAudio2->CreateSourceVoice(&_voice, _wfx, 0, XAUDIO2_DEFAULT_FREQ_RATIO, nullptr)))
+	SoundStream* stream = gcnew SoundStream;
+	if (!stream->open(data))
 	{
-		TraceError(L"Create source voice error", hr);
-		SAFE_DELETE_ARRAY(_waveData);
 		return false;
 	}
-
-	_opened = true;
-	_playing = false;
-	return true;
+	return _attach(stream);
 }
 
 bool easy2d::Music::Media::play(int nLoopCount)
 {
-	if (!_opened)
+	if (!_stream)
 	{
 		E2D_WARNING(L"MusicInfo::play Failed: MusicInfo must be opened first!");
 		return false;
 	}
 
-	if (_voice == nullptr)
-	{
-		E2D_WARNING(L"MusicInfo::play Failed: IXAudio2SourceVoice Null pointer exception!");
-		return false;
-	}
-
-	if (_playing)
-	{
-		stop();
-	}
-
-	nLoopCount = min(nLoopCount, XAUDIO2_LOOP_INFINITE - 1);
-	nLoopCount = (nLoopCount < 0) ? XAUDIO2_LOOP_INFINITE : nLoopCount;
-
-	// ύ wave 
-	XAUDIO2_BUFFER buffer = { 0 };
-	buffer.pAudioData = _waveData;
-	buffer.Flags = XAUDIO2_END_OF_STREAM;
-	buffer.AudioBytes = _waveDataSize;
-	buffer.LoopCount = nLoopCount;
-
-	HRESULT hr;
-	if (FAILED(hr = _voice->SubmitSourceBuffer(&buffer)))
-	{
-		TraceError(L"Submitting source buffer error", hr);
-		_voice->DestroyVoice();
-		SAFE_DELETE_ARRAY(_waveData);
-		return false;
-	}
-
-	if (SUCCEEDED(hr = _voice->Start(0)))
-	{
-		// ųɹ
-		_playing = true;
-	}
+	stop();
 
-	return SUCCEEDED(hr);
+	_voice = Mixer::play(_stream, _volume, 0.f, nLoopCount);
+	return _voice != 0;
 }
 
 void easy2d::Music::Media::pause()
 {
-	if (_voice)
-	{
-		if (SUCCEEDED(_voice->Stop()))
-		{
-			_playing = false;
-		}
-	}
+	Mixer::pause(_voice);
 }
 
 void easy2d::Music::Media::resume()
 {
-	if (_voice)
-	{
-		if (SUCCEEDED(_voice->Start()))
-		{
-			_playing = true;
-		}
-	}
+	Mixer::resume(_voice);
 }
 
 void easy2d::Music::Media::stop()
 {
 	if (_voice)
 	{
-		if (SUCCEEDED(_voice->Stop()))
-		{
-			_voice->ExitLoop();
-			_voice->FlushSourceBuffers();
-			_playing = false;
-		}
+		Mixer::stop(_voice);
+		_voice = 0;
 	}
 }
 
 void easy2d::Music::Media::close()
 {
-	if (_voice)
-	{
-		_voice->Stop();
-		_voice->FlushSourceBuffers();
-		_voice->DestroyVoice();
-		_voice = nullptr;
-	}
-
-	if (_wfx)
-	{
-		::CoTaskMemFree(_wfx);
-		_wfx = nullptr;
-	}
-
-	SAFE_DELETE_ARRAY(_waveData);
-
-	_opened = false;
-	_playing = false;
+	stop();
+	GC::release(_stream);
 }
 
 bool easy2d::Music::Media::isPlaying() const
 {
-	if (_opened && _voice)
-	{
-		XAUDIO2_VOICE_STATE state;
-		_voice->GetState(&state);
-
-		if (state.BuffersQueued == 0)
-		{
-			_playing = false;
-		}
-		return _playing;
-	}
-	else
-	{
-		return false;
-	}
+	return _voice && Mixer::isPlaying(_voice);
 }
 
 bool easy2d::Music::Media::setVolume(float volume)
 {
+	_volume = volume;
 	if (_voice)
 	{
-		return SUCCEEDED(_voice->SetVolume(float(volume)));
-	}
-	return false;
-}
-
-HRESULT easy2d::Music::Media::_loadMediaFile(String const& file_path)
-{
-	HRESULT hr = S_OK;
-
-	IMFSourceReader* reader = nullptr;
-
-	hr = MFCreateSourceReaderFromURL(
-		file_path.c_str(),
-		nullptr,
-		&reader
-	);
-
-	if (SUCCEEDED(hr))
-	{
-		hr = _readSource(reader);
+		Mixer::setVolume(_voice, volume);
 	}
-
-	SafeRelease(reader);
-	return hr;
-}
-
-HRESULT easy2d::Music::Media::_loadMediaResource(LPVOID buffer, DWORD bufferSize)
-{
-	HRESULT	hr = S_OK;
-
-	IStream* stream = nullptr;
-	IMFByteStream* byte_stream = nullptr;
-	IMFSourceReader* reader = nullptr;
-
-	stream = SHCreateMemStream(
-		static_cast<const BYTE*>(buffer),
-		static_cast<UINT32>(bufferSize)
-	);
-
-	if (stream == nullptr)
-	{
-		E2D_WARNING(L"SHCreateMemStream failed");
-		return E_OUTOFMEMORY;
-	}
-
-	if (SUCCEEDED(hr))
-	{
-		hr = MFCreateMFByteStreamOnStream(stream, &byte_stream);
-	}
-
-	if (SUCCEEDED(hr))
-	{
-		hr = MFCreateSourceReaderFromByteStream(
-			byte_stream,
-			nullptr,
-			&reader
-		);
-	}
-
-	if (SUCCEEDED(hr))
-	{
-		hr = _readSource(reader);
-	}
-
-	SafeRelease(stream);
-	SafeRelease(byte_stream);
-	SafeRelease(reader);
-	return hr;
+	return true;
 }
 
-HRESULT easy2d::Music::Media::_readSource(IMFSourceReader* reader)
+bool easy2d::Music::Media::_attach(SoundStream* stream)
 {
-	HRESULT hr = S_OK;
-	DWORD max_stream_size = 0;
-
-	IMFMediaType* partial_type = nullptr;
-	IMFMediaType* uncompressed_type = nullptr;
-
-	hr = MFCreateMediaType(&partial_type);
-
-	if (SUCCEEDED(hr))
-	{
-		hr = partial_type->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Audio);
-	}
-
-	if (SUCCEEDED(hr))
-	{
-		hr = partial_type->SetGUID(MF_MT_SUBTYPE, MFAudioFormat_PCM);
-	}
-
-	//  source reader ýͣʹúʵĽȥƵ
-	if (SUCCEEDED(hr))
-	{
-		hr = reader->SetCurrentMediaType(
-			(DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM,
-			0,
-			partial_type
-		);
-	}
-
-	//  IMFMediaType лȡ WAVEFORMAT ṹ
-	if (SUCCEEDED(hr))
-	{
-		hr = reader->GetCurrentMediaType(
-			(DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM,
-			&uncompressed_type
-		);
-	}
-
-	// ָƵ
-	if (SUCCEEDED(hr))
-	{
-		hr = reader->SetStreamSelection(
-			(DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM,
-			true
-		);
-	}
-
-	// ȡ WAVEFORMAT 
-	if (SUCCEEDED(hr))
-	{
-		UINT32 size = 0;
-		hr = MFCreateWaveFormatExFromMFMediaType(
-			uncompressed_type,
-			&_wfx,
-			&size,
-			(DWORD)MFWaveFormatExConvertFlag_Normal
-		);
-	}
-
-	// ƵС
-	if (SUCCEEDED(hr))
-	{
-		PROPVARIANT prop;
-		PropVariantInit(&prop);
-
-		hr = reader->GetPresentationAttribute(
-			(DWORD)MF_SOURCE_READER_MEDIASOURCE,
-			MF_PD_DURATION,
-			&prop
-		);
-
-		LONGLONG duration = prop.uhVal.QuadPart;
-		max_stream_size = static_cast<DWORD>(
-			(duration * _wfx->nAvgBytesPerSec) / 10000000 + 1
-			);
-		PropVariantClear(&prop);
-	}
-
-	// ȡƵ
-	if (SUCCEEDED(hr))
-	{
-		DWORD flags = 0;
-		DWORD position = 0;
-		BYTE* data = new (std::nothrow) BYTE[max_stream_size];
-
-		IMFSample* sample = nullptr;
-		IMFMediaBuffer* buffer = nullptr;
-
-		if (data == nullptr)
-		{
-			E2D_WARNING(L"Low memory");
-			hr = E_OUTOFMEMORY;
-		}
-		else
-		{
-			while (true)
-			{
-				hr = reader->ReadSample(
-					(DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM,
-					0,
-					nullptr,
-					&flags,
-					nullptr,
-					&sample
-				);
-
-				if (flags & MF_SOURCE_READERF_ENDOFSTREAM) { break; }
-
-				if (sample == nullptr) { continue; }
-
-				if (SUCCEEDED(hr))
-				{
-					hr = sample->ConvertToContiguousBuffer(&buffer);
-
-					if (SUCCEEDED(hr))
-					{
-						BYTE* audio_data = nullptr;
-						DWORD sample_buffer_length = 0;
-
-						hr = buffer->Lock(
-							&audio_data,
-							nullptr,
-							&sample_buffer_length
-						);
-
-						if (SUCCEEDED(hr) && sample_buffer_length <= max_stream_size)
-						{
-							for (DWORD i = 0; i < sample_buffer_length; i++)
-							{
-								data[position++] = audio_data[i];
-							}
-							hr = buffer->Unlock();
-						}
-					}
-					buffer = nullptr;
-				}
-				sample = nullptr;
-
-				if (FAILED(hr)) { break; }
-			}
-
-			if (SUCCEEDED(hr))
-			{
-				_waveData = data;
-				_waveDataSize = position;
-			}
-			else
-			{
-				delete[] data;
-				data = nullptr;
-			}
-		}
-
-		SafeRelease(sample);
-		SafeRelease(buffer);
-	}
-
-	SafeRelease(partial_type);
-	SafeRelease(uncompressed_type);
-	return hr;
+	_stream = stream;
+	GC::retain(_stream);
+	return true;
 }
 
 bool easy2d::Music::__init()
 {
-	HRESULT hr;
-
-	if (FAILED(hr = MFStartup(MF_VERSION, MFSTARTUP_FULL)))
-	{
-		TraceError(L"Failed to startup MediaFoundation device", hr);
-		return false;
-	}
-
-	if (FAILED(hr = XAudio2Create(&s_pXAudio2, 0)))
-	{
-		TraceError(L"Failed to init XAudio2 engine", hr);
-		return false;
-	}
-
-	if (FAILED(hr = s_pXAudio2->CreateMasteringVoice(&s_pMasteringVoice)))
+#ifndef E2D_HEADLESS
+	// Media Foundation ڽ WAV ĸʽ
+	HRESULT hr = MFStartup(MF_VERSION, MFSTARTUP_FULL);
+	if (FAILED(hr))
 	{
-		TraceError(L"Failed to create mastering voice", hr);
-		SafeRelease(s_pXAudio2);
+		E2D_WARNING(L"Failed to startup MediaFoundation device (%#X)", hr);
 		return false;
 	}
-
+#endif
 	return true;
 }
 
 void easy2d::Music::__uninit()
 {
-	if (s_pMasteringVoice)
-	{
-		s_pMasteringVoice->DestroyVoice();
-	}
-
-	SafeRelease(s_pXAudio2);
-
+#ifndef E2D_HEADLESS
 	MFShutdown();
+#endif
 }
 
 #else
@@ -654,6 +245,10 @@ public:
 		const String& resType
 	);
 
+	bool open(
+		const Resource::Data& data
+	);
+
 	bool play(
 		int nLoopCount = 0
 	);
@@ -748,6 +343,12 @@ bool easy2d::Music::Media::open(int resNameId, const String& resType)
 	return false;
 }
 
+bool easy2d::Music::Media::open(const Resource::Data& data)
+{
+	E2D_ERROR(L"Music::open failed! Play sound from memory is not supported when use E2D_WIN7 macro");
+	return false;
+}
+
 bool easy2d::Music::Media::play(int nLoopCount)
 {
 	if (!_dev)
@@ -939,6 +540,11 @@ bool easy2d::Music::open(int resNameId, const easy2d::String& resType)
 	return _media->open(resNameId, resType);
 }
 
+bool easy2d::Music::open(const Resource::Data& data)
+{
+	return _media->open(data);
+}
+
 bool easy2d::Music::play(int nLoopCount)
 {
 	return _media->play(nLoopCount);
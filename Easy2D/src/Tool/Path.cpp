@@ -1,13 +1,10 @@
 #include <easy2d/e2dtool.h>
+#include <easy2d/e2dplatform.h>
 #include <algorithm>
 #include <list>
-#include <commdlg.h>
-
-#define DEFINE_KNOWN_FOLDER(name, l, w1, w2, b1, b2, b3, b4, b5, b6, b7, b8) \
-	EXTERN_C const GUID DECLSPEC_SELECTANY name \
-	= { l, w1, w2,{ b1, b2,  b3,  b4,  b5,  b6,  b7,  b8 } }
-
-DEFINE_KNOWN_FOLDER(FOLDERID_LocalAppData, 0xF1B32785, 0x6FBA, 0x4FCF, 0x9D, 0x55, 0x7B, 0x8E, 0x7F, 0x15, 0x70, 0x91);
+#ifndef E2D_HEADLESS
+#	include <commdlg.h>
+#endif
 
 
 static easy2d::String s_sLocalAppDataPath;
@@ -17,30 +14,21 @@ static std::list<easy2d::String> s_vPathList;
 
 bool easy2d::Path::__init(const String& gameName)
 {
-	// ȡ AppData\Local ļе·
-	typedef HRESULT(WINAPI* pFunSHGetKnownFolderPath)(const GUID& rfid, DWORD dwFlags, HANDLE hToken, PWSTR *ppszPath);
+	const String separator(1, platform::GetPathSeparator());
 
-	PWSTR pszPath = nullptr;
-	HMODULE hModule = LoadLibrary(L"shell32.dll");
-	pFunSHGetKnownFolderPath SHGetKnownFolderPath = (pFunSHGetKnownFolderPath)GetProcAddress(hModule, "SHGetKnownFolderPath");
-	HRESULT hr = SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &pszPath);
-
-	if (SUCCEEDED(hr))
-	{
-		s_sLocalAppDataPath = pszPath;
-		CoTaskMemFree(pszPath);
-	}
-	else
+	// ȡӦļе·
+	s_sLocalAppDataPath = platform::GetLocalDataDirectory();
+	if (s_sLocalAppDataPath.empty())
 	{
 		E2D_WARNING(L"Get local AppData path failed!");
 		return false;
 	}
 	
 	// ȡݵĬϱ·
-	s_sDataSavePath = s_sLocalAppDataPath + L"\\Easy2DGameData\\";
+	s_sDataSavePath = s_sLocalAppDataPath + separator + L"Easy2DGameData" + separator;
 	if (!gameName.empty())
 	{
-		s_sDataSavePath.append(gameName).append(L"\\");
+		s_sDataSavePath.append(gameName).append(separator);
 	}
 	if (!Path::exists(s_sDataSavePath))
 	{
@@ -49,19 +37,19 @@ bool easy2d::Path::__init(const String& gameName)
 			s_sDataSavePath = L"";
 		}
 	}
-	s_sDataSavePath.append(L"Data.ini");
+	s_sDataSavePath.append(L"Data.dat");
 
 	// ȡʱļĿ¼
-	wchar_t path[_MAX_PATH];
-	if (0 == ::GetTempPath(_MAX_PATH, path))
+	String path = platform::GetTempDirectory();
+	if (path.empty())
 	{
 		return false;
 	}
 
-	s_sTempPath.append(path).append(L"\\Easy2DGameTemp\\");
+	s_sTempPath.append(path).append(separator).append(L"Easy2DGameTemp").append(separator);
 	if (!gameName.empty())
 	{
-		s_sTempPath.append(gameName).append(L"\\");
+		s_sTempPath.append(gameName).append(separator);
 	}
 
 	if (!Path::exists(s_sTempPath))
@@ -79,7 +67,7 @@ void easy2d::Path::add(String path)
 {
 	if (path[path.length() - 1] != L'\\' && path[path.length() - 1] != L'/')
 	{
-		path.append(L"\\");
+		path.push_back(platform::GetPathSeparator());
 	}
 	auto iter = std::find(s_vPathList.cbegin(), s_vPathList.cend(), path);
 	if (iter == s_vPathList.cend())
@@ -95,12 +83,7 @@ easy2d::String easy2d::Path::getTempPath()
 
 easy2d::String easy2d::Path::getExecutableFilePath()
 {
-	TCHAR szPath[_MAX_PATH] = { 0 };
-	if (::GetModuleFileName(nullptr, szPath, _MAX_PATH) != 0)
-	{
-		return String(szPath);
-	}
-	return String();
+	return platform::GetExecutablePath();
 }
 
 easy2d::String easy2d::Path::searchForFile(const String& path)
@@ -122,6 +105,8 @@ easy2d::String easy2d::Path::searchForFile(const String& path)
 	return String();
 }
 
+#ifndef E2D_HEADLESS
+
 easy2d::String easy2d::Path::extractResource(int resNameId, const String & resType, const String & destFileName)
 {
 	String destFilePath = s_sTempPath + destFileName;
@@ -151,11 +136,15 @@ easy2d::String easy2d::Path::extractResource(int resNameId, const String & resTy
 	}
 }
 
+#endif
+
 easy2d::String easy2d::Path::getDataSavePath()
 {
 	return s_sDataSavePath;
 }
 
+#ifndef E2D_HEADLESS
+
 easy2d::String easy2d::Path::getSaveFilePath(const String& title, const String& defExt)
 {
 	// Ի
@@ -179,24 +168,27 @@ easy2d::String easy2d::Path::getSaveFilePath(const String& title, const String&
 	return L"";
 }
 
+#endif
+
 bool easy2d::Path::createFolder(const String& dirPath)
 {
-	if (dirPath.empty() || dirPath.length() >= MAX_PATH)
+	if (dirPath.empty())
 	{
 		return false;
 	}
 
-	wchar_t tmpDirPath[_MAX_PATH] = { 0 };
-	int length = (int)dirPath.length();
+	String tmpDirPath;
+	tmpDirPath.reserve(dirPath.length());
 
-	for (int i = 0; i < length; ++i)
+	const size_t length = dirPath.length();
+	for (size_t i = 0; i < length; ++i)
 	{
-		tmpDirPath[i] = dirPath.at(i);
+		tmpDirPath.push_back(dirPath.at(i));
 		if (tmpDirPath[i] == L'\\' || tmpDirPath[i] == L'/' || i == (length - 1))
 		{
-			if (::_waccess(tmpDirPath, 0) != 0)
+			if (!platform::FileExists(tmpDirPath))
 			{
-				if (::_wmkdir(tmpDirPath) != 0)
+				if (!platform::MakeDirectory(tmpDirPath))
 				{
 					return false;
 				}
@@ -208,9 +200,5 @@ bool easy2d::Path::createFolder(const String& dirPath)
 
 bool easy2d::Path::exists(const String & path)
 {
-	if (path.empty() || path.length() >= MAX_PATH)
-	{
-		return false;
-	}
-	return ::_waccess(path.c_str(), 0) == 0;
+	return platform::FileExists(path);
 }
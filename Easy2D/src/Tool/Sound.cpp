@@ -0,0 +1,959 @@
+#include <easy2d/e2dtool.h>
+#include <easy2d/e2dplatform.h>
+#include <map>
+#include <cstring>
+
+#if !defined(E2D_HEADLESS) && !defined(E2D_USE_MCI)
+#	include <mfapi.h>
+#	include <mfidl.h>
+#	include <mfreadwrite.h>
+#	include <shlwapi.h>
+
+#	pragma comment(lib, "Mfplat.lib")
+#	pragma comment(lib, "Mfreadwrite.lib")
+#	pragma comment(lib, "Shlwapi.lib")
+#endif
+
+
+namespace
+{
+	const int DECODE_FRAMES = 4096;		// һԽʱÿζȡ֡
+
+	std::map<easy2d::String, easy2d::Sound*> s_mSoundCache;
+
+	// WAV ʽ
+	enum class SampleFormat
+	{
+		Unknown,
+		UInt8,
+		Int16,
+		Int24,
+		Int32,
+		Float32,
+		Float64
+	};
+
+	unsigned int ReadU16(const unsigned char* p)
+	{
+		return unsigned(p[0]) | (unsigned(p[1]) << 8);
+	}
+
+	unsigned int ReadU32(const unsigned char* p)
+	{
+		return unsigned(p[0]) | (unsigned(p[1]) << 8) | (unsigned(p[2]) << 16) | (unsigned(p[3]) << 24);
+	}
+
+	float ReadSample(const unsigned char* p, SampleFormat format)
+	{
+		switch (format)
+		{
+		case SampleFormat::UInt8:
+			return (int(p[0]) - 128) / 128.f;
+		case SampleFormat::Int16:
+			return static_cast<short>(ReadU16(p)) / 32768.f;
+		case SampleFormat::Int24:
+			return static_cast<int>((unsigned(p[0]) << 8) | (unsigned(p[1]) << 16) | (unsigned(p[2]) << 24)) / 2147483648.f;
+		case SampleFormat::Int32:
+			return static_cast<int>(ReadU32(p)) / 2147483648.f;
+		case SampleFormat::Float32:
+		{
+			unsigned int bits = ReadU32(p);
+			float value;
+			::memcpy(&value, &bits, 4);
+			return value;
+		}
+		case SampleFormat::Float64:
+		{
+			unsigned long long bits = ReadU32(p) | (static_cast<unsigned long long>(ReadU32(p + 4)) << 32);
+			double value;
+			::memcpy(&value, &bits, 8);
+			return static_cast<float>(value);
+		}
+		default:
+			return 0.f;
+		}
+	}
+
+	// ȡֽԴ
+	class ByteSource
+	{
+	public:
+		virtual ~ByteSource() {}
+
+		virtual size_t read(void* buffer, size_t size) = 0;
+
+		virtual bool seek(size_t offset) = 0;
+
+		virtual size_t getSize() const = 0;
+	};
+
+	class MemorySource :
+		public ByteSource
+	{
+	public:
+		MemorySource(const void* data, size_t size)
+			: _data(static_cast<const unsigned char*>(data))
+			, _size(size)
+			, _offset(0)
+		{
+		}
+
+		virtual size_t read(void* buffer, size_t size) override
+		{
+			size = min(size, _size - _offset);
+			::memcpy(buffer, _data + _offset, size);
+			_offset += size;
+			return size;
+		}
+
+		virtual bool seek(size_t offset) override
+		{
+			if (offset > _size)
+			{
+				return false;
+			}
+			_offset = offset;
+			return true;
+		}
+
+		virtual size_t getSize() const override
+		{
+			return _size;
+		}
+
+	private:
+		const unsigned char* _data;
+		size_t _size;
+		size_t _offset;
+	};
+
+	class FileSource :
+		public ByteSource
+	{
+	public:
+		explicit FileSource(FILE* file)
+			: _file(file)
+			, _size(0)
+		{
+			if (::fseek(_file, 0, SEEK_END) == 0)
+			{
+				long size = ::ftell(_file);
+				_size = size > 0 ? static_cast<size_t>(size) : 0;
+			}
+			::fseek(_file, 0, SEEK_SET);
+		}
+
+		virtual ~FileSource()
+		{
+			::fclose(_file);
+		}
+
+		virtual size_t read(void* buffer, size_t size) override
+		{
+			return ::fread(buffer, 1, size, _file);
+		}
+
+		virtual bool seek(size_t offset) override
+		{
+			return ::fseek(_file, static_cast<long>(offset), SEEK_SET) == 0;
+		}
+
+		virtual size_t getSize() const override
+		{
+			return _size;
+		}
+
+	private:
+		FILE* _file;
+		size_t _size;
+	};
+
+	// WAV ʱֻǰ
+	class WaveDecoder :
+		public easy2d::AudioDecoder
+	{
+	public:
+		WaveDecoder(ByteSource* source, easy2d::Object* owner)
+			: _source(source)
+			, _owner(owner)
+			, _format(SampleFormat::Unknown)
+			, _channels(0)
+			, _rate(0)
+			, _blockAlign(0)
+			, _dataOffset(0)
+			, _dataSize(0)
+			, _remaining(0)
+		{
+			easy2d::GC::retain(_owner);
+			if (_parse())
+			{
+				rewind();
+			}
+		}
+
+		virtual ~WaveDecoder()
+		{
+			delete _source;
+			easy2d::GC::release(_owner);
+		}
+
+		bool isValid() const
+		{
+			return _format != SampleFormat::Unknown;
+		}
+
+		virtual int getChannelCount() const override
+		{
+			return int(min(_channels, 2u));
+		}
+
+		virtual int getSampleRate() const override
+		{
+			return int(_rate);
+		}
+
+		virtual int read(float* samples, int frameCount) override
+		{
+			if (!isValid())
+			{
+				return 0;
+			}
+
+			size_t frames = min(static_cast<size_t>(max(frameCount, 0)), _remaining / _blockAlign);
+			if (frames == 0)
+			{
+				return 0;
+			}
+
+			_buffer.resize(frames * _blockAlign);
+			const size_t bytes = _source->read(_buffer.data(), _buffer.size());
+
+			// ļضʱֱӽ
+			_remaining = (bytes < _buffer.size()) ? 0 : _remaining - bytes;
+			frames = bytes / _blockAlign;
+
+			const unsigned int outChannels = min(_channels, 2u);
+			const unsigned int bytesPerSample = _blockAlign / _channels;
+			for (size_t i = 0; i < frames; ++i)
+			{
+				const unsigned char* frame = _buffer.data() + i * _blockAlign;
+				for (unsigned int c = 0; c < outChannels; ++c)
+				{
+					samples[i * outChannels + c] = ReadSample(frame + c * bytesPerSample, _format);
+				}
+			}
+			return static_cast<int>(frames);
+		}
+
+		virtual bool rewind() override
+		{
+			if (!isValid() || !_source->seek(_dataOffset))
+			{
+				return false;
+			}
+			_remaining = _dataSize;
+			return true;
+		}
+
+	private:
+		// ȡʽҵݿλ
+		bool _parse()
+		{
+			const size_t size = _source->getSize();
+			unsigned char header[40];
+			if (size < 12 || _source->read(header, 12) != 12
+				|| ::memcmp(header, "RIFF", 4) != 0 || ::memcmp(header + 8, "WAVE", 4) != 0)
+			{
+				return false;
+			}
+
+			SampleFormat format = SampleFormat::Unknown;
+			bool hasData = false;
+
+			size_t pos = 12;
+			while (pos + 8 <= size)
+			{
+				if (!_source->seek(pos) || _source->read(header, 8) != 8)
+				{
+					break;
+				}
+
+				size_t chunkSize = ReadU32(header + 4);
+				size_t available = min(chunkSize, size - pos - 8);
+
+				if (::memcmp(header, "fmt ", 4) == 0 && available >= 16)
+				{
+					unsigned char* fmt = header;
+					if (_source->read(fmt, min(available, sizeof(header))) < 16)
+					{
+						break;
+					}
+
+					unsigned int tag = ReadU16(fmt);
+					unsigned int bits = ReadU16(fmt + 14);
+					_channels = ReadU16(fmt + 2);
+					_rate = ReadU32(fmt + 4);
+					_blockAlign = ReadU16(fmt + 12);
+
+					// WAVE_FORMAT_EXTENSIBLE ʵʸʽӸʽ GUID ǰֽ
+					if (tag == 0xFFFE && available >= 40)
+					{
+						tag = ReadU16(fmt + 24);
+					}
+
+					if (tag == 1)
+					{
+						format = (bits == 8) ? SampleFormat::UInt8
+							: (bits == 16) ? SampleFormat::Int16
+							: (bits == 24) ? SampleFormat::Int24
+							: (bits == 32) ? SampleFormat::Int32
+							: SampleFormat::Unknown;
+					}
+					else if (tag == 3)
+					{
+						format = (bits == 32) ? SampleFormat::Float32
+							: (bits == 64) ? SampleFormat::Float64
+							: SampleFormat::Unknown;
+					}
+
+					if (format != SampleFormat::Unknown && _blockAlign < _channels * (bits / 8))
+					{
+						format = SampleFormat::Unknown;
+					}
+				}
+				else if (::memcmp(header, "data", 4) == 0)
+				{
+					// ʽдļгȿܲȷʵʴСΪ׼
+					_dataOffset = pos + 8;
+					_dataSize = available;
+					hasData = true;
+				}
+
+				if (chunkSize + (chunkSize & 1) >= size - pos - 8)
+				{
+					break;
+				}
+				pos += 8 + chunkSize + (chunkSize & 1);
+			}
+
+			if (!hasData || _channels == 0 || _rate == 0 || _blockAlign == 0)
+			{
+				return false;
+			}
+			_format = format;
+			return isValid();
+		}
+
+	private:
+		ByteSource* _source;
+		easy2d::Object* _owner;
+		SampleFormat _format;
+		unsigned int _channels;
+		unsigned int _rate;
+		unsigned int _blockAlign;
+		size_t _dataOffset;
+		size_t _dataSize;
+		size_t _remaining;
+		std::vector<unsigned char> _buffer;
+	};
+
+#if !defined(E2D_HEADLESS) && !defined(E2D_USE_MCI)
+	// Media Foundation  16 λ PCM תΪ
+	class MediaFoundationDecoder :
+		public easy2d::AudioDecoder
+	{
+	public:
+		explicit MediaFoundationDecoder(easy2d::Object* owner)
+			: _owner(owner)
+			, _reader(nullptr)
+			, _channels(0)
+			, _rate(0)
+			, _blockAlign(0)
+			, _offset(0)
+		{
+			easy2d::GC::retain(_owner);
+		}
+
+		virtual ~MediaFoundationDecoder()
+		{
+			SafeRelease(_reader);
+			easy2d::GC::release(_owner);
+		}
+
+		HRESULT openFile(const easy2d::String& filePath)
+		{
+			HRESULT hr = MFCreateSourceReaderFromURL(filePath.c_str(), nullptr, &_reader);
+			if (SUCCEEDED(hr))
+			{
+				hr = _configure();
+			}
+			return hr;
+		}
+
+		HRESULT openMemory(const void* data, size_t size)
+		{
+			IStream* stream = SHCreateMemStream(static_cast<const BYTE*>(data), static_cast<UINT32>(size));
+			IMFByteStream* byteStream = nullptr;
+			HRESULT hr = stream ? S_OK : E_OUTOFMEMORY;
+
+			if (SUCCEEDED(hr))
+			{
+				hr = MFCreateMFByteStreamOnStream(stream, &byteStream);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				hr = MFCreateSourceReaderFromByteStream(byteStream, nullptr, &_reader);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				hr = _configure();
+			}
+
+			SafeRelease(byteStream);
+			SafeRelease(stream);
+			return hr;
+		}
+
+		virtual int getChannelCount() const override
+		{
+			return int(min(_channels, 2u));
+		}
+
+		virtual int getSampleRate() const override
+		{
+			return int(_rate);
+		}
+
+		virtual int read(float* samples, int frameCount) override
+		{
+			const UINT outChannels = min(_channels, 2u);
+
+			int done = 0;
+			while (done < frameCount)
+			{
+				if (_offset >= _pending.size())
+				{
+					if (!_fetch())
+					{
+						break;
+					}
+					continue;
+				}
+
+				const int frames = min(static_cast<int>((_pending.size() - _offset) / _blockAlign), frameCount - done);
+				for (int i = 0; i < frames; ++i)
+				{
+					const BYTE* frame = _pending.data() + _offset + i * _blockAlign;
+					for (UINT c = 0; c < outChannels; ++c)
+					{
+						samples[(done + i) * outChannels + c] = ReadSample(frame + c * 2, SampleFormat::Int16);
+					}
+				}
+				_offset += frames * _blockAlign;
+				done += frames;
+
+				if (frames == 0)
+				{
+					// ֱ֡Ӷ
+					_offset = _pending.size();
+				}
+			}
+			return done;
+		}
+
+		virtual bool rewind() override
+		{
+			PROPVARIANT position;
+			PropVariantInit(&position);
+			position.vt = VT_I8;
+			position.hVal.QuadPart = 0;
+
+			HRESULT hr = _reader->SetCurrentPosition(GUID_NULL, position);
+			PropVariantClear(&position);
+
+			_pending.clear();
+			_offset = 0;
+			return SUCCEEDED(hr);
+		}
+
+	private:
+		//  source reader ýͣʹúʵĽȥƵ
+		HRESULT _configure()
+		{
+			IMFMediaType* partialType = nullptr;
+			IMFMediaType* uncompressedType = nullptr;
+			WAVEFORMATEX* wfx = nullptr;
+
+			HRESULT hr = MFCreateMediaType(&partialType);
+
+			if (SUCCEEDED(hr))
+			{
+				hr = partialType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Audio);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				hr = partialType->SetGUID(MF_MT_SUBTYPE, MFAudioFormat_PCM);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				hr = partialType->SetUINT32(MF_MT_AUDIO_BITS_PER_SAMPLE, 16);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				hr = _reader->SetCurrentMediaType((DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM, 0, partialType);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				hr = _reader->GetCurrentMediaType((DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM, &uncompressedType);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				hr = _reader->SetStreamSelection((DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM, true);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				UINT32 wfxSize = 0;
+				hr = MFCreateWaveFormatExFromMFMediaType(uncompressedType, &wfx, &wfxSize, (DWORD)MFWaveFormatExConvertFlag_Normal);
+			}
+
+			if (SUCCEEDED(hr) && (wfx->wBitsPerSample != 16 || wfx->nChannels == 0 || wfx->nBlockAlign < wfx->nChannels * 2))
+			{
+				hr = E_FAIL;
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				_channels = wfx->nChannels;
+				_rate = wfx->nSamplesPerSec;
+				_blockAlign = wfx->nBlockAlign;
+			}
+
+			if (wfx)
+			{
+				::CoTaskMemFree(wfx);
+			}
+			SafeRelease(partialType);
+			SafeRelease(uncompressedType);
+			return hr;
+		}
+
+		// ȡһ飬ʧʱ false
+		bool _fetch()
+		{
+			DWORD flags = 0;
+			IMFSample* sample = nullptr;
+			HRESULT hr = _reader->ReadSample((DWORD)MF_SOURCE_READER_FIRST_AUDIO_STREAM, 0, nullptr, &flags, nullptr, &sample);
+
+			if (FAILED(hr) || (flags & MF_SOURCE_READERF_ENDOFSTREAM))
+			{
+				SafeRelease(sample);
+				return false;
+			}
+
+			_pending.clear();
+			_offset = 0;
+
+			if (sample == nullptr)
+			{
+				return true;
+			}
+
+			IMFMediaBuffer* buffer = nullptr;
+			hr = sample->ConvertToContiguousBuffer(&buffer);
+
+			BYTE* audioData = nullptr;
+			DWORD length = 0;
+			if (SUCCEEDED(hr))
+			{
+				hr = buffer->Lock(&audioData, nullptr, &length);
+			}
+
+			if (SUCCEEDED(hr))
+			{
+				_pending.assign(audioData, audioData + length);
+				hr = buffer->Unlock();
+			}
+
+			SafeRelease(buffer);
+			SafeRelease(sample);
+			return SUCCEEDED(hr);
+		}
+
+	private:
+		easy2d::Object* _owner;
+		IMFSourceReader* _reader;
+		UINT _channels;
+		UINT _rate;
+		UINT _blockAlign;
+		std::vector<BYTE> _pending;
+		size_t _offset;
+	};
+#endif
+
+	// ʹõ WAV 
+	// ļ·Ϊʱڴн룬صĶüΪ 1
+	easy2d::AudioDecoder* CreateDecoder(const easy2d::String& filePath, const void* data, size_t size, easy2d::Object* owner)
+	{
+		ByteSource* source = nullptr;
+		if (filePath.empty())
+		{
+			source = new MemorySource(data, size);
+		}
+		else if (FILE* file = easy2d::platform::OpenFile(filePath, "rb"))
+		{
+			source = new FileSource(file);
+		}
+
+		if (source)
+		{
+			WaveDecoder* wave = new WaveDecoder(source, owner);
+			if (wave->isValid())
+			{
+				return wave;
+			}
+			wave->release();
+		}
+
+#if !defined(E2D_HEADLESS) && !defined(E2D_USE_MCI)
+		// ýֵ֧ĸʽʹ Media Foundation 
+		MediaFoundationDecoder* decoder = new MediaFoundationDecoder(owner);
+		HRESULT hr = filePath.empty() ? decoder->openMemory(data, size) : decoder->openFile(filePath);
+		if (SUCCEEDED(hr))
+		{
+			return decoder;
+		}
+		decoder->release();
+#endif
+		return nullptr;
+	}
+
+	// һԶȡеȫ
+	void DecodeAll(easy2d::AudioDecoder* decoder, std::vector<float>& samples)
+	{
+		const int channels = decoder->getChannelCount();
+
+		size_t frames = 0;
+		while (true)
+		{
+			samples.resize((frames + DECODE_FRAMES) * channels);
+			int count = decoder->read(samples.data() + frames * channels, DECODE_FRAMES);
+			if (count <= 0)
+			{
+				break;
+			}
+			frames += count;
+		}
+		samples.resize(frames * channels);
+	}
+}
+
+
+easy2d::Sound::Sound()
+	: _samples()
+	, _channelCount(0)
+	, _sampleRate(0)
+	, _frameCount(0)
+{
+}
+
+easy2d::Sound::Sound(const String& filePath)
+	: Sound()
+{
+	this->open(filePath);
+}
+
+easy2d::Sound::~Sound()
+{
+}
+
+bool easy2d::Sound::open(const String& filePath)
+{
+	if (isOpened())
+	{
+		E2D_WARNING(L"Sound can be opened only once!");
+		return false;
+	}
+
+	// ԴеƵֱӴӳڴн
+	Archive * archive = Archive::search(filePath);
+	if (archive)
+	{
+		return open(archive->getData(filePath));
+	}
+
+	String actualFilePath = Path::searchForFile(filePath);
+	if (actualFilePath.empty())
+	{
+		E2D_WARNING(L"Sound::open failed! File not found.");
+		return false;
+	}
+
+	AudioDecoder * decoder = CreateDecoder(actualFilePath, nullptr, 0, nullptr);
+	if (!decoder)
+	{
+		E2D_WARNING(L"Sound::open failed! Unsupported audio format.");
+		return false;
+	}
+
+	std::vector<float> samples;
+	DecodeAll(decoder, samples);
+	bool succeeded = open(samples.data(), static_cast<int>(samples.size() / decoder->getChannelCount()), decoder->getChannelCount(), decoder->getSampleRate());
+	decoder->release();
+	return succeeded;
+}
+
+bool easy2d::Sound::open(const Resource::Data& data)
+{
+	if (isOpened())
+	{
+		E2D_WARNING(L"Sound can be opened only once!");
+		return false;
+	}
+
+	if (!data.isValid())
+	{
+		E2D_WARNING(L"Sound::open failed! Invalid data.");
+		return false;
+	}
+
+	AudioDecoder * decoder = CreateDecoder(L"", data.buffer, data.size, nullptr);
+	if (!decoder)
+	{
+		E2D_WARNING(L"Sound::open failed! Unsupported audio format.");
+		return false;
+	}
+
+	std::vector<float> samples;
+	DecodeAll(decoder, samples);
+	bool succeeded = open(samples.data(), static_cast<int>(samples.size() / decoder->getChannelCount()), decoder->getChannelCount(), decoder->getSampleRate());
+	decoder->release();
+	return succeeded;
+}
+
+bool easy2d::Sound::open(const float* samples, int frameCount, int channelCount, int sampleRate)
+{
+	if (isOpened())
+	{
+		E2D_WARNING(L"Sound can be opened only once!");
+		return false;
+	}
+
+	if (!samples || frameCount <= 0 || channelCount < 1 || channelCount > 2 || sampleRate <= 0)
+	{
+		E2D_WARNING(L"Sound::open failed! Invalid samples.");
+		return false;
+	}
+
+	_samples.assign(samples, samples + static_cast<size_t>(frameCount) * channelCount);
+	_channelCount = channelCount;
+	_sampleRate = sampleRate;
+	_frameCount = frameCount;
+	return true;
+}
+
+bool easy2d::Sound::isOpened() const
+{
+	return _frameCount > 0;
+}
+
+int easy2d::Sound::getChannelCount() const
+{
+	return _channelCount;
+}
+
+int easy2d::Sound::getSampleRate() const
+{
+	return _sampleRate;
+}
+
+int easy2d::Sound::getFrameCount() const
+{
+	return _frameCount;
+}
+
+float easy2d::Sound::getDuration() const
+{
+	return _sampleRate ? float(_frameCount) / _sampleRate : 0.f;
+}
+
+easy2d::Sound * easy2d::Sound::preload(const String& filePath)
+{
+	auto iter = s_mSoundCache.find(filePath);
+	if (iter != s_mSoundCache.end())
+	{
+		return iter->second;
+	}
+
+	Sound * sound = gcnew Sound;
+	if (!sound->open(filePath))
+	{
+		return nullptr;
+	}
+
+	GC::retain(sound);
+	s_mSoundCache.insert(std::make_pair(filePath, sound));
+	return sound;
+}
+
+void easy2d::Sound::clearCache()
+{
+	for (auto pair : s_mSoundCache)
+	{
+		GC::release(pair.second);
+	}
+	s_mSoundCache.clear();
+}
+
+
+easy2d::SoundStream::SoundStream()
+	: _filePath()
+	, _data()
+	, _archiveData()
+	, _archive(nullptr)
+	, _channelCount(0)
+	, _sampleRate(0)
+{
+}
+
+easy2d::SoundStream::SoundStream(const String& filePath)
+	: SoundStream()
+{
+	this->open(filePath);
+}
+
+easy2d::SoundStream::~SoundStream()
+{
+	GC::release(_archive);
+}
+
+bool easy2d::SoundStream::open(const String& filePath)
+{
+	if (isOpened())
+	{
+		E2D_WARNING(L"SoundStream can be opened only once!");
+		return false;
+	}
+
+	// ԴеƵֱӴӳڴн
+	Archive * archive = Archive::search(filePath);
+	if (archive)
+	{
+		_archiveData = archive->getData(filePath);
+		if (!_archiveData.isValid())
+		{
+			E2D_WARNING(L"SoundStream::open failed! Invalid data.");
+			return false;
+		}
+		_archive = archive;
+		GC::retain(_archive);
+	}
+	else
+	{
+		_filePath = Path::searchForFile(filePath);
+		if (_filePath.empty())
+		{
+			E2D_WARNING(L"SoundStream::open failed! File not found.");
+			return false;
+		}
+	}
+
+	if (!_probe())
+	{
+		_filePath.clear();
+		_archiveData = Resource::Data();
+		GC::release(_archive);
+		return false;
+	}
+	return true;
+}
+
+bool easy2d::SoundStream::open(const Resource::Data& data)
+{
+	if (isOpened())
+	{
+		E2D_WARNING(L"SoundStream can be opened only once!");
+		return false;
+	}
+
+	if (!data.isValid())
+	{
+		E2D_WARNING(L"SoundStream::open failed! Invalid data.");
+		return false;
+	}
+
+	const unsigned char* bytes = static_cast<const unsigned char*>(data.buffer);
+	_data.assign(bytes, bytes + data.size);
+
+	if (!_probe())
+	{
+		std::vector<unsigned char>().swap(_data);
+		return false;
+	}
+	return true;
+}
+
+bool easy2d::SoundStream::isOpened() const
+{
+	return _channelCount > 0;
+}
+
+int easy2d::SoundStream::getChannelCount() const
+{
+	return _channelCount;
+}
+
+int easy2d::SoundStream::getSampleRate() const
+{
+	return _sampleRate;
+}
+
+easy2d::AudioDecoder * easy2d::SoundStream::createDecoder()
+{
+	AudioDecoder * decoder = _createDecoder();
+	if (decoder)
+	{
+		decoder->autorelease();
+	}
+	return decoder;
+}
+
+easy2d::AudioDecoder * easy2d::SoundStream::_createDecoder()
+{
+	if (!_filePath.empty())
+	{
+		return CreateDecoder(_filePath, nullptr, 0, this);
+	}
+	else if (_archive)
+	{
+		return CreateDecoder(L"", _archiveData.buffer, _archiveData.size, this);
+	}
+	else if (!_data.empty())
+	{
+		return CreateDecoder(L"", _data.data(), _data.size(), this);
+	}
+	return nullptr;
+}
+
+bool easy2d::SoundStream::_probe()
+{
+	// Ŵһνȡʽرļ
+	AudioDecoder * decoder = _createDecoder();
+	if (!decoder)
+	{
+		E2D_WARNING(L"SoundStream::open failed! Unsupported audio format.");
+		return false;
+	}
+
+	_channelCount = decoder->getChannelCount();
+	_sampleRate = decoder->getSampleRate();
+	decoder->release();
+	return true;
+}
@@ -1,5 +1,6 @@
 #include <easy2d/e2dtool.h>
 #include <easy2d/e2dnode.h>
+#include <unordered_map>
 
 namespace easy2d
 {
@@ -20,24 +21,26 @@ namespace easy2d
 			, totalTimes(updateTimes)
 			, delay(max(delay, 0))
 			, lastTime(easy2d::Time::getTotalTime())
+			, due(0)
 			, callback(func)
 			, name(name)
+			, seq(0)
+			, index(0)
+			, heapIndex(static_cast<size_t>(-1))
+			, prevNamed(nullptr)
+			, nextNamed(nullptr)
 		{
 		}
 
 		void update()
 		{
-			if (callback)
-			{
-				callback();
-			}
-
+			// ȸ״̬صпʱ
 			++runTimes;
 			lastTime += delay;
 
-			if (runTimes == totalTimes)
+			if (callback)
 			{
-				stopped = true;
+				callback();
 			}
 		}
 
@@ -61,12 +64,179 @@ namespace easy2d
 		int		totalTimes;
 		float	delay;
 		float	lastTime;
+		float	due;			// ´ִеʱ
 		easy2d::String name;
 		easy2d::Function<void()> callback;
+		size_t	seq;			// ˳ִʱͬʱӵִ
+		size_t	index;			// ڶʱеλ
+		size_t	heapIndex;		// Сеλ
+		TimerEntity* prevNamed;	// ͬǰһʱ
+		TimerEntity* nextNamed;	// ͬĺһʱ
 	};
 }
 
-static std::vector<easy2d::TimerEntity*> s_vTimers;
+namespace
+{
+	const size_t NO_INDEX = static_cast<size_t>(-1);
+
+	// жʱƳʱĩβĶʱλ
+	std::vector<easy2d::TimerEntity*> s_vTimers;
+
+	// еĶʱ´ִеʱųС
+	std::vector<easy2d::TimerEntity*> s_vHeap;
+
+	// Ƶͬʱ
+	std::unordered_map<easy2d::String, easy2d::TimerEntity*> s_mNamedTimers;
+
+	// ӵĶʱ
+	size_t s_nTimerSeq = 0;
+
+	bool Earlier(easy2d::TimerEntity* a, easy2d::TimerEntity* b)
+	{
+		if (a->due != b->due)
+			return a->due < b->due;
+		return a->seq < b->seq;
+	}
+
+	void HeapSet(size_t i, easy2d::TimerEntity* timer)
+	{
+		s_vHeap[i] = timer;
+		timer->heapIndex = i;
+	}
+
+	void SiftUp(size_t i)
+	{
+		auto timer = s_vHeap[i];
+		while (i > 0)
+		{
+			size_t parent = (i - 1) / 2;
+			if (!Earlier(timer, s_vHeap[parent]))
+				break;
+			HeapSet(i, s_vHeap[parent]);
+			i = parent;
+		}
+		HeapSet(i, timer);
+	}
+
+	void SiftDown(size_t i)
+	{
+		auto timer = s_vHeap[i];
+		const size_t size = s_vHeap.size();
+		while (true)
+		{
+			size_t child = i * 2 + 1;
+			if (child >= size)
+				break;
+			if (child + 1 < size && Earlier(s_vHeap[child + 1], s_vHeap[child]))
+				++child;
+			if (!Earlier(s_vHeap[child], timer))
+				break;
+			HeapSet(i, s_vHeap[child]);
+			i = child;
+		}
+		HeapSet(i, timer);
+	}
+
+	// ѶʱС
+	void Schedule(easy2d::TimerEntity* timer)
+	{
+		if (timer->heapIndex != NO_INDEX)
+			return;
+
+		timer->due = timer->lastTime + timer->delay;
+		s_vHeap.push_back(timer);
+		SiftUp(s_vHeap.size() - 1);
+	}
+
+	// ѶʱСƳ
+	void Unschedule(easy2d::TimerEntity* timer)
+	{
+		size_t i = timer->heapIndex;
+		if (i == NO_INDEX)
+			return;
+
+		timer->heapIndex = NO_INDEX;
+		auto last = s_vHeap.back();
+		s_vHeap.pop_back();
+
+		if (last != timer)
+		{
+			HeapSet(i, last);
+			SiftUp(i);
+			SiftDown(last->heapIndex);
+		}
+	}
+
+	// ƳͷŶʱ
+	void Destroy(easy2d::TimerEntity* timer)
+	{
+		if (timer->stopped)
+			return;
+
+		timer->stopped = true;
+		Unschedule(timer);
+
+		// Ƴ
+		if (timer->prevNamed)
+		{
+			timer->prevNamed->nextNamed = timer->nextNamed;
+		}
+		else if (!timer->name.empty())
+		{
+			if (timer->nextNamed)
+				s_mNamedTimers[timer->name] = timer->nextNamed;
+			else
+				s_mNamedTimers.erase(timer->name);
+		}
+
+		if (timer->nextNamed)
+		{
+			timer->nextNamed->prevNamed = timer->prevNamed;
+		}
+		timer->prevNamed = timer->nextNamed = nullptr;
+
+		// ĩβĶʱλ
+		auto last = s_vTimers.back();
+		s_vTimers[timer->index] = last;
+		last->index = timer->index;
+		s_vTimers.pop_back();
+
+		easy2d::GC::release(timer);
+	}
+
+	// ͬжʱִв
+	template <typename _Func>
+	void ForEachNamed(const easy2d::String& name, _Func func)
+	{
+		if (name.empty())
+		{
+			// δĶʱû
+			std::vector<easy2d::TimerEntity*> timers;
+			for (auto timer : s_vTimers)
+			{
+				if (timer->name.empty())
+					timers.push_back(timer);
+			}
+
+			for (auto timer : timers)
+			{
+				func(timer);
+			}
+			return;
+		}
+
+		auto iter = s_mNamedTimers.find(name);
+		if (iter == s_mNamedTimers.end())
+			return;
+
+		for (auto timer = iter->second; timer;)
+		{
+			auto next = timer->nextNamed;
+			func(timer);
+			timer = next;
+		}
+	}
+}
 
 
 void easy2d::Timer::add(const Function<void()>& func, float delay, int updateTimes, bool paused, const String& name)
@@ -74,7 +244,25 @@ void easy2d::Timer::add(const Function<void()>& func, float delay, int updateTim
 	auto timer = gcnew TimerEntity(func, name, delay, updateTimes, paused);
 	GC::retain(timer);
 
+	timer->seq = s_nTimerSeq++;
+	timer->index = s_vTimers.size();
 	s_vTimers.push_back(timer);
+
+	if (!name.empty())
+	{
+		auto& head = s_mNamedTimers[name];
+		timer->nextNamed = head;
+		if (head)
+		{
+			head->prevNamed = timer;
+		}
+		head = timer;
+	}
+
+	if (timer->running)
+	{
+		Schedule(timer);
+	}
 }
 
 void easy2d::Timer::add(const Function<void()>& func, const String& name)
@@ -89,35 +277,28 @@ void easy2d::Timer::start(float timeout, const Function<void()>& func)
 
 void easy2d::Timer::stop(const String& name)
 {
-	for (auto timer : s_vTimers)
+	ForEachNamed(name, [](TimerEntity* timer)
 	{
-		if (timer->name == name)
-		{
-			timer->running = false;
-		}
-	}
+		timer->running = false;
+		Unschedule(timer);
+	});
 }
 
 void easy2d::Timer::start(const String& name)
 {
-	for (auto timer : s_vTimers)
+	ForEachNamed(name, [](TimerEntity* timer)
 	{
-		if (timer->name == name)
-		{
-			timer->running = true;
-		}
-	}
+		timer->running = true;
+		Schedule(timer);
+	});
 }
 
 void easy2d::Timer::remove(const String& name)
 {
-	for (auto timer : s_vTimers)
+	ForEachNamed(name, [](TimerEntity* timer)
 	{
-		if (timer->name == name)
-		{
-			timer->stopped = true;
-		}
-	}
+		Destroy(timer);
+	});
 }
 
 void easy2d::Timer::stopAll()
@@ -125,7 +306,9 @@ void easy2d::Timer::stopAll()
 	for (auto timer : s_vTimers)
 	{
 		timer->running = false;
+		timer->heapIndex = NO_INDEX;
 	}
+	s_vHeap.clear();
 }
 
 void easy2d::Timer::startAll()
@@ -133,41 +316,53 @@ void easy2d::Timer::startAll()
 	for (auto timer : s_vTimers)
 	{
 		timer->running = true;
+		Schedule(timer);
 	}
 }
 
 void easy2d::Timer::removeAll()
 {
-	for (auto timer : s_vTimers)
+	while (!s_vTimers.empty())
 	{
-		timer->stopped = true;
+		Destroy(s_vTimers.back());
 	}
 }
 
 void easy2d::Timer::__update()
 {
-	if (s_vTimers.empty() || Game::isPaused())
+	E2D_PROFILE_SCOPE("Timer::update");
+
+	if (s_vHeap.empty() || Game::isPaused())
 		return;
 
-	for (size_t i = 0; i < s_vTimers.size();)
+	// ȡеڵĶʱÿʱÿִ֡һ
+	std::vector<TimerEntity*> readyTimers;
+	while (!s_vHeap.empty() && s_vHeap[0]->ready())
 	{
-		auto timer = s_vTimers[i];
-		// ֹͣĶʱ
-		if (timer->stopped)
-		{
-			GC::release(timer);
-			s_vTimers.erase(s_vTimers.begin() + i);
-		}
-		else
+		auto timer = s_vHeap[0];
+		Unschedule(timer);
+		GC::retain(timer);
+		readyTimers.push_back(timer);
+	}
+
+	for (auto timer : readyTimers)
+	{
+		// ǰĶʱƳֹͣʱ
+		if (!timer->stopped && timer->running)
 		{
-			// ¶ʱ
-			if (timer->ready())
+			timer->update();
+
+			if (timer->runTimes == timer->totalTimes)
 			{
-				timer->update();
+				Destroy(timer);
+			}
+			else if (timer->running && !timer->stopped)
+			{
+				// صпƳֹͣʱ
+				Schedule(timer);
 			}
-
-			++i;
 		}
+		GC::release(timer);
 	}
 }
 
@@ -176,6 +371,13 @@ void easy2d::Timer::__resetAll()
 	for (auto timer : s_vTimers)
 	{
 		timer->lastTime = Time::getTotalTime();
+		timer->due = timer->lastTime + timer->delay;
+	}
+
+	// ½
+	for (size_t i = s_vHeap.size() / 2; i-- > 0;)
+	{
+		SiftDown(i);
 	}
 }
 
@@ -186,4 +388,6 @@ void easy2d::Timer::__uninit()
 		GC::release(timer);
 	}
 	s_vTimers.clear();
-}
\ No newline at end of file
+	s_vHeap.clear();
+	s_mNamedTimers.clear();
+}
@@ -16,22 +16,22 @@ void easy2d::BoxTransition::_updateCustom()
 {
 	if (_delta <= 0.5)
 	{
-		_outLayerParam.contentBounds = D2D1::RectF(
+		_outLayerParam.clipRect = Rect(
 			float(_windowSize.width * _delta),
 			float(_windowSize.height * _delta),
-			float(_windowSize.width * (1 - _delta)),
-			float(_windowSize.height * (1 - _delta))
+			float(_windowSize.width * (1 - 2 * _delta)),
+			float(_windowSize.height * (1 - 2 * _delta))
 		);
 	}
 	else
 	{
 		_outLayerParam.opacity = 0;
 		_inLayerParam.opacity = 1;
-		_inLayerParam.contentBounds = D2D1::RectF(
+		_inLayerParam.clipRect = Rect(
 			float(_windowSize.width * (1 - _delta)),
 			float(_windowSize.height * (1 - _delta)),
-			float(_windowSize.width * _delta),
-			float(_windowSize.height * _delta)
+			float(_windowSize.width * (2 * _delta - 1)),
+			float(_windowSize.height * (2 * _delta - 1))
 		);
 		if (_delta >= 1)
 		{
@@ -2,14 +2,30 @@
 #include <easy2d/e2dtransition.h>
 #include <easy2d/e2dnode.h>
 
+namespace
+{
+	// ڴڵĿɼͼĲüϲ
+	easy2d::LayerParam MakeSceneLayerParam(const easy2d::Point& rootPos, const easy2d::Size& windowSize, const easy2d::LayerParam& param)
+	{
+		const easy2d::Rect& bounds = param.clipRect;
+		float left = max(max(rootPos.x, 0), bounds.getLeft());
+		float top = max(max(rootPos.y, 0), bounds.getTop());
+		float right = min(min(rootPos.x + windowSize.width, windowSize.width), bounds.getRight());
+		float bottom = min(min(rootPos.y + windowSize.height, windowSize.height), bounds.getBottom());
+
+		return easy2d::LayerParam(
+			easy2d::Rect(left, top, max(right - left, 0), max(bottom - top, 0)),
+			param.opacity
+		);
+	}
+}
+
 easy2d::Transition::Transition(float duration)
 	: _end(false)
 	, _last(0)
 	, _delta(0)
 	, _outScene(nullptr)
 	, _inScene(nullptr)
-	, _outLayer(nullptr)
-	, _inLayer(nullptr)
 	, _outLayerParam()
 	, _inLayerParam()
 {
@@ -18,9 +34,6 @@ easy2d::Transition::Transition(float duration)
 
 easy2d::Transition::~Transition()
 {
-	SafeRelease(_outLayer);
-	SafeRelease(_inLayer);
-
 	GC::release(_outScene);
 	GC::release(_inScene);
 }
@@ -32,20 +45,6 @@ bool easy2d::Transition::isDone()
 
 void easy2d::Transition::_init(Scene * prev, Scene * next)
 {
-	// ͼ
-	HRESULT hr = Renderer::getRenderTarget()->CreateLayer(&_inLayer);
-
-	if (SUCCEEDED(hr))
-	{
-		hr = Renderer::getRenderTarget()->CreateLayer(&_outLayer);
-	}
-
-	if (FAILED(hr))
-	{
-		E2D_WARNING(L"ɶͼ㴴ʧ");
-		return;
-	}
-
 	_last = Time::getTotalTime();
 	_outScene = prev;
 	_inScene = next;
@@ -53,7 +52,7 @@ void easy2d::Transition::_init(Scene * prev, Scene * next)
 	if (_inScene) _inScene->retain();
 
 	_windowSize = Window::getSize();
-	_outLayerParam = _inLayerParam = D2D1::LayerParameters();
+	_outLayerParam = _inLayerParam = LayerParam();
 }
 
 void easy2d::Transition::_update()
@@ -83,44 +82,26 @@ void easy2d::Transition::_update()
 
 void easy2d::Transition::_render()
 {
-	auto pRT = Renderer::getRenderTarget();
+	auto device = Renderer::getDevice();
 
 	if (_outScene)
 	{
-		Point rootPos = _outScene->getPos();
-		auto clipRect = D2D1::RectF(
-			float(max(rootPos.x, 0)),
-			float(max(rootPos.y, 0)),
-			float(min(rootPos.x + _windowSize.width, _windowSize.width)),
-			float(min(rootPos.y + _windowSize.height, _windowSize.height))
-		);
-		pRT->SetTransform(D2D1::Matrix3x2F::Identity());
-		pRT->PushAxisAlignedClip(clipRect, D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
-		pRT->PushLayer(_outLayerParam, _outLayer);
+		device->setTransform(Matrix32());
+		device->pushLayer(MakeSceneLayerParam(_outScene->getPos(), _windowSize, _outLayerParam));
 
-		_outScene->_render();
+		_outScene->_renderView();
 
-		pRT->PopLayer();
-		pRT->PopAxisAlignedClip();
+		device->popLayer();
 	}
 
 	if (_inScene)
 	{
-		Point rootPos = _inScene->getPos();
-		auto clipRect = D2D1::RectF(
-			float(max(rootPos.x, 0)),
-			float(max(rootPos.y, 0)),
-			float(min(rootPos.x + _windowSize.width, _windowSize.width)),
-			float(min(rootPos.y + _windowSize.height, _windowSize.height))
-		);
-		pRT->SetTransform(D2D1::Matrix3x2F::Identity());
-		pRT->PushAxisAlignedClip(clipRect, D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
-		pRT->PushLayer(_inLayerParam, _inLayer);
+		device->setTransform(Matrix32());
+		device->pushLayer(MakeSceneLayerParam(_inScene->getPos(), _windowSize, _inLayerParam));
 
-		_inScene->_render();
+		_inScene->_renderView();
 
-		pRT->PopLayer();
-		pRT->PopAxisAlignedClip();
+		device->popLayer();
 	}
 }
 
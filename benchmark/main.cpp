@@ -0,0 +1,650 @@
+// Easy2D ܻ׼
+// ޴ڻĳ· JSON ʽ׼ڱȽϲͬύ֮Ĳ
+// ÷easy2d-benchmark [--repeat ] [ƹ ...]
+
+#include <easy2d/easy2d.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace easy2d;
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	// һβĽ
+	struct Sample
+	{
+		double seconds;		// ܺʱ
+		double operations;	// ִеĲ
+	};
+
+	struct Benchmark
+	{
+		const char* name;
+		const char* unit;	// һβĺ
+		Function<Sample()> run;
+	};
+
+	// ֹŻ
+	volatile float s_fSink = 0;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// ־׼󣬱׼ֻԽ
+	class StderrLogSink :
+		public LogSink
+	{
+	public:
+		virtual void write(Logger::Level level, const String& text) override
+		{
+			const ByteString output = WideToUtf8(text);
+			::fwrite(output.data(), 1, output.size(), stderr);
+		}
+	};
+
+	// ÿ֡ʱִлصʱָ֡Ϸ
+	class FrameDriver :
+		public Node
+	{
+	public:
+		FrameDriver(int warmupFrames, int frames, const Function<void()>& perFrame)
+			: _warmupFrames(warmupFrames)
+			, _frames(frames)
+			, _frame(0)
+			, _seconds(0)
+			, _perFrame(perFrame)
+		{
+		}
+
+		virtual void onUpdate() override
+		{
+			if (_perFrame)
+			{
+				_perFrame();
+			}
+
+			++_frame;
+			if (_frame == _warmupFrames)
+			{
+				_start = Clock::now();
+			}
+			else if (_frame == _warmupFrames + _frames)
+			{
+				_seconds = SecondsSince(_start);
+				Game::quit();
+			}
+		}
+
+		double getSeconds() const { return _seconds; }
+
+	private:
+		int _warmupFrames;
+		int _frames;
+		int _frame;
+		double _seconds;
+		Clock::time_point _start;
+		Function<void()> _perFrame;
+	};
+
+	// Ϸѭ֡ؼʱ֡ܺʱ
+	// Ϸʱ䲻ʵʱͬÿֻ֡һҲȴ
+	double RunFrames(const Function<void(Scene*)>& setup, int frames, const Function<void()>& perFrame = nullptr)
+	{
+		const int warmupFrames = 3;
+
+		Scene* scene = gcnew Scene;
+		setup(scene);
+
+		FrameDriver* driver = gcnew FrameDriver(warmupFrames, frames, perFrame);
+		GC::retain(driver);
+		scene->addChild(driver);
+
+		SceneManager::enter(scene, nullptr, false);
+		Game::start();
+
+		double seconds = driver->getSeconds();
+		GC::release(driver);
+		GC::clear();
+		return seconds;
+	}
+
+	//
+	// ڵ
+	//
+
+	// 1000 Ľڵÿ޸ĸڵȡڵı任
+	Sample TransformDeep()
+	{
+		const int depth = 1000;
+		const int iterations = 2000;
+
+		Node* root = gcnew Node;
+		GC::retain(root);
+
+		Node* leaf = root;
+		for (int i = 1; i < depth; ++i)
+		{
+			Node* child = gcnew Node;
+			child->setPos(1, 1);
+			child->setRotation(0.1f);
+			leaf->addChild(child);
+			leaf = child;
+		}
+
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			root->setRotation(static_cast<float>(i));
+			s_fSink = s_fSink + leaf->getTransform()._31;
+		}
+		Sample sample = { SecondsSince(start), double(iterations) * depth };
+
+		GC::release(root);
+		GC::clear();
+		return sample;
+	}
+
+	// һڵµ 10000 ӽڵ㣬ÿ޸ĸڵȡӽڵı任
+	Sample TransformWide()
+	{
+		const int width = 10000;
+		const int iterations = 500;
+
+		Node* root = gcnew Node;
+		GC::retain(root);
+
+		Node* last = nullptr;
+		for (int i = 0; i < width; ++i)
+		{
+			last = gcnew Node;
+			last->setPos(static_cast<float>(i % 100), static_cast<float>(i / 100));
+			root->addChild(last);
+		}
+
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			root->setPosX(static_cast<float>(i));
+			s_fSink = s_fSink + last->getTransform()._31;
+		}
+		Sample sample = { SecondsSince(start), double(iterations) * width };
+
+		GC::release(root);
+		GC::clear();
+		return sample;
+	}
+
+	// ÿ֡ 10000 ӽڵ˳һ֡ʱ
+	Sample SortChildren()
+	{
+		const int childCount = 10000;
+		const int frames = 100;
+
+		std::vector<Node*> children;
+		std::mt19937 random(42);
+
+		double seconds = RunFrames(
+			[&](Scene* scene)
+			{
+				Node* parent = gcnew Node;
+				for (int i = 0; i < childCount; ++i)
+				{
+					Node* child = gcnew Node;
+					parent->addChild(child);
+					children.push_back(child);
+				}
+				scene->addChild(parent);
+			},
+			frames,
+			[&]()
+			{
+				for (auto child : children)
+				{
+					child->setOrder(static_cast<int>(random() % 1000));
+				}
+			}
+		);
+
+		Sample sample = { seconds, double(frames) * childCount };
+		return sample;
+	}
+
+	// 㹲 1100 Ľڵַƶ¼
+	Sample ListenerDispatch()
+	{
+		const int branches = 100;
+		const int leaves = 10;
+		const int iterations = 1000;
+
+		int handled = 0;
+		Node* root = gcnew Node;
+		GC::retain(root);
+
+		for (int i = 0; i < branches; ++i)
+		{
+			Node* branch = gcnew Node;
+			branch->addListener([&](Event*) { ++handled; });
+			for (int j = 0; j < leaves; ++j)
+			{
+				Node* leaf = gcnew Node;
+				leaf->addListener([&](Event*) { ++handled; });
+				branch->addChild(leaf);
+			}
+			root->addChild(branch);
+		}
+
+		MouseMoveEvent evt(10, 10);
+		Clock::time_point start = Clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			root->dispatch(&evt);
+		}
+		Sample sample = { SecondsSince(start), double(handled) };
+
+		GC::release(root);
+		GC::clear();
+		return sample;
+	}
+
+	//
+	// 붨ʱ
+	//
+
+	// 50000 ڵִһ MoveBy һ RotateBy
+	Sample Actions()
+	{
+		const int nodeCount = 50000;
+		const int frames = 30;
+
+		double seconds = RunFrames(
+			[&](Scene* scene)
+			{
+				for (int i = 0; i < nodeCount; ++i)
+				{
+					Node* node = gcnew Node;
+					node->runAction(gcnew MoveBy(1000.f, Vector2(100, 100)));
+					node->runAction(gcnew RotateBy(1000.f, 360.f));
+					scene->addChild(node);
+				}
+			},
+			frames
+		);
+
+		Sample sample = { seconds, double(frames) * nodeCount * 2 };
+		return sample;
+	}
+
+	// ÿ֡ 1000 ִֻһεĶʱ֮֡дƳ
+	Sample TimerChurn()
+	{
+		const int timersPerFrame = 1000;
+		const int frames = 100;
+
+		int fired = 0;
+		double seconds = RunFrames(
+			[](Scene*) {},
+			frames,
+			[&]()
+			{
+				for (int i = 0; i < timersPerFrame; ++i)
+				{
+					Timer::add([&]() { ++fired; }, 0.f, 1);
+				}
+			}
+		);
+
+		Timer::removeAll();
+		Sample sample = { seconds, double(frames) * timersPerFrame };
+		return sample;
+	}
+
+	//
+	// ڴ
+	//
+
+	// ԶͷŵĶ GC::clear ͳһ
+	Sample GCChurn()
+	{
+		const int objectsPerRound = 10000;
+		const int rounds = 50;
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			for (int i = 0; i < objectsPerRound; ++i)
+			{
+				gcnew Listener;
+			}
+			GC::clear();
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * objectsPerRound };
+		return sample;
+	}
+
+	//
+	// 
+	//
+
+	std::vector<Matrix32> MakeMatrices(size_t count)
+	{
+		std::vector<Matrix32> matrices;
+		matrices.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const float f = static_cast<float>(i);
+			Matrix32 m = Matrix32::scaling(1.f + f * 0.001f, 2.f) * Matrix32::rotation(f) * Matrix32::translation(f, -f);
+			matrices.push_back(m);
+		}
+		return matrices;
+	}
+
+	Sample Matrix32Multiply()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		std::vector<Matrix32> matrices = MakeMatrices(count);
+		Matrix32 result;
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			for (size_t i = 1; i < count; ++i)
+			{
+				result = matrices[i - 1] * matrices[i];
+				s_fSink = s_fSink + result._31;
+			}
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * (count - 1) };
+		return sample;
+	}
+
+	Sample Matrix32TransformPoint()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		std::vector<Matrix32> matrices = MakeMatrices(count);
+		Vector2 point(1, 2);
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				Vector2 p = matrices[i].transform(point);
+				s_fSink = s_fSink + p.x;
+			}
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * count };
+		return sample;
+	}
+
+	Sample Matrix32Invert()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		std::vector<Matrix32> matrices = MakeMatrices(count);
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				Matrix32 inverse = Matrix32::invert(matrices[i]);
+				s_fSink = s_fSink + inverse._11;
+			}
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * count };
+		return sample;
+	}
+
+	Sample Matrix32TransformRect()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		std::vector<Matrix32> matrices = MakeMatrices(count);
+		Rect rect(-1, -2, 3, 4);
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				Rect r = matrices[i].transform(rect);
+				s_fSink = s_fSink + r.size.width;
+			}
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * count };
+		return sample;
+	}
+
+	// ת󣬽ǶȸǶȦķ֮һΪ 0 
+	Sample Matrix32Rotation()
+	{
+		const int count = 4096;
+		const int rounds = 500;
+
+		std::vector<float> angles(count);
+		for (int i = 0; i < count; ++i)
+		{
+			angles[i] = (i % 4 == 0) ? 0.f : static_cast<float>(i) * 0.37f - 500.f;
+		}
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				Matrix32 m = Matrix32::rotation(angles[i]);
+				s_fSink = s_fSink + m._12;
+			}
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * count };
+		return sample;
+	}
+
+	//
+	// 
+	//
+
+	Sample Matrix32MultiplyBatch()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		std::vector<Matrix32> matrices = MakeMatrices(count);
+		std::vector<Matrix32> results(count);
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			Matrix32::multiply(&matrices[0], &matrices[1], &results[0], count - 1);
+			s_fSink = s_fSink + results[round % (count - 1)]._31;
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * (count - 1) };
+		return sample;
+	}
+
+	Sample Matrix32TransformPointBatch()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		Matrix32 matrix = MakeMatrices(2)[1];
+		std::vector<Vector2> points(count);
+		std::vector<Vector2> results(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			points[i] = Vector2(static_cast<float>(i), 2);
+		}
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			Matrix32::transformPoints(matrix, &points[0], &results[0], count);
+			s_fSink = s_fSink + results[round % count].x;
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * count };
+		return sample;
+	}
+
+	Sample Matrix32TransformRectBatch()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		std::vector<Matrix32> matrices = MakeMatrices(count);
+		std::vector<Rect> rects(count, Rect(-1, -2, 3, 4));
+		std::vector<Rect> results(count);
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			Matrix32::transformRects(&matrices[0], &rects[0], &results[0], count);
+			s_fSink = s_fSink + results[round % count].size.width;
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * count };
+		return sample;
+	}
+
+	Sample Matrix32InvertBatch()
+	{
+		const size_t count = 4096;
+		const int rounds = 500;
+
+		std::vector<Matrix32> matrices = MakeMatrices(count);
+		std::vector<Matrix32> results(count);
+
+		Clock::time_point start = Clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			Matrix32::invert(&matrices[0], &results[0], count);
+			s_fSink = s_fSink + results[round % count]._11;
+		}
+		Sample sample = { SecondsSince(start), double(rounds) * count };
+		return sample;
+	}
+
+	bool MatchesFilter(const char* name, const std::vector<const char*>& filters)
+	{
+		if (filters.empty())
+		{
+			return true;
+		}
+		for (auto filter : filters)
+		{
+			if (::strstr(name, filter))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int repeat = 5;
+	std::vector<const char*> filters;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+		{
+			repeat = max(::atoi(argv[++i]), 1);
+		}
+		else
+		{
+			filters.push_back(argv[i]);
+		}
+	}
+
+	Logger::clearSinks();
+	Logger::addSink(gcnew StderrLogSink);
+
+	if (!Game::init(L"Easy2DBenchmark"))
+	{
+		return 1;
+	}
+
+	// ѭȴÿ֡һ
+	Time::setRealTime(false);
+	Time::setFixedStep(1.f / 60);
+
+	const Benchmark benchmarks[] =
+	{
+		{ "transform_deep", "node", TransformDeep },
+		{ "transform_wide", "node", TransformWide },
+		{ "sort_children", "child", SortChildren },
+		{ "listener_dispatch", "listener", ListenerDispatch },
+		{ "actions", "action", Actions },
+		{ "timer_churn", "timer", TimerChurn },
+		{ "gc_churn", "object", GCChurn },
+		{ "matrix_multiply", "matrix", Matrix32Multiply },
+		{ "matrix_transform_point", "point", Matrix32TransformPoint },
+		{ "matrix_transform_rect", "rect", Matrix32TransformRect },
+		{ "matrix_invert", "matrix", Matrix32Invert },
+		{ "matrix_rotation", "matrix", Matrix32Rotation },
+		{ "matrix_multiply_batch", "matrix", Matrix32MultiplyBatch },
+		{ "matrix_transform_point_batch", "point", Matrix32TransformPointBatch },
+		{ "matrix_transform_rect_batch", "rect", Matrix32TransformRectBatch },
+		{ "matrix_invert_batch", "matrix", Matrix32InvertBatch },
+	};
+
+	::printf(
+		"{\n\t\"repeat\": %d,\n\t\"matrix_instruction_set\": \"%s\",\n\t\"benchmarks\": [",
+		repeat,
+		Matrix32::getBatchInstructionSet()
+	);
+
+	bool first = true;
+	for (const auto& benchmark : benchmarks)
+	{
+		if (!MatchesFilter(benchmark.name, filters))
+		{
+			continue;
+		}
+
+		std::vector<double> results;
+		double operations = 0;
+		for (int i = 0; i < repeat; ++i)
+		{
+			Sample sample = benchmark.run();
+			operations = sample.operations;
+			results.push_back(sample.seconds * 1e9 / max(sample.operations, 1.0));
+		}
+		std::sort(results.begin(), results.end());
+
+		const double best = results.front();
+		const double median = results[results.size() / 2];
+
+		::fprintf(stderr, "%-30s %10.2f ns/%s (median %.2f)\n", benchmark.name, best, benchmark.unit, median);
+		::printf(
+			"%s\n\t\t{ \"name\": \"%s\", \"unit\": \"%s\", \"operations\": %.0f, \"min_ns_per_op\": %.3f, \"median_ns_per_op\": %.3f }",
+			first ? "" : ",",
+			benchmark.name,
+			benchmark.unit,
+			operations,
+			best,
+			median
+		);
+		::fflush(stdout);
+		first = false;
+	}
+
+	::printf("\n\t]\n}\n");
+
+	Game::destroy();
+	return 0;
+}
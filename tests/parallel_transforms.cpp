@@ -0,0 +1,133 @@
+// иеı任
+// ߳ͬʱƶڵ㲢ȡ󣬶ľõλһ
+
+#include <easy2d/easy2d.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace easy2d;
+
+namespace
+{
+	const int MOVER_COUNT = 64;
+	const int CHILD_COUNT = 4;
+	const int MOVES_PER_FRAME = 8;
+	const int FRAME_COUNT = 30;
+
+	// ںľֹڵ㣬ʹÿα任³ã̵߳Ķȡص
+	const int IDLE_COUNT = 2048;
+
+	// иµĸڵλ
+	const float GROUP_X = 100;
+	const float GROUP_Y = 50;
+
+	std::atomic<int> s_nFailures(0);
+	std::atomic<int> s_nChecks(0);
+	int s_nFrame = 0;
+
+	class Mover :
+		public Node
+	{
+	public:
+		explicit Mover(int index) : _index(index) {}
+
+		virtual void onUpdate() override
+		{
+			for (int k = 0; k < MOVES_PER_FRAME; ++k)
+			{
+				// ÿƶͬ꣬ȽϽʱû
+				const float x = float(_index * 1000 + k);
+				const float y = float(s_nFrame * 100 + k);
+				this->setPos(x, y);
+
+				Matrix32 world = this->getTransform();
+				check(world, GROUP_X + x, GROUP_Y + y);
+
+				// ӽڵ޸ĵĸڵ
+				auto& children = this->getAllChildren();
+				for (size_t i = 0; i < children.size(); ++i)
+				{
+					Matrix32 childWorld = children[i]->getTransform();
+					check(childWorld, GROUP_X + x + float(i), GROUP_Y + y + float(i));
+				}
+			}
+		}
+
+	private:
+		void check(const Matrix32& world, float x, float y)
+		{
+			++s_nChecks;
+			if (world._31 != x || world._32 != y)
+			{
+				if (++s_nFailures <= 8)
+				{
+					std::printf("FAILED: node %d expected (%g, %g), got (%g, %g)\n", _index, x, y, world._31, world._32);
+				}
+			}
+		}
+
+		int _index;
+	};
+
+	class Driver :
+		public Node
+	{
+	public:
+		virtual void onUpdate() override
+		{
+			if (++s_nFrame == FRAME_COUNT)
+			{
+				Game::quit();
+			}
+		}
+	};
+}
+
+int main()
+{
+	if (!Game::init(L"Easy2DTest"))
+	{
+		return 1;
+	}
+
+	Time::setRealTime(false);
+	Time::setFixedStep(1 / 60.f);
+	JobSystem::setThreadCount(4);
+	Renderer::setDevice(new SoftwareRenderDevice(16, 16, 1));
+
+	auto scene = gcnew Scene;
+	scene->addChild(gcnew Driver, -1);
+
+	auto group = gcnew Node;
+	group->setPos(GROUP_X, GROUP_Y);
+	group->setParallelUpdate(true);
+	scene->addChild(group);
+
+	for (int i = 0; i < MOVER_COUNT; ++i)
+	{
+		auto mover = gcnew Mover(i);
+		for (int j = 0; j < CHILD_COUNT; ++j)
+		{
+			auto child = gcnew Node;
+			child->setPos(float(j), float(j));
+			mover->addChild(child);
+		}
+		group->addChild(mover);
+	}
+
+	for (int i = 0; i < IDLE_COUNT; ++i)
+	{
+		scene->addChild(gcnew Node);
+	}
+
+	SceneManager::enter(scene, nullptr, false);
+	Game::start();
+
+	const int failures = s_nFailures;
+	std::printf("%d transforms checked, %d failed\n", int(s_nChecks), failures);
+
+	std::fflush(stdout);
+	std::_Exit(std::min(failures, 255));
+}
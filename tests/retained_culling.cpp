@@ -0,0 +1,94 @@
+// ģʽӿ޳
+// ڵ޳ӽڵӿʱ¼¼Ⱦ
+
+#include <easy2d/easy2d.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace easy2d;
+
+namespace
+{
+	const int SIZE = 64;
+
+	SoftwareRenderDevice * s_pDevice = nullptr;
+	Node * s_pChild = nullptr;
+	int s_nFrame = 0;
+	int s_nVisibleFrame = -1;
+
+	// ĿǷѱ
+	bool IsPixelDrawn(int x, int y)
+	{
+		const unsigned char* pixel = s_pDevice->getPixels() + (y * SIZE + x) * 4;
+		return pixel[0] != 0 || pixel[1] != 0 || pixel[2] != 0;
+	}
+
+	class Driver :
+		public Node
+	{
+	public:
+		virtual void onUpdate() override
+		{
+			// ǰ֡ڵӽڵ㶼ӿ֮⣬֮ӽڵӿ
+			if (s_nFrame == 3)
+			{
+				s_pChild->setPos(-180, -180);
+			}
+
+			if (s_nFrame > 3 && s_nVisibleFrame < 0 && IsPixelDrawn(24, 24))
+			{
+				s_nVisibleFrame = s_nFrame;
+			}
+
+			if (++s_nFrame == 12)
+			{
+				Game::quit();
+			}
+		}
+	};
+}
+
+int main()
+{
+	if (!Game::init(L"Easy2DTest"))
+	{
+		return 1;
+	}
+
+	Time::setRealTime(false);
+	Time::setFixedStep(1 / 60.f);
+	Renderer::setRetainedMode(true);
+	Renderer::setCulling(true);
+
+	s_pDevice = new SoftwareRenderDevice(SIZE, SIZE, 1);
+	Renderer::setDevice(s_pDevice);
+
+	auto scene = gcnew Scene;
+	auto parent = gcnew Node;
+	parent->setPos(200, 200);
+	scene->addChild(parent);
+
+	auto child = gcnew RectShape(Size(8, 8));
+	child->setStyle(Shape::Style::Solid);
+	child->setFillColor(Color(Color::Red));
+	parent->addChild(child);
+	s_pChild = child;
+
+	scene->addChild(gcnew Driver);
+	SceneManager::enter(scene, nullptr, false);
+	Game::start();
+
+	int failures = 0;
+	if (s_nVisibleFrame < 0)
+	{
+		std::printf("FAILED: child moved into the viewport was never drawn\n");
+		++failures;
+	}
+	else
+	{
+		std::printf("child drawn at frame %d\n", s_nVisibleFrame);
+	}
+
+	std::fflush(stdout);
+	std::_Exit(failures);
+}